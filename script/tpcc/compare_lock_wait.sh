@@ -0,0 +1,31 @@
+#!/bin/sh
+
+###############################################
+# Compare aborting at once against waiting for the owner of a tuple on TPC-C
+# across warehouse counts. Fewer warehouses mean more contention.
+#
+# Usage: compare_lock_wait.sh <path to tpcc binary> [extra tpcc options]
+#
+# Every run writes one line to lock_wait.summary:
+#   <lock wait timeout> <tpcc summary line>
+# The tpcc summary line is "scale backends warehouses goodput abort_rate
+# memory", the goodput only counts committed transactions.
+###############################################
+
+TPCC=${1:-./src/tpcc}
+[ $# -gt 0 ] && shift
+
+WAREHOUSES="1 2 4 8 16"
+TIMEOUTS="0 1000"
+
+rm -f lock_wait.summary
+
+for warehouses in $WAREHOUSES; do
+  for timeout in $TIMEOUTS; do
+    echo "Running TPC-C with $warehouses warehouses and lock wait $timeout us"
+    $TPCC -w $warehouses -l $timeout "$@" || exit 1
+    echo "$timeout $(head -n 1 outputfile.summary)" >> lock_wait.summary
+  done
+done
+
+cat lock_wait.summary
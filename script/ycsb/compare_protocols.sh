@@ -0,0 +1,31 @@
+#!/bin/sh
+
+###############################################
+# Compare timestamp ordering and optimistic concurrency control on YCSB
+# across skew levels.
+#
+# Usage: compare_protocols.sh <path to ycsb binary> [extra ycsb options]
+#
+# Every run writes one line to protocols.summary:
+#   <protocol> <ycsb summary line>
+# The ycsb summary line is "scale backends columns operations update_ratio
+# zipf_theta throughput abort_rate memory".
+###############################################
+
+YCSB=${1:-./src/ycsb}
+[ $# -gt 0 ] && shift
+
+THETAS="0.0 0.5 0.8 0.9 0.99"
+PROTOCOLS="to occ"
+
+rm -f protocols.summary
+
+for theta in $THETAS; do
+  for protocol in $PROTOCOLS; do
+    echo "Running YCSB with protocol $protocol and zipf theta $theta"
+    $YCSB -y $protocol -z $theta "$@" || exit 1
+    echo "$protocol $(head -n 1 outputfile.summary)" >> protocols.summary
+  done
+done
+
+cat protocols.summary
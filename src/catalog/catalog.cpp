@@ -62,6 +62,11 @@ void Catalog::CreateMetricsCatalog() {
   auto query_metrics_catalog = CreateMetricsCatalog(default_db_oid,
       QUERY_METRIC_NAME);
   default_db->AddTable(query_metrics_catalog.release(), true);
+
+  // Create table for log metrics
+  auto log_metrics_catalog = CreateMetricsCatalog(default_db_oid,
+      LOG_METRIC_NAME);
+  default_db->AddTable(log_metrics_catalog.release(), true);
   LOG_TRACE("Metrics tables created");
 }
 
@@ -519,6 +524,8 @@ std::unique_ptr<storage::DataTable> Catalog::CreateMetricsCatalog(
     schema = InitializeDatabaseMetricsSchema().release();
   } else if (table_name == INDEX_METRIC_NAME) {
     schema = InitializeIndexMetricsSchema().release();
+  } else if (table_name == LOG_METRIC_NAME) {
+    schema = InitializeLogMetricsSchema().release();
   }
 
   std::unique_ptr<storage::DataTable> table(
@@ -744,6 +751,45 @@ std::unique_ptr<catalog::Schema> Catalog::InitializeQueryMetricsSchema() {
   return database_schema;
 }
 
+// Initialize log catalog schema
+std::unique_ptr<catalog::Schema> Catalog::InitializeLogMetricsSchema() {
+  const std::string not_null_constraint_name = "not_null";
+  catalog::Constraint not_null_constraint(ConstraintType::NOTNULL,
+      not_null_constraint_name);
+  oid_t integer_type_size = type::Type::GetTypeSize(type::Type::INTEGER);
+  type::Type::TypeId integer_type = type::Type::INTEGER;
+
+  auto phase_column = catalog::Column(type::Type::VARCHAR, max_name_size,
+      "phase", true);
+  phase_column.AddConstraint(not_null_constraint);
+
+  // Latencies are in microseconds
+  auto count_column = catalog::Column(integer_type, integer_type_size,
+      "count", true);
+  count_column.AddConstraint(not_null_constraint);
+  auto average_column = catalog::Column(integer_type, integer_type_size,
+      "average", true);
+  average_column.AddConstraint(not_null_constraint);
+  auto median_column = catalog::Column(integer_type, integer_type_size,
+      "median", true);
+  median_column.AddConstraint(not_null_constraint);
+  auto perc_99th_column = catalog::Column(integer_type, integer_type_size,
+      "perc_99th", true);
+  perc_99th_column.AddConstraint(not_null_constraint);
+  auto max_column = catalog::Column(integer_type, integer_type_size, "max",
+      true);
+  max_column.AddConstraint(not_null_constraint);
+
+  auto timestamp_column = catalog::Column(integer_type, integer_type_size,
+      "time_stamp", true);
+  timestamp_column.AddConstraint(not_null_constraint);
+
+  std::unique_ptr<catalog::Schema> log_schema(new catalog::Schema( {
+      phase_column, count_column, average_column, median_column,
+      perc_99th_column, max_column, timestamp_column }));
+  return log_schema;
+}
+
 void Catalog::PrintCatalogs() {
 }
 
@@ -247,6 +247,35 @@ std::unique_ptr<storage::Tuple> GetQueryMetricsCatalogTuple(
   return std::move(tuple);
 }
 
+/**
+ * Generate a log metric tuple
+ * Input: The table schema, the phase name, the number of latencies recorded,
+ * their average, median, 99th percentile and max, the timestamp
+ * Returns: The generated tuple
+ */
+std::unique_ptr<storage::Tuple> GetLogMetricsCatalogTuple(
+    const catalog::Schema *schema, std::string phase, int64_t count,
+    int64_t average, int64_t median, int64_t perc_99th, int64_t max,
+    int64_t time_stamp, type::AbstractPool *pool) {
+  std::unique_ptr<storage::Tuple> tuple(new storage::Tuple(schema, true));
+  auto val1 = type::ValueFactory::GetVarcharValue(phase, nullptr);
+  auto val2 = type::ValueFactory::GetIntegerValue(count);
+  auto val3 = type::ValueFactory::GetIntegerValue(average);
+  auto val4 = type::ValueFactory::GetIntegerValue(median);
+  auto val5 = type::ValueFactory::GetIntegerValue(perc_99th);
+  auto val6 = type::ValueFactory::GetIntegerValue(max);
+  auto val7 = type::ValueFactory::GetIntegerValue(time_stamp);
+
+  tuple->SetValue(0, val1, pool);
+  tuple->SetValue(1, val2, nullptr);
+  tuple->SetValue(2, val3, nullptr);
+  tuple->SetValue(3, val4, nullptr);
+  tuple->SetValue(4, val5, nullptr);
+  tuple->SetValue(5, val6, nullptr);
+  tuple->SetValue(6, val7, nullptr);
+  return tuple;
+}
+
 /**
  * Generate a table catalog tuple
  * Input: The table schema, the table id, the table name, the database id, and
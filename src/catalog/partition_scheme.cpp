@@ -0,0 +1,155 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// partition_scheme.cpp
+//
+// Identification: src/catalog/partition_scheme.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "catalog/partition_scheme.h"
+
+#include <algorithm>
+#include <sstream>
+
+#include "common/exception.h"
+#include "common/logger.h"
+#include "common/macros.h"
+
+namespace peloton {
+namespace catalog {
+
+PartitionScheme::PartitionScheme(PartitionType partition_type,
+                                 oid_t column_id,
+                                 type::Type::TypeId column_type,
+                                 oid_t partition_count)
+    : partition_type_(partition_type),
+      column_id_(column_id),
+      column_type_(column_type),
+      partition_count_(partition_count) {}
+
+std::shared_ptr<const PartitionScheme> PartitionScheme::CreateRange(
+    oid_t column_id, type::Type::TypeId column_type,
+    const std::vector<type::Value> &bounds) {
+  if (bounds.empty()) {
+    throw CatalogException("Range partitioning needs at least one bound");
+  }
+
+  std::shared_ptr<PartitionScheme> scheme(new PartitionScheme(
+      PartitionType::RANGE, column_id, column_type, bounds.size() + 1));
+  for (auto &bound : bounds) {
+    if (bound.IsNull()) {
+      throw CatalogException("Range partition bounds cannot be NULL");
+    }
+    scheme->bounds_.push_back(bound.CastAs(column_type));
+  }
+
+  std::sort(scheme->bounds_.begin(), scheme->bounds_.end(),
+            [](const type::Value &lhs, const type::Value &rhs) {
+              return lhs.CompareLessThan(rhs) == type::CMP_TRUE;
+            });
+  for (size_t bound_itr = 1; bound_itr < scheme->bounds_.size();
+       bound_itr++) {
+    if (scheme->bounds_[bound_itr - 1].CompareEquals(
+            scheme->bounds_[bound_itr]) == type::CMP_TRUE) {
+      throw CatalogException("Range partition bounds must be distinct");
+    }
+  }
+  return scheme;
+}
+
+std::shared_ptr<const PartitionScheme> PartitionScheme::CreateHash(
+    oid_t column_id, type::Type::TypeId column_type, oid_t partition_count) {
+  if (partition_count == 0 || partition_count == INVALID_OID) {
+    throw CatalogException("Hash partitioning needs at least one partition");
+  }
+  return std::shared_ptr<const PartitionScheme>(new PartitionScheme(
+      PartitionType::HASH, column_id, column_type, partition_count));
+}
+
+oid_t PartitionScheme::GetPartition(const type::Value &value) const {
+  if (value.IsNull()) {
+    return 0;
+  }
+
+  auto key = value.GetTypeId() == column_type_ ? value
+                                               : value.CastAs(column_type_);
+  if (partition_type_ == PartitionType::HASH) {
+    return static_cast<oid_t>(key.Hash() % partition_count_);
+  }
+
+  // The number of bounds not greater than the key
+  auto bound = std::upper_bound(
+      bounds_.begin(), bounds_.end(), key,
+      [](const type::Value &lhs, const type::Value &rhs) {
+        return lhs.CompareLessThan(rhs) == type::CMP_TRUE;
+      });
+  return static_cast<oid_t>(bound - bounds_.begin());
+}
+
+std::vector<bool> PartitionScheme::GetPartitions(
+    ExpressionType comparison, const type::Value &value) const {
+  std::vector<bool> partitions(partition_count_, true);
+  if (value.IsNull()) {
+    return partitions;
+  }
+
+  oid_t partition;
+  try {
+    partition = GetPartition(value);
+  } catch (Exception &e) {
+    LOG_TRACE("Cannot map %s to a partition: %s", value.GetInfo().c_str(),
+              e.what());
+    return partitions;
+  }
+
+  oid_t first = 0;
+  oid_t last = partition_count_ - 1;
+  switch (comparison) {
+    case ExpressionType::COMPARE_EQUAL:
+      first = last = partition;
+      break;
+    case ExpressionType::COMPARE_LESSTHAN:
+    case ExpressionType::COMPARE_LESSTHANOREQUALTO:
+      if (partition_type_ == PartitionType::RANGE) last = partition;
+      break;
+    case ExpressionType::COMPARE_GREATERTHAN:
+    case ExpressionType::COMPARE_GREATERTHANOREQUALTO:
+      if (partition_type_ == PartitionType::RANGE) first = partition;
+      break;
+    default:
+      break;
+  }
+
+  for (oid_t partition_itr = 0; partition_itr < partition_count_;
+       partition_itr++) {
+    partitions[partition_itr] = (partition_itr >= first &&
+                                 partition_itr <= last);
+  }
+  return partitions;
+}
+
+const std::string PartitionScheme::GetInfo() const {
+  std::ostringstream os;
+
+  os << "PartitionScheme[" << partition_type_ << ", "
+     << "Column:" << column_id_ << ", "
+     << "Partitions:" << partition_count_ << "]";
+
+  if (bounds_.empty() == false) {
+    os << " :: (";
+    for (size_t bound_itr = 0; bound_itr < bounds_.size(); bound_itr++) {
+      if (bound_itr > 0) os << ", ";
+      os << bounds_[bound_itr].ToString();
+    }
+    os << ")";
+  }
+
+  return os.str();
+}
+
+}  // End catalog namespace
+}  // End peloton namespace
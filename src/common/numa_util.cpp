@@ -0,0 +1,180 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// numa_util.cpp
+//
+// Identification: src/common/numa_util.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <linux/mempolicy.h>
+#include <pthread.h>
+#include <sched.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+
+#include "common/logger.h"
+#include "common/macros.h"
+#include "common/numa_util.h"
+
+#define NUMA_SYSFS_DIR "/sys/devices/system/node/"
+
+namespace peloton {
+
+namespace {
+
+struct NumaTopology {
+  NumaTopology();
+
+  // Kernel node id of every node
+  std::vector<int> node_ids;
+
+  std::vector<std::vector<int>> node_cpus;
+
+  // Node of every cpu, NUMA_NODE_ANY for cpus of no node
+  std::vector<int> cpu_nodes;
+};
+
+std::string ReadLine(const std::string &path) {
+  std::ifstream file(path);
+  std::string line;
+  if (file.is_open()) std::getline(file, line);
+  return line;
+}
+
+NumaTopology::NumaTopology() {
+  node_ids = NumaUtil::ParseList(ReadLine(NUMA_SYSFS_DIR "online"));
+  for (auto node_id : node_ids) {
+    node_cpus.push_back(NumaUtil::ParseList(ReadLine(
+        NUMA_SYSFS_DIR "node" + std::to_string(node_id) + "/cpulist")));
+  }
+
+  if (node_ids.empty()) {
+    node_ids.push_back(0);
+    node_cpus.emplace_back();
+  }
+
+  for (int node = 0; node < static_cast<int>(node_cpus.size()); node++) {
+    for (auto cpu : node_cpus[node]) {
+      if (cpu >= static_cast<int>(cpu_nodes.size())) {
+        cpu_nodes.resize(cpu + 1, NUMA_NODE_ANY);
+      }
+      cpu_nodes[cpu] = node;
+    }
+  }
+
+  LOG_TRACE("NUMA nodes : %lu", node_ids.size());
+}
+
+const NumaTopology &GetTopology() {
+  static NumaTopology topology;
+  return topology;
+}
+
+}  // namespace
+
+int NumaUtil::GetNodeCount() {
+  return static_cast<int>(GetTopology().node_ids.size());
+}
+
+int NumaUtil::GetCurrentNode() {
+  if (GetNodeCount() == 1) return 0;
+
+  int cpu = sched_getcpu();
+  if (cpu < 0) return 0;
+  int node = GetNodeOfCpu(cpu);
+  return (node == NUMA_NODE_ANY) ? 0 : node;
+}
+
+int NumaUtil::GetNodeOfCpu(int cpu) {
+  auto &cpu_nodes = GetTopology().cpu_nodes;
+  if (cpu < 0 || cpu >= static_cast<int>(cpu_nodes.size())) {
+    return NUMA_NODE_ANY;
+  }
+  return cpu_nodes[cpu];
+}
+
+const std::vector<int> &NumaUtil::GetNodeCpus(int node) {
+  PL_ASSERT(node >= 0 && node < GetNodeCount());
+  return GetTopology().node_cpus[node];
+}
+
+void NumaUtil::PlaceMemory(void *address, size_t size, int node) {
+  auto &topology = GetTopology();
+  if (topology.node_ids.size() == 1 || node < 0 ||
+      node >= static_cast<int>(topology.node_ids.size())) {
+    return;
+  }
+
+  uintptr_t page_size = static_cast<uintptr_t>(sysconf(_SC_PAGESIZE));
+  uintptr_t begin =
+      (reinterpret_cast<uintptr_t>(address) + page_size - 1) & ~(page_size - 1);
+  uintptr_t end =
+      (reinterpret_cast<uintptr_t>(address) + size) & ~(page_size - 1);
+  if (begin >= end) return;
+
+  const size_t mask_bits = sizeof(unsigned long) * 8;
+  size_t node_id = topology.node_ids[node];
+  std::vector<unsigned long> node_mask(node_id / mask_bits + 1, 0);
+  node_mask[node_id / mask_bits] |= 1UL << (node_id % mask_bits);
+
+  // The kernel reads one bit less than the given maximum node
+  if (syscall(SYS_mbind, begin, end - begin, MPOL_PREFERRED, node_mask.data(),
+              node_mask.size() * mask_bits + 1, 0) != 0) {
+    LOG_TRACE("Failed to place %lu bytes on node %d", end - begin, node);
+  }
+}
+
+bool NumaUtil::PinCurrentThread(int node) {
+  if (GetNodeCount() == 1 || node < 0 || node >= GetNodeCount()) {
+    return false;
+  }
+
+  auto &cpus = GetNodeCpus(node);
+  if (cpus.empty()) return false;
+
+  cpu_set_t cpu_set;
+  CPU_ZERO(&cpu_set);
+  for (auto cpu : cpus) {
+    if (cpu < CPU_SETSIZE) CPU_SET(cpu, &cpu_set);
+  }
+  return pthread_setaffinity_np(pthread_self(), sizeof(cpu_set), &cpu_set) ==
+         0;
+}
+
+std::vector<int> NumaUtil::ParseList(const std::string &list) {
+  std::vector<int> items;
+  const char *position = list.c_str();
+
+  while (*position != '\0') {
+    char *end = nullptr;
+    long first = strtol(position, &end, 10);
+    if (end == position || first < 0) break;
+
+    long last = first;
+    position = end;
+    if (*position == '-') {
+      last = strtol(position + 1, &end, 10);
+      if (end == position + 1 || last < first) break;
+      position = end;
+    }
+
+    for (long item = first; item <= last; item++) {
+      items.push_back(static_cast<int>(item));
+    }
+
+    if (*position != ',') break;
+    position++;
+  }
+
+  return items;
+}
+
+}  // End peloton namespace
@@ -0,0 +1,69 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// lock_table.cpp
+//
+// Identification: src/concurrency/lock_table.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <algorithm>
+
+#include "concurrency/lock_table.h"
+
+#include "storage/tile_group_header.h"
+
+namespace peloton {
+namespace concurrency {
+
+LockTable::LockTable() : queues_(LOCK_TABLE_SIZE) {}
+
+LockTable &LockTable::GetInstance() {
+  static LockTable lock_table;
+  return lock_table;
+}
+
+size_t LockTable::Hash(const ItemPointer &location) {
+  uint64_t key = (static_cast<uint64_t>(location.block) << 32) |
+                 static_cast<uint64_t>(location.offset);
+  key *= 0x9E3779B97F4A7C15ull;
+  return static_cast<size_t>(key >> 32) % LOCK_TABLE_SIZE;
+}
+
+bool LockTable::WaitForRelease(
+    const ItemPointer &location,
+    const storage::TileGroupHeader *const tile_group_header,
+    const txn_id_t owner, const Deadline &deadline) {
+  auto &queue = queues_[Hash(location)];
+  auto tuple_id = location.offset;
+
+  std::unique_lock<std::mutex> lock(queue.latch);
+  queue.waiter_count++;
+  while (tile_group_header->GetTransactionId(tuple_id) == owner) {
+    auto now = std::chrono::steady_clock::now();
+    if (now >= deadline) {
+      break;
+    }
+    auto slice = std::chrono::microseconds(LOCK_WAIT_SLICE_US);
+    queue.released.wait_for(lock, std::min<std::chrono::nanoseconds>(
+                                      deadline - now, slice));
+  }
+  queue.waiter_count--;
+
+  return tile_group_header->GetTransactionId(tuple_id) != owner;
+}
+
+void LockTable::NotifyRelease(const ItemPointer &location) {
+  auto &queue = queues_[Hash(location)];
+
+  std::lock_guard<std::mutex> lock(queue.latch);
+  if (queue.waiter_count > 0) {
+    queue.released.notify_all();
+  }
+}
+
+}  // End concurrency namespace
+}  // End peloton namespace
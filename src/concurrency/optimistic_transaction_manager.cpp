@@ -0,0 +1,146 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// optimistic_transaction_manager.cpp
+//
+// Identification: src/concurrency/optimistic_transaction_manager.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "concurrency/optimistic_transaction_manager.h"
+
+#include "catalog/manager.h"
+#include "common/logger.h"
+#include "concurrency/transaction.h"
+
+namespace peloton {
+namespace concurrency {
+
+OptimisticTransactionManager &OptimisticTransactionManager::GetInstance() {
+  static OptimisticTransactionManager txn_manager;
+  return txn_manager;
+}
+
+// a version that has been superseded by a committed version can not be owned,
+// the transaction would overwrite an update it has not seen.
+bool OptimisticTransactionManager::IsOwnable(
+    UNUSED_ATTRIBUTE Transaction *const current_txn,
+    const storage::TileGroupHeader *const tile_group_header,
+    const oid_t &tuple_id) {
+  auto tuple_txn_id = tile_group_header->GetTransactionId(tuple_id);
+  auto tuple_end_cid = tile_group_header->GetEndCommitId(tuple_id);
+  return tuple_txn_id == INITIAL_TXN_ID && tuple_end_cid == MAX_CID;
+}
+
+bool OptimisticTransactionManager::AcquireOwnership(
+    Transaction *const current_txn,
+    const storage::TileGroupHeader *const tile_group_header,
+    const oid_t &tuple_id) {
+  auto txn_id = current_txn->GetTransactionId();
+
+  if (tile_group_header->SetAtomicTransactionId(tuple_id, txn_id) == false) {
+    return false;
+  }
+
+  // a committing transaction sets the end commit id of the version before it
+  // releases the ownership, so a version that was superseded while we were
+  // acquiring it is detected here.
+  if (tile_group_header->GetEndCommitId(tuple_id) != MAX_CID) {
+    tile_group_header->SetTransactionId(tuple_id, INITIAL_TXN_ID);
+    return false;
+  }
+  return true;
+}
+
+bool OptimisticTransactionManager::PerformRead(Transaction *const current_txn,
+                                               const ItemPointer &location,
+                                               bool acquire_ownership) {
+  if (current_txn->IsDeclaredReadOnly() == true) {
+    // Ignore read validation for all readonly transactions
+    return true;
+  }
+
+  oid_t tile_group_id = location.block;
+  oid_t tuple_id = location.offset;
+
+  LOG_TRACE("PerformRead (%u, %u)\n", location.block, location.offset);
+  auto &manager = catalog::Manager::GetInstance();
+  auto tile_group_header = manager.GetTileGroup(tile_group_id)->GetHeader();
+
+  if (IsOwner(current_txn, tile_group_header, tuple_id) == false) {
+    if (acquire_ownership == true) {
+      // select for update takes the ownership right away
+      if (IsOwnable(current_txn, tile_group_header, tuple_id) == false ||
+          AcquireOwnership(current_txn, tile_group_header, tuple_id) ==
+              false) {
+        return false;
+      }
+      current_txn->RecordReadOwn(location);
+    } else {
+      // the read is validated at commit
+      current_txn->RecordRead(location);
+    }
+  }
+
+  // Increment table read op stats
+  if (FLAGS_stats_mode != STATS_TYPE_INVALID) {
+    stats::BackendStatsContext::GetInstance()->IncrementTableReads(
+        location.block);
+  }
+  return true;
+}
+
+bool OptimisticTransactionManager::ValidateReadSet(
+    Transaction *const current_txn) {
+  auto &manager = catalog::Manager::GetInstance();
+  auto txn_id = current_txn->GetTransactionId();
+
+  for (auto &tuple_entry : current_txn->GetReadWriteSet()) {
+    if (tuple_entry.type != RWType::READ) {
+      // the transaction owns all other versions
+      continue;
+    }
+
+    auto tile_group_header =
+        manager.GetTileGroup(tuple_entry.location.block)->GetHeader();
+    auto tuple_slot = tuple_entry.location.offset;
+
+    // an owner other than us may commit a newer version before we do.
+    auto tuple_txn_id = tile_group_header->GetTransactionId(tuple_slot);
+    if (tuple_txn_id != INITIAL_TXN_ID && tuple_txn_id != txn_id) {
+      return false;
+    }
+    if (tile_group_header->GetEndCommitId(tuple_slot) != MAX_CID) {
+      return false;
+    }
+  }
+  return true;
+}
+
+ResultType OptimisticTransactionManager::CommitTransaction(
+    Transaction *const current_txn) {
+  LOG_TRACE("Committing peloton txn : %lu ", current_txn->GetTransactionId());
+
+  if (current_txn->IsDeclaredReadOnly() == true) {
+    EndReadonlyTransaction(current_txn);
+    return ResultType::SUCCESS;
+  }
+
+  // the write set is already owned, so no version we write can change. draw
+  // the commit id first, then check that nothing we read has changed.
+  cid_t end_commit_id = GetNextCommitId();
+
+  if (ValidateReadSet(current_txn) == false) {
+    LOG_TRACE("Read validation failed for txn : %lu ",
+              current_txn->GetTransactionId());
+    return AbortTransaction(current_txn);
+  }
+
+  return InstallTransaction(current_txn, end_commit_id);
+}
+
+}  // End storage namespace
+}  // End peloton namespace
@@ -0,0 +1,128 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// read_write_set.cpp
+//
+// Identification: src/concurrency/read_write_set.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <algorithm>
+
+#include "common/macros.h"
+#include "concurrency/read_write_set.h"
+
+namespace peloton {
+namespace concurrency {
+
+namespace {
+
+struct ReadWriteSetBuffers {
+  std::vector<ReadWriteSet::Entry> entries;
+  std::vector<uint32_t> index;
+};
+
+// Cleared buffers of finished transactions. A transaction may end on another
+// thread than the one it began on, the buffers then move to that thread.
+thread_local std::vector<ReadWriteSetBuffers> buffer_pool;
+
+}  // namespace
+
+ReadWriteSet::ReadWriteSet() {
+  if (buffer_pool.empty() == false) {
+    entries_.swap(buffer_pool.back().entries);
+    index_.swap(buffer_pool.back().index);
+    buffer_pool.pop_back();
+  }
+}
+
+ReadWriteSet::~ReadWriteSet() {
+  if (buffer_pool.size() >= READ_WRITE_SET_POOL_SIZE ||
+      entries_.capacity() > READ_WRITE_SET_MAX_POOLED_ENTRIES) {
+    return;
+  }
+  if (buffer_pool.capacity() == 0) {
+    buffer_pool.reserve(READ_WRITE_SET_POOL_SIZE);
+  }
+
+  entries_.clear();
+  index_.clear();
+  buffer_pool.emplace_back();
+  buffer_pool.back().entries.swap(entries_);
+  buffer_pool.back().index.swap(index_);
+}
+
+size_t ReadWriteSet::Hash(const ItemPointer &location) {
+  uint64_t key = (static_cast<uint64_t>(location.block) << 32) |
+                 static_cast<uint64_t>(location.offset);
+  key *= 0x9E3779B97F4A7C15ull;
+  return static_cast<size_t>(key ^ (key >> 29));
+}
+
+RWType *ReadWriteSet::Find(const ItemPointer &location) {
+  if (index_.empty()) {
+    for (auto &entry : entries_) {
+      if (entry.location.block == location.block &&
+          entry.location.offset == location.offset) {
+        return &entry.type;
+      }
+    }
+    return nullptr;
+  }
+
+  size_t mask = index_.size() - 1;
+  for (size_t slot = Hash(location) & mask; index_[slot] != 0;
+       slot = (slot + 1) & mask) {
+    auto &entry = entries_[index_[slot] - 1];
+    if (entry.location.block == location.block &&
+        entry.location.offset == location.offset) {
+      return &entry.type;
+    }
+  }
+  return nullptr;
+}
+
+void ReadWriteSet::Insert(const ItemPointer &location, RWType type) {
+  PL_ASSERT(Find(location) == nullptr);
+  entries_.push_back({location, type});
+
+  if (index_.empty()) {
+    if (entries_.size() > READ_WRITE_SET_SCAN_LIMIT) BuildIndex();
+  } else if (entries_.size() * 2 > index_.size()) {
+    BuildIndex();
+  } else {
+    IndexEntry(static_cast<uint32_t>(entries_.size() - 1));
+  }
+}
+
+void ReadWriteSet::SortByTileGroup() {
+  std::sort(entries_.begin(), entries_.end(),
+            [](const Entry &lhs, const Entry &rhs) {
+              return lhs.location < rhs.location;
+            });
+  if (index_.empty() == false) BuildIndex();
+}
+
+void ReadWriteSet::BuildIndex() {
+  size_t slot_count = 1;
+  while (slot_count < entries_.size() * 4) slot_count <<= 1;
+
+  index_.assign(slot_count, 0);
+  for (uint32_t entry_offset = 0; entry_offset < entries_.size();
+       entry_offset++) {
+    IndexEntry(entry_offset);
+  }
+}
+
+void ReadWriteSet::IndexEntry(uint32_t entry_offset) {
+  size_t mask = index_.size() - 1;
+  size_t slot = Hash(entries_[entry_offset].location) & mask;
+  while (index_[slot] != 0) slot = (slot + 1) & mask;
+  index_[slot] = entry_offset + 1;
+}
+
+}  // End concurrency namespace
+}  // End peloton namespace
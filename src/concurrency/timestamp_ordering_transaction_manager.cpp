@@ -16,6 +16,7 @@
 #include "common/exception.h"
 #include "common/logger.h"
 #include "common/platform.h"
+#include "concurrency/lock_table.h"
 #include "concurrency/transaction.h"
 #include "gc/gc_manager_factory.h"
 #include "logging/log_manager.h"
@@ -84,13 +85,53 @@ void TimestampOrderingTransactionManager::InitTupleReserved(
   *(cid_t *)(reserved_area + LAST_READER_OFFSET) = 0;
 }
 
+namespace {
+
+// Owns the pooled transactions of a thread
+struct TransactionPool {
+  ~TransactionPool() {
+    for (auto txn : transactions) delete txn;
+  }
+
+  std::vector<Transaction *> transactions;
+};
+
+thread_local TransactionPool transaction_pool;
+
+}  // namespace
+
+Transaction *TimestampOrderingTransactionManager::AcquireTransaction() {
+  auto &transactions = transaction_pool.transactions;
+  if (transactions.empty()) {
+    return new Transaction();
+  }
+
+  Transaction *txn = transactions.back();
+  transactions.pop_back();
+  return txn;
+}
+
+void TimestampOrderingTransactionManager::ReleaseTransaction(
+    Transaction *txn) {
+  auto &transactions = transaction_pool.transactions;
+  if (transactions.size() >= TRANSACTION_POOL_SIZE) {
+    delete txn;
+    return;
+  }
+  if (transactions.capacity() == 0) {
+    transactions.reserve(TRANSACTION_POOL_SIZE);
+  }
+  transactions.push_back(txn);
+}
+
 Transaction *TimestampOrderingTransactionManager::BeginTransaction() {
   auto &log_manager = logging::LogManager::GetInstance();
   log_manager.PrepareLogging();
 
   txn_id_t txn_id = GetNextTransactionId();
   cid_t begin_cid = GetNextCommitId();
-  Transaction *txn = new Transaction(txn_id, begin_cid);
+  Transaction *txn = AcquireTransaction();
+  txn->Init(txn_id, begin_cid);
 
   auto eid = EpochManagerFactory::GetInstance().EnterEpoch(begin_cid);
   txn->SetEpochId(eid);
@@ -109,7 +150,8 @@ Transaction *TimestampOrderingTransactionManager::BeginReadonlyTransaction() {
   auto &epoch_manager = EpochManagerFactory::GetInstance();
 
   cid_t begin_cid = epoch_manager.GetReadOnlyTxnCid();
-  Transaction *txn = new Transaction(txn_id, begin_cid, true);
+  Transaction *txn = AcquireTransaction();
+  txn->Init(txn_id, begin_cid, true);
 
   auto eid = epoch_manager.EnterReadOnlyEpoch(begin_cid);
   txn->SetEpochId(eid);
@@ -131,20 +173,21 @@ void TimestampOrderingTransactionManager::EndTransaction(
   if (current_txn->GetResult() == ResultType::SUCCESS) {
     if (current_txn->IsGCSetEmpty() != true) {
       gc::GCManagerFactory::GetInstance().
-          RecycleTransaction(current_txn->GetGCSetPtr(), current_txn->GetBeginCommitId());
+          RecycleTransaction(current_txn->GetGCSet(), current_txn->GetEndCommitId());
     }
     // Log the transaction's commit
-    // For time stamp ordering, every transaction only has one timestamp
-    log_manager.LogCommitTransaction(current_txn->GetBeginCommitId());
+    bool wait_for_flush = (current_txn->IsPipelinedCommit() == false);
+    log_manager.LogCommitTransaction(current_txn->GetEndCommitId(),
+                                     wait_for_flush);
   } else {
     if (current_txn->IsGCSetEmpty() != true) {
       gc::GCManagerFactory::GetInstance().
-          RecycleTransaction(current_txn->GetGCSetPtr(), GetNextCommitId());
+          RecycleTransaction(current_txn->GetGCSet(), GetNextCommitId());
     }
     log_manager.DoneLogging();
   }
 
-  delete current_txn;
+  ReleaseTransaction(current_txn);
   current_txn = nullptr;
 
   if (FLAGS_stats_mode != STATS_TYPE_INVALID) {
@@ -160,7 +203,13 @@ void TimestampOrderingTransactionManager::EndReadonlyTransaction(
   EpochManagerFactory::GetInstance().ExitReadOnlyEpoch(
       current_txn->GetEpochId());
 
-  delete current_txn;
+  // The snapshot may hold commits whose log records are not stable yet, so
+  // the results wait for them like the results of a commit
+  bool wait_for_flush = (current_txn->IsPipelinedCommit() == false);
+  logging::LogManager::GetInstance().WaitForReadCommits(
+      current_txn->GetBeginCommitId(), wait_for_flush);
+
+  ReleaseTransaction(current_txn);
   current_txn = nullptr;
 
   if (FLAGS_stats_mode != STATS_TYPE_INVALID) {
@@ -350,38 +399,90 @@ bool TimestampOrderingTransactionManager::IsOwnable(
     const oid_t &tuple_id) {
   auto tuple_txn_id = tile_group_header->GetTransactionId(tuple_id);
   auto tuple_end_cid = tile_group_header->GetEndCommitId(tuple_id);
-  return tuple_txn_id == INITIAL_TXN_ID &&
+  // a tuple owned by a younger transaction may be released in time,
+  // AcquireOwnership waits for it.
+  bool may_wait = FLAGS_lock_wait_timeout > 0 &&
+                  tuple_txn_id != INVALID_TXN_ID &&
+                  tuple_txn_id > current_txn->GetTransactionId();
+  return (tuple_txn_id == INITIAL_TXN_ID || may_wait) &&
          tuple_end_cid > current_txn->GetBeginCommitId();
 }
 
+bool TimestampOrderingTransactionManager::WaitForOwner(
+    Transaction *const current_txn,
+    const storage::TileGroupHeader *const tile_group_header,
+    const oid_t &tuple_id, LockTable::Deadline &deadline) {
+  if (FLAGS_lock_wait_timeout == 0) {
+    return false;
+  }
+
+  txn_id_t owner = tile_group_header->GetTransactionId(tuple_id);
+  if (owner == INITIAL_TXN_ID) {
+    // released in the meantime
+    return true;
+  }
+  // wait-die: only an older transaction waits for the owner, so the waits can
+  // not form a cycle. A younger transaction gives up right away.
+  if (owner == INVALID_TXN_ID || owner < current_txn->GetTransactionId()) {
+    return false;
+  }
+  if (deadline == LockTable::Deadline()) {
+    deadline = std::chrono::steady_clock::now() +
+               std::chrono::microseconds(FLAGS_lock_wait_timeout);
+  }
+  ItemPointer location(tile_group_header->GetTileGroup()->GetTileGroupId(),
+                       tuple_id);
+  return LockTable::GetInstance().WaitForRelease(location, tile_group_header,
+                                                 owner, deadline);
+}
+
 bool TimestampOrderingTransactionManager::AcquireOwnership(
     Transaction *const current_txn,
     const storage::TileGroupHeader *const tile_group_header,
     const oid_t &tuple_id) {
   auto txn_id = current_txn->GetTransactionId();
+  LockTable::Deadline deadline;
 
-  // to acquire the ownership, we must guarantee that no other transactions that
-  // has read
-  // the tuple has a larger timestamp than the current transaction.
-  GetSpinlockField(tile_group_header, tuple_id)->Lock();
-  // change timestamp
-  cid_t last_reader_cid = GetLastReaderCommitId(tile_group_header, tuple_id);
+  while (true) {
+    // to acquire the ownership, we must guarantee that no other transactions
+    // that has read
+    // the tuple has a larger timestamp than the current transaction.
+    GetSpinlockField(tile_group_header, tuple_id)->Lock();
+    // change timestamp
+    cid_t last_reader_cid = GetLastReaderCommitId(tile_group_header, tuple_id);
 
-  if (last_reader_cid > current_txn->GetBeginCommitId()) {
-    GetSpinlockField(tile_group_header, tuple_id)->Unlock();
-
-    return false;
-  } else {
-    if (tile_group_header->SetAtomicTransactionId(tuple_id, txn_id) == false) {
+    if (last_reader_cid > current_txn->GetBeginCommitId()) {
       GetSpinlockField(tile_group_header, tuple_id)->Unlock();
 
       return false;
-    } else {
-      GetSpinlockField(tile_group_header, tuple_id)->Unlock();
+    }
 
-      return true;
+    bool acquired = tile_group_header->SetAtomicTransactionId(tuple_id, txn_id);
+    GetSpinlockField(tile_group_header, tuple_id)->Unlock();
+
+    if (acquired == true) {
+      break;
     }
+
+    // the tuple is owned by a concurrent transaction.
+    if (WaitForOwner(current_txn, tile_group_header, tuple_id, deadline) ==
+        false) {
+      return false;
+    }
+  }
+
+  // once the previous owner has finished, the latest version is either this
+  // version again, if the owner aborted or only held the tuple, or the
+  // version the owner committed. The owner began after the current
+  // transaction, so its version is not visible to the current transaction
+  // and can not be updated by it.
+  if (tile_group_header->GetEndCommitId(tuple_id) != MAX_CID) {
+    tile_group_header->SetTransactionId(tuple_id, INITIAL_TXN_ID);
+    LockTable::GetInstance().NotifyRelease(ItemPointer(
+        tile_group_header->GetTileGroup()->GetTileGroupId(), tuple_id));
+    return false;
   }
+  return true;
 }
 
 // release write lock on a tuple.
@@ -397,6 +498,7 @@ void TimestampOrderingTransactionManager::YieldOwnership(
   auto tile_group_header = manager.GetTileGroup(tile_group_id)->GetHeader();
   PL_ASSERT(IsOwner(current_txn, tile_group_header, tuple_id));
   tile_group_header->SetTransactionId(tuple_id, INITIAL_TXN_ID);
+  LockTable::GetInstance().NotifyRelease(ItemPointer(tile_group_id, tuple_id));
 }
 
 bool TimestampOrderingTransactionManager::PerformRead(
@@ -447,21 +549,32 @@ bool TimestampOrderingTransactionManager::PerformRead(
   }
   // if the current transaction does not own this tuple, then attemp to set last
   // reader cid.
-  if (SetLastReaderCommitId(tile_group_header, tuple_id,
-                            current_txn->GetBeginCommitId()) == true) {
-    current_txn->RecordRead(location);
-    // Increment table read op stats
-    if (FLAGS_stats_mode != STATS_TYPE_INVALID) {
-      stats::BackendStatsContext::GetInstance()->IncrementTableReads(
-          location.block);
+  LockTable::Deadline deadline;
+  while (SetLastReaderCommitId(tile_group_header, tuple_id,
+                               current_txn->GetBeginCommitId()) == false) {
+    // if the tuple has been owned by some concurrent transactions and is not
+    // released in time, then read fails.
+    if (WaitForOwner(current_txn, tile_group_header, tuple_id, deadline) ==
+        false) {
+      LOG_TRACE("Transaction read failed");
+      return false;
     }
-    return true;
-  } else {
-    // if the tuple has been owned by some concurrent transactions, then read
-    // fails.
+  }
+
+  // the owner may have committed a version that replaces the one we read.
+  if (tile_group_header->GetEndCommitId(tuple_id) <=
+      current_txn->GetBeginCommitId()) {
     LOG_TRACE("Transaction read failed");
     return false;
   }
+
+  current_txn->RecordRead(location);
+  // Increment table read op stats
+  if (FLAGS_stats_mode != STATS_TYPE_INVALID) {
+    stats::BackendStatsContext::GetInstance()->IncrementTableReads(
+        location.block);
+  }
+  return true;
 }
 
 void TimestampOrderingTransactionManager::PerformInsert(
@@ -758,22 +871,32 @@ ResultType TimestampOrderingTransactionManager::CommitTransaction(
     return ResultType::SUCCESS;
   }
 
+  // For time stamp ordering, every transaction only has one timestamp
+  return InstallTransaction(current_txn, current_txn->GetBeginCommitId());
+}
+
+ResultType TimestampOrderingTransactionManager::InstallTransaction(
+    Transaction *const current_txn, const cid_t end_commit_id) {
   auto &manager = catalog::Manager::GetInstance();
   auto &log_manager = logging::LogManager::GetInstance();
 
-  // generate transaction id.
-  cid_t end_commit_id = current_txn->GetBeginCommitId();
+  current_txn->SetEndCommitId(end_commit_id);
   log_manager.LogBeginTransaction(end_commit_id);
 
   auto &rw_set = current_txn->GetReadWriteSet();
 
-  auto gc_set = current_txn->GetGCSetPtr();
+  auto &gc_set = current_txn->GetGCSet();
+
+  auto &lock_table = LockTable::GetInstance();
+
+  // columns assigned by the updates of the tuple being logged
+  std::vector<oid_t> updated_columns;
 
   oid_t database_id = 0;
   if (FLAGS_stats_mode != STATS_TYPE_INVALID) {
-    if (!rw_set.empty()) {
-      database_id =
-          manager.GetTileGroup(rw_set.begin()->first)->GetDatabaseId();
+    if (!rw_set.IsEmpty()) {
+      database_id = manager.GetTileGroup(rw_set.begin()->location.block)
+                        ->GetDatabaseId();
     }
   }
 
@@ -781,18 +904,29 @@ ResultType TimestampOrderingTransactionManager::CommitTransaction(
   // 1. install a new version for update operations;
   // 2. install an empty version for delete operations;
   // 3. install a new tuple for insert operations.
-  for (auto &tile_group_entry : rw_set) {
-    oid_t tile_group_id = tile_group_entry.first;
+  // the entries of a tile group are adjacent once sorted, so every tile group
+  // is looked up once.
+  rw_set.SortByTileGroup();
+
+  for (auto group_begin = rw_set.begin(); group_begin != rw_set.end();) {
+    oid_t tile_group_id = group_begin->location.block;
     auto tile_group = manager.GetTileGroup(tile_group_id);
     auto tile_group_header = tile_group->GetHeader();
-    for (auto &tuple_entry : tile_group_entry.second) {
-      auto tuple_slot = tuple_entry.first;
-      if (tuple_entry.second == RWType::READ_OWN) {
+
+    auto group_end = group_begin;
+    while (group_end != rw_set.end() &&
+           group_end->location.block == tile_group_id) {
+      group_end++;
+    }
+    for (auto tuple_entry = group_begin; tuple_entry != group_end;
+         tuple_entry++) {
+      auto tuple_slot = tuple_entry->location.offset;
+      if (tuple_entry->type == RWType::READ_OWN) {
         // A read operation has acquired ownership but hasn't done any further
         // update/delete yet
         // Yield the ownership
         YieldOwnership(current_txn, tile_group_id, tuple_slot);
-      } else if (tuple_entry.second == RWType::UPDATE) {
+      } else if (tuple_entry->type == RWType::UPDATE) {
         // we must guarantee that, at any time point, only one version is
         // visible.
         ItemPointer new_version =
@@ -818,15 +952,19 @@ ResultType TimestampOrderingTransactionManager::CommitTransaction(
         new_tile_group_header->SetTransactionId(new_version.offset,
                                                 INITIAL_TXN_ID);
         tile_group_header->SetTransactionId(tuple_slot, INITIAL_TXN_ID);
+        lock_table.NotifyRelease(tuple_entry->location);
 
         // add to gc set.
-        gc_set->operator[](tile_group_id)[tuple_slot] = false;
+        gc_set.push_back({tile_group_id, tuple_slot, false});
 
         // add to log manager
-        log_manager.LogUpdate(
-            end_commit_id, ItemPointer(tile_group_id, tuple_slot), new_version);
+        ItemPointer old_version(tile_group_id, tuple_slot);
+        bool columns_known =
+            current_txn->GetUpdatedColumns(old_version, updated_columns);
+        log_manager.LogUpdate(end_commit_id, old_version, new_version,
+                              columns_known ? &updated_columns : nullptr);
 
-      } else if (tuple_entry.second == RWType::DELETE) {
+      } else if (tuple_entry->type == RWType::DELETE) {
         ItemPointer new_version =
             tile_group_header->GetPrevItemPointer(tuple_slot);
 
@@ -848,20 +986,21 @@ ResultType TimestampOrderingTransactionManager::CommitTransaction(
         new_tile_group_header->SetTransactionId(new_version.offset,
                                                 INVALID_TXN_ID);
         tile_group_header->SetTransactionId(tuple_slot, INITIAL_TXN_ID);
+        lock_table.NotifyRelease(tuple_entry->location);
 
         // add to gc set.
         // we need to recycle both old and new versions.
         // we require the GC to delete tuple from index only once.
         // recycle old version, delete from index
-        gc_set->operator[](tile_group_id)[tuple_slot] = true;
+        gc_set.push_back({tile_group_id, tuple_slot, true});
         // recycle new version (which is an empty version), do not delete from index
-        gc_set->operator[](new_version.block)[new_version.offset] = false;
+        gc_set.push_back({new_version.block, new_version.offset, false});
 
         // add to log manager
         log_manager.LogDelete(end_commit_id,
                               ItemPointer(tile_group_id, tuple_slot));
 
-      } else if (tuple_entry.second == RWType::INSERT) {
+      } else if (tuple_entry->type == RWType::INSERT) {
         PL_ASSERT(tile_group_header->GetTransactionId(tuple_slot) ==
                   current_txn->GetTransactionId());
         // set the begin commit id to persist insert
@@ -879,7 +1018,7 @@ ResultType TimestampOrderingTransactionManager::CommitTransaction(
         log_manager.LogInsert(end_commit_id,
                               ItemPointer(tile_group_id, tuple_slot));
 
-      } else if (tuple_entry.second == RWType::INS_DEL) {
+      } else if (tuple_entry->type == RWType::INS_DEL) {
         PL_ASSERT(tile_group_header->GetTransactionId(tuple_slot) ==
                   current_txn->GetTransactionId());
 
@@ -893,11 +1032,13 @@ ResultType TimestampOrderingTransactionManager::CommitTransaction(
         tile_group_header->SetTransactionId(tuple_slot, INVALID_TXN_ID);
 
         // add to gc set.
-        gc_set->operator[](tile_group_id)[tuple_slot] = true;
+        gc_set.push_back({tile_group_id, tuple_slot, true});
 
         // no log is needed for this case
       }
     }
+
+    group_begin = group_end;
   }
 
   ResultType result = current_txn->GetResult();
@@ -915,37 +1056,55 @@ ResultType TimestampOrderingTransactionManager::CommitTransaction(
 
 ResultType TimestampOrderingTransactionManager::AbortTransaction(
     Transaction *const current_txn) {
-  // It's impossible that a pre-declared readonly transaction aborts
-  PL_ASSERT(current_txn->IsDeclaredReadOnly() == false);
-
   LOG_TRACE("Aborting peloton txn : %lu ", current_txn->GetTransactionId());
+
+  // A pre-declared readonly transaction wrote nothing, e.g. it is rolled back
+  // by its session
+  if (current_txn->IsDeclaredReadOnly() == true) {
+    EndReadonlyTransaction(current_txn);
+    return ResultType::ABORTED;
+  }
+
   auto &manager = catalog::Manager::GetInstance();
 
   auto &rw_set = current_txn->GetReadWriteSet();
 
-  auto gc_set = current_txn->GetGCSetPtr();
+  auto &gc_set = current_txn->GetGCSet();
+
+  auto &lock_table = LockTable::GetInstance();
 
   oid_t database_id = 0;
   if (FLAGS_stats_mode != STATS_TYPE_INVALID) {
-    if (!rw_set.empty()) {
-      database_id =
-          manager.GetTileGroup(rw_set.begin()->first)->GetDatabaseId();
+    if (!rw_set.IsEmpty()) {
+      database_id = manager.GetTileGroup(rw_set.begin()->location.block)
+                        ->GetDatabaseId();
     }
   }
 
-  for (auto &tile_group_entry : rw_set) {
-    oid_t tile_group_id = tile_group_entry.first;
+  // the entries of a tile group are adjacent once sorted, so every tile group
+  // is looked up once.
+  rw_set.SortByTileGroup();
+
+  for (auto group_begin = rw_set.begin(); group_begin != rw_set.end();) {
+    oid_t tile_group_id = group_begin->location.block;
     auto tile_group = manager.GetTileGroup(tile_group_id);
     auto tile_group_header = tile_group->GetHeader();
 
-    for (auto &tuple_entry : tile_group_entry.second) {
-      auto tuple_slot = tuple_entry.first;
-      if (tuple_entry.second == RWType::READ_OWN) {
+    auto group_end = group_begin;
+    while (group_end != rw_set.end() &&
+           group_end->location.block == tile_group_id) {
+      group_end++;
+    }
+
+    for (auto tuple_entry = group_begin; tuple_entry != group_end;
+         tuple_entry++) {
+      auto tuple_slot = tuple_entry->location.offset;
+      if (tuple_entry->type == RWType::READ_OWN) {
         // A read operation has acquired ownership but hasn't done any further
         // update/delete yet
         // Yield the ownership
         YieldOwnership(current_txn, tile_group_id, tuple_slot);
-      } else if (tuple_entry.second == RWType::UPDATE) {
+      } else if (tuple_entry->type == RWType::UPDATE) {
         ItemPointer new_version =
             tile_group_header->GetPrevItemPointer(tuple_slot);
 
@@ -999,11 +1158,12 @@ ResultType TimestampOrderingTransactionManager::AbortTransaction(
         COMPILER_MEMORY_FENCE;
 
         tile_group_header->SetTransactionId(tuple_slot, INITIAL_TXN_ID);
+        lock_table.NotifyRelease(tuple_entry->location);
 
         // add to gc set.
-        gc_set->operator[](new_version.block)[new_version.offset] = false;
+        gc_set.push_back({new_version.block, new_version.offset, false});
 
-      } else if (tuple_entry.second == RWType::DELETE) {
+      } else if (tuple_entry->type == RWType::DELETE) {
         ItemPointer new_version =
             tile_group_header->GetPrevItemPointer(tuple_slot);
 
@@ -1053,11 +1213,12 @@ ResultType TimestampOrderingTransactionManager::AbortTransaction(
         COMPILER_MEMORY_FENCE;
 
         tile_group_header->SetTransactionId(tuple_slot, INITIAL_TXN_ID);
+        lock_table.NotifyRelease(tuple_entry->location);
 
         // add to gc set.
-        gc_set->operator[](new_version.block)[new_version.offset] = false;
+        gc_set.push_back({new_version.block, new_version.offset, false});
 
-      } else if (tuple_entry.second == RWType::INSERT) {
+      } else if (tuple_entry->type == RWType::INSERT) {
         tile_group_header->SetBeginCommitId(tuple_slot, MAX_CID);
         tile_group_header->SetEndCommitId(tuple_slot, MAX_CID);
 
@@ -1068,9 +1229,9 @@ ResultType TimestampOrderingTransactionManager::AbortTransaction(
 
         // add to gc set.
         // delete from index
-        gc_set->operator[](tile_group_id)[tuple_slot] = true;
+        gc_set.push_back({tile_group_id, tuple_slot, true});
 
-      } else if (tuple_entry.second == RWType::INS_DEL) {
+      } else if (tuple_entry->type == RWType::INS_DEL) {
         tile_group_header->SetBeginCommitId(tuple_slot, MAX_CID);
         tile_group_header->SetEndCommitId(tuple_slot, MAX_CID);
 
@@ -1080,9 +1241,11 @@ ResultType TimestampOrderingTransactionManager::AbortTransaction(
         tile_group_header->SetTransactionId(tuple_slot, INVALID_TXN_ID);
 
         // add to gc set.
-        gc_set->operator[](tile_group_id)[tuple_slot] = true;
+        gc_set.push_back({tile_group_id, tuple_slot, true});
       }
     }
+
+    group_begin = group_end;
   }
 
   current_txn->SetResult(ResultType::ABORTED);
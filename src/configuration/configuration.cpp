@@ -70,10 +70,59 @@ DEFINE_string(socket_family,
 // RESOURCE USAGE
 //===----------------------------------------------------------------------===//
 
+DEFINE_uint64(query_memory,
+              256 * 1024 * 1024,
+              "Memory in bytes the operators of a query that buffer rows may "
+              "use, sorts, hash joins and hash aggregations spill to "
+              "temporary files beyond it (default: 256MB)");
+
+DEFINE_uint64(sort_workers,
+              0,
+              "Number of threads used by a sort or merge join, 0 for one per "
+              "core (default: 0)");
+
+DEFINE_bool(numa_placement,
+            false,
+            "Place the tile groups of a table on the NUMA nodes and take "
+            "insert slots from the node of the inserting thread "
+            "(default: false)");
+
+DEFINE_bool(numa_pin_threads,
+            false,
+            "Pin the worker threads to the cores of the NUMA nodes, in turn "
+            "(default: false)");
+
+//===----------------------------------------------------------------------===//
+// CLIENT CONNECTION DEFAULTS
+//===----------------------------------------------------------------------===//
+
+DEFINE_bool(autocommit_snapshot_read,
+            false,
+            "Run read only autocommit statements as read only transactions "
+            "on the snapshot of the epoch manager. They then neither take "
+            "ownership nor raise the read timestamps of the tuples they read, "
+            "but may miss commits of other connections from the last epochs "
+            "(default: false)");
+
+//===----------------------------------------------------------------------===//
+// LOCK MANAGEMENT
+//===----------------------------------------------------------------------===//
+
+DEFINE_uint64(lock_wait_timeout,
+              1000,
+              "Microseconds a transaction waits for the owner of a tuple "
+              "before it gives up, 0 to never wait (default: 1000)");
+
 //===----------------------------------------------------------------------===//
 // WRITE AHEAD LOG
 //===----------------------------------------------------------------------===//
 
+DEFINE_bool(pipelined_commit,
+            false,
+            "Let autocommit statements finish without waiting for the log "
+            "flush and wait once before their results are sent "
+            "(default: false)");
+
 //===----------------------------------------------------------------------===//
 // ERROR REPORTING AND LOGGING
 //===----------------------------------------------------------------------===//
@@ -94,6 +143,18 @@ DEFINE_uint64(stats_mode,
               peloton::STATS_TYPE_INVALID,
               "Enable statistics collection (default: 0)");
 
+//===----------------------------------------------------------------------===//
+// COPY
+//===----------------------------------------------------------------------===//
+
+DEFINE_uint64(copy_workers,
+              0,
+              "Number of threads used by COPY, 0 for one per core (default: 0)");
+
+DEFINE_bool(copy_file_per_worker,
+            false,
+            "Make COPY TO write one file per worker (default: false)");
+
 //===----------------------------------------------------------------------===//
 // AI
 //===----------------------------------------------------------------------===//
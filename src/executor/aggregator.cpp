@@ -153,14 +153,17 @@ bool Helper(const planner::AggregatePlan *node, AbstractAttributeAggregator **ag
 HashAggregator::HashAggregator(const planner::AggregatePlan *node,
                                storage::AbstractTable *output_table,
                                executor::ExecutorContext *econtext,
-                               size_t num_input_columns)
+                               size_t num_input_columns, size_t spill_level)
     : AbstractAggregator(node, output_table, econtext),
-      num_input_columns(num_input_columns) {}
+      num_input_columns(num_input_columns),
+      spill_level_(spill_level) {}
 //  group_by_key_values.resize(node->GetGroupbyColIds().size(),
 //      type::ValueFactory::GetNullValueByType(type::Type::INTEGER));
 //}
 
-HashAggregator::~HashAggregator() {
+HashAggregator::~HashAggregator() { ClearGroups(); }
+
+void HashAggregator::ClearGroups() {
   for (auto entry : aggregates_map) {
     // Clean up allocated storage
     for (size_t aggno = 0; aggno < node->GetUniqueAggTerms().size(); aggno++) {
@@ -169,6 +172,45 @@ HashAggregator::~HashAggregator() {
     delete[] entry.second->aggregates;
     delete entry.second;
   }
+  aggregates_map.clear();
+
+  if (memory_reserved_ > 0) {
+    executor_context->ReleaseMemory(memory_reserved_);
+    memory_reserved_ = 0;
+  }
+}
+
+bool HashAggregator::ReserveGroup(const AbstractTuple *tuple) {
+  // Once rows spill, new groups keep spilling so the groups in memory stay
+  // the same
+  if (spilled_rows_ != nullptr) return false;
+  if (executor_context == nullptr) return true;
+
+  // Estimate the hash table entry, the aggregates and the copied values
+  size_t group_size = sizeof(HashAggregateMapType::value_type) +
+                      sizeof(AggregateList) +
+                      node->GetUniqueAggTerms().size() *
+                          (sizeof(AbstractAttributeAggregator *) +
+                           sizeof(AvgAggregator));
+  for (auto &value : group_by_key_values) {
+    group_size += sizeof(type::Value);
+    if (value.GetTypeId() == type::Type::VARCHAR ||
+        value.GetTypeId() == type::Type::VARBINARY) {
+      group_size += value.GetLength();
+    }
+  }
+  for (size_t col_id = 0; col_id < num_input_columns; col_id++) {
+    type::Value value = tuple->GetValue(col_id);
+    group_size += sizeof(type::Value);
+    if (value.GetTypeId() == type::Type::VARCHAR ||
+        value.GetTypeId() == type::Type::VARBINARY) {
+      group_size += value.GetLength();
+    }
+  }
+
+  if (!executor_context->ReserveMemory(group_size)) return false;
+  memory_reserved_ += group_size;
+  return true;
 }
 
 bool HashAggregator::Advance(AbstractTuple *cur_tuple) {
@@ -187,6 +229,19 @@ bool HashAggregator::Advance(AbstractTuple *cur_tuple) {
 
   // Group not found. Make a new entry in the hash for this new group.
   if (map_itr == aggregates_map.end()) {
+    // Out of memory: the row goes to its partition. The last level keeps
+    // all of its groups in memory, whatever the budget.
+    if (spill_level_ < SPILL_MAX_LEVEL && !ReserveGroup(cur_tuple)) {
+      if (spilled_rows_ == nullptr) {
+        LOG_DEBUG("Hash aggregation spills on level %lu after %lu groups",
+                  spill_level_, aggregates_map.size());
+        spilled_rows_.reset(new SpillPartitions(spill_level_));
+      }
+      spilled_rows_->Add(cur_tuple, num_input_columns,
+                         node->GetGroupbyColIds());
+      return true;
+    }
+
     LOG_TRACE("Group-by key not found. Start a new group.");
     // Allocate new aggregate list
     aggregate_list = new AggregateList();
@@ -238,6 +293,33 @@ bool HashAggregator::Finalize() {
       return false;
     }
   }
+
+  // The spilled partitions get the memory of the finalized groups
+  ClearGroups();
+  if (spilled_rows_ != nullptr) return FinalizeSpilledPartitions();
+  return true;
+}
+
+bool HashAggregator::FinalizeSpilledPartitions() {
+  std::unique_ptr<SpillPartitions> spilled_rows(std::move(spilled_rows_));
+
+  std::vector<type::Value> values;
+  expression::ContainerTuple<std::vector<type::Value>> tuple(&values);
+  for (size_t partition = 0; partition < SPILL_PARTITION_COUNT; partition++) {
+    auto file = spilled_rows->ReleasePartition(partition);
+    if (file == nullptr) continue;
+
+    LOG_DEBUG("Aggregating %lu spilled rows of partition %lu on level %lu",
+              file->GetRowCount(), partition, spill_level_);
+    HashAggregator aggregator(node, output_table, executor_context,
+                              num_input_columns, spill_level_ + 1);
+    while (file->ReadRow(values)) {
+      aggregator.Advance(&tuple);
+    }
+    file.reset();
+
+    if (aggregator.Finalize() == false) return false;
+  }
   return true;
 }
 
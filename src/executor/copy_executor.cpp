@@ -11,6 +11,14 @@
 //===----------------------------------------------------------------------===//
 
 #include <concurrency/transaction_manager_factory.h>
+#include <cerrno>
+#include <condition_variable>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <thread>
 #include <utility>
 #include <vector>
 
@@ -20,16 +28,134 @@
 #include "executor/executor_context.h"
 #include "executor/logical_tile_factory.h"
 #include "planner/copy_plan.h"
+#include "planner/seq_scan_plan.h"
+#include "storage/data_table.h"
 #include "storage/table_factory.h"
+#include "storage/tile_group.h"
+#include "storage/tile_group_header.h"
+#include "type/value_factory.h"
 #include "logging/logging_util.h"
 #include "common/exception.h"
 #include "common/macros.h"
+#include "common/numa_util.h"
 #include <sys/stat.h>
 #include <sys/mman.h>
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
 
 namespace peloton {
 namespace executor {
 
+namespace {
+
+// Every binary copy file starts with this signature
+const char binary_copy_signature[] = "PGCOPY\n\377\r\n";
+const size_t binary_copy_signature_size = sizeof(binary_copy_signature);
+
+// Field count that ends a binary copy file
+const int16_t binary_copy_trailer = -1;
+
+template <typename T>
+T ReadBigEndian(const char *data) {
+  typename std::make_unsigned<T>::type value = 0;
+  for (size_t i = 0; i < sizeof(T); i++) {
+    value = (value << 8) | static_cast<unsigned char>(data[i]);
+  }
+  return static_cast<T>(value);
+}
+
+template <typename T>
+void AppendBigEndian(std::string &buffer, T value) {
+  auto bits = static_cast<typename std::make_unsigned<T>::type>(value);
+  for (size_t i = sizeof(T); i > 0; i--) {
+    buffer.push_back(static_cast<char>(bits >> ((i - 1) * 8)));
+  }
+}
+
+// Threads used by COPY
+size_t GetWorkerCount() {
+  if (FLAGS_copy_workers != 0) return FLAGS_copy_workers;
+  return std::max(1u, std::thread::hardware_concurrency());
+}
+
+// Returns the offset of the first delimiter or new line in the data, or its
+// length if there is none. Compares 16 bytes at a time where SSE2 is
+// available.
+size_t FindEscapeCharacter(const char *data, size_t len, char delimiter,
+                           char new_line) {
+  size_t offset = 0;
+#ifdef __SSE2__
+  const __m128i delimiters = _mm_set1_epi8(delimiter);
+  const __m128i new_lines = _mm_set1_epi8(new_line);
+  for (; offset + sizeof(__m128i) <= len; offset += sizeof(__m128i)) {
+    __m128i bytes =
+        _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + offset));
+    int mask = _mm_movemask_epi8(_mm_or_si128(
+        _mm_cmpeq_epi8(bytes, delimiters), _mm_cmpeq_epi8(bytes, new_lines)));
+    if (mask != 0) return offset + __builtin_ctz(mask);
+  }
+#endif
+  for (; offset < len; offset++) {
+    if (data[offset] == delimiter || data[offset] == new_line) return offset;
+  }
+  return len;
+}
+
+// Copy the field to the output and escape its delimiters and new lines.
+// The output needs room for 3 bytes per input byte in the worst case.
+// Returns the number of bytes written.
+size_t EscapeField(const char *data, size_t len, char delimiter,
+                   char new_line, char *output) {
+  size_t offset = 0;
+  size_t written = 0;
+  while (true) {
+    // Runs without special characters are copied in one go
+    size_t run = FindEscapeCharacter(data + offset, len - offset, delimiter,
+                                     new_line);
+    memcpy(output + written, data + offset, run);
+    offset += run;
+    written += run;
+    if (offset == len) break;
+
+    char ch = data[offset++];
+    if (ch == delimiter) {
+      output[written++] = '\\';
+      output[written++] = '\\';
+    } else {
+      output[written++] = '\\';
+    }
+    output[written++] = ch;
+  }
+  return written;
+}
+
+// Whether the plan reads every column of every tuple of the table in order,
+// so that it outputs what the tile groups of the table hold
+bool IsFullTableScan(const planner::AbstractPlan *plan,
+                     const storage::DataTable *table) {
+  // hybrid scans report SEQSCAN as well
+  auto scan = dynamic_cast<const planner::SeqScanPlan *>(plan);
+  if (scan == nullptr || scan->GetTable() != table ||
+      scan->GetPredicate() != nullptr || scan->IsForUpdate() ||
+      scan->GetChildren().empty() == false) {
+    return false;
+  }
+
+  // a scan without column ids reads all columns
+  auto &column_ids = scan->GetColumnIds();
+  if (column_ids.empty()) return true;
+  if (column_ids.size() != table->GetSchema()->GetColumnCount()) {
+    return false;
+  }
+  for (oid_t column_itr = 0; column_itr < column_ids.size(); column_itr++) {
+    if (column_ids[column_itr] != column_itr) return false;
+  }
+  return true;
+}
+
+}  // namespace
+
 /**
  * @brief Constructor for Copy executor.
  * @param node Copy node corresponding to this executor.
@@ -45,11 +171,37 @@ CopyExecutor::~CopyExecutor() {}
  * @return true on success, false otherwise.
  */
 bool CopyExecutor::DInit() {
-  PL_ASSERT(children_.size() == 1);
-
   // Grab info from plan node and check it
   const planner::CopyPlan &node = GetPlanNode<planner::CopyPlan>();
 
+  // Imports read the file themselves and append to the target table
+  if (node.IsImport()) {
+    PL_ASSERT(children_.size() == 0);
+    PL_ASSERT(node.target_table != nullptr);
+    return true;
+  }
+
+  PL_ASSERT(children_.size() == 1);
+  delimiter = node.delimiter;
+
+  // Binary exports and exports with several workers format the tile groups
+  // of the table directly instead of the tiles of the child
+  if (node.copy_type == CopyType::EXPORT_BINARY &&
+      node.deserialize_parameters) {
+    throw ExecutorException("Binary copy of query parameters is not supported");
+  }
+  direct_export = node.target_table != nullptr &&
+                  node.deserialize_parameters == false &&
+                  IsFullTableScan(node.GetChildren()[0].get(),
+                                  node.target_table) &&
+                  (node.copy_type == CopyType::EXPORT_BINARY ||
+                   GetWorkerCount() > 1);
+
+  // Every worker creates its own file
+  if (direct_export && FLAGS_copy_file_per_worker) {
+    return true;
+  }
+
   bool success = logging::LoggingUtil::InitFileHandle(node.file_path.c_str(),
                                                       file_handle_, "w");
 
@@ -123,18 +275,7 @@ void CopyExecutor::Copy(const char *data, int len, bool end_of_line) {
   }
 
   // Now copy the string to local buffer and escape delimiters
-  // TODO A better way is to search for delimiter once and perform copy
-  for (int i = 0; i < len; i++) {
-    char ch = data[i];
-    // Check delimiter
-    if (ch == delimiter) {
-      buff[buff_size++] = '\\';
-      buff[buff_size++] = '\\';
-    } else if (ch == new_line) {
-      buff[buff_size++] = '\\';
-    }
-    buff[buff_size++] = ch;
-  }
+  buff_size += EscapeField(data, len, delimiter, new_line, buff + buff_size);
 
   // Append col delimiter and new line delimiter
   if (end_of_line == false) {
@@ -154,6 +295,19 @@ bool CopyExecutor::DExecute() {
     return false;
   }
 
+  const planner::CopyPlan &node = GetPlanNode<planner::CopyPlan>();
+  if (node.IsImport()) {
+    ImportFile();
+    done = true;
+    return true;
+  }
+
+  if (direct_export) {
+    ExportTable();
+    done = true;
+    return true;
+  }
+
   while (children_[0]->Execute() == true) {
     // Get input a tile
     std::unique_ptr<LogicalTile> logical_tile(children_[0]->GetOutput());
@@ -267,5 +421,918 @@ bool CopyExecutor::DExecute() {
   return true;
 }
 
+//===--------------------------------------------------------------------===//
+// Import
+//===--------------------------------------------------------------------===//
+
+namespace {
+
+// A piece of the import file that holds whole rows only
+struct ImportChunk {
+  std::unique_ptr<char[]> data;
+  size_t size = 0;
+};
+
+// State shared by the reader and the parser threads of an import
+struct ImportContext {
+  ImportContext(storage::DataTable *table,
+                concurrency::Transaction *transaction, CopyType copy_type,
+                char delimiter)
+      : table(table),
+        transaction(transaction),
+        copy_type(copy_type),
+        delimiter(delimiter),
+        failed(false) {}
+
+  // Wait for room in the queue and hand a chunk to the parser threads
+  void PushChunk(ImportChunk &&chunk) {
+    std::unique_lock<std::mutex> lock(chunk_mutex);
+    chunk_cv.wait(lock, [this] {
+      return chunks.size() < COPY_IMPORT_QUEUE_DEPTH || failed;
+    });
+    chunks.push_back(std::move(chunk));
+    chunk_cv.notify_all();
+  }
+
+  // Wait for the next chunk. Returns false once the file is exhausted.
+  bool PopChunk(ImportChunk &chunk) {
+    std::unique_lock<std::mutex> lock(chunk_mutex);
+    chunk_cv.wait(lock, [this] { return !chunks.empty() || reader_done; });
+    if (chunks.empty()) return false;
+    chunk = std::move(chunks.front());
+    chunks.pop_front();
+    chunk_cv.notify_all();
+    return true;
+  }
+
+  void FinishReading() {
+    std::lock_guard<std::mutex> lock(chunk_mutex);
+    reader_done = true;
+    chunk_cv.notify_all();
+  }
+
+  // Add a filled tile group to the table and its indexes
+  void AddTileGroup(const std::shared_ptr<storage::TileGroup> &tile_group) {
+    if (failed) return;
+    {
+      std::lock_guard<std::mutex> lock(tile_group_mutex);
+      tile_groups.push_back(tile_group);
+    }
+    if (table->AddBulkLoadTileGroup(tile_group, transaction) == false) {
+      Fail("duplicate key violates a primary or unique index");
+    }
+  }
+
+  // Record the first error, the other threads stop at the next chunk
+  void Fail(const std::string &message) {
+    std::lock_guard<std::mutex> lock(chunk_mutex);
+    if (failed == false) {
+      error_message = message;
+      failed = true;
+    }
+    chunk_cv.notify_all();
+  }
+
+  storage::DataTable *table;
+  concurrency::Transaction *transaction;
+  CopyType copy_type;
+  char delimiter;
+
+  // Chunks read but not yet parsed
+  std::deque<ImportChunk> chunks;
+  bool reader_done = false;
+  std::mutex chunk_mutex;
+  std::condition_variable chunk_cv;
+
+  // Tile groups handed to the table so far
+  std::vector<std::shared_ptr<storage::TileGroup>> tile_groups;
+  std::mutex tile_group_mutex;
+
+  std::atomic<bool> failed;
+  std::string error_message;
+};
+
+// Returns the length of the whole text rows at the start of the data. Only
+// csv fields can hold a new line, inside quotes; tsv escapes them.
+size_t FindTextRowsEnd(const char *data, size_t size, bool is_csv) {
+  if (is_csv == false) {
+    for (size_t offset = size; offset > 0; offset--) {
+      if (data[offset - 1] == '\n') return offset;
+    }
+    return 0;
+  }
+
+  bool in_quotes = false;
+  size_t rows_end = 0;
+  for (size_t offset = 0; offset < size; offset++) {
+    if (data[offset] == '"') {
+      in_quotes = !in_quotes;
+    } else if (data[offset] == '\n' && in_quotes == false) {
+      rows_end = offset + 1;
+    }
+  }
+  return rows_end;
+}
+
+// Returns the length of the whole binary rows at the start of the data.
+// Stops at the trailer, a field count of -1.
+size_t FindBinaryRowsEnd(const char *data, size_t size, bool &found_trailer) {
+  size_t rows_end = 0;
+  while (rows_end + sizeof(int16_t) <= size) {
+    auto field_count = ReadBigEndian<int16_t>(data + rows_end);
+    if (field_count < 0) {
+      found_trailer = true;
+      return rows_end;
+    }
+
+    size_t row_end = rows_end + sizeof(int16_t);
+    for (int16_t field_itr = 0; field_itr < field_count; field_itr++) {
+      if (row_end + sizeof(int32_t) > size) return rows_end;
+      auto field_length = ReadBigEndian<int32_t>(data + row_end);
+      row_end += sizeof(int32_t);
+      if (field_length > 0) row_end += field_length;
+    }
+    if (row_end > size) return rows_end;
+    rows_end = row_end;
+  }
+  return rows_end;
+}
+
+// Split the first text row of the data into its fields and return the bytes
+// consumed. An empty unquoted csv field and a tsv \N are NULL.
+size_t SplitTextRow(const char *data, size_t size, bool is_csv,
+                    char delimiter, std::vector<std::string> &fields,
+                    std::vector<bool> &nulls, size_t &field_count) {
+  size_t offset = 0;
+  field_count = 0;
+  while (true) {
+    if (field_count == fields.size()) {
+      fields.emplace_back();
+      nulls.push_back(false);
+    }
+    auto &field = fields[field_count];
+    field.clear();
+    bool quoted = false;
+    bool escaped_null = false;
+
+    while (offset < size) {
+      char ch = data[offset];
+      if (is_csv && ch == '"') {
+        // Quoted run, a doubled quote stands for itself
+        quoted = true;
+        offset++;
+        while (offset < size) {
+          if (data[offset] == '"') {
+            if (offset + 1 < size && data[offset + 1] == '"') {
+              field.push_back('"');
+              offset += 2;
+              continue;
+            }
+            break;
+          }
+          field.push_back(data[offset++]);
+        }
+        offset++;
+        continue;
+      }
+      if (ch == delimiter || ch == '\n') break;
+      if (is_csv == false && ch == '\\' && offset + 1 < size) {
+        char escaped = data[++offset];
+        switch (escaped) {
+          case 'N':
+            escaped_null = true;
+            break;
+          case 't':
+            field.push_back('\t');
+            break;
+          case 'n':
+            field.push_back('\n');
+            break;
+          case 'r':
+            field.push_back('\r');
+            break;
+          default:
+            field.push_back(escaped);
+            break;
+        }
+        offset++;
+        continue;
+      }
+      field.push_back(ch);
+      offset++;
+    }
+
+    // Tolerate windows line endings
+    bool end_of_row = (offset >= size || data[offset] == '\n');
+    if (end_of_row && quoted == false && field.empty() == false &&
+        field.back() == '\r') {
+      field.pop_back();
+    }
+
+    nulls[field_count] =
+        is_csv ? (field.empty() && quoted == false) : escaped_null;
+    field_count++;
+
+    if (offset < size) offset++;
+    if (end_of_row) return offset;
+  }
+}
+
+type::Value GetTextValue(const std::string &field,
+                         type::Type::TypeId type_id) {
+  switch (type_id) {
+    case type::Type::TINYINT:
+    case type::Type::SMALLINT:
+    case type::Type::INTEGER:
+    case type::Type::BIGINT: {
+      char *end = nullptr;
+      errno = 0;
+      long long value = strtoll(field.c_str(), &end, 10);
+      if (field.empty() || *end != '\0' || errno == ERANGE) break;
+      if (type_id == type::Type::TINYINT) {
+        if (value < type::PELOTON_INT8_MIN || value > type::PELOTON_INT8_MAX)
+          break;
+        return type::ValueFactory::GetTinyIntValue(value);
+      } else if (type_id == type::Type::SMALLINT) {
+        if (value < type::PELOTON_INT16_MIN || value > type::PELOTON_INT16_MAX)
+          break;
+        return type::ValueFactory::GetSmallIntValue(value);
+      } else if (type_id == type::Type::INTEGER) {
+        if (value < type::PELOTON_INT32_MIN || value > type::PELOTON_INT32_MAX)
+          break;
+        return type::ValueFactory::GetIntegerValue(value);
+      }
+      if (value < type::PELOTON_INT64_MIN) break;
+      return type::ValueFactory::GetBigIntValue(value);
+    }
+    case type::Type::DECIMAL: {
+      char *end = nullptr;
+      errno = 0;
+      double value = strtod(field.c_str(), &end);
+      if (field.empty() || *end != '\0' || errno == ERANGE) break;
+      return type::ValueFactory::GetDecimalValue(value);
+    }
+    case type::Type::BOOLEAN:
+      return type::ValueFactory::CastAsBoolean(
+          type::ValueFactory::GetVarcharValue(field));
+    case type::Type::TIMESTAMP:
+      return type::ValueFactory::CastAsTimestamp(
+          type::ValueFactory::GetVarcharValue(field));
+    case type::Type::VARCHAR:
+      return type::ValueFactory::GetVarcharValue(field);
+    case type::Type::VARBINARY:
+      return type::ValueFactory::GetVarbinaryValue(field);
+    default:
+      throw ExecutorException("Cannot import columns of type " +
+                              TypeIdToString(type_id));
+  }
+  throw ExecutorException("Invalid " + TypeIdToString(type_id) +
+                          " value: " + field);
+}
+
+type::Value GetBinaryValue(const char *data, int32_t length,
+                           type::Type::TypeId type_id) {
+  int32_t expected_length = -1;
+  switch (type_id) {
+    case type::Type::BOOLEAN:
+    case type::Type::TINYINT:
+      expected_length = 1;
+      break;
+    case type::Type::SMALLINT:
+      expected_length = 2;
+      break;
+    case type::Type::INTEGER:
+      expected_length = 4;
+      break;
+    case type::Type::BIGINT:
+    case type::Type::DECIMAL:
+    case type::Type::TIMESTAMP:
+      expected_length = 8;
+      break;
+    default:
+      break;
+  }
+  if (expected_length != -1 && length != expected_length) {
+    throw ExecutorException("Invalid " + TypeIdToString(type_id) +
+                            " field length " + std::to_string(length));
+  }
+
+  switch (type_id) {
+    case type::Type::BOOLEAN:
+      return type::ValueFactory::GetBooleanValue(data[0] != 0);
+    case type::Type::TINYINT:
+      return type::ValueFactory::GetTinyIntValue(
+          static_cast<int8_t>(data[0]));
+    case type::Type::SMALLINT:
+      return type::ValueFactory::GetSmallIntValue(ReadBigEndian<int16_t>(data));
+    case type::Type::INTEGER:
+      return type::ValueFactory::GetIntegerValue(ReadBigEndian<int32_t>(data));
+    case type::Type::BIGINT:
+      return type::ValueFactory::GetBigIntValue(ReadBigEndian<int64_t>(data));
+    case type::Type::TIMESTAMP:
+      return type::ValueFactory::GetTimestampValue(
+          ReadBigEndian<int64_t>(data));
+    case type::Type::DECIMAL: {
+      uint64_t bits = ReadBigEndian<uint64_t>(data);
+      double value;
+      memcpy(&value, &bits, sizeof(value));
+      return type::ValueFactory::GetDecimalValue(value);
+    }
+    case type::Type::VARCHAR:
+      return type::ValueFactory::GetVarcharValue(std::string(data, length));
+    case type::Type::VARBINARY:
+      return type::ValueFactory::GetVarbinaryValue(
+          reinterpret_cast<const unsigned char *>(data), length, true);
+    default:
+      throw ExecutorException("Cannot import columns of type " +
+                              TypeIdToString(type_id));
+  }
+}
+
+// Get a slot for the next tuple, moving on to a fresh tile group once the
+// current one is full
+oid_t AcquireTupleSlot(ImportContext &context,
+                       std::shared_ptr<storage::TileGroup> &tile_group) {
+  if (tile_group != nullptr) {
+    oid_t tuple_id = tile_group->GetHeader()->GetNextEmptyTupleSlot();
+    if (tuple_id != INVALID_OID) return tuple_id;
+    context.AddTileGroup(tile_group);
+  }
+  tile_group = context.table->GetBulkLoadTileGroup();
+  return tile_group->GetHeader()->GetNextEmptyTupleSlot();
+}
+
+// Parser thread: turn the rows of the chunks into tuples of the thread's own
+// tile groups
+void ParseChunks(ImportContext *context) {
+  auto schema = context->table->GetSchema();
+  oid_t column_count = schema->GetColumnCount();
+  bool is_binary = context->copy_type == CopyType::IMPORT_BINARY;
+  bool is_csv = context->copy_type == CopyType::IMPORT_CSV;
+
+  // Reused across rows to avoid reallocating the field buffers
+  std::vector<std::string> fields;
+  std::vector<bool> nulls;
+  size_t field_count = 0;
+
+  std::shared_ptr<storage::TileGroup> tile_group;
+  ImportChunk chunk;
+  while (context->PopChunk(chunk)) {
+    // Drain the queue so that the reader is not blocked
+    if (context->failed) continue;
+
+    try {
+      const char *data = chunk.data.get();
+      size_t offset = 0;
+      while (offset < chunk.size) {
+        if (is_binary) {
+          auto row_field_count = ReadBigEndian<int16_t>(data + offset);
+          offset += sizeof(int16_t);
+          if (row_field_count != static_cast<int16_t>(column_count)) {
+            throw ExecutorException("Expected " +
+                                    std::to_string(column_count) +
+                                    " fields in row but found " +
+                                    std::to_string(row_field_count));
+          }
+
+          oid_t tuple_id = AcquireTupleSlot(*context, tile_group);
+          for (oid_t column_itr = 0; column_itr < column_count; column_itr++) {
+            auto field_length = ReadBigEndian<int32_t>(data + offset);
+            offset += sizeof(int32_t);
+            auto type_id = schema->GetType(column_itr);
+            type::Value value =
+                (field_length < 0)
+                    ? type::ValueFactory::GetNullValueByType(type_id)
+                    : GetBinaryValue(data + offset, field_length, type_id);
+            if (field_length > 0) offset += field_length;
+            tile_group->SetValue(value, tuple_id, column_itr);
+          }
+        } else {
+          offset += SplitTextRow(data + offset, chunk.size - offset, is_csv,
+                                 context->delimiter, fields, nulls,
+                                 field_count);
+
+          // Skip blank lines
+          if (field_count == 1 && fields[0].empty() && column_count != 1) {
+            continue;
+          }
+          if (field_count != column_count) {
+            throw ExecutorException("Expected " +
+                                    std::to_string(column_count) +
+                                    " fields in row but found " +
+                                    std::to_string(field_count));
+          }
+
+          oid_t tuple_id = AcquireTupleSlot(*context, tile_group);
+          for (oid_t column_itr = 0; column_itr < column_count; column_itr++) {
+            auto type_id = schema->GetType(column_itr);
+            type::Value value =
+                nulls[column_itr]
+                    ? type::ValueFactory::GetNullValueByType(type_id)
+                    : GetTextValue(fields[column_itr], type_id);
+            tile_group->SetValue(value, tuple_id, column_itr);
+          }
+        }
+      }
+    } catch (Exception &e) {
+      context->Fail(e.what());
+    }
+  }
+
+  if (tile_group != nullptr && tile_group->GetNextTupleSlot() > 0) {
+    context->AddTileGroup(tile_group);
+  }
+}
+
+// Reader: cut the file into chunks of whole rows for the parser threads
+void ReadChunks(FILE *file, ImportContext &context) {
+  bool is_binary = context.copy_type == CopyType::IMPORT_BINARY;
+  bool is_csv = context.copy_type == CopyType::IMPORT_CSV;
+
+  if (is_binary) {
+    // Signature, flags and the length of the header extension
+    char header[binary_copy_signature_size + 2 * sizeof(int32_t)];
+    if (fread(header, 1, sizeof(header), file) != sizeof(header) ||
+        memcmp(header, binary_copy_signature, binary_copy_signature_size) !=
+            0) {
+      context.Fail("invalid binary copy file signature");
+      context.FinishReading();
+      return;
+    }
+    auto extension_length = ReadBigEndian<int32_t>(
+        header + binary_copy_signature_size + sizeof(int32_t));
+    if (extension_length > 0) fseek(file, extension_length, SEEK_CUR);
+  }
+
+  // Partial row at the end of the previous chunk
+  std::vector<char> carry;
+  bool found_trailer = false;
+  while (context.failed == false && found_trailer == false) {
+    ImportChunk chunk;
+    chunk.data.reset(new char[carry.size() + COPY_IMPORT_CHUNK_SIZE]);
+    if (carry.empty() == false) {
+      memcpy(chunk.data.get(), carry.data(), carry.size());
+    }
+    size_t bytes_read = fread(chunk.data.get() + carry.size(), 1,
+                              COPY_IMPORT_CHUNK_SIZE, file);
+    size_t size = carry.size() + bytes_read;
+    bool end_of_file = (bytes_read < COPY_IMPORT_CHUNK_SIZE);
+
+    size_t rows_end = 0;
+    if (is_binary) {
+      rows_end = FindBinaryRowsEnd(chunk.data.get(), size, found_trailer);
+    } else if (end_of_file) {
+      // The last row does not need a new line
+      rows_end = size;
+    } else {
+      rows_end = FindTextRowsEnd(chunk.data.get(), size, is_csv);
+    }
+
+    // A row longer than a chunk grows the next chunk
+    carry.assign(chunk.data.get() + rows_end, chunk.data.get() + size);
+    chunk.size = rows_end;
+    if (rows_end > 0) {
+      context.PushChunk(std::move(chunk));
+    }
+
+    if (end_of_file) {
+      if (is_binary && found_trailer == false) {
+        context.Fail("binary copy file ends without a trailer");
+      }
+      break;
+    }
+  }
+
+  context.FinishReading();
+}
+
+}  // namespace
+
+/**
+ * @brief Import the file into the target table. The reader cuts the file into
+ * chunks of whole rows, the parser threads turn them into tuples of fresh tile
+ * groups and add those to the table and its indexes. All tuples become
+ * inserts of the statement's transaction once the whole file is loaded, and
+ * are logged and made visible when it commits.
+ */
+void CopyExecutor::ImportFile() {
+  const planner::CopyPlan &node = GetPlanNode<planner::CopyPlan>();
+  auto target_table = node.target_table;
+
+  FILE *file = fopen(node.file_path.c_str(), "rb");
+  if (file == nullptr) {
+    throw ExecutorException("Failed to open file " + node.file_path +
+                            ". Try absolute path and make sure you have the "
+                            "permission to access this file.");
+  }
+
+  ImportContext context(target_table, executor_context_->GetTransaction(),
+                        node.copy_type, node.delimiter);
+
+  size_t parser_count = GetWorkerCount();
+  std::vector<std::thread> parser_threads;
+  for (size_t thread_itr = 0; thread_itr < parser_count; thread_itr++) {
+    parser_threads.emplace_back(ParseChunks, &context);
+  }
+  ReadChunks(file, context);
+  for (auto &parser_thread : parser_threads) {
+    parser_thread.join();
+  }
+  fclose(file);
+
+  if (context.failed) {
+    target_table->AbortBulkLoad(context.tile_groups);
+    throw ExecutorException("Failed to import " + node.file_path + ": " +
+                            context.error_message);
+  }
+
+  // The loaded tuples commit or abort with the transaction of the statement
+  target_table->CommitBulkLoad(context.tile_groups,
+                               executor_context_->GetTransaction());
+
+  for (auto &tile_group : context.tile_groups) {
+    total_tuples_imported += tile_group->GetNextTupleSlot();
+  }
+  executor_context_->num_processed += total_tuples_imported;
+  LOG_DEBUG("Imported %lu tuples into %lu tile groups",
+            total_tuples_imported, context.tile_groups.size());
+}
+
+//===--------------------------------------------------------------------===//
+// Export
+//===--------------------------------------------------------------------===//
+
+namespace {
+
+// State shared by the writer and the formatting threads of an export
+struct ExportContext {
+  ExportContext(storage::DataTable *table,
+                concurrency::Transaction *transaction, bool is_binary,
+                char delimiter, char new_line, size_t tile_group_count)
+      : table(table),
+        transaction(transaction),
+        is_binary(is_binary),
+        delimiter(delimiter),
+        new_line(new_line),
+        tile_group_count(tile_group_count),
+        next_tile_group(0),
+        bytes_written(0),
+        failed(false) {}
+
+  // Hand the formatted tile group to the writer
+  void PushChunk(size_t tile_group_offset, std::string &&chunk) {
+    std::lock_guard<std::mutex> lock(chunk_mutex);
+    chunks[tile_group_offset] = std::move(chunk);
+    chunk_cv.notify_all();
+  }
+
+  // Wait until the tile group is close enough to the writer, so that the
+  // formatted chunks waiting to be written stay bounded
+  void WaitForWindow(size_t tile_group_offset) {
+    std::unique_lock<std::mutex> lock(chunk_mutex);
+    chunk_cv.wait(lock, [this, tile_group_offset] {
+      return tile_group_offset < next_to_write + COPY_EXPORT_WINDOW || failed;
+    });
+  }
+
+  // Wait for the formatted chunk of the tile group
+  bool PopChunk(size_t tile_group_offset, std::string &chunk) {
+    std::unique_lock<std::mutex> lock(chunk_mutex);
+    chunk_cv.wait(lock, [this, tile_group_offset] {
+      return chunks.count(tile_group_offset) != 0 || failed;
+    });
+    if (failed) return false;
+    chunk = std::move(chunks[tile_group_offset]);
+    chunks.erase(tile_group_offset);
+    next_to_write = tile_group_offset + 1;
+    chunk_cv.notify_all();
+    return true;
+  }
+
+  // Split the tile groups by the NUMA node they are placed on. Tile groups
+  // of no node are spread over the nodes.
+  void SplitByNode(size_t node_count) {
+    node_tile_groups.resize(node_count);
+    node_cursors = std::vector<std::atomic<size_t>>(node_count);
+    for (size_t tile_group_offset = 0; tile_group_offset < tile_group_count;
+         tile_group_offset++) {
+      int node = table->GetTileGroup(tile_group_offset)->GetNumaNode();
+      size_t list_id = (node == NUMA_NODE_ANY)
+                           ? tile_group_offset % node_count
+                           : static_cast<size_t>(node) % node_count;
+      node_tile_groups[list_id].push_back(tile_group_offset);
+    }
+  }
+
+  // Hand out the next tile group. Split tile groups go to the workers of
+  // their node first, the others take them once their own are done.
+  bool NextTileGroup(int numa_node, size_t &tile_group_offset) {
+    if (node_tile_groups.empty()) {
+      tile_group_offset = next_tile_group++;
+      return tile_group_offset < tile_group_count;
+    }
+
+    size_t node_count = node_tile_groups.size();
+    for (size_t node_itr = 0; node_itr < node_count; node_itr++) {
+      size_t list_id = (numa_node + node_itr) % node_count;
+      size_t cursor = node_cursors[list_id]++;
+      if (cursor < node_tile_groups[list_id].size()) {
+        tile_group_offset = node_tile_groups[list_id][cursor];
+        return true;
+      }
+    }
+    return false;
+  }
+
+  void Fail(const std::string &message) {
+    std::lock_guard<std::mutex> lock(chunk_mutex);
+    if (failed == false) {
+      error_message = message;
+      failed = true;
+    }
+    chunk_cv.notify_all();
+  }
+
+  storage::DataTable *table;
+  concurrency::Transaction *transaction;
+  // the transaction's read set is not thread safe
+  std::mutex read_mutex;
+  bool is_binary;
+  char delimiter;
+  char new_line;
+
+  // Tile groups are handed out to the workers one at a time
+  size_t tile_group_count;
+  std::atomic<size_t> next_tile_group;
+
+  // Offsets of the tile groups of every NUMA node and the next one to hand
+  // out, if the tile groups are split by node
+  std::vector<std::vector<size_t>> node_tile_groups;
+  std::vector<std::atomic<size_t>> node_cursors;
+
+  // Formatted tile groups not yet written, by tile group offset
+  std::map<size_t, std::string> chunks;
+  size_t next_to_write = 0;
+  std::mutex chunk_mutex;
+  std::condition_variable chunk_cv;
+
+  std::atomic<size_t> bytes_written;
+  std::atomic<bool> failed;
+  std::string error_message;
+};
+
+void AppendBinaryHeader(std::string &buffer) {
+  buffer.append(binary_copy_signature, binary_copy_signature_size);
+  // Flags and the length of the header extension
+  AppendBigEndian<int32_t>(buffer, 0);
+  AppendBigEndian<int32_t>(buffer, 0);
+}
+
+void AppendBinaryValue(std::string &buffer, const type::Value &value) {
+  if (value.IsNull()) {
+    AppendBigEndian<int32_t>(buffer, -1);
+    return;
+  }
+
+  switch (value.GetTypeId()) {
+    case type::Type::BOOLEAN:
+    case type::Type::TINYINT:
+      AppendBigEndian<int32_t>(buffer, 1);
+      buffer.push_back(value.GetAs<int8_t>());
+      break;
+    case type::Type::SMALLINT:
+      AppendBigEndian<int32_t>(buffer, 2);
+      AppendBigEndian(buffer, value.GetAs<int16_t>());
+      break;
+    case type::Type::INTEGER:
+      AppendBigEndian<int32_t>(buffer, 4);
+      AppendBigEndian(buffer, value.GetAs<int32_t>());
+      break;
+    case type::Type::BIGINT:
+    case type::Type::TIMESTAMP:
+      AppendBigEndian<int32_t>(buffer, 8);
+      AppendBigEndian(buffer, value.GetAs<int64_t>());
+      break;
+    case type::Type::DECIMAL: {
+      double decimal = value.GetAs<double>();
+      uint64_t bits;
+      memcpy(&bits, &decimal, sizeof(bits));
+      AppendBigEndian<int32_t>(buffer, 8);
+      AppendBigEndian(buffer, bits);
+    } break;
+    case type::Type::VARCHAR: {
+      // Without the terminating null character
+      int32_t length = value.GetLength() - 1;
+      AppendBigEndian(buffer, length);
+      buffer.append(value.GetData(), length);
+    } break;
+    case type::Type::VARBINARY: {
+      int32_t length = value.GetLength();
+      AppendBigEndian(buffer, length);
+      buffer.append(value.GetData(), length);
+    } break;
+    default:
+      throw ExecutorException("Cannot export columns of type " +
+                              TypeIdToString(value.GetTypeId()));
+  }
+}
+
+// Format the tuples of the tile group that are visible to the transaction.
+// They are read through the transaction manager like a sequential scan
+// reads them. Returns false if a read fails.
+bool FormatTileGroup(ExportContext &context, storage::TileGroup *tile_group,
+                     std::string &buffer) {
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto tile_group_header = tile_group->GetHeader();
+  oid_t column_count = context.table->GetSchema()->GetColumnCount();
+  oid_t tuple_count = tile_group->GetNextTupleSlot();
+
+  std::vector<oid_t> position_list;
+  for (oid_t tuple_id = 0; tuple_id < tuple_count; tuple_id++) {
+    if (txn_manager.IsVisible(context.transaction, tile_group_header,
+                              tuple_id) == VisibilityType::OK) {
+      position_list.push_back(tuple_id);
+    }
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(context.read_mutex);
+    for (auto tuple_id : position_list) {
+      ItemPointer location(tile_group->GetTileGroupId(), tuple_id);
+      if (txn_manager.PerformRead(context.transaction, location, false) ==
+          false) {
+        txn_manager.SetTransactionResult(context.transaction,
+                                         ResultType::FAILURE);
+        return false;
+      }
+    }
+  }
+
+  for (auto tuple_id : position_list) {
+    if (context.is_binary) {
+      AppendBigEndian(buffer, static_cast<int16_t>(column_count));
+    }
+    for (oid_t column_itr = 0; column_itr < column_count; column_itr++) {
+      auto value = tile_group->GetValue(tuple_id, column_itr);
+      if (context.is_binary) {
+        AppendBinaryValue(buffer, value);
+        continue;
+      }
+
+      // Same text as the tiles of the child would give
+      auto field = value.ToString();
+      size_t offset = buffer.size();
+      buffer.resize(offset + field.length() * 3 + 1);
+      offset += EscapeField(field.c_str(), field.length(), context.delimiter,
+                            context.new_line, &buffer[offset]);
+      buffer[offset++] = (column_itr == column_count - 1) ? context.new_line
+                                                          : context.delimiter;
+      buffer.resize(offset);
+    }
+  }
+  return true;
+}
+
+void WriteChunk(ExportContext &context, FILE *file, const std::string &chunk) {
+  if (chunk.empty()) return;
+  if (fwrite(chunk.data(), 1, chunk.size(), file) != chunk.size()) {
+    context.Fail("failed to write the output file");
+    return;
+  }
+  context.bytes_written += chunk.size();
+}
+
+// Worker: format tile groups in the order they are handed out. With a file
+// per worker the worker writes them itself, otherwise the writer does.
+// A worker of a NUMA node runs on that node and prefers its tile groups.
+void ExportTileGroups(ExportContext *context, FILE *worker_file,
+                      int numa_node) {
+  if (numa_node != NUMA_NODE_ANY) NumaUtil::PinCurrentThread(numa_node);
+
+  if (worker_file != nullptr && context->is_binary) {
+    std::string header;
+    AppendBinaryHeader(header);
+    WriteChunk(*context, worker_file, header);
+  }
+
+  size_t tile_group_offset;
+  while (context->failed == false &&
+         context->NextTileGroup(numa_node, tile_group_offset)) {
+
+    std::string chunk;
+    try {
+      if (worker_file == nullptr) context->WaitForWindow(tile_group_offset);
+      auto tile_group = context->table->GetTileGroup(tile_group_offset);
+      if (FormatTileGroup(*context, tile_group.get(), chunk) == false) {
+        context->Fail("transaction read failed");
+        break;
+      }
+    } catch (Exception &e) {
+      context->Fail(e.what());
+      break;
+    }
+
+    if (worker_file != nullptr) {
+      WriteChunk(*context, worker_file, chunk);
+    } else {
+      context->PushChunk(tile_group_offset, std::move(chunk));
+    }
+  }
+
+  if (worker_file != nullptr && context->is_binary) {
+    std::string trailer;
+    AppendBigEndian(trailer, binary_copy_trailer);
+    WriteChunk(*context, worker_file, trailer);
+  }
+}
+
+}  // namespace
+
+/**
+ * @brief Export the target table. Workers format its tile groups in parallel.
+ * The chunks are either written to the output file in tile group order, or
+ * each worker writes its own file named after the output file and the worker.
+ */
+void CopyExecutor::ExportTable() {
+  const planner::CopyPlan &node = GetPlanNode<planner::CopyPlan>();
+  ExportContext context(node.target_table, executor_context_->GetTransaction(),
+                        node.copy_type == CopyType::EXPORT_BINARY, delimiter,
+                        new_line, node.target_table->GetTileGroupCount());
+
+  size_t worker_count = GetWorkerCount();
+  std::vector<FILE *> worker_files(worker_count, nullptr);
+  if (FLAGS_copy_file_per_worker) {
+    for (size_t worker_itr = 0; worker_itr < worker_count; worker_itr++) {
+      std::string worker_file_path =
+          node.file_path + "." + std::to_string(worker_itr);
+      worker_files[worker_itr] = fopen(worker_file_path.c_str(), "wb");
+      if (worker_files[worker_itr] == nullptr) {
+        for (auto file : worker_files) {
+          if (file != nullptr) fclose(file);
+        }
+        throw ExecutorException("Failed to create file " + worker_file_path);
+      }
+    }
+  }
+
+  // Workers writing their own files need not follow the tile group order,
+  // so with placed tile groups they are spread over the NUMA nodes and scan
+  // local tile groups first
+  size_t node_count = NumaUtil::GetNodeCount();
+  bool split_by_node =
+      FLAGS_copy_file_per_worker && FLAGS_numa_placement && node_count > 1;
+  if (split_by_node) context.SplitByNode(node_count);
+
+  std::vector<std::thread> workers;
+  for (size_t worker_itr = 0; worker_itr < worker_count; worker_itr++) {
+    int numa_node = NUMA_NODE_ANY;
+    if (split_by_node) numa_node = static_cast<int>(worker_itr % node_count);
+    workers.emplace_back(ExportTileGroups, &context, worker_files[worker_itr],
+                         numa_node);
+  }
+
+  // Write the chunks of the workers in tile group order
+  if (FLAGS_copy_file_per_worker == false) {
+    std::string chunk;
+    if (context.is_binary) {
+      AppendBinaryHeader(chunk);
+      WriteChunk(context, file_handle_.file, chunk);
+    }
+    for (size_t tile_group_offset = 0;
+         tile_group_offset < context.tile_group_count; tile_group_offset++) {
+      if (context.PopChunk(tile_group_offset, chunk) == false) break;
+      WriteChunk(context, file_handle_.file, chunk);
+    }
+    if (context.is_binary) {
+      chunk.clear();
+      AppendBigEndian(chunk, binary_copy_trailer);
+      WriteChunk(context, file_handle_.file, chunk);
+    }
+  }
+
+  for (auto &worker : workers) {
+    worker.join();
+  }
+
+  if (FLAGS_copy_file_per_worker) {
+    for (auto file : worker_files) {
+      fflush(file);
+      fsync(fileno(file));
+      fclose(file);
+    }
+  } else {
+    logging::LoggingUtil::FFlushFsync(file_handle_);
+    fclose(file_handle_.file);
+  }
+
+  total_bytes_written += context.bytes_written;
+  if (context.failed) {
+    throw ExecutorException("Failed to copy to " + node.file_path + ": " +
+                            context.error_message);
+  }
+  LOG_DEBUG("Exported %lu tile groups with %lu workers",
+            context.tile_group_count, worker_count);
+}
+
 }  // namespace executor
 }  // namespace peloton
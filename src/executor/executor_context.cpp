@@ -13,18 +13,23 @@
 
 #include "type/value.h"
 #include "executor/executor_context.h"
+#include "common/logger.h"
 #include "concurrency/transaction.h"
 
 namespace peloton {
 namespace executor {
 
 ExecutorContext::ExecutorContext(concurrency::Transaction *transaction)
-    : transaction_(transaction) {}
+    : transaction_(transaction),
+      memory_budget_(FLAGS_query_memory),
+      memory_used_(0) {}
 
 ExecutorContext::ExecutorContext(concurrency::Transaction *transaction,
                                  const std::vector<type::Value> &params)
     : transaction_(transaction),
-      params_(params) {}
+      params_(params),
+      memory_budget_(FLAGS_query_memory),
+      memory_used_(0) {}
 
 ExecutorContext::~ExecutorContext() {
   // params will be freed automatically
@@ -57,5 +62,30 @@ type::EphemeralPool *ExecutorContext::GetPool() {
   return pool_.get();
 }
 
+bool ExecutorContext::ReserveMemory(size_t bytes) {
+  size_t used = memory_used_.load();
+  do {
+    if (used + bytes > memory_budget_) {
+      LOG_DEBUG("Query memory budget of %lu bytes exceeded (%lu in use)",
+                memory_budget_, used);
+      return false;
+    }
+  } while (!memory_used_.compare_exchange_weak(used, used + bytes));
+  return true;
+}
+
+void ExecutorContext::ChargeMemory(size_t bytes) {
+  size_t used = memory_used_.fetch_add(bytes) + bytes;
+  if (used > memory_budget_) {
+    LOG_DEBUG("Query memory budget of %lu bytes exceeded (%lu in use)",
+              memory_budget_, used);
+  }
+}
+
+void ExecutorContext::ReleaseMemory(size_t bytes) {
+  PL_ASSERT(memory_used_ >= bytes);
+  memory_used_ -= bytes;
+}
+
 }  // namespace executor
 }  // namespace peloton
@@ -16,6 +16,7 @@
 
 #include "common/logger.h"
 #include "type/value.h"
+#include "executor/executor_context.h"
 #include "executor/logical_tile.h"
 #include "executor/hash_executor.h"
 #include "planner/hash_plan.h"
@@ -51,16 +52,6 @@ bool HashExecutor::DExecute() {
   if (done_ == false) {
     const planner::HashPlan &node = GetPlanNode<planner::HashPlan>();
 
-    // First, get all the input logical tiles
-    while (children_[0]->Execute()) {
-      child_tiles_.emplace_back(children_[0]->GetOutput());
-    }
-
-    if (child_tiles_.size() == 0) {
-      LOG_TRACE("Hash Executor : false -- no child tiles ");
-      return false;
-    }
-
     /* *
      * HashKeys is a vector of TupleValue expr
      * from which we construct a vector of column ids that represent the
@@ -78,45 +69,175 @@ bool HashExecutor::DExecute() {
       column_ids_.push_back(tuple_value->GetColumnId());
     }
 
-    // Construct the hash table by going over each child logical tile and
-    // hashing
-    for (size_t child_tile_itr = 0; child_tile_itr < child_tiles_.size();
-         child_tile_itr++) {
-      auto tile = child_tiles_[child_tile_itr].get();
-
-      // Go over all tuples in the logical tile
-      for (oid_t tuple_id : *tile) {
-        // Key : container tuple with a subset of tuple attributes
-        // Value : < child_tile offset, tuple offset >
-        auto key = HashMapType::key_type(tile, tuple_id, &column_ids_);
-        if (hash_table_.find(key) != hash_table_.end()){
-           //If data is already present, remove from output
-           //but leave data for hash joins.
-           tile->RemoveVisibility(tuple_id);
+    // Get all the input logical tiles, and construct the hash table by
+    // hashing each one, as long as it fits in memory
+    while (children_[0]->Execute()) {
+      std::unique_ptr<LogicalTile> tile(children_[0]->GetOutput());
+
+      if (spilled_rows_ == nullptr &&
+          !ReserveMemory(tile->GetTupleCount() *
+                         GetHashedRowSize(tile->GetColumnCount()))) {
+        SpillHashTable(tile.get());
+      }
+
+      if (spilled_rows_ != nullptr) {
+        SpillTile(tile.get());
+      } else {
+        child_tiles_.emplace_back(tile.release());
+        HashTile(child_tiles_.size() - 1);
+      }
+    }
+
+    // Without a join to take the partitions, remove the duplicates of one
+    // partition at a time
+    if (spilled_rows_ != nullptr && partitioned_output_ == false) {
+      for (size_t partition = 0; partition < SPILL_PARTITION_COUNT;
+           partition++) {
+        auto file = spilled_rows_->ReleasePartition(partition);
+        if (file != nullptr) {
+          spilled_partitions_.emplace_back(std::move(file),
+                                           spilled_rows_->GetLevel());
         }
-        hash_table_[key].insert(
-                    std::make_pair(child_tile_itr, tuple_id));
       }
+      spilled_rows_.reset();
     }
 
     done_ = true;
   }
 
   // Return logical tiles one at a time
-  while (result_itr < child_tiles_.size()) {
-    if (child_tiles_[result_itr]->GetTupleCount() == 0) {
-      result_itr++;
+  do {
+    while (result_itr < child_tiles_.size()) {
+      if (child_tiles_[result_itr]->GetTupleCount() == 0) {
+        result_itr++;
+        continue;
+      } else {
+        SetOutput(child_tiles_[result_itr++].release());
+        LOG_TRACE("Hash Executor : true -- return tile one at a time ");
+        return true;
+      }
+    }
+  } while (LoadSpilledPartition());
+
+  LOG_TRACE("Hash Executor : false -- done ");
+  return false;
+}
+
+size_t HashExecutor::GetHashedRowSize(oid_t column_count) {
+  // The hash table entry, the location in its set with the set's node and
+  // bucket pointers, and the position lists of the logical tile
+  return sizeof(HashMapType::value_type) + sizeof(std::pair<size_t, oid_t>) +
+         4 * sizeof(void *) + column_count * sizeof(oid_t);
+}
+
+void HashExecutor::HashTile(size_t child_tile_itr) {
+  auto tile = child_tiles_[child_tile_itr].get();
+
+  // Go over all tuples in the logical tile
+  for (oid_t tuple_id : *tile) {
+    // Key : container tuple with a subset of tuple attributes
+    // Value : < child_tile offset, tuple offset >
+    auto key = HashMapType::key_type(tile, tuple_id, &column_ids_);
+    if (hash_table_.find(key) != hash_table_.end()) {
+      // If data is already present, remove from output
+      // but leave data for hash joins.
+      tile->RemoveVisibility(tuple_id);
+    }
+    hash_table_[key].insert(std::make_pair(child_tile_itr, tuple_id));
+  }
+}
+
+void HashExecutor::SpillHashTable(const LogicalTile *tile) {
+  LOG_DEBUG("Hash table of %lu tiles does not fit in memory, spilling",
+            child_tiles_.size());
+  spilled_schema_.reset(tile->GetPhysicalSchema());
+  spilled_rows_.reset(new SpillPartitions(0));
+
+  // Every row, including the duplicates hidden from the output
+  for (auto &entry : hash_table_) {
+    for (auto &location : entry.second) {
+      auto child_tile = child_tiles_[location.first].get();
+      const expression::ContainerTuple<LogicalTile> tuple(child_tile,
+                                                          location.second);
+      spilled_rows_->Add(&tuple, child_tile->GetColumnCount(), column_ids_);
+    }
+  }
+
+  ClearHashTable();
+}
+
+void HashExecutor::SpillTile(LogicalTile *tile) {
+  for (oid_t tuple_id : *tile) {
+    const expression::ContainerTuple<LogicalTile> tuple(tile, tuple_id);
+    spilled_rows_->Add(&tuple, tile->GetColumnCount(), column_ids_);
+  }
+}
+
+void HashExecutor::ClearHashTable() {
+  hash_table_.clear();
+  child_tiles_.clear();
+  result_itr = 0;
+
+  if (memory_reserved_ > 0) {
+    executor_context_->ReleaseMemory(memory_reserved_);
+    memory_reserved_ = 0;
+  }
+}
+
+bool HashExecutor::LoadSpilledPartition() {
+  if (spilled_partitions_.empty()) return false;
+  ClearHashTable();
+
+  while (spilled_partitions_.empty() == false) {
+    auto file = std::move(spilled_partitions_.front().first);
+    auto level = spilled_partitions_.front().second;
+    spilled_partitions_.pop_front();
+
+    // Partition it again if it does not fit either. The last level is
+    // hashed whatever the budget.
+    size_t memory =
+        file->GetSize() +
+        file->GetRowCount() *
+            GetHashedRowSize(spilled_schema_->GetColumnCount());
+    if (level < SPILL_MAX_LEVEL && !ReserveMemory(memory)) {
+      LOG_DEBUG("Partitioning %lu spilled rows of level %lu again",
+                file->GetRowCount(), level);
+      SpillPartitions partitions(level + 1);
+      std::vector<type::Value> values;
+      const expression::ContainerTuple<std::vector<type::Value>> tuple(
+          &values);
+      while (file->ReadRow(values)) {
+        partitions.Add(&tuple, values.size(), column_ids_);
+      }
+      for (size_t partition = 0; partition < SPILL_PARTITION_COUNT;
+           partition++) {
+        auto partition_file = partitions.ReleasePartition(partition);
+        if (partition_file != nullptr) {
+          spilled_partitions_.emplace_back(std::move(partition_file),
+                                           level + 1);
+        }
+      }
       continue;
-    } else {
-      SetOutput(child_tiles_[result_itr++].release());
-      LOG_TRACE("Hash Executor : true -- return tile one at a time ");
-      return true;
     }
+
+    LogicalTile *tile;
+    while ((tile = file->ReadTile(*spilled_schema_,
+                                  DEFAULT_TUPLES_PER_TILEGROUP)) != nullptr) {
+      child_tiles_.emplace_back(tile);
+      HashTile(child_tiles_.size() - 1);
+    }
+    return true;
   }
 
-  LOG_TRACE("Hash Executor : false -- done ");
   return false;
 }
 
+bool HashExecutor::ReserveMemory(size_t bytes) {
+  if (executor_context_ == nullptr) return true;
+  if (!executor_context_->ReserveMemory(bytes)) return false;
+  memory_reserved_ += bytes;
+  return true;
+}
+
 } /* namespace executor */
 } /* namespace peloton */
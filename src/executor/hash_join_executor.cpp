@@ -15,6 +15,7 @@
 
 #include "type/types.h"
 #include "common/logger.h"
+#include "executor/executor_context.h"
 #include "executor/logical_tile_factory.h"
 #include "executor/hash_join_executor.h"
 #include "expression/abstract_expression.h"
@@ -41,6 +42,7 @@ bool HashJoinExecutor::DInit() {
             PlanNodeType::HASH);
 
   hash_executor_ = reinterpret_cast<HashExecutor *>(children_[1]);
+  hash_executor_->SetPartitionedOutput();
 
   return true;
 }
@@ -55,6 +57,10 @@ bool HashJoinExecutor::DExecute() {
 
   // Loop until we have non-empty result tile or exit
   for (;;) {
+    if (spilled_ == true) {
+      return ExecuteSpilled();
+    }
+
     // Check if we have any buffered output tiles
     if (buffered_output_tiles.empty() == false) {
       auto output_tile = buffered_output_tiles.front();
@@ -78,6 +84,13 @@ bool HashJoinExecutor::DExecute() {
         BufferRightTile(children_[1]->GetOutput());
       }
       right_child_done_ = true;
+
+      // The hash table did not fit in memory
+      if (hash_executor_->IsSpilled()) {
+        SpillLeftInput();
+        spilled_ = true;
+        continue;
+      }
     }
 
     // Get next tile from LEFT child
@@ -95,95 +108,261 @@ bool HashJoinExecutor::DExecute() {
       return BuildOuterJoinOutput();
     }
 
-    LogicalTile *left_tile = left_result_tiles_.back().get();
-
     //===------------------------------------------------------------------===//
     // Build Join Tile
     //===------------------------------------------------------------------===//
 
     // Get the hash table from the hash executor
-    auto &hash_table = hash_executor_->GetHashTable();
-    auto &hashed_col_ids = hash_executor_->GetHashKeyIds();
-
-    oid_t prev_tile = INVALID_OID;
-    std::unique_ptr<LogicalTile> output_tile;
-    LogicalTile::PositionListsBuilder pos_lists_builder;
-
-    // Go over the left tile
-    for (auto left_tile_itr : *left_tile) {
-      const expression::ContainerTuple<executor::LogicalTile> left_tuple(
-          left_tile, left_tile_itr, &hashed_col_ids);
-
-      // Find matching tuples in the hash table built on top of the right table
-      auto right_tuples = hash_table.find(left_tuple);
-
-      if (right_tuples != hash_table.end()) {
-    	// Not yet supported due to assertion in gettomg right_tuples->first
-//    	if (predicate_ != nullptr) {
-//    		auto eval = predicate_->Evaluate(&left_tuple, &right_tuples->first,
-//					executor_context_);
-//			if (eval.IsFalse())
-//				continue;
-//    	}
-
-        RecordMatchedLeftRow(left_result_tiles_.size() - 1, left_tile_itr);
-
-        // Go over the matching right tuples
-        for (auto &location : right_tuples->second) {
-          // Check if we got a new right tile itr
-          if (prev_tile != location.first) {
-            // Check if we have any join tuples
-            if (pos_lists_builder.Size() > 0) {
-              LOG_TRACE("Join tile size : %lu \n", pos_lists_builder.Size());
-              output_tile->SetPositionListsAndVisibility(
-                  pos_lists_builder.Release());
-              buffered_output_tiles.push_back(output_tile.release());
-            }
-
-            // Get the logical tile from right child
-            LogicalTile *right_tile = right_result_tiles_[location.first].get();
-
-            // Build output logical tile
-            output_tile = BuildOutputLogicalTile(left_tile, right_tile);
-
-            // Build position lists
-            pos_lists_builder =
-                LogicalTile::PositionListsBuilder(left_tile, right_tile);
-
-            pos_lists_builder.SetRightSource(
-                &right_result_tiles_[location.first]->GetPositionLists());
+    ProbeLeftTile(hash_executor_->GetHashTable(),
+                  hash_executor_->GetHashKeyIds());
+
+    // Check if we have any buffered output tiles
+    if (buffered_output_tiles.empty() == false) {
+      auto output_tile = buffered_output_tiles.front();
+      SetOutput(output_tile);
+      buffered_output_tiles.pop_front();
+      return true;
+    } else {
+      // Try again
+      continue;
+    }
+  }
+}
+
+void HashJoinExecutor::ProbeLeftTile(
+    const HashExecutor::HashMapType &hash_table,
+    const std::vector<oid_t> &hashed_col_ids) {
+  LogicalTile *left_tile = left_result_tiles_.back().get();
+
+  oid_t prev_tile = INVALID_OID;
+  std::unique_ptr<LogicalTile> output_tile;
+  LogicalTile::PositionListsBuilder pos_lists_builder;
+
+  // Go over the left tile
+  for (auto left_tile_itr : *left_tile) {
+    const expression::ContainerTuple<executor::LogicalTile> left_tuple(
+        left_tile, left_tile_itr, &hashed_col_ids);
+
+    // Find matching tuples in the hash table built on top of the right table
+    auto right_tuples = hash_table.find(left_tuple);
+
+    if (right_tuples != hash_table.end()) {
+      // Not yet supported due to assertion in gettomg right_tuples->first
+      //    	if (predicate_ != nullptr) {
+      //    		auto eval = predicate_->Evaluate(&left_tuple,
+      //    &right_tuples->first,
+      //					executor_context_);
+      //			if (eval.IsFalse())
+      //				continue;
+      //    	}
+
+      RecordMatchedLeftRow(left_result_tiles_.size() - 1, left_tile_itr);
+
+      // Go over the matching right tuples
+      for (auto &location : right_tuples->second) {
+        // Check if we got a new right tile itr
+        if (prev_tile != location.first) {
+          // Check if we have any join tuples
+          if (pos_lists_builder.Size() > 0) {
+            LOG_TRACE("Join tile size : %lu \n", pos_lists_builder.Size());
+            output_tile->SetPositionListsAndVisibility(
+                pos_lists_builder.Release());
+            buffered_output_tiles.push_back(output_tile.release());
           }
 
-          // Add join tuple
-          pos_lists_builder.AddRow(left_tile_itr, location.second);
+          // Get the logical tile from right child
+          LogicalTile *right_tile = right_result_tiles_[location.first].get();
+
+          // Build output logical tile
+          output_tile = BuildOutputLogicalTile(left_tile, right_tile);
 
-          RecordMatchedRightRow(location.first, location.second);
+          // Build position lists
+          pos_lists_builder =
+              LogicalTile::PositionListsBuilder(left_tile, right_tile);
 
-          // Cache prev logical tile itr
-          prev_tile = location.first;
+          pos_lists_builder.SetRightSource(
+              &right_result_tiles_[location.first]->GetPositionLists());
         }
+
+        // Add join tuple
+        pos_lists_builder.AddRow(left_tile_itr, location.second);
+
+        RecordMatchedRightRow(location.first, location.second);
+
+        // Cache prev logical tile itr
+        prev_tile = location.first;
       }
     }
+  }
 
-    // Check if we have any join tuples
-    if (pos_lists_builder.Size() > 0) {
-      LOG_TRACE("Join tile size : %lu \n", pos_lists_builder.Size());
-      output_tile->SetPositionListsAndVisibility(pos_lists_builder.Release());
-      buffered_output_tiles.push_back(output_tile.release());
+  // Check if we have any join tuples
+  if (pos_lists_builder.Size() > 0) {
+    LOG_TRACE("Join tile size : %lu \n", pos_lists_builder.Size());
+    output_tile->SetPositionListsAndVisibility(pos_lists_builder.Release());
+    buffered_output_tiles.push_back(output_tile.release());
+  }
+}
+
+void HashJoinExecutor::SpillLeftInput() {
+  auto &hashed_col_ids = hash_executor_->GetHashKeyIds();
+  std::unique_ptr<SpillPartitions> right_rows(
+      hash_executor_->ReleaseSpilledRows());
+  SpillPartitions left_rows(right_rows->GetLevel());
+
+  while (children_[0]->Execute()) {
+    std::unique_ptr<LogicalTile> left_tile(children_[0]->GetOutput());
+    if (left_schema_ == nullptr) {
+      left_schema_.reset(left_tile->GetPhysicalSchema());
     }
+    for (oid_t left_tile_itr : *left_tile) {
+      const expression::ContainerTuple<LogicalTile> left_tuple(left_tile.get(),
+                                                               left_tile_itr);
+      left_rows.Add(&left_tuple, left_tile->GetColumnCount(), hashed_col_ids);
+    }
+  }
+  left_child_done_ = true;
+
+  LOG_DEBUG("Hash join spilled %lu left and %lu right rows",
+            left_rows.GetRowCount(), right_rows->GetRowCount());
+  for (size_t partition = 0; partition < SPILL_PARTITION_COUNT; partition++) {
+    partition_pairs_.push_back({left_rows.ReleasePartition(partition),
+                                right_rows->ReleasePartition(partition),
+                                right_rows->GetLevel()});
+  }
+}
 
+bool HashJoinExecutor::ExecuteSpilled() {
+  auto &hashed_col_ids = hash_executor_->GetHashKeyIds();
+
+  for (;;) {
     // Check if we have any buffered output tiles
     if (buffered_output_tiles.empty() == false) {
       auto output_tile = buffered_output_tiles.front();
       SetOutput(output_tile);
       buffered_output_tiles.pop_front();
-
       return true;
-    } else {
-      // Try again
+    }
+
+    if (partition_loaded_ == true) {
+      // Probe with the next left rows of the pair
+      std::unique_ptr<LogicalTile> left_tile;
+      if (left_partition_ != nullptr) {
+        left_tile.reset(left_partition_->ReadTile(
+            *left_schema_, DEFAULT_TUPLES_PER_TILEGROUP));
+      }
+      if (left_tile != nullptr) {
+        BufferLeftTile(left_tile.release());
+        ProbeLeftTile(partition_hash_table_, hashed_col_ids);
+        continue;
+      }
+
+      // Then the rows of the pair without a match
+      if (BuildOuterJoinOutput()) {
+        return true;
+      }
+      UnloadPartitionPair();
       continue;
     }
+
+    if (partition_pairs_.empty()) {
+      return false;
+    }
+
+    PartitionPair pair = std::move(partition_pairs_.front());
+    partition_pairs_.pop_front();
+    LoadPartitionPair(pair);
+  }
+}
+
+void HashJoinExecutor::LoadPartitionPair(PartitionPair &pair) {
+  bool left_outer =
+      (join_type_ == JoinType::LEFT || join_type_ == JoinType::OUTER);
+  bool right_outer =
+      (join_type_ == JoinType::RIGHT || join_type_ == JoinType::OUTER);
+
+  // Skip the pairs without output
+  bool has_output = (pair.left != nullptr && pair.right != nullptr) ||
+                    (pair.left != nullptr && left_outer) ||
+                    (pair.right != nullptr && right_outer);
+  if (has_output == false) {
+    return;
+  }
+
+  if (pair.right != nullptr) {
+    auto right_schema = hash_executor_->GetSpilledSchema();
+    size_t memory = pair.right->GetSize() +
+                    pair.right->GetRowCount() *
+                        HashExecutor::GetHashedRowSize(
+                            right_schema->GetColumnCount());
+
+    // Partition the pair again if the right rows do not fit either. The last
+    // level is hashed whatever the budget.
+    if (executor_context_ != nullptr) {
+      if (executor_context_->ReserveMemory(memory)) {
+        partition_memory_ = memory;
+      } else if (pair.level < SPILL_MAX_LEVEL) {
+        RepartitionPair(pair);
+        return;
+      }
+    }
+
+    LogicalTile *right_tile;
+    while ((right_tile = pair.right->ReadTile(
+                *right_schema, DEFAULT_TUPLES_PER_TILEGROUP)) != nullptr) {
+      BufferRightTile(right_tile);
+      size_t right_tile_itr = right_result_tiles_.size() - 1;
+      for (oid_t tuple_id : *right_tile) {
+        auto key = HashExecutor::HashMapType::key_type(
+            right_tile, tuple_id, &hash_executor_->GetHashKeyIds());
+        partition_hash_table_[key].insert(
+            std::make_pair(right_tile_itr, tuple_id));
+      }
+    }
+  }
+
+  left_partition_ = std::move(pair.left);
+  partition_loaded_ = true;
+}
+
+void HashJoinExecutor::RepartitionPair(PartitionPair &pair) {
+  auto &hashed_col_ids = hash_executor_->GetHashKeyIds();
+  LOG_DEBUG("Partitioning %lu spilled right rows of level %lu again",
+            pair.right->GetRowCount(), pair.level);
+
+  SpillPartitions left_rows(pair.level + 1);
+  SpillPartitions right_rows(pair.level + 1);
+  std::vector<type::Value> values;
+  const expression::ContainerTuple<std::vector<type::Value>> tuple(&values);
+  while (pair.left != nullptr && pair.left->ReadRow(values)) {
+    left_rows.Add(&tuple, values.size(), hashed_col_ids);
+  }
+  while (pair.right->ReadRow(values)) {
+    right_rows.Add(&tuple, values.size(), hashed_col_ids);
+  }
+
+  for (size_t partition = 0; partition < SPILL_PARTITION_COUNT; partition++) {
+    partition_pairs_.push_back({left_rows.ReleasePartition(partition),
+                                right_rows.ReleasePartition(partition),
+                                pair.level + 1});
+  }
+}
+
+void HashJoinExecutor::UnloadPartitionPair() {
+  partition_hash_table_.clear();
+  left_partition_.reset();
+
+  left_result_tiles_.clear();
+  right_result_tiles_.clear();
+  no_matching_left_row_sets_.clear();
+  no_matching_right_row_sets_.clear();
+  left_matching_idx = 0;
+  right_matching_idx = 0;
+
+  if (partition_memory_ > 0) {
+    executor_context_->ReleaseMemory(partition_memory_);
+    partition_memory_ = 0;
   }
+  partition_loaded_ = false;
 }
 
 }  // namespace executor
@@ -17,6 +17,7 @@
 #include "common/logger.h"
 #include "type/value.h"
 #include "executor/logical_tile.h"
+#include "executor/executor_context.h"
 #include "executor/hash_set_op_executor.h"
 
 #include "planner/set_op_plan.h"
@@ -31,6 +32,12 @@ HashSetOpExecutor::HashSetOpExecutor(const planner::AbstractPlan *node,
                                      ExecutorContext *executor_context)
     : AbstractExecutor(node, executor_context) {}
 
+HashSetOpExecutor::~HashSetOpExecutor() {
+  if (memory_charged_ > 0) {
+    executor_context_->ReleaseMemory(memory_charged_);
+  }
+}
+
 /**
  * @brief Do some basic checks and initialize executor state.
  * @return true on success, false otherwise.
@@ -85,6 +92,20 @@ bool HashSetOpExecutor::ExecuteHelper() {
     }
   }
 
+  // The hash table entries with their node and bucket pointers, and the
+  // position lists of the left tiles
+  if (executor_context_ != nullptr) {
+    size_t memory = htable_.size() * (sizeof(HashSetOpMapType::value_type) +
+                                      2 * sizeof(void *));
+    for (auto &tile : left_tiles_) {
+      for (auto &position_list : tile->GetPositionLists()) {
+        memory += position_list.size() * sizeof(oid_t);
+      }
+    }
+    executor_context_->ChargeMemory(memory);
+    memory_charged_ += memory;
+  }
+
   // Scan the right child's input and update counter when appropriate
   while (children_[1]->Execute()) {
     // Each right tile can be destroyed after processing
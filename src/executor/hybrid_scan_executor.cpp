@@ -170,6 +170,8 @@ bool HybridScanExecutor::DInit() {
     throw Exception("Invalid hybrid scan type : " + HybridScanTypeToString(type_));
   }
 
+  zone_map_filter_.Init(predicate_, executor_context_);
+
   return true;
 }
 
@@ -191,6 +193,12 @@ bool HybridScanExecutor::SeqScanUtil() {
   while (current_tile_group_offset_ < table_tile_group_count_) {
     LOG_TRACE("Current tile group offset : %u", current_tile_group_offset_);
     auto tile_group = table_->GetTileGroup(current_tile_group_offset_++);
+
+    // Skip tile groups whose values cannot satisfy the predicate
+    if (zone_map_filter_.MayMatch(tile_group.get()) == false) {
+      continue;
+    }
+
     auto tile_group_header = tile_group->GetHeader();
 
     oid_t active_tuple_count = tile_group->GetNextTupleSlot();
@@ -642,8 +642,6 @@ bool IndexScanExecutor::CheckKeyConditions(const ItemPointer &tuple_location) {
   auto &manager = catalog::Manager::GetInstance();
 
   auto tile_group = manager.GetTileGroup(tuple_location.block);
-  expression::ContainerTuple<storage::TileGroup> tuple(tile_group.get(),
-                                                       tuple_location.offset);
 
   // This is the end of loop
   oid_t cond_num = key_column_ids_.size();
@@ -660,8 +658,10 @@ bool IndexScanExecutor::CheckKeyConditions(const ItemPointer &tuple_location) {
     // This the comparison right hand side operand
     const type::Value &rhs = values_[i];
 
-    // Also retrieve left hand side operand using index key column ID
-    type::Value val = (tuple.GetValue(tuple_key_column_id));
+    // Also retrieve left hand side operand using index key column ID,
+    // read at its precomputed location in the tile group
+    type::Value val = tile_group->GetColumnAccessor(tuple_key_column_id)
+                          .GetValue(tuple_location.offset);
     const type::Value &lhs = val;
 
     // Expression type. We use this to interpret comparison result
@@ -589,19 +589,11 @@ void LogicalTile::MaterializeRowAtAtATime(
 
     auto &column_position_lists = GetPositionLists();
 
-    // Get old column information
+    // Amortize schema lookups once per column
     std::vector<oid_t> old_column_position_idxs;
-    std::vector<size_t> old_column_offsets;
-    std::vector<type::Type::TypeId> old_column_types;
-    std::vector<bool> old_is_inlineds;
-    std::vector<storage::Tile *> old_tiles;
-
-    // Get new column information
-    std::vector<size_t> new_column_offsets;
-    std::vector<bool> new_is_inlineds;
-    std::vector<size_t> new_column_lengths;
+    std::vector<storage::ColumnAccessor> old_columns;
+    std::vector<storage::ColumnAccessor> new_columns;
 
-    // Amortize schema lookups once per column
     for (oid_t old_col_id : old_column_ids) {
       auto &column_info = schema[old_col_id];
 
@@ -609,41 +601,24 @@ void LogicalTile::MaterializeRowAtAtATime(
       old_column_position_idxs.push_back(column_info.position_list_idx);
 
       // Get old column information
-      storage::Tile *old_tile = column_info.base_tile.get();
-      old_tiles.push_back(old_tile);
-      auto old_schema = old_tile->GetSchema();
-      oid_t old_column_id = column_info.origin_column_id;
-      const size_t old_column_offset = old_schema->GetOffset(old_column_id);
-      old_column_offsets.push_back(old_column_offset);
-      const type::Type::TypeId old_column_type =
-          old_schema->GetType(old_column_id);
-      old_column_types.push_back(old_column_type);
-      const bool old_is_inlined = old_schema->IsInlined(old_column_id);
-      old_is_inlineds.push_back(old_is_inlined);
+      old_columns.push_back(column_info.base_tile->GetColumnAccessor(
+          column_info.origin_column_id));
 
       // Old to new column mapping
       auto it = old_to_new_cols.find(old_col_id);
       PL_ASSERT(it != old_to_new_cols.end());
 
       // Get new column information
-      oid_t new_column_id = it->second;
-      auto new_schema = dest_tile->GetSchema();
-      const size_t new_column_offset = new_schema->GetOffset(new_column_id);
-      new_column_offsets.push_back(new_column_offset);
-      const bool new_is_inlined = new_schema->IsInlined(new_column_id);
-      new_is_inlineds.push_back(new_is_inlined);
-      const size_t new_column_length =
-          new_schema->GetAppropriateLength(new_column_id);
-      new_column_lengths.push_back(new_column_length);
+      new_columns.push_back(dest_tile->GetColumnAccessor(it->second));
     }
 
-    PL_ASSERT(new_column_offsets.size() == old_column_ids.size());
+    PL_ASSERT(new_columns.size() == old_column_ids.size());
 
     ///////////////////////////
     // EACH TUPLE
     ///////////////////////////
     // Copy all values in the tuple to the physical tile
-    // This uses fast getter and setter functions
+    // Fields are copied at fixed offsets without building values
     for (oid_t old_tuple_id : *this) {
       ///////////////////////////
       // EACH COLUMN
@@ -656,17 +631,11 @@ void LogicalTile::MaterializeRowAtAtATime(
 
         oid_t base_tuple_id = column_position_list[old_tuple_id];
 
-        auto value = old_tiles[col_itr]->GetValueFast(
-            base_tuple_id, old_column_offsets[col_itr],
-            old_column_types[col_itr], old_is_inlineds[col_itr]);
-
         LOG_TRACE("Old Tuple : %u Column : %u ", old_tuple_id, old_col_id);
-        LOG_TRACE("New Tuple : %u Column : %lu ", new_tuple_id,
-                  new_column_offsets[col_itr]);
+        LOG_TRACE("New Tuple : %u Column : %u ", new_tuple_id, col_itr);
 
-        dest_tile->SetValueFast(
-            value, new_tuple_id, new_column_offsets[col_itr],
-            new_is_inlineds[col_itr], new_column_lengths[col_itr]);
+        MaterializeField(new_columns[col_itr], new_tuple_id,
+                         old_columns[col_itr], base_tuple_id);
 
         // Go to next column
         col_itr++;
@@ -697,15 +666,8 @@ void LogicalTile::MaterializeColumnAtATime(
       auto &column_info = GetColumnInfo(old_col_id);
 
       // Amortize schema lookups once per column
-      storage::Tile *old_tile = column_info.base_tile.get();
-      auto old_schema = old_tile->GetSchema();
-
-      // Get old column information
-      oid_t old_column_id = column_info.origin_column_id;
-      const size_t old_column_offset = old_schema->GetOffset(old_column_id);
-      const type::Type::TypeId old_column_type =
-          old_schema->GetType(old_column_id);
-      const bool old_is_inlined = old_schema->IsInlined(old_column_id);
+      auto old_column = column_info.base_tile->GetColumnAccessor(
+          column_info.origin_column_id);
 
       // Old to new column mapping
       auto it = old_to_new_cols.find(old_col_id);
@@ -713,11 +675,7 @@ void LogicalTile::MaterializeColumnAtATime(
 
       // Get new column information
       oid_t new_column_id = it->second;
-      auto new_schema = dest_tile->GetSchema();
-      const size_t new_column_offset = new_schema->GetOffset(new_column_id);
-      const bool new_is_inlined = new_schema->IsInlined(new_column_id);
-      const size_t new_column_length =
-          new_schema->GetAppropriateLength(new_column_id);
+      auto new_column = dest_tile->GetColumnAccessor(new_column_id);
 
       // Get the position list
       auto &column_position_list =
@@ -725,20 +683,17 @@ void LogicalTile::MaterializeColumnAtATime(
       oid_t new_tuple_id = 0;
 
       // Copy all values in the column to the physical tile
-      // This uses fast getter and setter functions
+      // Fields are copied at fixed offsets without building values
       ///////////////////////////
       // EACH TUPLE
       ///////////////////////////
       for (oid_t old_tuple_id : *this) {
         oid_t base_tuple_id = column_position_list[old_tuple_id];
-        type::Value value = (old_tile->GetValueFast(
-            base_tuple_id, old_column_offset, old_column_type, old_is_inlined));
 
         LOG_TRACE("Old Tuple : %u Column : %u ", old_tuple_id, old_col_id);
         LOG_TRACE("New Tuple : %u Column : %u ", new_tuple_id, new_column_id);
 
-        dest_tile->SetValueFast(value, new_tuple_id, new_column_offset,
-                                new_is_inlined, new_column_length);
+        MaterializeField(new_column, new_tuple_id, old_column, base_tuple_id);
 
         // Go to next tuple
         new_tuple_id++;
@@ -747,6 +702,19 @@ void LogicalTile::MaterializeColumnAtATime(
   }
 }
 
+// Rows padded by outer joins have no base tuple and materialize as NULL
+void LogicalTile::MaterializeField(const storage::ColumnAccessor &dest_column,
+                                   oid_t new_tuple_id,
+                                   const storage::ColumnAccessor &old_column,
+                                   oid_t base_tuple_id) {
+  if (base_tuple_id == NULL_OID) {
+    dest_column.SetValue(new_tuple_id, type::ValueFactory::GetNullValueByType(
+                                           dest_column.GetType()));
+  } else {
+    dest_column.CopyField(new_tuple_id, old_column, base_tuple_id);
+  }
+}
+
 /**
  * @brief Create a physical tile
  * @param
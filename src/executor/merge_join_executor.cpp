@@ -15,14 +15,59 @@
 
 #include "type/types.h"
 #include "common/logger.h"
+#include "executor/executor_context.h"
 #include "executor/logical_tile_factory.h"
 #include "executor/merge_join_executor.h"
+#include "executor/normalized_key.h"
+#include "executor/parallel_sort.h"
 #include "expression/abstract_expression.h"
 #include "common/container_tuple.h"
 
 namespace peloton {
 namespace executor {
 
+namespace {
+
+bool IsIntegerType(type::Type::TypeId type_id) {
+  return type_id == type::Type::TINYINT || type_id == type::Type::SMALLINT ||
+         type_id == type::Type::INTEGER || type_id == type::Type::BIGINT;
+}
+
+// Normalized keys of different types do not compare, so both sides of a
+// join clause are cast to a common type
+type::Type::TypeId GetKeyType(type::Type::TypeId left_type,
+                              type::Type::TypeId right_type) {
+  if (left_type == right_type) return left_type;
+  if (left_type == type::Type::DECIMAL || right_type == type::Type::DECIMAL) {
+    return type::Type::DECIMAL;
+  }
+  if (IsIntegerType(left_type) && IsIntegerType(right_type)) {
+    return type::Type::BIGINT;
+  }
+  return left_type;
+}
+
+// Memory of the position lists of a buffered logical tile
+size_t GetTileMemory(const LogicalTile *tile) {
+  size_t memory = 0;
+  for (auto &position_list : tile->GetPositionLists()) {
+    memory += position_list.size() * sizeof(oid_t);
+  }
+  return memory;
+}
+
+// Memory of the join keys of one side
+template <typename JoinKey>
+size_t GetKeyMemory(const std::vector<JoinKey> &join_keys) {
+  size_t memory = join_keys.capacity() * sizeof(JoinKey);
+  for (auto &join_key : join_keys) {
+    memory += join_key.key.capacity();
+  }
+  return memory;
+}
+
+}  // namespace
+
 /**
  * @brief Constructor for nested loop join executor.
  * @param node Nested loop join node corresponding to this executor.
@@ -33,6 +78,8 @@ MergeJoinExecutor::MergeJoinExecutor(const planner::AbstractPlan *node,
   join_clauses_ = nullptr;
 }
 
+MergeJoinExecutor::~MergeJoinExecutor() { ReleaseMemory(memory_charged_); }
+
 bool MergeJoinExecutor::DInit() {
   auto status = AbstractJoinExecutor::DInit();
   if (status == false) return status;
@@ -43,246 +90,281 @@ bool MergeJoinExecutor::DInit() {
 
   if (join_clauses_ == nullptr) return false;
 
+  key_types_.clear();
+  for (auto &clause : *join_clauses_) {
+    key_types_.push_back(GetKeyType(clause.left_->GetValueType(),
+                                    clause.right_->GetValueType()));
+  }
+
+  join_done_ = false;
+  matched_rows_.clear();
+  next_matched_row_ = 0;
+  ReleaseMemory(memory_charged_);
+
   return true;
 }
 
 /**
  * @brief Creates logical tiles from the two input logical tiles after applying
- * join predicate.
+ * join predicate. Every output tile holds a run of matched rows, in join key
+ * order, that come from the same pair of input tiles.
  * @return true on success, false otherwise.
  */
 bool MergeJoinExecutor::DExecute() {
-  LOG_TRACE(
-      "********** Merge Join executor :: 2 children "
-      "left:: start: %lu, end: %lu, done: %d "
-      "right:: start: %lu, end: %lu, done: %d",
-      left_start_row, left_end_row, left_child_done_, right_start_row,
-      right_end_row, right_child_done_);
+  LOG_TRACE("********** Merge Join executor :: 2 children ");
 
-  // Build outer join output when done
-  if (right_child_done_ && left_child_done_) {
-    return BuildOuterJoinOutput();
-  }
-
-  //===--------------------------------------------------------------------===//
-  // Pick right and left tiles
-  //===--------------------------------------------------------------------===//
-
-  // Try to get next tile from RIGHT child
-  if (((right_child_done_ == false) && (right_start_row == right_end_row)) ||
-      (left_child_done_ == true)) {
-    if (children_[1]->Execute() == false) {
-      LOG_TRACE("Did not get right tile ");
-      right_child_done_ = true;
-      // Try again
-      return DExecute();
+  if (!join_done_) {
+    while (children_[0]->Execute()) {
+      BufferLeftTile(children_[0]->GetOutput());
+      ChargeMemory(GetTileMemory(left_result_tiles_.back().get()));
     }
+    left_child_done_ = true;
 
-    LOG_TRACE("Got right tile ");
-
-    auto right_tile = children_[1]->GetOutput();
-    BufferRightTile(right_tile);
-
-    right_start_row = 0;
-    right_end_row = Advance(right_tile, right_start_row, false);
-    LOG_TRACE("size of right tiles: %lu", right_result_tiles_.size());
-  }
-
-  // Try to get next tile from LEFT child
-  if (((left_child_done_ == false) && (left_start_row == left_end_row)) ||
-      (right_child_done_ == true)) {
-    if (children_[0]->Execute() == false) {
-      LOG_TRACE("Did not get left tile ");
-      left_child_done_ = true;
-      // if we know the join type is left join, we don't have to get the
-      // tiles from right child anymore.
-      if (join_type_ == JoinType::LEFT || join_type_ == JoinType::INNER) {
-        return BuildOuterJoinOutput();
-      } else {
-        // otherwise, try again
-        return DExecute();
-      }
-
-      // Try again
-      return DExecute();
+    while (children_[1]->Execute()) {
+      BufferRightTile(children_[1]->GetOutput());
+      ChargeMemory(GetTileMemory(right_result_tiles_.back().get()));
     }
+    right_child_done_ = true;
 
-    LOG_TRACE("Got left tile ");
-
-    auto left_tile = children_[0]->GetOutput();
-    BufferLeftTile(left_tile);
-
-    left_start_row = 0;
-    left_end_row = Advance(left_tile, left_start_row, true);
-    LOG_TRACE("size of left tiles: %lu", left_result_tiles_.size());
-  }
-
-  // Check if we have logical tiles to process
-  if (left_result_tiles_.empty() || right_result_tiles_.empty()) {
-    return BuildOuterJoinOutput();
+    LOG_TRACE("size of left tiles: %lu, size of right tiles: %lu",
+              left_result_tiles_.size(), right_result_tiles_.size());
+    Join();
+    join_done_ = true;
   }
 
-  LogicalTile *left_tile = left_result_tiles_.back().get();
-  LogicalTile *right_tile = right_result_tiles_.back().get();
-
-  //===--------------------------------------------------------------------===//
-  // Build Join Tile
-  //===--------------------------------------------------------------------===//
-
-  // Build output logical tile
-  auto output_tile = BuildOutputLogicalTile(left_tile, right_tile);
-
-  // Build position lists
-  LogicalTile::PositionListsBuilder pos_lists_builder(left_tile, right_tile);
-
-  while ((left_end_row > left_start_row) && (right_end_row > right_start_row)) {
-    expression::ContainerTuple<executor::LogicalTile> left_tuple(
-        left_tile, left_start_row);
-    expression::ContainerTuple<executor::LogicalTile> right_tuple(
-        right_tile, right_start_row);
-    bool not_matching_tuple_pair = false;
-
-    // Evaluate and compare the join clauses
-    for (auto &clause : *join_clauses_) {
-      auto left_value =
-          clause.left_->Evaluate(&left_tuple, &right_tuple, nullptr);
-      auto right_value =
-          clause.right_->Evaluate(&left_tuple, &right_tuple, nullptr);
-
-      // Left key < Right key, advance left
-      if (left_value.CompareLessThan(right_value) == type::CMP_TRUE) {
-        LOG_TRACE("left < right, advance left ");
-        left_start_row = left_end_row;
-        left_end_row = Advance(left_tile, left_start_row, true);
-        not_matching_tuple_pair = true;
-        break;
-      }
-      // Left key > Right key, advance right
-      else if (left_value.CompareGreaterThan(right_value) == type::CMP_TRUE) {
-        LOG_TRACE("left > right, advance right ");
-        right_start_row = right_end_row;
-        right_end_row = Advance(right_tile, right_start_row, false);
-        not_matching_tuple_pair = true;
+  if (next_matched_row_ < matched_rows_.size()) {
+    auto &first_row = matched_rows_[next_matched_row_];
+    LogicalTile *left_tile = left_result_tiles_[first_row.left_tile_idx].get();
+    LogicalTile *right_tile =
+        right_result_tiles_[first_row.right_tile_idx].get();
+
+    // Build output logical tile
+    auto output_tile = BuildOutputLogicalTile(left_tile, right_tile);
+
+    // Build position lists
+    LogicalTile::PositionListsBuilder pos_lists_builder(left_tile, right_tile);
+    while (next_matched_row_ < matched_rows_.size()) {
+      auto &row = matched_rows_[next_matched_row_];
+      if (row.left_tile_idx != first_row.left_tile_idx ||
+          row.right_tile_idx != first_row.right_tile_idx) {
         break;
       }
-
-      // Left key == Right key, go and check next join clause
+      pos_lists_builder.AddRow(row.left_row_idx, row.right_row_idx);
+      next_matched_row_++;
     }
 
-    // At least one of the join clauses don't match
-    // One of the tile has been advanced
-    if (not_matching_tuple_pair) {
-      continue;
-    }
+    output_tile->SetPositionListsAndVisibility(pos_lists_builder.Release());
+    SetOutput(output_tile.release());
+    return true;
+  }
 
-    // Join clauses matched, try to match predicate
-    LOG_TRACE("one pair of tuples matches join clause ");
-
-    // Join predicate exists
-    if (predicate_ != nullptr) {
-      auto eval = predicate_->Evaluate(&left_tuple,
-                                      &right_tuple, executor_context_);
-      if (eval.IsFalse()) {
-      //if (predicate_->Evaluate(&left_tuple, &right_tuple, executor_context_)
-      //        .IsFalse()) {
-        // Join predicate is false. Advance both.
-        left_start_row = left_end_row;
-        left_end_row = Advance(left_tile, left_start_row, true);
-
-        right_start_row = right_end_row;
-        right_end_row = Advance(right_tile, right_start_row, false);
-      }
-    }
+  // Build outer join output when done
+  return BuildOuterJoinOutput();
+}
 
-    // Sub tile matched, do a Cartesian product
-    // Go over every pair of tuples in left and right logical tiles
-    for (size_t left_tile_row_itr = left_start_row;
-         left_tile_row_itr < left_end_row; left_tile_row_itr++) {
-      for (size_t right_tile_row_itr = right_start_row;
-           right_tile_row_itr < right_end_row; right_tile_row_itr++) {
-        // Insert a tuple into the output logical tile
-        pos_lists_builder.AddRow(left_tile_row_itr, right_tile_row_itr);
-
-        RecordMatchedLeftRow(left_result_tiles_.size() - 1, left_tile_row_itr);
-        RecordMatchedRightRow(right_result_tiles_.size() - 1,
-                              right_tile_row_itr);
+/**
+ * @brief Evaluate the join clauses for every row of the buffered tiles of one
+ * side, and sort the resulting keys unless the input already was. The tiles
+ * are divided among the workers in contiguous ranges, so sorted input stays
+ * sorted.
+ */
+void MergeJoinExecutor::BuildJoinKeys(bool is_left,
+                                      std::vector<JoinKey> &join_keys) {
+  auto &tiles = is_left ? left_result_tiles_ : right_result_tiles_;
+  size_t partition_count = std::min(GetSortWorkerCount(), tiles.size());
+  std::vector<std::vector<JoinKey>> partition_keys(partition_count);
+
+  RunPartitions(partition_count, [&](size_t partition) {
+    auto context = CreateWorkerContext();
+    size_t tile_begin = partition * tiles.size() / partition_count;
+    size_t tile_end = (partition + 1) * tiles.size() / partition_count;
+    for (size_t tile_idx = tile_begin; tile_idx < tile_end; tile_idx++) {
+      LogicalTile *tile = tiles[tile_idx].get();
+      for (oid_t row_idx : *tile) {
+        expression::ContainerTuple<LogicalTile> tuple(tile, row_idx);
+        JoinKey join_key;
+        join_key.tile_idx = tile_idx;
+        join_key.row_idx = row_idx;
+
+        bool is_null = false;
+        for (size_t clause_idx = 0; clause_idx < join_clauses_->size();
+             clause_idx++) {
+          auto &clause = (*join_clauses_)[clause_idx];
+          auto expr = is_left ? clause.left_.get() : clause.right_.get();
+          auto value = expr->Evaluate(&tuple, &tuple, context.get());
+          if (value.IsNull()) {
+            is_null = true;
+            break;
+          }
+
+          auto key_type = key_types_[clause_idx];
+          if (key_type != type::Type::INVALID &&
+              value.GetTypeId() != key_type) {
+            NormalizedKey::Append(value.CastAs(key_type), false, join_key.key);
+          } else {
+            NormalizedKey::Append(value, false, join_key.key);
+          }
+        }
+
+        if (!is_null) partition_keys[partition].push_back(std::move(join_key));
       }
     }
+  });
 
-    // Then, advance both if necessary
-    right_start_row = right_end_row;
-    right_end_row = Advance(right_tile, right_start_row, false);
+  join_keys.clear();
+  for (auto &keys : partition_keys) {
+    join_keys.insert(join_keys.end(), std::make_move_iterator(keys.begin()),
+                     std::make_move_iterator(keys.end()));
+  }
 
-    if (right_start_row != right_end_row) {
-      left_start_row = left_end_row;
-      left_end_row = Advance(left_tile, left_start_row, true);
-    }
+  if (!std::is_sorted(join_keys.begin(), join_keys.end())) {
+    LOG_TRACE("Sorting %lu %s join keys", join_keys.size(),
+              is_left ? "left" : "right");
+    ParallelSort(join_keys);
   }
+}
 
-  // Check if we have any join tuples.
-  if (pos_lists_builder.Size() > 0) {
-    output_tile->SetPositionListsAndVisibility(pos_lists_builder.Release());
-    SetOutput(output_tile.release());
-    return true;
+/**
+ * @brief Cut the sorted left keys into ranges of equal size, and merge every
+ * range concurrently with the right keys from its first to its last key.
+ * A run of equal keys may be cut, its parts then join the same right keys.
+ * Without join clauses all keys are equal, and every worker joins its range
+ * of left rows with all right rows.
+ */
+void MergeJoinExecutor::Join() {
+  BuildJoinKeys(true, left_keys_);
+  BuildJoinKeys(false, right_keys_);
+  size_t key_memory = GetKeyMemory(left_keys_) + GetKeyMemory(right_keys_);
+  ChargeMemory(key_memory);
+
+  size_t partition_count = std::max(
+      size_t(1), std::min(GetSortWorkerCount(),
+                          left_keys_.size() / PARALLEL_SORT_MIN_PARTITION_SIZE));
+  std::vector<size_t> left_bounds(partition_count + 1);
+  for (size_t partition = 0; partition <= partition_count; partition++) {
+    left_bounds[partition] = partition * left_keys_.size() / partition_count;
   }
-  // Try again
-  else {
-    // If we are out of any more pairs of child tiles to examine,
-    // then we will return false earlier in this function
-    // So, no need to return false here
-    DExecute();
+
+  std::vector<MatchedRows> partition_rows(partition_count);
+  RunPartitions(partition_count, [&](size_t partition) {
+    size_t left_begin = left_bounds[partition];
+    size_t left_end = left_bounds[partition + 1];
+    if (left_begin == left_end) return;
+
+    size_t right_begin =
+        std::lower_bound(right_keys_.begin(), right_keys_.end(),
+                         left_keys_[left_begin]) -
+        right_keys_.begin();
+    size_t right_end =
+        std::upper_bound(right_keys_.begin(), right_keys_.end(),
+                         left_keys_[left_end - 1]) -
+        right_keys_.begin();
+
+    auto context = CreateWorkerContext();
+    JoinRange(left_begin, left_end, right_begin, right_end, context.get(),
+              partition_rows[partition]);
+  });
+
+  // The ranges follow each other in key order
+  for (auto &matched_rows : partition_rows) {
+    for (auto &row : matched_rows) {
+      RecordMatchedLeftRow(row.left_tile_idx, row.left_row_idx);
+      RecordMatchedRightRow(row.right_tile_idx, row.right_row_idx);
+    }
+    matched_rows_.insert(matched_rows_.end(), matched_rows.begin(),
+                         matched_rows.end());
+    MatchedRows().swap(matched_rows);
   }
+  next_matched_row_ = 0;
+  ChargeMemory(matched_rows_.capacity() * sizeof(MatchedRow));
 
-  return true;
+  std::vector<JoinKey>().swap(left_keys_);
+  std::vector<JoinKey>().swap(right_keys_);
+  ReleaseMemory(key_memory);
+}
+
+void MergeJoinExecutor::ChargeMemory(size_t bytes) {
+  if (executor_context_ == nullptr) return;
+  executor_context_->ChargeMemory(bytes);
+  memory_charged_ += bytes;
+}
+
+void MergeJoinExecutor::ReleaseMemory(size_t bytes) {
+  if (bytes == 0) return;
+  PL_ASSERT(memory_charged_ >= bytes);
+  executor_context_->ReleaseMemory(bytes);
+  memory_charged_ -= bytes;
 }
 
 /**
- * @brief Advance the row iterator until value changes in terms of the join
- * clauses
- * @return the end row number, [start_row, end_row) are the rows of the same
- * value
- *         if the end_row == start_row, the subset is empty
+ * @brief A context of its own for a worker, with the transaction and the
+ * parameters of the query's context. The pool of the query's context is not
+ * thread safe.
  */
-size_t MergeJoinExecutor::Advance(LogicalTile *tile, size_t start_row,
-                                  bool is_left) {
-  size_t end_row = start_row + 1;
-  size_t this_row = start_row;
-  size_t tuple_count = tile->GetTupleCount();
-  if (start_row >= tuple_count) return start_row;
-
-  while (end_row < tuple_count) {
-    expression::ContainerTuple<executor::LogicalTile> this_tuple(tile,
-                                                                 this_row);
-    expression::ContainerTuple<executor::LogicalTile> next_tuple(tile, end_row);
-
-    bool diff = false;
-
-    for (auto &clause : *join_clauses_) {
-      // Go through each join clauses
-      auto expr = is_left ? clause.left_.get() : clause.right_.get();
-      auto this_value =
-          expr->Evaluate(&this_tuple, &this_tuple, executor_context_);
-      auto next_value =
-          expr->Evaluate(&next_tuple, &next_tuple, executor_context_);
-
-      if (!(this_value.CompareEquals(next_value) == type::CMP_TRUE)) {
-        diff = true;
-        break;
-      }
+std::unique_ptr<ExecutorContext> MergeJoinExecutor::CreateWorkerContext()
+    const {
+  if (executor_context_ == nullptr) return nullptr;
+  return std::unique_ptr<ExecutorContext>(new ExecutorContext(
+      executor_context_->GetTransaction(), executor_context_->GetParams()));
+}
+
+void MergeJoinExecutor::JoinRange(size_t left_begin, size_t left_end,
+                                  size_t right_begin, size_t right_end,
+                                  ExecutorContext *context,
+                                  MatchedRows &matched_rows) const {
+  size_t left_itr = left_begin;
+  size_t right_itr = right_begin;
+
+  while (left_itr < left_end && right_itr < right_end) {
+    int result = left_keys_[left_itr].key.compare(right_keys_[right_itr].key);
+    if (result < 0) {
+      left_itr++;
+      continue;
+    }
+    if (result > 0) {
+      right_itr++;
+      continue;
     }
 
-    if (diff) {
-      break;
+    // Rows with the same key on both sides
+    size_t left_group_end = left_itr + 1;
+    while (left_group_end < left_end &&
+           left_keys_[left_group_end].key == left_keys_[left_itr].key) {
+      left_group_end++;
+    }
+    size_t right_group_end = right_itr + 1;
+    while (right_group_end < right_end &&
+           right_keys_[right_group_end].key == right_keys_[right_itr].key) {
+      right_group_end++;
     }
 
-    // the two tuples are the same, we advance by 1
-    this_row = end_row;
-    end_row++;
-  }
+    for (size_t left_row = left_itr; left_row < left_group_end; left_row++) {
+      auto &left_key = left_keys_[left_row];
+      for (size_t right_row = right_itr; right_row < right_group_end;
+           right_row++) {
+        auto &right_key = right_keys_[right_row];
+
+        // Join predicate exists
+        if (predicate_ != nullptr) {
+          expression::ContainerTuple<LogicalTile> left_tuple(
+              left_result_tiles_[left_key.tile_idx].get(), left_key.row_idx);
+          expression::ContainerTuple<LogicalTile> right_tuple(
+              right_result_tiles_[right_key.tile_idx].get(),
+              right_key.row_idx);
+          if (!predicate_->Evaluate(&left_tuple, &right_tuple, context)
+                   .IsTrue()) {
+            continue;
+          }
+        }
+
+        matched_rows.push_back({left_key.tile_idx, left_key.row_idx,
+                                right_key.tile_idx, right_key.row_idx});
+      }
+    }
 
-  LOG_TRACE("Advanced %s with subset size %lu ", is_left ? "left" : "right",
-            end_row - start_row);
-  return end_row;
+    left_itr = left_group_end;
+    right_itr = right_group_end;
+  }
 }
 
 }  // namespace executor
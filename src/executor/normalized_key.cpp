@@ -0,0 +1,109 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// normalized_key.cpp
+//
+// Identification: src/executor/normalized_key.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <cstring>
+
+#include "executor/normalized_key.h"
+#include "common/exception.h"
+
+namespace peloton {
+namespace executor {
+
+namespace {
+
+// Most significant byte first, so that memcmp compares the numbers
+void AppendBigEndian(uint64_t bits, size_t length, std::string &key) {
+  for (size_t i = length; i > 0; i--) {
+    key.push_back(static_cast<char>((bits >> ((i - 1) * 8)) & 0xFF));
+  }
+}
+
+// Flip the sign bit, so that negative numbers come before positive ones
+void AppendSigned(int64_t value, size_t length, std::string &key) {
+  uint64_t sign_bit = uint64_t(1) << (length * 8 - 1);
+  AppendBigEndian(static_cast<uint64_t>(value) ^ sign_bit, length, key);
+}
+
+}  // namespace
+
+void NormalizedKey::Append(const type::Value &value, bool descending,
+                           std::string &key) {
+  size_t start = key.size();
+
+  if (value.IsNull()) {
+    key.push_back('\x01');
+  } else {
+    key.push_back('\x00');
+    switch (value.GetTypeId()) {
+      case type::Type::BOOLEAN:
+        key.push_back(static_cast<char>(value.GetAs<int8_t>()));
+        break;
+      case type::Type::TINYINT:
+        AppendSigned(value.GetAs<int8_t>(), sizeof(int8_t), key);
+        break;
+      case type::Type::SMALLINT:
+        AppendSigned(value.GetAs<int16_t>(), sizeof(int16_t), key);
+        break;
+      case type::Type::INTEGER:
+        AppendSigned(value.GetAs<int32_t>(), sizeof(int32_t), key);
+        break;
+      case type::Type::BIGINT:
+        AppendSigned(value.GetAs<int64_t>(), sizeof(int64_t), key);
+        break;
+      case type::Type::TIMESTAMP:
+        AppendBigEndian(value.GetAs<uint64_t>(), sizeof(uint64_t), key);
+        break;
+      case type::Type::DECIMAL: {
+        // Negative numbers have all bits inverted, so that larger magnitudes
+        // come first, positive ones only the sign bit
+        double decimal = value.GetAs<double>();
+        if (decimal == 0) decimal = 0;  // -0.0
+        uint64_t bits;
+        memcpy(&bits, &decimal, sizeof(bits));
+        if (bits >> 63) {
+          bits = ~bits;
+        } else {
+          bits ^= uint64_t(1) << 63;
+        }
+        AppendBigEndian(bits, sizeof(bits), key);
+        break;
+      }
+      case type::Type::VARCHAR:
+      case type::Type::VARBINARY: {
+        // Zero bytes are escaped as 0x00 0xFF and the end is marked by
+        // 0x00 0x00, so a prefix sorts before the longer string
+        const char *data = value.GetData();
+        uint32_t length = value.GetLength();
+        for (uint32_t i = 0; i < length; i++) {
+          key.push_back(data[i]);
+          if (data[i] == '\0') key.push_back('\xFF');
+        }
+        key.push_back('\x00');
+        key.push_back('\x00');
+        break;
+      }
+      default:
+        throw ExecutorException("Cannot sort on values of type " +
+                                type::Type::GetInstance(value.GetTypeId())
+                                    ->ToString());
+    }
+  }
+
+  if (descending) {
+    for (size_t i = start; i < key.size(); i++) {
+      key[i] = ~key[i];
+    }
+  }
+}
+
+}  // End executor namespace
+}  // End peloton namespace
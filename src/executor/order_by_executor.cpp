@@ -17,9 +17,12 @@
 #include "executor/logical_tile_factory.h"
 #include "executor/order_by_executor.h"
 #include "executor/executor_context.h"
+#include "executor/normalized_key.h"
+#include "executor/parallel_sort.h"
 
 #include "planner/order_by_plan.h"
 #include "storage/tile.h"
+#include "type/serializeio.h"
 
 namespace peloton {
 namespace executor {
@@ -32,7 +35,7 @@ OrderByExecutor::OrderByExecutor(const planner::AbstractPlan *node,
                                  ExecutorContext *executor_context)
     : AbstractExecutor(node, executor_context) {}
 
-OrderByExecutor::~OrderByExecutor() {}
+OrderByExecutor::~OrderByExecutor() { ReleaseMemory(); }
 
 bool OrderByExecutor::DInit() {
   PL_ASSERT(children_.size() == 1);
@@ -63,6 +66,8 @@ bool OrderByExecutor::DExecute() {
 
   if (!sort_done_) DoSort();
 
+  if (!runs_.empty()) return ExecuteMerge();
+
   if (!(num_tuples_returned_ < sort_buffer_.size())) {
     return false;
   }
@@ -71,12 +76,30 @@ bool OrderByExecutor::DExecute() {
   PL_ASSERT(input_schema_.get());
   PL_ASSERT(input_tiles_.size() > 0);
 
-  // Returned tiles must be newly created physical tiles.
-  // NOTE: the schema of these tiles might not match the input tiles when some of the order by columns are not be part of the output schema
+  // NOTE: the schema of the returned tiles might not match the input tiles when some of the order by columns are not be part of the output schema
 
   size_t tile_size = std::min(size_t(DEFAULT_TUPLES_PER_TILEGROUP),
                               sort_buffer_.size() - num_tuples_returned_);
 
+  // A long enough run of sorted tuples from the same input tile keeps
+  // referring to the base tiles instead of being copied. This covers input
+  // that is already ordered and input that fits in a single tile.
+  oid_t run_tile_id = sort_buffer_[num_tuples_returned_].item_pointer.block;
+  size_t run_size = 1;
+  while (run_size < tile_size &&
+         sort_buffer_[num_tuples_returned_ + run_size].item_pointer.block ==
+             run_tile_id) {
+    run_size++;
+  }
+  if (run_size == tile_size || run_size >= ORDER_BY_MIN_PASS_THROUGH_RUN) {
+    SetOutput(BuildPassThroughTile(run_tile_id, run_size));
+    num_tuples_returned_ += run_size;
+    return true;
+  }
+
+  // Otherwise the tuples are copied into a newly created physical tile
+  const planner::OrderByPlan &node = GetPlanNode<planner::OrderByPlan>();
+  auto &output_column_ids = node.GetOutputColumnIds();
   std::shared_ptr<storage::Tile> ptile(storage::TileFactory::GetTile(
       BackendType::MM, INVALID_OID, INVALID_OID, INVALID_OID, INVALID_OID,
       nullptr, *input_schema_, nullptr, tile_size));
@@ -88,8 +111,8 @@ bool OrderByExecutor::DExecute() {
         sort_buffer_[num_tuples_returned_ + id].item_pointer.offset;
     // Insert a physical tuple into physical tile
     for (oid_t col = 0; col < input_schema_->GetColumnCount(); col++) {
-      type::Value val =
-          (input_tiles_[source_tile_id]->GetValue(source_tuple_id, col));
+      type::Value val = (input_tiles_[source_tile_id]->GetValue(
+          source_tuple_id, output_column_ids[col]));
       ptile.get()->SetValue(val, id, col);
     }
   }
@@ -108,19 +131,114 @@ bool OrderByExecutor::DExecute() {
   return true;
 }
 
+/**
+ * @brief Wrap the next run of sorted tuples, which all come from the same
+ * input tile, in a logical tile over the base tiles of that input tile.
+ */
+LogicalTile *OrderByExecutor::BuildPassThroughTile(oid_t source_tile_id,
+                                                   size_t run_size) {
+  const planner::OrderByPlan &node = GetPlanNode<planner::OrderByPlan>();
+  LogicalTile *source_tile = input_tiles_[source_tile_id].get();
+
+  LogicalTile::PositionLists position_lists;
+  for (auto &source_list : source_tile->GetPositionLists()) {
+    LogicalTile::PositionList position_list;
+    position_list.reserve(run_size);
+    for (size_t id = 0; id < run_size; id++) {
+      oid_t source_tuple_id =
+          sort_buffer_[num_tuples_returned_ + id].item_pointer.offset;
+      position_list.push_back(source_list[source_tuple_id]);
+    }
+    position_lists.push_back(std::move(position_list));
+  }
+
+  std::vector<LogicalTile::ColumnInfo> schema;
+  for (auto column_id : node.GetOutputColumnIds()) {
+    schema.push_back(source_tile->GetColumnInfo(column_id));
+  }
+
+  LogicalTile *output_tile = LogicalTileFactory::GetTile();
+  output_tile->SetSchema(std::move(schema));
+  output_tile->SetPositionListsAndVisibility(std::move(position_lists));
+  PL_ASSERT(output_tile->GetTupleCount() == run_size);
+  return output_tile;
+}
+
+/**
+ * @brief Return the next tuples of the merged runs. The spilled tuples only
+ * have the output columns left, so they are copied into a new physical tile.
+ */
+bool OrderByExecutor::ExecuteMerge() {
+  if (merge_heap_.empty()) return false;
+
+  size_t tile_size = std::min(size_t(DEFAULT_TUPLES_PER_TILEGROUP),
+                              num_tuples_sorted_ - num_tuples_returned_);
+  PL_ASSERT(tile_size > 0);
+
+  std::shared_ptr<storage::Tile> ptile(storage::TileFactory::GetTile(
+      BackendType::MM, INVALID_OID, INVALID_OID, INVALID_OID, INVALID_OID,
+      nullptr, *input_schema_, nullptr, tile_size));
+
+  for (size_t id = 0; id < tile_size; id++) {
+    PL_ASSERT(!merge_heap_.empty());
+    auto &row = merge_heap_.front()->row;
+    ReferenceSerializeInput input(row.data(), row.size());
+    for (oid_t col = 0; col < input_schema_->GetColumnCount(); col++) {
+      type::Value val =
+          type::Value::DeserializeFrom(input, input_schema_->GetType(col));
+      ptile.get()->SetValue(val, id, col);
+    }
+    AdvanceMerge();
+  }
+
+  std::vector<std::shared_ptr<storage::Tile>> singleton({ptile});
+  std::unique_ptr<LogicalTile> ltile(LogicalTileFactory::WrapTiles(singleton));
+  PL_ASSERT(ltile->GetTupleCount() == tile_size);
+
+  SetOutput(ltile.release());
+
+  num_tuples_returned_ += tile_size;
+
+  PL_ASSERT(num_tuples_returned_ <= num_tuples_sorted_);
+
+  return true;
+}
+
 bool OrderByExecutor::DoSort() {
   PL_ASSERT(children_.size() == 1);
   PL_ASSERT(children_[0] != nullptr);
   PL_ASSERT(!sort_done_);
   PL_ASSERT(executor_context_ != nullptr);
 
+  // Grab data from plan node
+  const planner::OrderByPlan &node = GetPlanNode<planner::OrderByPlan>();
+  descend_flags_ = node.GetDescendFlags();
+
+  // With a LIMIT on top only the first tuples are kept. Underlying ordered
+  // input needs no sorting at all.
+  top_n_ = limit_ && !underling_ordered_;
+
   // Extract all data from child
   while (children_[0]->Execute()) {
     input_tiles_.emplace_back(children_[0]->GetOutput());
+    tile_references_.push_back(0);
 
     // increase the counter
     num_tuples_get_ += input_tiles_.back()->GetTupleCount();
 
+    // Extract the schema of the output columns
+    if (input_schema_ == nullptr) {
+      std::unique_ptr<catalog::Schema> physical_schema(
+          input_tiles_.back()->GetPhysicalSchema());
+      std::vector<catalog::Column> output_key_columns;
+      for (auto id : node.GetOutputColumnIds()) {
+        output_key_columns.push_back(physical_schema->GetColumn(id));
+      }
+      input_schema_.reset(new catalog::Schema(output_key_columns));
+    }
+
+    AddInputTile();
+
     // Optimization for ordered output
     if (underling_ordered_ && limit_) {
       LOG_TRACE("underling_ordered and limit both work");
@@ -132,106 +250,228 @@ bool OrderByExecutor::DoSort() {
     }
   }
 
-  /** Number of valid tuples to be sorted. */
-  size_t count = 0;
-  for (auto &tile : input_tiles_) {
-    count += tile->GetTupleCount();
+  if (!runs_.empty()) {
+    if (!sort_buffer_.empty()) SpillSortBuffer();
+    input_tiles_.clear();
+    tile_references_.clear();
+
+    // Merge the first runs into one until a single pass can merge them all.
+    // The merged run takes their place, so ties keep the input order.
+    while (runs_.size() > ORDER_BY_MERGE_FAN_IN) {
+      std::unique_ptr<SortedRun> merged_run(new SortedRun());
+      merged_run->file.reset(new SpillFile());
+      StartMerge(0, ORDER_BY_MERGE_FAN_IN);
+      while (!merge_heap_.empty()) {
+        SortedRun *run = merge_heap_.front();
+        merged_run->Write(run->key, run->row.data(), run->row.size());
+        AdvanceMerge();
+      }
+      runs_.erase(runs_.begin(), runs_.begin() + ORDER_BY_MERGE_FAN_IN);
+      runs_.insert(runs_.begin(), std::move(merged_run));
+    }
+
+    LOG_DEBUG("Merging %lu runs of %lu tuples", runs_.size(),
+              num_tuples_sorted_);
+    StartMerge(0, runs_.size());
+    sort_done_ = true;
+    return true;
   }
 
-  if (count == 0) return true;
+  num_tuples_sorted_ = sort_buffer_.size();
 
-  // Grab data from plan node
-  const planner::OrderByPlan &node = GetPlanNode<planner::OrderByPlan>();
-  descend_flags_ = node.GetDescendFlags();
+  // If the underlying result has the same order, it is not necessary to sort
+  // the result again. Instead, go to the end.
+  if (underling_ordered_) {
+    LOG_TRACE("underling_ordered works and already get all tuples (%lu)",
+              num_tuples_sorted_);
+  } else if (top_n_) {
+    std::sort_heap(sort_buffer_.begin(), sort_buffer_.end());
+  } else {
+    // Finally ... sort it !
+    ParallelSort(sort_buffer_);
+  }
 
-  // Extract the schema for sort keys.
+  sort_done_ = true;
+
+  return true;
+}
+
+/**
+ * @brief Build the normalized sort keys of the tuples in the last input tile.
+ * In top-N mode, a tuple only enters the heap if it sorts before its largest
+ * entry, which it then replaces.
+ */
+void OrderByExecutor::AddInputTile() {
+  const planner::OrderByPlan &node = GetPlanNode<planner::OrderByPlan>();
+  auto &sort_keys = node.GetSortKeys();
+  oid_t tile_id = input_tiles_.size() - 1;
+  LogicalTile *tile = input_tiles_[tile_id].get();
+  size_t heap_size = limit_offset_ + limit_number_;
+
+  // Memory held for each tuple besides its key
+  size_t tuple_memory =
+      sizeof(sort_buffer_entry_t) + input_schema_->GetLength();
+
+  for (oid_t tuple_id : *tile) {
+    sort_buffer_entry_t entry;
+    entry.item_pointer = ItemPointer(tile_id, tuple_id);
+    if (!underling_ordered_) {
+      for (oid_t id = 0; id < sort_keys.size(); id++) {
+        NormalizedKey::Append(tile->GetValue(tuple_id, sort_keys[id]),
+                              descend_flags_[id], entry.key);
+      }
+    }
+    size_t key_size = entry.key.size();
+
+    if (top_n_ && sort_buffer_.size() >= heap_size) {
+      if (heap_size == 0 || !(entry < sort_buffer_.front())) continue;
+
+      std::pop_heap(sort_buffer_.begin(), sort_buffer_.end());
+      auto &evicted = sort_buffer_.back();
+      memory_used_ -= tuple_memory + evicted.key.size();
+      oid_t evicted_tile_id = evicted.item_pointer.block;
+      if (--tile_references_[evicted_tile_id] == 0 &&
+          evicted_tile_id != tile_id) {
+        input_tiles_[evicted_tile_id].reset();
+      }
+      evicted = std::move(entry);
+    } else {
+      sort_buffer_.push_back(std::move(entry));
+    }
+    if (top_n_) {
+      std::push_heap(sort_buffer_.begin(), sort_buffer_.end());
+    }
 
-  std::unique_ptr<catalog::Schema> physical_schema;
-  physical_schema.reset(input_tiles_[0]->GetPhysicalSchema());
-  std::vector<catalog::Column> sort_key_columns;
-  std::vector<catalog::Column> output_key_columns;
-  for (auto id : node.GetSortKeys()) {
-    sort_key_columns.push_back(physical_schema->GetColumn(id));
+    tile_references_[tile_id]++;
+    memory_used_ += tuple_memory + key_size;
   }
-  for (auto id : node.GetOutputColumnIds()) {
-    output_key_columns.push_back(physical_schema->GetColumn(id));
+
+  if (tile_references_[tile_id] == 0) {
+    input_tiles_[tile_id].reset();
   }
-  sort_key_tuple_schema_.reset(new catalog::Schema(sort_key_columns));
-  input_schema_.reset(new catalog::Schema(output_key_columns));
-  auto executor_pool = executor_context_->GetPool();
 
-  // Extract all valid tuples into a single std::vector (the sort buffer)
-  sort_buffer_.reserve(count);
-  for (oid_t tile_id = 0; tile_id < input_tiles_.size(); tile_id++) {
-    for (oid_t tuple_id : *input_tiles_[tile_id]) {
-      // Extract the sort key tuple
-      std::unique_ptr<storage::Tuple> tuple(
-          new storage::Tuple(sort_key_tuple_schema_.get(), true));
-      for (oid_t id = 0; id < node.GetSortKeys().size(); id++) {
-        type::Value val =
-            (input_tiles_[tile_id]->GetValue(tuple_id, node.GetSortKeys()[id]));
-        tuple->SetValue(id, val, executor_pool);
-      }
-      // Inert the sort key tuple into sort buffer
-      sort_buffer_.emplace_back(sort_buffer_entry_t(
-          ItemPointer(tile_id, tuple_id), std::move(tuple)));
+  if (!ReserveMemory()) {
+    // The heap is a valid sort buffer, the limit is still applied on top
+    if (top_n_) {
+      LOG_DEBUG("Top %lu tuples exceed the sort memory", heap_size);
+      top_n_ = false;
     }
+    SpillSortBuffer();
+  }
+}
+
+/**
+ * @brief Charge the memory held by the sort buffer and its tuples to the
+ * budget of the query.
+ * @return false if it does not fit, nothing more is reserved then.
+ */
+bool OrderByExecutor::ReserveMemory() {
+  if (executor_context_ == nullptr) return true;
+
+  if (memory_used_ < memory_reserved_) {
+    executor_context_->ReleaseMemory(memory_reserved_ - memory_used_);
+  } else if (memory_used_ > memory_reserved_ &&
+             !executor_context_->ReserveMemory(memory_used_ -
+                                               memory_reserved_)) {
+    return false;
+  }
+  memory_reserved_ = memory_used_;
+  return true;
+}
+
+void OrderByExecutor::ReleaseMemory() {
+  if (memory_reserved_ > 0) {
+    executor_context_->ReleaseMemory(memory_reserved_);
+    memory_reserved_ = 0;
   }
+}
 
-  PL_ASSERT(count == sort_buffer_.size());
+/**
+ * @brief Sort the sort buffer and write it with the output columns of its
+ * tuples to a new run. The input tiles are released afterwards.
+ */
+void OrderByExecutor::SpillSortBuffer() {
+  const planner::OrderByPlan &node = GetPlanNode<planner::OrderByPlan>();
+  auto &output_column_ids = node.GetOutputColumnIds();
 
-  // If the underlying result has the same order, it is not necessary to sort
-  // the result again. Instead, go to the end.
-  if (underling_ordered_) {
-    LOG_TRACE("underling_ordered works and already get all tuples (%lu)",
-              count);
-    sort_done_ = true;
-    return true;
+  if (!underling_ordered_) {
+    ParallelSort(sort_buffer_);
   }
 
-  // Prepare the compare function
-  // Note: This is a less-than comparer, NOT an equality comparer.
-  struct TupleComparer {
-    TupleComparer(std::vector<bool> &_descend_flags)
-        : descend_flags(_descend_flags) {}
-
-    bool operator()(const storage::Tuple *ta, const storage::Tuple *tb) {
-      for (oid_t id = 0; id < descend_flags.size(); id++) {
-        type::Value va = (ta->GetValue(id));
-        type::Value vb = (tb->GetValue(id));
-        if (!descend_flags[id]) {
-          if (va.CompareLessThan(vb) == type::CMP_TRUE)
-            return true;
-          else {
-            if (va.CompareGreaterThan(vb) == type::CMP_TRUE) return false;
-          }
-        } else {
-          if (vb.CompareLessThan(va) == type::CMP_TRUE)
-            return true;
-          else {
-            if (vb.CompareGreaterThan(va) == type::CMP_TRUE) return false;
-          }
-        }
-      }
-      return false;  // Will return false if all keys equal
+  std::unique_ptr<SortedRun> run(new SortedRun());
+  run->file.reset(new SpillFile());
+  CopySerializeOutput row;
+  for (auto &entry : sort_buffer_) {
+    LogicalTile *tile = input_tiles_[entry.item_pointer.block].get();
+    row.Reset();
+    for (auto column_id : output_column_ids) {
+      tile->GetValue(entry.item_pointer.offset, column_id).SerializeTo(row);
     }
+    run->Write(entry.key, row.Data(), row.Size());
+  }
+  LOG_DEBUG("Spilled %lu sorted tuples (%lu bytes)", sort_buffer_.size(),
+            run->file->GetSize());
 
-    std::vector<bool> descend_flags;
-  };
-
-  TupleComparer comp(descend_flags_);
+  runs_.push_back(std::move(run));
+  spilled_run_count_++;
+  num_tuples_sorted_ += sort_buffer_.size();
 
-  // Finally ... sort it !
-  std::sort(
-      sort_buffer_.begin(), sort_buffer_.end(),
-      [&comp](const sort_buffer_entry_t &a, const sort_buffer_entry_t &b) {
-        return comp(a.tuple.get(), b.tuple.get());
-      });
+  sort_buffer_.clear();
+  for (oid_t tile_id = 0; tile_id < input_tiles_.size(); tile_id++) {
+    input_tiles_[tile_id].reset();
+    tile_references_[tile_id] = 0;
+  }
+  memory_used_ = 0;
+  ReleaseMemory();
+}
 
-  sort_done_ = true;
+void OrderByExecutor::SortedRun::Write(const std::string &record_key,
+                                       const char *record_row,
+                                       size_t row_length) {
+  uint32_t header[2] = {static_cast<uint32_t>(record_key.size()),
+                        static_cast<uint32_t>(row_length)};
+  file->Write(header, sizeof(header));
+  file->Write(record_key.data(), record_key.size());
+  file->Write(record_row, row_length);
+}
 
+bool OrderByExecutor::SortedRun::Next() {
+  uint32_t header[2];
+  if (!file->Read(header, sizeof(header))) return false;
+  key.resize(header[0]);
+  row.resize(header[1]);
+  if (!file->Read(&key[0], key.size()) || !file->Read(&row[0], row.size())) {
+    throw ExecutorException("Spilled sort run is truncated");
+  }
   return true;
 }
 
+bool OrderByExecutor::LaterInMerge(const SortedRun *lhs,
+                                   const SortedRun *rhs) {
+  int result = lhs->key.compare(rhs->key);
+  if (result != 0) return result > 0;
+  return lhs->order > rhs->order;
+}
+
+void OrderByExecutor::StartMerge(size_t first_run, size_t run_count) {
+  merge_heap_.clear();
+  for (size_t run_id = first_run; run_id < first_run + run_count; run_id++) {
+    auto &run = runs_[run_id];
+    run->file->Rewind();
+    run->order = run_id;
+    if (run->Next()) merge_heap_.push_back(run.get());
+  }
+  std::make_heap(merge_heap_.begin(), merge_heap_.end(), LaterInMerge);
+}
+
+void OrderByExecutor::AdvanceMerge() {
+  std::pop_heap(merge_heap_.begin(), merge_heap_.end(), LaterInMerge);
+  if (merge_heap_.back()->Next()) {
+    std::push_heap(merge_heap_.begin(), merge_heap_.end(), LaterInMerge);
+  } else {
+    merge_heap_.pop_back();
+  }
+}
+
 } /* namespace executor */
 } /* namespace peloton */
@@ -0,0 +1,121 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// parallel_sort.cpp
+//
+// Identification: src/executor/parallel_sort.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <condition_variable>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+#include "common/thread_pool.h"
+#include "executor/parallel_sort.h"
+#include "type/types.h"
+
+namespace peloton {
+namespace executor {
+
+namespace {
+
+// Workers shared by all parallel operators, started on first use. The
+// calling thread always runs a partition itself, so one worker less is
+// enough to keep every sort worker busy.
+class PartitionThreadPool {
+ public:
+  PartitionThreadPool() {
+    pool_.Initialize(std::max(size_t(1), GetSortWorkerCount()) - 1, 0);
+  }
+
+  ~PartitionThreadPool() { pool_.Shutdown(); }
+
+  ThreadPool &GetPool() { return pool_; }
+
+ private:
+  ThreadPool pool_;
+};
+
+ThreadPool &GetPartitionThreadPool() {
+  static PartitionThreadPool partition_thread_pool;
+  return partition_thread_pool.GetPool();
+}
+
+}  // namespace
+
+size_t GetSortWorkerCount() {
+  if (FLAGS_sort_workers != 0) return FLAGS_sort_workers;
+  return std::max(1u, std::thread::hardware_concurrency());
+}
+
+void RunPartitions(size_t partition_count,
+                   const std::function<void(size_t)> &task) {
+  std::exception_ptr error;
+  std::mutex error_mutex;
+  auto run_task = [&](size_t partition) {
+    try {
+      task(partition);
+    } catch (...) {
+      std::lock_guard<std::mutex> lock(error_mutex);
+      if (error == nullptr) error = std::current_exception();
+    }
+  };
+
+  // The calling thread takes the first partition, and every partition still
+  // queued afterwards, so partitions never wait for a free worker. Queued
+  // tasks may run after the call returns, they then find nothing left to do
+  // and only touch the shared progress.
+  struct Progress {
+    std::mutex mutex;
+    std::condition_variable done_cv;
+    size_t next_partition = 1;
+    size_t pending_count = 0;
+  };
+  std::shared_ptr<Progress> progress(new Progress());
+  progress->pending_count = partition_count;
+  auto next_task = [&run_task](Progress &progress, size_t partition_count) {
+    size_t partition;
+    {
+      std::lock_guard<std::mutex> lock(progress.mutex);
+      if (progress.next_partition >= partition_count) return false;
+      partition = progress.next_partition++;
+    }
+    run_task(partition);
+    std::lock_guard<std::mutex> lock(progress.mutex);
+    if (--progress.pending_count == 0) progress.done_cv.notify_all();
+    return true;
+  };
+
+  if (partition_count == 0) return;
+  auto &pool = GetPartitionThreadPool();
+  for (size_t partition = 1; partition < partition_count; partition++) {
+    pool.SubmitTask([progress, next_task, partition_count]() {
+      next_task(*progress, partition_count);
+    });
+  }
+
+  run_task(0);
+  {
+    std::lock_guard<std::mutex> lock(progress->mutex);
+    progress->pending_count--;
+  }
+  while (next_task(*progress, partition_count)) {
+  }
+
+  {
+    std::unique_lock<std::mutex> lock(progress->mutex);
+    progress->done_cv.wait(lock,
+                           [&]() { return progress->pending_count == 0; });
+  }
+
+  if (error != nullptr) std::rethrow_exception(error);
+}
+
+}  // End executor namespace
+}  // End peloton namespace
@@ -13,6 +13,8 @@
 
 #include "executor/projection_executor.h"
 
+#include <numeric>
+
 #include "planner/projection_plan.h"
 #include "common/logger.h"
 #include "type/types.h"
@@ -45,12 +47,19 @@ bool ProjectionExecutor::DInit() {
   this->project_info_ = node.GetProjectInfo();
   this->schema_ = node.GetSchema();
 
+  compiled_targets_.clear();
+  for (auto &target : project_info_->GetTargetList()) {
+    compiled_targets_.push_back(
+        expression::CompiledExpression::Compile(target.second));
+  }
+
   return true;
 }
 
 /**
  * @brief Create projected tuples based on one or two input.
- * Newly-created physical tiles are needed.
+ * Only computed columns are written into a newly-created physical tile,
+ * direct mapped columns keep referring to the tiles of the input.
  *
  * @return true on success, false otherwise.
  */
@@ -69,29 +78,79 @@ bool ProjectionExecutor::DExecute() {
 
     // Get input from child
     std::unique_ptr<LogicalTile> source_tile(children_[0]->GetOutput());
-    auto num_tuples = source_tile->GetTupleCount();
-
-    // Create new physical tile where we store projected tuples
-    std::shared_ptr<storage::Tile> dest_tile(
-        storage::TileFactory::GetTempTile(*schema_, num_tuples));
-
-    // Create projections tuple-at-a-time from original tile
-    oid_t new_tuple_id = 0;
-    for (oid_t old_tuple_id : *source_tile) {
-      storage::Tuple *buffer = new storage::Tuple(schema_, true);
-      expression::ContainerTuple<LogicalTile> tuple(source_tile.get(),
-                                                    old_tuple_id);
-      project_info_->Evaluate(buffer, &tuple, nullptr, executor_context_);
+    std::vector<oid_t> tuple_ids;
+    for (oid_t tuple_id : *source_tile) {
+      tuple_ids.push_back(tuple_id);
+    }
+    oid_t num_tuples = tuple_ids.size();
+
+    // The output keeps the visible rows of the input
+    LogicalTile::PositionLists position_lists;
+    for (auto &source_list : source_tile->GetPositionLists()) {
+      LogicalTile::PositionList position_list;
+      position_list.reserve(num_tuples);
+      for (oid_t tuple_id : tuple_ids) {
+        position_list.push_back(source_list[tuple_id]);
+      }
+      position_lists.push_back(std::move(position_list));
+    }
 
-      // Insert projected tuple into the new tile
-      dest_tile.get()->InsertTuple(new_tuple_id, buffer);
+    std::vector<LogicalTile::ColumnInfo> output_schema(
+        schema_->GetColumnCount());
+
+    // Computed columns are evaluated column-at-a-time into a new physical
+    // tile that holds only them
+    const auto &target_list = project_info_->GetTargetList();
+    if (target_list.size() > 0) {
+      std::vector<catalog::Column> columns;
+      for (auto &target : target_list) {
+        columns.push_back(schema_->GetColumn(target.first));
+      }
+      catalog::Schema computed_schema(columns);
+      std::shared_ptr<storage::Tile> dest_tile(
+          storage::TileFactory::GetTempTile(computed_schema, num_tuples));
+
+      LogicalTile::PositionList dest_rows(num_tuples);
+      std::iota(dest_rows.begin(), dest_rows.end(), 0);
+      oid_t dest_position_list_idx = position_lists.size();
+      position_lists.push_back(std::move(dest_rows));
+
+      for (oid_t column_itr = 0; column_itr < target_list.size();
+           column_itr++) {
+        auto compiled = compiled_targets_[column_itr].get();
+        if (compiled != nullptr) {
+          compiled->EvaluateBatch(source_tile.get(), tuple_ids,
+                                  dest_tile.get(), column_itr);
+        } else {
+          auto expr = target_list[column_itr].second;
+          auto column_type = computed_schema.GetType(column_itr);
+          for (oid_t row = 0; row < num_tuples; row++) {
+            expression::ContainerTuple<LogicalTile> tuple(source_tile.get(),
+                                                          tuple_ids[row]);
+            auto value = expr->Evaluate(&tuple, nullptr, executor_context_);
+            if (value.GetTypeId() != column_type) {
+              value = value.CastAs(column_type);
+            }
+            dest_tile->SetValue(value, row, column_itr);
+          }
+        }
+
+        output_schema[target_list[column_itr].first] = {
+            dest_position_list_idx, dest_tile, column_itr};
+      }
+    }
 
-      delete buffer;
-      new_tuple_id++;
+    // Direct mapped columns pass through without copying
+    for (auto &direct_map : project_info_->GetDirectMapList()) {
+      PL_ASSERT(direct_map.second.first == 0);
+      output_schema[direct_map.first] =
+          source_tile->GetColumnInfo(direct_map.second.second);
     }
 
-    // Wrap physical tile in logical tile and return it
-    SetOutput(LogicalTileFactory::WrapTiles({dest_tile}));
+    std::unique_ptr<LogicalTile> output_tile(LogicalTileFactory::GetTile());
+    output_tile->SetSchema(std::move(output_schema));
+    output_tile->SetPositionListsAndVisibility(std::move(position_lists));
+    SetOutput(output_tile.release());
 
     return true;
   }
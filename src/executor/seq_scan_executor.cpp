@@ -12,6 +12,7 @@
 
 #include "executor/seq_scan_executor.h"
 
+#include <algorithm>
 #include <memory>
 #include <utility>
 #include <vector>
@@ -57,8 +58,30 @@ bool SeqScanExecutor::DInit() {
   
   current_tile_group_offset_ = START_OID;
 
+  compiled_predicate_ = expression::CompiledExpression::Compile(predicate_);
+  if (compiled_predicate_ != nullptr &&
+      compiled_predicate_->GetValueType() != type::Type::BOOLEAN) {
+    compiled_predicate_.reset();
+  }
+
   if (target_table_ != nullptr) {
     table_tile_group_count_ = target_table_->GetTileGroupCount();
+    zone_map_filter_.Init(predicate_, executor_context_);
+
+    // Skip the partitions that cannot hold tuples satisfying the predicate
+    prune_partitions_ = false;
+    if (target_table_->GetPartitionScheme() != nullptr &&
+        predicate_ != nullptr) {
+      auto partitions = node.GetScannedPartitions(executor_context_);
+      if (std::find(partitions.begin(), partitions.end(), false) !=
+          partitions.end()) {
+        target_table_->GetTileGroupIds(partitions, tile_group_ids_);
+        table_tile_group_count_ = tile_group_ids_.size();
+        prune_partitions_ = true;
+        LOG_TRACE("Scanning %u of %lu tile groups", table_tile_group_count_,
+                  target_table_->GetTileGroupCount());
+      }
+    }
 
     if (column_ids_.empty()) {
       column_ids_.resize(target_table_->GetSchema()->GetColumnCount());
@@ -89,7 +112,10 @@ bool SeqScanExecutor::DExecute() {
         // Invalidate tuples that don't satisfy the predicate.
         for (oid_t tuple_id : *tile) {
           expression::ContainerTuple<LogicalTile> tuple(tile.get(), tuple_id);
-          auto eval = predicate_->Evaluate(&tuple, nullptr, executor_context_);
+          auto eval =
+              (compiled_predicate_ != nullptr)
+                  ? compiled_predicate_->Evaluate(&tuple, nullptr)
+                  : predicate_->Evaluate(&tuple, nullptr, executor_context_);
           if (eval.IsFalse()) {
           //if (predicate_->Evaluate(&tuple, nullptr, executor_context_)
           //        .IsFalse()) {
@@ -125,7 +151,16 @@ bool SeqScanExecutor::DExecute() {
     // Retrieve next tile group.
     while (current_tile_group_offset_ < table_tile_group_count_) {
       auto tile_group =
-          target_table_->GetTileGroup(current_tile_group_offset_++);
+          prune_partitions_
+              ? target_table_->GetTileGroupById(
+                    tile_group_ids_[current_tile_group_offset_++])
+              : target_table_->GetTileGroup(current_tile_group_offset_++);
+
+      // Skip tile groups whose values cannot satisfy the predicate
+      if (zone_map_filter_.MayMatch(tile_group.get()) == false) {
+        continue;
+      }
+
       auto tile_group_header = tile_group->GetHeader();
 
       oid_t active_tuple_count = tile_group->GetNextTupleSlot();
@@ -133,36 +168,62 @@ bool SeqScanExecutor::DExecute() {
       // Construct position list by looping through tile group
       // and applying the predicate.
       std::vector<oid_t> position_list;
-      for (oid_t tuple_id = 0; tuple_id < active_tuple_count; tuple_id++) {
-        ItemPointer location(tile_group->GetTileGroupId(), tuple_id);
 
+      // With a compiled predicate, collect the visible tuples first and
+      // filter them in one pass over the tiles.
+      if (compiled_predicate_ != nullptr) {
+        for (oid_t tuple_id = 0; tuple_id < active_tuple_count; tuple_id++) {
+          auto visibility = transaction_manager.IsVisible(
+              current_txn, tile_group_header, tuple_id);
+          if (visibility == VisibilityType::OK) {
+            position_list.push_back(tuple_id);
+          }
+        }
 
-        auto visibility = transaction_manager.IsVisible(current_txn, tile_group_header, tuple_id);
+        compiled_predicate_->Filter(tile_group.get(), position_list);
 
-        // check transaction visibility
-        if (visibility == VisibilityType::OK) {
-          // if the tuple is visible, then perform predicate evaluation.
-          if (predicate_ == nullptr) {
-            position_list.push_back(tuple_id);
-            auto res = transaction_manager.PerformRead(current_txn, location, acquire_owner);
-            if (!res) {
-              transaction_manager.SetTransactionResult(current_txn, ResultType::FAILURE);
-              return res;
-            }
-          } else {
-            expression::ContainerTuple<storage::TileGroup> tuple(
-                tile_group.get(), tuple_id);
-            LOG_TRACE("Evaluate predicate for a tuple");
-            auto eval = predicate_->Evaluate(&tuple, nullptr, executor_context_);
-            LOG_TRACE("Evaluation result: %s", eval.GetInfo().c_str());
-            if (eval.IsTrue()) {
+        for (auto tuple_id : position_list) {
+          ItemPointer location(tile_group->GetTileGroupId(), tuple_id);
+          auto res = transaction_manager.PerformRead(current_txn, location,
+                                                     acquire_owner);
+          if (!res) {
+            transaction_manager.SetTransactionResult(current_txn,
+                                                     ResultType::FAILURE);
+            return res;
+          }
+        }
+      } else {
+        for (oid_t tuple_id = 0; tuple_id < active_tuple_count; tuple_id++) {
+          ItemPointer location(tile_group->GetTileGroupId(), tuple_id);
+
+
+          auto visibility = transaction_manager.IsVisible(current_txn, tile_group_header, tuple_id);
+
+          // check transaction visibility
+          if (visibility == VisibilityType::OK) {
+            // if the tuple is visible, then perform predicate evaluation.
+            if (predicate_ == nullptr) {
               position_list.push_back(tuple_id);
               auto res = transaction_manager.PerformRead(current_txn, location, acquire_owner);
               if (!res) {
                 transaction_manager.SetTransactionResult(current_txn, ResultType::FAILURE);
                 return res;
-              } else {
-                LOG_TRACE("Sequential Scan Predicate Satisfied");
+              }
+            } else {
+              expression::ContainerTuple<storage::TileGroup> tuple(
+                  tile_group.get(), tuple_id);
+              LOG_TRACE("Evaluate predicate for a tuple");
+              auto eval = predicate_->Evaluate(&tuple, nullptr, executor_context_);
+              LOG_TRACE("Evaluation result: %s", eval.GetInfo().c_str());
+              if (eval.IsTrue()) {
+                position_list.push_back(tuple_id);
+                auto res = transaction_manager.PerformRead(current_txn, location, acquire_owner);
+                if (!res) {
+                  transaction_manager.SetTransactionResult(current_txn, ResultType::FAILURE);
+                  return res;
+                } else {
+                  LOG_TRACE("Sequential Scan Predicate Satisfied");
+                }
               }
             }
           }
@@ -0,0 +1,175 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// spill_file.cpp
+//
+// Identification: src/executor/spill_file.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <cerrno>
+#include <cstring>
+
+#include "executor/spill_file.h"
+#include "catalog/schema.h"
+#include "common/abstract_tuple.h"
+#include "common/exception.h"
+#include "common/logger.h"
+#include "executor/logical_tile.h"
+#include "executor/logical_tile_factory.h"
+#include "storage/tile.h"
+#include "type/serializeio.h"
+#include "type/value_factory.h"
+
+namespace peloton {
+namespace executor {
+
+SpillFile::SpillFile() {
+  file_ = std::tmpfile();
+  if (file_ == nullptr) {
+    throw ExecutorException("Could not create spill file: " +
+                            std::string(strerror(errno)));
+  }
+  LOG_TRACE("Created spill file %d", fileno(file_));
+}
+
+SpillFile::~SpillFile() { fclose(file_); }
+
+void SpillFile::Write(const void *data, size_t length) {
+  if (fwrite(data, 1, length, file_) != length) {
+    throw ExecutorException("Could not write spill file: " +
+                            std::string(strerror(errno)));
+  }
+  size_ += length;
+}
+
+void SpillFile::Rewind() {
+  if (fflush(file_) != 0 || fseek(file_, 0, SEEK_SET) != 0) {
+    throw ExecutorException("Could not rewind spill file: " +
+                            std::string(strerror(errno)));
+  }
+}
+
+bool SpillFile::Read(void *data, size_t length) {
+  size_t read = fread(data, 1, length, file_);
+  if (read == length) return true;
+  if (ferror(file_)) {
+    throw ExecutorException("Could not read spill file: " +
+                            std::string(strerror(errno)));
+  }
+  if (read != 0) {
+    throw ExecutorException("Spill file is truncated");
+  }
+  return false;
+}
+
+void SpillFile::WriteRow(const AbstractTuple *tuple, size_t column_count) {
+  CopySerializeOutput row;
+  row.WriteInt(static_cast<int32_t>(column_count));
+  for (oid_t column_id = 0; column_id < column_count; column_id++) {
+    type::Value value = tuple->GetValue(column_id);
+    row.WriteByte(static_cast<int8_t>(value.GetTypeId()));
+    value.SerializeTo(row);
+  }
+
+  uint32_t row_length = row.Size();
+  Write(&row_length, sizeof(row_length));
+  Write(row.Data(), row_length);
+  row_count_++;
+}
+
+bool SpillFile::ReadRow(std::vector<type::Value> &values) {
+  uint32_t row_length;
+  if (!Read(&row_length, sizeof(row_length))) return false;
+
+  std::vector<char> row(row_length);
+  if (!Read(row.data(), row_length)) {
+    throw ExecutorException("Spill file is truncated");
+  }
+
+  values.clear();
+  ReferenceSerializeInput input(row.data(), row.size());
+  int32_t column_count = input.ReadInt();
+  for (int32_t column_id = 0; column_id < column_count; column_id++) {
+    auto type_id = static_cast<type::Type::TypeId>(input.ReadByte());
+    type::Value value = type::Value::DeserializeFrom(input, type_id);
+
+    // Variable length values still point into the row buffer. The length of
+    // a varchar includes its terminating null character.
+    if (!value.IsNull() && type_id == type::Type::VARCHAR &&
+        value.GetLength() > 0) {
+      value = type::ValueFactory::GetVarcharValue(
+          std::string(value.GetData(), value.GetLength() - 1));
+    } else if (!value.IsNull() && type_id == type::Type::VARBINARY) {
+      value = type::ValueFactory::GetVarbinaryValue(
+          reinterpret_cast<const unsigned char *>(value.GetData()),
+          value.GetLength(), true);
+    }
+    values.push_back(value);
+  }
+  return true;
+}
+
+LogicalTile *SpillFile::ReadTile(const catalog::Schema &schema,
+                                 size_t max_rows) {
+  std::vector<std::vector<type::Value>> rows;
+  std::vector<type::Value> values;
+  while (rows.size() < max_rows && ReadRow(values)) {
+    PL_ASSERT(values.size() == schema.GetColumnCount());
+    rows.push_back(values);
+  }
+  if (rows.empty()) return nullptr;
+
+  std::shared_ptr<storage::Tile> tile(storage::TileFactory::GetTile(
+      BackendType::MM, INVALID_OID, INVALID_OID, INVALID_OID, INVALID_OID,
+      nullptr, schema, nullptr, rows.size()));
+  for (oid_t tuple_id = 0; tuple_id < rows.size(); tuple_id++) {
+    for (oid_t column_id = 0; column_id < rows[tuple_id].size(); column_id++) {
+      tile->SetValue(rows[tuple_id][column_id], tuple_id, column_id);
+    }
+  }
+
+  std::vector<std::shared_ptr<storage::Tile>> singleton({tile});
+  return LogicalTileFactory::WrapTiles(singleton);
+}
+
+//===----------------------------------------------------------------------===//
+// Spill Partitions
+//===----------------------------------------------------------------------===//
+
+SpillPartitions::SpillPartitions(size_t level)
+    : level_(level), partitions_(SPILL_PARTITION_COUNT) {}
+
+size_t SpillPartitions::GetPartition(
+    const AbstractTuple *tuple,
+    const std::vector<oid_t> &key_column_ids) const {
+  // Start every level from a different seed, and mix the high bits in so
+  // the partition does not only depend on the low bits of the hash
+  size_t seed = (level_ + 1) * 0x9E3779B97F4A7C15ULL;
+  for (auto column_id : key_column_ids) {
+    tuple->GetValue(column_id).HashCombine(seed);
+  }
+  seed *= 0x9E3779B97F4A7C15ULL;
+  return (seed >> 32) % SPILL_PARTITION_COUNT;
+}
+
+void SpillPartitions::Add(const AbstractTuple *tuple, size_t column_count,
+                          const std::vector<oid_t> &key_column_ids) {
+  auto &partition = partitions_[GetPartition(tuple, key_column_ids)];
+  if (partition == nullptr) partition.reset(new SpillFile());
+  partition->WriteRow(tuple, column_count);
+  row_count_++;
+}
+
+std::unique_ptr<SpillFile> SpillPartitions::ReleasePartition(
+    size_t partition) {
+  PL_ASSERT(partition < partitions_.size());
+  if (partitions_[partition] != nullptr) partitions_[partition]->Rewind();
+  return std::move(partitions_[partition]);
+}
+
+}  // End executor namespace
+}  // End peloton namespace
@@ -11,14 +11,19 @@
 //===----------------------------------------------------------------------===//
 
 #include "executor/update_executor.h"
+
+#include <algorithm>
+
 #include "planner/update_plan.h"
 #include "common/logger.h"
 #include "catalog/manager.h"
+#include "catalog/partition_scheme.h"
 #include "executor/logical_tile.h"
 #include "executor/executor_context.h"
 #include "common/container_tuple.h"
 #include "concurrency/transaction.h"
 #include "concurrency/transaction_manager_factory.h"
+#include "logging/log_manager.h"
 #include "storage/data_table.h"
 #include "storage/tile_group_header.h"
 #include "storage/tile.h"
@@ -51,6 +56,54 @@ bool UpdateExecutor::DInit() {
   PL_ASSERT(target_table_);
   PL_ASSERT(project_info_);
 
+  // The updated columns are only recorded while the log writes them
+  updated_column_ids_.clear();
+  if (logging::LogManager::GetInstance().IsLoggingUpdatedColumns()) {
+    for (auto &target : project_info_->GetTargetList()) {
+      updated_column_ids_.push_back(target.first);
+    }
+    std::sort(updated_column_ids_.begin(), updated_column_ids_.end());
+    updated_column_ids_.erase(
+        std::unique(updated_column_ids_.begin(), updated_column_ids_.end()),
+        updated_column_ids_.end());
+  }
+
+  auto &partition_scheme = target_table_->GetPartitionScheme();
+  if (partition_scheme != nullptr) {
+    for (auto &target : project_info_->GetTargetList()) {
+      if (target.first == partition_scheme->GetColumnId()) {
+        partition_target_ = target.second;
+      }
+    }
+  }
+
+  return true;
+}
+
+bool UpdateExecutor::GetNewVersionPartition(
+    const AbstractTuple *old_tuple, const storage::TileGroup *tile_group,
+    oid_t &partition) {
+  auto &partition_scheme = target_table_->GetPartitionScheme();
+  partition = tile_group->GetPartitionId();
+  if (partition_scheme == nullptr ||
+      (partition_target_ == nullptr && partition != INVALID_OID)) {
+    return true;
+  }
+
+  oid_t column_id = partition_scheme->GetColumnId();
+  auto key = (partition_target_ != nullptr)
+                 ? partition_target_->Evaluate(old_tuple, nullptr,
+                                               executor_context_)
+                 : old_tuple->GetValue(column_id);
+  oid_t new_partition = partition_scheme->GetPartition(key);
+
+  // Like a partition constraint, tuples are not moved between partitions
+  if (partition != INVALID_OID && partition != new_partition) {
+    LOG_TRACE("Update moves the tuple from partition %u to %u", partition,
+              new_partition);
+    return false;
+  }
+  partition = new_partition;
   return true;
 }
 
@@ -171,6 +224,16 @@ bool UpdateExecutor::DExecute() {
     const planner::UpdatePlan &update_node = GetPlanNode<planner::UpdatePlan>();
 
     if (is_owner == true && is_written == true) {
+      oid_t partition = INVALID_OID;
+      expression::ContainerTuple<storage::TileGroup> owned_tuple(
+          tile_group, physical_tuple_id);
+      if (update_node.GetUpdatePrimaryKey() == false &&
+          GetNewVersionPartition(&owned_tuple, tile_group, partition) ==
+              false) {
+        transaction_manager.SetTransactionResult(current_txn,
+                                                 ResultType::FAILURE);
+        return false;
+      }
 
       if (update_node.GetUpdatePrimaryKey()) {
         // Update primary key
@@ -200,6 +263,15 @@ bool UpdateExecutor::DExecute() {
                                 executor_context_);
 
         transaction_manager.PerformUpdate(current_txn, old_location);
+
+        // The update is logged against the version before the transaction
+        auto logged_location =
+            tile_group_header->GetNextItemPointer(physical_tuple_id);
+        if (updated_column_ids_.empty() == false &&
+            logged_location.IsNull() == false) {
+          current_txn->RecordUpdatedColumns(logged_location,
+                                            updated_column_ids_);
+        }
       }
     }
     // if we have already got the
@@ -246,8 +318,24 @@ bool UpdateExecutor::DExecute() {
           // if it is the latest version and not locked by other threads, then
           // insert a new version.
 
+          expression::ContainerTuple<storage::TileGroup> old_tuple(
+              tile_group, physical_tuple_id);
+
+          // the new version stays in the partition of the old one
+          oid_t partition = INVALID_OID;
+          if (GetNewVersionPartition(&old_tuple, tile_group, partition) ==
+              false) {
+            if (is_owner == false) {
+              transaction_manager.YieldOwnership(current_txn, tile_group_id,
+                                                 physical_tuple_id);
+            }
+            transaction_manager.SetTransactionResult(current_txn,
+                                                     ResultType::FAILURE);
+            return false;
+          }
+
           // acquire a version slot from the table.
-          ItemPointer new_location = target_table_->AcquireVersion();
+          ItemPointer new_location = target_table_->AcquireVersion(partition);
 
           auto &manager = catalog::Manager::GetInstance();
           auto new_tile_group = manager.GetTileGroup(new_location.block);
@@ -255,9 +343,6 @@ bool UpdateExecutor::DExecute() {
           expression::ContainerTuple<storage::TileGroup> new_tuple(
               new_tile_group.get(), new_location.offset);
 
-          expression::ContainerTuple<storage::TileGroup> old_tuple(
-              tile_group, physical_tuple_id);
-
           // perform projection from old version to new version.
           // this triggers in-place update, and we do not need to allocate
           // another
@@ -299,6 +384,10 @@ bool UpdateExecutor::DExecute() {
                     new_location.offset);
           transaction_manager.PerformUpdate(current_txn, old_location,
                                             new_location);
+          if (updated_column_ids_.empty() == false) {
+            current_txn->RecordUpdatedColumns(old_location,
+                                              updated_column_ids_);
+          }
 
           // TODO: Why don't we also do this in the if branch above?
           executor_context_->num_processed += 1;  // updated one
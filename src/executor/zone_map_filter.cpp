@@ -0,0 +1,153 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// zone_map_filter.cpp
+//
+// Identification: src/executor/zone_map_filter.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "executor/zone_map_filter.h"
+
+#include "common/logger.h"
+#include "expression/abstract_expression.h"
+#include "expression/expression_util.h"
+#include "storage/tile_group.h"
+#include "storage/zone_map.h"
+
+namespace peloton {
+namespace executor {
+
+void ZoneMapFilter::Init(const expression::AbstractExpression *predicate,
+                         ExecutorContext *executor_context) {
+  nodes_.clear();
+  if (predicate == nullptr) {
+    return;
+  }
+
+  AddNode(predicate, executor_context);
+  if (nodes_.back().type == NodeType::ANY) {
+    nodes_.clear();
+  }
+}
+
+size_t ZoneMapFilter::AddNode(const expression::AbstractExpression *expr,
+                              ExecutorContext *executor_context) {
+  Node node;
+  auto expr_type = expr->GetExpressionType();
+
+  switch (expr_type) {
+    case ExpressionType::CONJUNCTION_AND:
+    case ExpressionType::CONJUNCTION_OR: {
+      size_t left = AddNode(expr->GetChild(0), executor_context);
+      size_t right = AddNode(expr->GetChild(1), executor_context);
+      bool left_any = (nodes_[left].type == NodeType::ANY);
+      bool right_any = (nodes_[right].type == NodeType::ANY);
+
+      // A side that always matches decides nothing in an AND, and
+      // everything in an OR
+      if (expr_type == ExpressionType::CONJUNCTION_AND) {
+        if (left_any) return right;
+        if (right_any) return left;
+        node.type = NodeType::AND;
+      } else {
+        if (left_any) return left;
+        if (right_any) return right;
+        node.type = NodeType::OR;
+      }
+      node.left = left;
+      node.right = right;
+      break;
+    }
+
+    case ExpressionType::OPERATOR_IS_NULL: {
+      auto child = expr->GetChild(0);
+      if (child != nullptr &&
+          child->GetExpressionType() == ExpressionType::VALUE_TUPLE) {
+        auto tuple_value =
+            static_cast<const expression::TupleValueExpression *>(child);
+        if (tuple_value->GetTupleId() == 0 && tuple_value->GetColumnId() >= 0) {
+          node.type = NodeType::IS_NULL;
+          node.column_id = tuple_value->GetColumnId();
+        }
+      }
+      break;
+    }
+
+    case ExpressionType::COMPARE_EQUAL:
+    case ExpressionType::COMPARE_LESSTHAN:
+    case ExpressionType::COMPARE_LESSTHANOREQUALTO:
+    case ExpressionType::COMPARE_GREATERTHAN:
+    case ExpressionType::COMPARE_GREATERTHANOREQUALTO: {
+      // Normalize to <column> <comparison> <constant>
+      const expression::TupleValueExpression *column = nullptr;
+      const expression::AbstractExpression *operand = nullptr;
+      ExpressionType comparison;
+      if (expression::ExpressionUtil::NormalizeColumnComparison(
+              expr, executor_context != nullptr, column, operand,
+              comparison) == false) {
+        break;
+      }
+
+      node.type = NodeType::COMPARE;
+      node.column_id = column->GetColumnId();
+      node.comparison = comparison;
+      node.constant =
+          operand->Evaluate(nullptr, nullptr, executor_context).Copy();
+      break;
+    }
+
+    default:
+      break;
+  }
+
+  nodes_.push_back(node);
+  return nodes_.size() - 1;
+}
+
+bool ZoneMapFilter::MayMatch(storage::TileGroup *tile_group) const {
+  if (nodes_.empty()) {
+    return true;
+  }
+
+  auto zone_map = tile_group->GetZoneMap();
+  if (zone_map == nullptr) {
+    return true;
+  }
+
+  bool may_match = MayMatch(*zone_map, nodes_.size() - 1);
+  if (may_match == false) {
+    LOG_TRACE("Skipping tile group %u : %s", tile_group->GetTileGroupId(),
+              zone_map->GetInfo().c_str());
+  }
+  return may_match;
+}
+
+bool ZoneMapFilter::MayMatch(const storage::ZoneMap &zone_map,
+                             size_t node_offset) const {
+  auto &node = nodes_[node_offset];
+  if ((node.type == NodeType::COMPARE || node.type == NodeType::IS_NULL) &&
+      node.column_id >= zone_map.GetColumnCount()) {
+    return true;
+  }
+
+  switch (node.type) {
+    case NodeType::COMPARE:
+      return zone_map.MayMatch(node.column_id, node.comparison, node.constant);
+    case NodeType::IS_NULL:
+      return zone_map.MayBeNull(node.column_id);
+    case NodeType::AND:
+      return MayMatch(zone_map, node.left) && MayMatch(zone_map, node.right);
+    case NodeType::OR:
+      return MayMatch(zone_map, node.left) || MayMatch(zone_map, node.right);
+    case NodeType::ANY:
+    default:
+      return true;
+  }
+}
+
+}  // End executor namespace
+}  // End peloton namespace
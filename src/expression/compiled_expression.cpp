@@ -0,0 +1,1168 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// compiled_expression.cpp
+//
+// Identification: src/expression/compiled_expression.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "expression/compiled_expression.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "common/container_tuple.h"
+#include "common/exception.h"
+#include "common/logger.h"
+#include "executor/logical_tile.h"
+#include "expression/abstract_expression.h"
+#include "expression/constant_value_expression.h"
+#include "expression/tuple_value_expression.h"
+#include "storage/tile.h"
+#include "storage/tile_group.h"
+#include "type/type_util.h"
+#include "type/value_factory.h"
+
+namespace peloton {
+namespace expression {
+
+namespace {
+
+// Types held in the integer registers
+bool IsIntegerType(type::Type::TypeId type_id) {
+  switch (type_id) {
+    case type::Type::BOOLEAN:
+    case type::Type::TINYINT:
+    case type::Type::SMALLINT:
+    case type::Type::INTEGER:
+    case type::Type::BIGINT:
+    case type::Type::TIMESTAMP:
+      return true;
+    default:
+      return false;
+  }
+}
+
+// Types supporting arithmetic; this relies on the order in type.h
+bool IsNumericType(type::Type::TypeId type_id) {
+  return type_id >= type::Type::TINYINT && type_id <= type::Type::DECIMAL;
+}
+
+bool IsSupportedType(type::Type::TypeId type_id) {
+  return IsIntegerType(type_id) || type_id == type::Type::DECIMAL ||
+         type_id == type::Type::VARCHAR;
+}
+
+void GetIntegerRange(type::Type::TypeId type_id, int64_t &min, int64_t &max) {
+  switch (type_id) {
+    case type::Type::TINYINT:
+      min = INT8_MIN;
+      max = INT8_MAX;
+      break;
+    case type::Type::SMALLINT:
+      min = INT16_MIN;
+      max = INT16_MAX;
+      break;
+    case type::Type::INTEGER:
+      min = INT32_MIN;
+      max = INT32_MAX;
+      break;
+    default:
+      min = INT64_MIN;
+      max = INT64_MAX;
+      break;
+  }
+}
+
+// Offset of a comparison from the EQUAL op code of its type
+int GetComparisonOffset(ExpressionType expression_type) {
+  switch (expression_type) {
+    case ExpressionType::COMPARE_EQUAL:
+      return 0;
+    case ExpressionType::COMPARE_NOTEQUAL:
+      return 1;
+    case ExpressionType::COMPARE_LESSTHAN:
+      return 2;
+    case ExpressionType::COMPARE_GREATERTHAN:
+      return 3;
+    case ExpressionType::COMPARE_LESSTHANOREQUALTO:
+      return 4;
+    case ExpressionType::COMPARE_GREATERTHANOREQUALTO:
+      return 5;
+    default:
+      return -1;
+  }
+}
+
+// Words of the null bitmap of a register in a batch
+const size_t batch_null_words = (COMPILED_EXPRESSION_BATCH_SIZE + 63) / 64;
+
+inline bool IsNullRow(const uint64_t *nulls, size_t row) {
+  return (nulls[row >> 6] >> (row & 63)) & 1;
+}
+
+inline void SetNullRow(uint64_t *nulls, size_t row) {
+  nulls[row >> 6] |= 1ull << (row & 63);
+}
+
+[[noreturn]] void ThrowOutOfRange() {
+  throw Exception(EXCEPTION_TYPE_OUT_OF_RANGE, "Numeric value out of range.");
+}
+
+[[noreturn]] void ThrowDivideByZero() {
+  throw Exception(EXCEPTION_TYPE_DIVIDE_BY_ZERO, "Division by zero.");
+}
+
+}  // namespace
+
+//===----------------------------------------------------------------------===//
+// Compilation
+//===----------------------------------------------------------------------===//
+
+std::unique_ptr<CompiledExpression> CompiledExpression::Compile(
+    const AbstractExpression *expression) {
+  if (expression == nullptr) {
+    return nullptr;
+  }
+
+  std::unique_ptr<CompiledExpression> compiled(new CompiledExpression());
+  int result = compiled->CompileNode(expression);
+  if (result < 0 || compiled->register_types_[result] == type::Type::VARCHAR) {
+    LOG_TRACE("Expression %s is not compiled",
+              ExpressionTypeToString(expression->GetExpressionType()).c_str());
+    return nullptr;
+  }
+  compiled->result_register_ = result;
+
+  LOG_TRACE("Compiled expression: %lu loads, %lu instructions, %lu registers",
+            compiled->loads_.size(), compiled->instructions_.size(),
+            compiled->register_types_.size());
+  return compiled;
+}
+
+int CompiledExpression::AllocateRegister(type::Type::TypeId type_id) {
+  if (register_types_.size() == COMPILED_EXPRESSION_MAX_REGISTERS) {
+    return -1;
+  }
+  register_types_.push_back(type_id);
+  initial_registers_.push_back(Register());
+  return static_cast<int>(register_types_.size() - 1);
+}
+
+int CompiledExpression::ToDecimal(int source) {
+  if (register_types_[source] == type::Type::DECIMAL) {
+    return source;
+  }
+  int destination = AllocateRegister(type::Type::DECIMAL);
+  if (destination < 0) {
+    return -1;
+  }
+  instructions_.push_back({OpCode::INTEGER_TO_DECIMAL,
+                           static_cast<uint8_t>(destination),
+                           static_cast<uint8_t>(source),
+                           static_cast<uint8_t>(source), 0, 0});
+  return destination;
+}
+
+int CompiledExpression::CompileNode(const AbstractExpression *expression) {
+  if (expression == nullptr) {
+    return -1;
+  }
+
+  auto expression_type = expression->GetExpressionType();
+  switch (expression_type) {
+    case ExpressionType::VALUE_TUPLE: {
+      auto tuple_value =
+          static_cast<const TupleValueExpression *>(expression);
+      auto type_id = tuple_value->GetValueType();
+      if (!IsSupportedType(type_id) || tuple_value->GetColumnId() < 0 ||
+          tuple_value->GetTupleId() < 0 || tuple_value->GetTupleId() > 1) {
+        return -1;
+      }
+      uint32_t tuple_index = tuple_value->GetTupleId();
+      oid_t column_id = tuple_value->GetColumnId();
+
+      // Every column is loaded only once
+      for (auto &load : loads_) {
+        if (load.tuple_index == tuple_index && load.column_id == column_id) {
+          return load.destination;
+        }
+      }
+      int destination = AllocateRegister(type_id);
+      if (destination < 0) {
+        return -1;
+      }
+      loads_.push_back(
+          {static_cast<uint8_t>(destination), tuple_index, column_id});
+      return destination;
+    }
+
+    case ExpressionType::VALUE_CONSTANT: {
+      auto value =
+          static_cast<const ConstantValueExpression *>(expression)->GetValue();
+      auto type_id = value.GetTypeId();
+      if (!IsSupportedType(type_id)) {
+        return -1;
+      }
+      int destination = AllocateRegister(type_id);
+      if (destination < 0) {
+        return -1;
+      }
+      Register &initial = initial_registers_[destination];
+      if (value.IsNull()) {
+        initial_nulls_ |= 1ull << destination;
+        return destination;
+      }
+      switch (type_id) {
+        case type::Type::BOOLEAN:
+        case type::Type::TINYINT:
+          initial.integer = value.GetAs<int8_t>();
+          break;
+        case type::Type::SMALLINT:
+          initial.integer = value.GetAs<int16_t>();
+          break;
+        case type::Type::INTEGER:
+          initial.integer = value.GetAs<int32_t>();
+          break;
+        case type::Type::BIGINT:
+        case type::Type::TIMESTAMP:
+          initial.integer = value.GetAs<int64_t>();
+          break;
+        case type::Type::DECIMAL:
+          initial.decimal = value.GetAs<double>();
+          break;
+        default:
+          constants_.push_back(value);
+          initial.varchar.data = constants_.back().GetData();
+          initial.varchar.length = constants_.back().GetLength();
+          break;
+      }
+      return destination;
+    }
+
+    case ExpressionType::COMPARE_EQUAL:
+    case ExpressionType::COMPARE_NOTEQUAL:
+    case ExpressionType::COMPARE_LESSTHAN:
+    case ExpressionType::COMPARE_GREATERTHAN:
+    case ExpressionType::COMPARE_LESSTHANOREQUALTO:
+    case ExpressionType::COMPARE_GREATERTHANOREQUALTO: {
+      int left = CompileNode(expression->GetChild(0));
+      int right = CompileNode(expression->GetChild(1));
+      if (left < 0 || right < 0) {
+        return -1;
+      }
+      auto left_type = register_types_[left];
+      auto right_type = register_types_[right];
+
+      OpCode first;
+      if (left_type == type::Type::VARCHAR &&
+          right_type == type::Type::VARCHAR) {
+        first = OpCode::EQUAL_VARCHAR;
+      } else if (IsNumericType(left_type) && IsNumericType(right_type)) {
+        if (left_type == type::Type::DECIMAL ||
+            right_type == type::Type::DECIMAL) {
+          left = ToDecimal(left);
+          right = ToDecimal(right);
+          if (left < 0 || right < 0) {
+            return -1;
+          }
+          first = OpCode::EQUAL_DECIMAL;
+        } else {
+          first = OpCode::EQUAL_INTEGER;
+        }
+      } else if (left_type == right_type && IsIntegerType(left_type)) {
+        // Booleans and timestamps
+        first = OpCode::EQUAL_INTEGER;
+      } else {
+        return -1;
+      }
+
+      int destination = AllocateRegister(type::Type::BOOLEAN);
+      if (destination < 0) {
+        return -1;
+      }
+      auto op_code = static_cast<OpCode>(static_cast<int>(first) +
+                                         GetComparisonOffset(expression_type));
+      instructions_.push_back({op_code, static_cast<uint8_t>(destination),
+                               static_cast<uint8_t>(left),
+                               static_cast<uint8_t>(right), 0, 0});
+      return destination;
+    }
+
+    case ExpressionType::CONJUNCTION_AND:
+    case ExpressionType::CONJUNCTION_OR:
+    case ExpressionType::OPERATOR_NOT: {
+      int left = CompileNode(expression->GetChild(0));
+      int right = left;
+      if (expression_type != ExpressionType::OPERATOR_NOT) {
+        right = CompileNode(expression->GetChild(1));
+      }
+      if (left < 0 || right < 0 ||
+          register_types_[left] != type::Type::BOOLEAN ||
+          register_types_[right] != type::Type::BOOLEAN) {
+        return -1;
+      }
+      int destination = AllocateRegister(type::Type::BOOLEAN);
+      if (destination < 0) {
+        return -1;
+      }
+      OpCode op_code = OpCode::NOT;
+      if (expression_type == ExpressionType::CONJUNCTION_AND) {
+        op_code = OpCode::AND;
+      } else if (expression_type == ExpressionType::CONJUNCTION_OR) {
+        op_code = OpCode::OR;
+      }
+      instructions_.push_back({op_code, static_cast<uint8_t>(destination),
+                               static_cast<uint8_t>(left),
+                               static_cast<uint8_t>(right), 0, 0});
+      return destination;
+    }
+
+    case ExpressionType::OPERATOR_PLUS:
+    case ExpressionType::OPERATOR_MINUS:
+    case ExpressionType::OPERATOR_MULTIPLY:
+    case ExpressionType::OPERATOR_DIVIDE:
+    case ExpressionType::OPERATOR_MOD:
+    case ExpressionType::OPERATOR_UNARY_MINUS: {
+      int left, right;
+      if (expression_type == ExpressionType::OPERATOR_UNARY_MINUS) {
+        // Evaluated as 0 - child, like OperatorUnaryMinusExpression
+        left = AllocateRegister(type::Type::INTEGER);
+        right = CompileNode(expression->GetChild(0));
+      } else {
+        left = CompileNode(expression->GetChild(0));
+        right = CompileNode(expression->GetChild(1));
+      }
+      if (left < 0 || right < 0 || !IsNumericType(register_types_[left]) ||
+          !IsNumericType(register_types_[right])) {
+        return -1;
+      }
+
+      // The wider type of both operands, as in DeduceExpressionType
+      auto result_type =
+          std::max(register_types_[left], register_types_[right]);
+      bool is_decimal = (result_type == type::Type::DECIMAL);
+      if (is_decimal) {
+        if (expression_type == ExpressionType::OPERATOR_MOD) {
+          return -1;
+        }
+        left = ToDecimal(left);
+        right = ToDecimal(right);
+        if (left < 0 || right < 0) {
+          return -1;
+        }
+      }
+
+      OpCode op_code;
+      switch (expression_type) {
+        case ExpressionType::OPERATOR_PLUS:
+          op_code = is_decimal ? OpCode::ADD_DECIMAL : OpCode::ADD_INTEGER;
+          break;
+        case ExpressionType::OPERATOR_MULTIPLY:
+          op_code =
+              is_decimal ? OpCode::MULTIPLY_DECIMAL : OpCode::MULTIPLY_INTEGER;
+          break;
+        case ExpressionType::OPERATOR_DIVIDE:
+          op_code = is_decimal ? OpCode::DIVIDE_DECIMAL : OpCode::DIVIDE_INTEGER;
+          break;
+        case ExpressionType::OPERATOR_MOD:
+          op_code = OpCode::MODULO_INTEGER;
+          break;
+        default:
+          op_code =
+              is_decimal ? OpCode::SUBTRACT_DECIMAL : OpCode::SUBTRACT_INTEGER;
+          break;
+      }
+
+      int destination = AllocateRegister(result_type);
+      if (destination < 0) {
+        return -1;
+      }
+      int64_t min, max;
+      GetIntegerRange(result_type, min, max);
+      instructions_.push_back({op_code, static_cast<uint8_t>(destination),
+                               static_cast<uint8_t>(left),
+                               static_cast<uint8_t>(right), min, max});
+      return destination;
+    }
+
+    default:
+      return -1;
+  }
+}
+
+//===----------------------------------------------------------------------===//
+// Evaluation
+//===----------------------------------------------------------------------===//
+
+bool CompiledExpression::ReadStorage(type::Type::TypeId type_id,
+                                     const char *location, Register &value) {
+  switch (type_id) {
+    case type::Type::BOOLEAN:
+    case type::Type::TINYINT: {
+      int8_t data = *reinterpret_cast<const int8_t *>(location);
+      value.integer = data;
+      return data == type::PELOTON_INT8_NULL;
+    }
+    case type::Type::SMALLINT: {
+      int16_t data = *reinterpret_cast<const int16_t *>(location);
+      value.integer = data;
+      return data == type::PELOTON_INT16_NULL;
+    }
+    case type::Type::INTEGER: {
+      int32_t data = *reinterpret_cast<const int32_t *>(location);
+      value.integer = data;
+      return data == type::PELOTON_INT32_NULL;
+    }
+    case type::Type::BIGINT: {
+      int64_t data = *reinterpret_cast<const int64_t *>(location);
+      value.integer = data;
+      return data == type::PELOTON_INT64_NULL;
+    }
+    case type::Type::TIMESTAMP: {
+      uint64_t data = *reinterpret_cast<const uint64_t *>(location);
+      value.integer = static_cast<int64_t>(data);
+      return data == type::PELOTON_TIMESTAMP_NULL;
+    }
+    case type::Type::DECIMAL: {
+      double data = *reinterpret_cast<const double *>(location);
+      value.decimal = data;
+      return data == type::PELOTON_DECIMAL_NULL;
+    }
+    default: {
+      // Uninlined varlen: a pointer to the length followed by the data
+      const char *data = *reinterpret_cast<const char *const *>(location);
+      if (data == nullptr) {
+        return true;
+      }
+      value.varchar.length = *reinterpret_cast<const uint32_t *>(data);
+      value.varchar.data = data + sizeof(uint32_t);
+      return false;
+    }
+  }
+}
+
+void CompiledExpression::WriteStorage(type::Type::TypeId type_id,
+                                      const Register &value, bool is_null,
+                                      char *location) {
+  switch (type_id) {
+    case type::Type::BOOLEAN:
+    case type::Type::TINYINT:
+      *reinterpret_cast<int8_t *>(location) =
+          is_null ? type::PELOTON_INT8_NULL
+                  : static_cast<int8_t>(value.integer);
+      break;
+    case type::Type::SMALLINT:
+      *reinterpret_cast<int16_t *>(location) =
+          is_null ? type::PELOTON_INT16_NULL
+                  : static_cast<int16_t>(value.integer);
+      break;
+    case type::Type::INTEGER:
+      *reinterpret_cast<int32_t *>(location) =
+          is_null ? type::PELOTON_INT32_NULL
+                  : static_cast<int32_t>(value.integer);
+      break;
+    case type::Type::BIGINT:
+      *reinterpret_cast<int64_t *>(location) =
+          is_null ? type::PELOTON_INT64_NULL : value.integer;
+      break;
+    case type::Type::TIMESTAMP:
+      *reinterpret_cast<uint64_t *>(location) =
+          is_null ? type::PELOTON_TIMESTAMP_NULL
+                  : static_cast<uint64_t>(value.integer);
+      break;
+    default:
+      PL_ASSERT(type_id == type::Type::DECIMAL);
+      *reinterpret_cast<double *>(location) =
+          is_null ? type::PELOTON_DECIMAL_NULL : value.decimal;
+      break;
+  }
+}
+
+bool CompiledExpression::ReadValue(type::Type::TypeId type_id,
+                                   type::Value value,
+                                   Register &destination) const {
+  if (value.GetTypeId() != type_id) {
+    value = value.CastAs(type_id);
+  }
+  if (value.IsNull()) {
+    return true;
+  }
+
+  switch (type_id) {
+    case type::Type::BOOLEAN:
+    case type::Type::TINYINT:
+      destination.integer = value.GetAs<int8_t>();
+      break;
+    case type::Type::SMALLINT:
+      destination.integer = value.GetAs<int16_t>();
+      break;
+    case type::Type::INTEGER:
+      destination.integer = value.GetAs<int32_t>();
+      break;
+    case type::Type::BIGINT:
+    case type::Type::TIMESTAMP:
+      destination.integer = value.GetAs<int64_t>();
+      break;
+    case type::Type::DECIMAL:
+      destination.decimal = value.GetAs<double>();
+      break;
+    default:
+      // The value may own its data
+      loaded_values_.push_back(value);
+      destination.varchar.data = loaded_values_.back().GetData();
+      destination.varchar.length = loaded_values_.back().GetLength();
+      break;
+  }
+  return false;
+}
+
+void CompiledExpression::LoadTuples(const AbstractTuple *tuple1,
+                                    const AbstractTuple *tuple2,
+                                    Register *registers,
+                                    uint64_t &nulls) const {
+  loaded_values_.clear();
+  for (auto &load : loads_) {
+    const AbstractTuple *tuple = (load.tuple_index == 0) ? tuple1 : tuple2;
+    PL_ASSERT(tuple != nullptr);
+
+    if (ReadValue(register_types_[load.destination],
+                  tuple->GetValue(load.column_id),
+                  registers[load.destination])) {
+      nulls |= 1ull << load.destination;
+    }
+  }
+}
+
+void CompiledExpression::Execute(Register *registers, uint64_t &nulls) const {
+  for (auto &instruction : instructions_) {
+    Register &destination = registers[instruction.destination];
+    const Register &left = registers[instruction.left];
+    const Register &right = registers[instruction.right];
+    bool left_null = (nulls >> instruction.left) & 1;
+    bool right_null = (nulls >> instruction.right) & 1;
+    uint64_t destination_bit = 1ull << instruction.destination;
+
+    // Three-valued logic
+    if (instruction.op_code == OpCode::AND) {
+      if (!left_null && !right_null) {
+        destination.integer = left.integer && right.integer;
+      } else if ((!left_null && !left.integer) ||
+                 (!right_null && !right.integer)) {
+        destination.integer = 0;
+      } else {
+        nulls |= destination_bit;
+      }
+      continue;
+    }
+    if (instruction.op_code == OpCode::OR) {
+      if (!left_null && !right_null) {
+        destination.integer = left.integer || right.integer;
+      } else if ((!left_null && left.integer) ||
+                 (!right_null && right.integer)) {
+        destination.integer = 1;
+      } else {
+        nulls |= destination_bit;
+      }
+      continue;
+    }
+
+    // Everything else is NULL if an operand is NULL
+    if (left_null || right_null) {
+      nulls |= destination_bit;
+      continue;
+    }
+
+    switch (instruction.op_code) {
+      case OpCode::INTEGER_TO_DECIMAL:
+        destination.decimal = static_cast<double>(left.integer);
+        break;
+
+      case OpCode::ADD_INTEGER:
+        if (__builtin_add_overflow(left.integer, right.integer,
+                                   &destination.integer) ||
+            destination.integer < instruction.min ||
+            destination.integer > instruction.max) {
+          ThrowOutOfRange();
+        }
+        break;
+      case OpCode::SUBTRACT_INTEGER:
+        if (__builtin_sub_overflow(left.integer, right.integer,
+                                   &destination.integer) ||
+            destination.integer < instruction.min ||
+            destination.integer > instruction.max) {
+          ThrowOutOfRange();
+        }
+        break;
+      case OpCode::MULTIPLY_INTEGER:
+        if (__builtin_mul_overflow(left.integer, right.integer,
+                                   &destination.integer) ||
+            destination.integer < instruction.min ||
+            destination.integer > instruction.max) {
+          ThrowOutOfRange();
+        }
+        break;
+      case OpCode::DIVIDE_INTEGER:
+        if (right.integer == 0) {
+          ThrowDivideByZero();
+        }
+        if (left.integer == INT64_MIN && right.integer == -1) {
+          ThrowOutOfRange();
+        }
+        destination.integer = left.integer / right.integer;
+        if (destination.integer < instruction.min ||
+            destination.integer > instruction.max) {
+          ThrowOutOfRange();
+        }
+        break;
+      case OpCode::MODULO_INTEGER:
+        if (right.integer == 0) {
+          ThrowDivideByZero();
+        }
+        destination.integer =
+            (right.integer == -1) ? 0 : left.integer % right.integer;
+        break;
+
+      case OpCode::ADD_DECIMAL:
+        destination.decimal = left.decimal + right.decimal;
+        break;
+      case OpCode::SUBTRACT_DECIMAL:
+        destination.decimal = left.decimal - right.decimal;
+        break;
+      case OpCode::MULTIPLY_DECIMAL:
+        destination.decimal = left.decimal * right.decimal;
+        break;
+      case OpCode::DIVIDE_DECIMAL:
+        if (right.decimal == 0) {
+          ThrowDivideByZero();
+        }
+        destination.decimal = left.decimal / right.decimal;
+        break;
+
+      case OpCode::EQUAL_INTEGER:
+        destination.integer = left.integer == right.integer;
+        break;
+      case OpCode::NOT_EQUAL_INTEGER:
+        destination.integer = left.integer != right.integer;
+        break;
+      case OpCode::LESS_THAN_INTEGER:
+        destination.integer = left.integer < right.integer;
+        break;
+      case OpCode::GREATER_THAN_INTEGER:
+        destination.integer = left.integer > right.integer;
+        break;
+      case OpCode::LESS_THAN_OR_EQUAL_INTEGER:
+        destination.integer = left.integer <= right.integer;
+        break;
+      case OpCode::GREATER_THAN_OR_EQUAL_INTEGER:
+        destination.integer = left.integer >= right.integer;
+        break;
+
+      case OpCode::EQUAL_DECIMAL:
+        destination.integer = left.decimal == right.decimal;
+        break;
+      case OpCode::NOT_EQUAL_DECIMAL:
+        destination.integer = left.decimal != right.decimal;
+        break;
+      case OpCode::LESS_THAN_DECIMAL:
+        destination.integer = left.decimal < right.decimal;
+        break;
+      case OpCode::GREATER_THAN_DECIMAL:
+        destination.integer = left.decimal > right.decimal;
+        break;
+      case OpCode::LESS_THAN_OR_EQUAL_DECIMAL:
+        destination.integer = left.decimal <= right.decimal;
+        break;
+      case OpCode::GREATER_THAN_OR_EQUAL_DECIMAL:
+        destination.integer = left.decimal >= right.decimal;
+        break;
+
+      case OpCode::NOT:
+        destination.integer = !left.integer;
+        break;
+
+      default: {
+        // Varchar comparisons
+        int cmp = type::TypeUtil::CompareStrings(
+            left.varchar.data, left.varchar.length, right.varchar.data,
+            right.varchar.length);
+        switch (instruction.op_code) {
+          case OpCode::EQUAL_VARCHAR:
+            destination.integer = cmp == 0;
+            break;
+          case OpCode::NOT_EQUAL_VARCHAR:
+            destination.integer = cmp != 0;
+            break;
+          case OpCode::LESS_THAN_VARCHAR:
+            destination.integer = cmp < 0;
+            break;
+          case OpCode::GREATER_THAN_VARCHAR:
+            destination.integer = cmp > 0;
+            break;
+          case OpCode::LESS_THAN_OR_EQUAL_VARCHAR:
+            destination.integer = cmp <= 0;
+            break;
+          default:
+            destination.integer = cmp >= 0;
+            break;
+        }
+        break;
+      }
+    }
+  }
+}
+
+type::Value CompiledExpression::GetResult(const Register &result,
+                                          bool is_null) const {
+  auto type_id = register_types_[result_register_];
+  if (is_null) {
+    return type::ValueFactory::GetNullValueByType(type_id);
+  }
+
+  switch (type_id) {
+    case type::Type::BOOLEAN:
+      return type::ValueFactory::GetBooleanValue(result.integer != 0);
+    case type::Type::TINYINT:
+      return type::ValueFactory::GetTinyIntValue(
+          static_cast<int8_t>(result.integer));
+    case type::Type::SMALLINT:
+      return type::ValueFactory::GetSmallIntValue(
+          static_cast<int16_t>(result.integer));
+    case type::Type::INTEGER:
+      return type::ValueFactory::GetIntegerValue(
+          static_cast<int32_t>(result.integer));
+    case type::Type::BIGINT:
+      return type::ValueFactory::GetBigIntValue(result.integer);
+    case type::Type::TIMESTAMP:
+      return type::ValueFactory::GetTimestampValue(result.integer);
+    default:
+      return type::ValueFactory::GetDecimalValue(result.decimal);
+  }
+}
+
+type::Value CompiledExpression::Evaluate(const AbstractTuple *tuple1,
+                                         const AbstractTuple *tuple2) const {
+  Register registers[COMPILED_EXPRESSION_MAX_REGISTERS];
+  std::memcpy(registers, initial_registers_.data(),
+              initial_registers_.size() * sizeof(Register));
+  uint64_t nulls = initial_nulls_;
+
+  LoadTuples(tuple1, tuple2, registers, nulls);
+  Execute(registers, nulls);
+  return GetResult(registers[result_register_],
+                   (nulls >> result_register_) & 1);
+}
+
+void CompiledExpression::Filter(storage::TileGroup *tile_group,
+                                std::vector<oid_t> &tuple_ids) const {
+  PL_ASSERT(register_types_[result_register_] == type::Type::BOOLEAN);
+
+  Register registers[COMPILED_EXPRESSION_MAX_REGISTERS];
+  size_t register_size = initial_registers_.size() * sizeof(Register);
+
+  // Bind the loads to the columns of the tile group
+  std::vector<const storage::ColumnAccessor *> bound_loads;
+  bool bound = true;
+  for (auto &load : loads_) {
+    if (load.tuple_index != 0) {
+      bound = false;
+      break;
+    }
+    auto &column = tile_group->GetColumnAccessor(load.column_id);
+    auto type_id = register_types_[load.destination];
+    if (column.GetType() != type_id ||
+        (type_id == type::Type::VARCHAR && column.IsInlined())) {
+      bound = false;
+      break;
+    }
+    bound_loads.push_back(&column);
+  }
+
+  size_t kept = 0;
+  for (auto tuple_id : tuple_ids) {
+    std::memcpy(registers, initial_registers_.data(), register_size);
+    uint64_t nulls = initial_nulls_;
+
+    if (bound) {
+      for (size_t i = 0; i < loads_.size(); i++) {
+        auto destination = loads_[i].destination;
+        const char *location = bound_loads[i]->GetFieldLocation(tuple_id);
+        if (ReadStorage(register_types_[destination], location,
+                        registers[destination])) {
+          nulls |= 1ull << destination;
+        }
+      }
+    } else {
+      ContainerTuple<storage::TileGroup> tuple(tile_group, tuple_id);
+      LoadTuples(&tuple, nullptr, registers, nulls);
+    }
+
+    Execute(registers, nulls);
+    if (!((nulls >> result_register_) & 1) &&
+        registers[result_register_].integer != 0) {
+      tuple_ids[kept++] = tuple_id;
+    }
+  }
+  tuple_ids.resize(kept);
+}
+
+//===----------------------------------------------------------------------===//
+// Batch Evaluation
+//===----------------------------------------------------------------------===//
+
+void CompiledExpression::ExecuteBatch(Register *registers, uint64_t *nulls,
+                                      size_t count) const {
+  const size_t words = (count + 63) / 64;
+
+  for (auto &instruction : instructions_) {
+    Register *destination =
+        registers + instruction.destination * COMPILED_EXPRESSION_BATCH_SIZE;
+    const Register *left =
+        registers + instruction.left * COMPILED_EXPRESSION_BATCH_SIZE;
+    const Register *right =
+        registers + instruction.right * COMPILED_EXPRESSION_BATCH_SIZE;
+    uint64_t *destination_nulls =
+        nulls + instruction.destination * batch_null_words;
+    const uint64_t *left_nulls = nulls + instruction.left * batch_null_words;
+    const uint64_t *right_nulls = nulls + instruction.right * batch_null_words;
+    const int64_t min = instruction.min;
+    const int64_t max = instruction.max;
+
+    // Three-valued logic
+    if (instruction.op_code == OpCode::AND ||
+        instruction.op_code == OpCode::OR) {
+      // A known operand value decides the result of the whole conjunction
+      const int64_t decisive = (instruction.op_code == OpCode::OR);
+      std::memset(destination_nulls, 0, words * sizeof(uint64_t));
+      for (size_t row = 0; row < count; row++) {
+        bool left_null = IsNullRow(left_nulls, row);
+        bool right_null = IsNullRow(right_nulls, row);
+        bool left_decides = !left_null && (left[row].integer != 0) == decisive;
+        bool right_decides =
+            !right_null && (right[row].integer != 0) == decisive;
+        if (left_decides || right_decides) {
+          destination[row].integer = decisive;
+        } else if (left_null || right_null) {
+          SetNullRow(destination_nulls, row);
+        } else {
+          destination[row].integer = !decisive;
+        }
+      }
+      continue;
+    }
+
+    // Everything else is NULL if an operand is NULL
+    for (size_t word = 0; word < words; word++) {
+      destination_nulls[word] = left_nulls[word] | right_nulls[word];
+    }
+
+    // Applies the operation to every row. Operations that may throw or
+    // dereference their operands only run for the rows that are not NULL.
+    auto map = [&](auto operation) {
+      for (size_t row = 0; row < count; row++) {
+        operation(destination[row], left[row], right[row]);
+      }
+    };
+    auto map_valid = [&](auto operation) {
+      for (size_t row = 0; row < count; row++) {
+        if (!IsNullRow(destination_nulls, row)) {
+          operation(destination[row], left[row], right[row]);
+        }
+      }
+    };
+    auto compare_varchar = [&](auto predicate) {
+      map_valid([predicate](Register &d, const Register &l, const Register &r) {
+        d.integer = predicate(type::TypeUtil::CompareStrings(
+            l.varchar.data, l.varchar.length, r.varchar.data,
+            r.varchar.length));
+      });
+    };
+
+    switch (instruction.op_code) {
+      case OpCode::INTEGER_TO_DECIMAL:
+        map([](Register &d, const Register &l, const Register &) {
+          d.decimal = static_cast<double>(l.integer);
+        });
+        break;
+
+      case OpCode::ADD_INTEGER:
+        map_valid([min, max](Register &d, const Register &l,
+                             const Register &r) {
+          if (__builtin_add_overflow(l.integer, r.integer, &d.integer) ||
+              d.integer < min || d.integer > max) {
+            ThrowOutOfRange();
+          }
+        });
+        break;
+      case OpCode::SUBTRACT_INTEGER:
+        map_valid([min, max](Register &d, const Register &l,
+                             const Register &r) {
+          if (__builtin_sub_overflow(l.integer, r.integer, &d.integer) ||
+              d.integer < min || d.integer > max) {
+            ThrowOutOfRange();
+          }
+        });
+        break;
+      case OpCode::MULTIPLY_INTEGER:
+        map_valid([min, max](Register &d, const Register &l,
+                             const Register &r) {
+          if (__builtin_mul_overflow(l.integer, r.integer, &d.integer) ||
+              d.integer < min || d.integer > max) {
+            ThrowOutOfRange();
+          }
+        });
+        break;
+      case OpCode::DIVIDE_INTEGER:
+        map_valid([min, max](Register &d, const Register &l,
+                             const Register &r) {
+          if (r.integer == 0) {
+            ThrowDivideByZero();
+          }
+          if (l.integer == INT64_MIN && r.integer == -1) {
+            ThrowOutOfRange();
+          }
+          d.integer = l.integer / r.integer;
+          if (d.integer < min || d.integer > max) {
+            ThrowOutOfRange();
+          }
+        });
+        break;
+      case OpCode::MODULO_INTEGER:
+        map_valid([](Register &d, const Register &l, const Register &r) {
+          if (r.integer == 0) {
+            ThrowDivideByZero();
+          }
+          d.integer = (r.integer == -1) ? 0 : l.integer % r.integer;
+        });
+        break;
+
+      case OpCode::ADD_DECIMAL:
+        map([](Register &d, const Register &l, const Register &r) {
+          d.decimal = l.decimal + r.decimal;
+        });
+        break;
+      case OpCode::SUBTRACT_DECIMAL:
+        map([](Register &d, const Register &l, const Register &r) {
+          d.decimal = l.decimal - r.decimal;
+        });
+        break;
+      case OpCode::MULTIPLY_DECIMAL:
+        map([](Register &d, const Register &l, const Register &r) {
+          d.decimal = l.decimal * r.decimal;
+        });
+        break;
+      case OpCode::DIVIDE_DECIMAL:
+        map_valid([](Register &d, const Register &l, const Register &r) {
+          if (r.decimal == 0) {
+            ThrowDivideByZero();
+          }
+          d.decimal = l.decimal / r.decimal;
+        });
+        break;
+
+      case OpCode::EQUAL_INTEGER:
+        map([](Register &d, const Register &l, const Register &r) {
+          d.integer = l.integer == r.integer;
+        });
+        break;
+      case OpCode::NOT_EQUAL_INTEGER:
+        map([](Register &d, const Register &l, const Register &r) {
+          d.integer = l.integer != r.integer;
+        });
+        break;
+      case OpCode::LESS_THAN_INTEGER:
+        map([](Register &d, const Register &l, const Register &r) {
+          d.integer = l.integer < r.integer;
+        });
+        break;
+      case OpCode::GREATER_THAN_INTEGER:
+        map([](Register &d, const Register &l, const Register &r) {
+          d.integer = l.integer > r.integer;
+        });
+        break;
+      case OpCode::LESS_THAN_OR_EQUAL_INTEGER:
+        map([](Register &d, const Register &l, const Register &r) {
+          d.integer = l.integer <= r.integer;
+        });
+        break;
+      case OpCode::GREATER_THAN_OR_EQUAL_INTEGER:
+        map([](Register &d, const Register &l, const Register &r) {
+          d.integer = l.integer >= r.integer;
+        });
+        break;
+
+      case OpCode::EQUAL_DECIMAL:
+        map([](Register &d, const Register &l, const Register &r) {
+          d.integer = l.decimal == r.decimal;
+        });
+        break;
+      case OpCode::NOT_EQUAL_DECIMAL:
+        map([](Register &d, const Register &l, const Register &r) {
+          d.integer = l.decimal != r.decimal;
+        });
+        break;
+      case OpCode::LESS_THAN_DECIMAL:
+        map([](Register &d, const Register &l, const Register &r) {
+          d.integer = l.decimal < r.decimal;
+        });
+        break;
+      case OpCode::GREATER_THAN_DECIMAL:
+        map([](Register &d, const Register &l, const Register &r) {
+          d.integer = l.decimal > r.decimal;
+        });
+        break;
+      case OpCode::LESS_THAN_OR_EQUAL_DECIMAL:
+        map([](Register &d, const Register &l, const Register &r) {
+          d.integer = l.decimal <= r.decimal;
+        });
+        break;
+      case OpCode::GREATER_THAN_OR_EQUAL_DECIMAL:
+        map([](Register &d, const Register &l, const Register &r) {
+          d.integer = l.decimal >= r.decimal;
+        });
+        break;
+
+      case OpCode::EQUAL_VARCHAR:
+        compare_varchar([](int cmp) { return cmp == 0; });
+        break;
+      case OpCode::NOT_EQUAL_VARCHAR:
+        compare_varchar([](int cmp) { return cmp != 0; });
+        break;
+      case OpCode::LESS_THAN_VARCHAR:
+        compare_varchar([](int cmp) { return cmp < 0; });
+        break;
+      case OpCode::GREATER_THAN_VARCHAR:
+        compare_varchar([](int cmp) { return cmp > 0; });
+        break;
+      case OpCode::LESS_THAN_OR_EQUAL_VARCHAR:
+        compare_varchar([](int cmp) { return cmp <= 0; });
+        break;
+      case OpCode::GREATER_THAN_OR_EQUAL_VARCHAR:
+        compare_varchar([](int cmp) { return cmp >= 0; });
+        break;
+
+      default:
+        PL_ASSERT(instruction.op_code == OpCode::NOT);
+        map([](Register &d, const Register &l, const Register &) {
+          d.integer = !l.integer;
+        });
+        break;
+    }
+  }
+}
+
+void CompiledExpression::EvaluateBatch(executor::LogicalTile *source_tile,
+                                       const std::vector<oid_t> &tuple_ids,
+                                       storage::Tile *destination,
+                                       oid_t column_id) const {
+  const size_t register_count = register_types_.size();
+  std::vector<Register> registers(register_count *
+                                  COMPILED_EXPRESSION_BATCH_SIZE);
+  std::vector<uint64_t> nulls(register_count * batch_null_words);
+
+  // Constants never change, so they are spread over the batch once
+  for (size_t reg = 0; reg < register_count; reg++) {
+    std::fill_n(registers.begin() + reg * COMPILED_EXPRESSION_BATCH_SIZE,
+                COMPILED_EXPRESSION_BATCH_SIZE, initial_registers_[reg]);
+    if ((initial_nulls_ >> reg) & 1) {
+      std::fill_n(nulls.begin() + reg * batch_null_words, batch_null_words,
+                  ~0ull);
+    }
+  }
+
+  // Bind the loads to the base tiles of the logical tile
+  struct BoundLoad {
+    const executor::LogicalTile::PositionList *positions;
+    storage::Tile *base_tile;
+    size_t offset;
+    bool direct;
+  };
+  const auto &position_lists = source_tile->GetPositionLists();
+  std::vector<BoundLoad> bound_loads;
+  for (auto &load : loads_) {
+    PL_ASSERT(load.tuple_index == 0);
+    const auto &column_info = source_tile->GetColumnInfo(load.column_id);
+    auto base_tile = column_info.base_tile.get();
+    auto schema = base_tile->GetSchema();
+    auto origin_column = column_info.origin_column_id;
+    auto type_id = register_types_[load.destination];
+    bool direct =
+        schema->GetType(origin_column) == type_id &&
+        !(type_id == type::Type::VARCHAR && schema->IsInlined(origin_column));
+    bound_loads.push_back({&position_lists[column_info.position_list_idx],
+                           base_tile, schema->GetOffset(origin_column),
+                           direct});
+  }
+
+  auto result_type = register_types_[result_register_];
+  auto destination_schema = destination->GetSchema();
+  auto destination_type = destination_schema->GetType(column_id);
+  auto destination_offset = destination_schema->GetOffset(column_id);
+
+  for (size_t start = 0; start < tuple_ids.size();
+       start += COMPILED_EXPRESSION_BATCH_SIZE) {
+    size_t count = std::min(tuple_ids.size() - start,
+                            (size_t)COMPILED_EXPRESSION_BATCH_SIZE);
+    loaded_values_.clear();
+
+    // Load the columns of the batch
+    for (size_t i = 0; i < loads_.size(); i++) {
+      auto &load = loads_[i];
+      auto &bound_load = bound_loads[i];
+      auto type_id = register_types_[load.destination];
+      Register *column =
+          registers.data() + load.destination * COMPILED_EXPRESSION_BATCH_SIZE;
+      uint64_t *column_nulls = nulls.data() + load.destination * batch_null_words;
+      std::memset(column_nulls, 0, batch_null_words * sizeof(uint64_t));
+
+      for (size_t row = 0; row < count; row++) {
+        oid_t tuple_id = tuple_ids[start + row];
+        oid_t position = (*bound_load.positions)[tuple_id];
+        bool is_null;
+        if (position == NULL_OID) {
+          is_null = true;
+        } else if (bound_load.direct) {
+          is_null = ReadStorage(
+              type_id,
+              bound_load.base_tile->GetTupleLocation(position) +
+                  bound_load.offset,
+              column[row]);
+        } else {
+          is_null = ReadValue(type_id,
+                              source_tile->GetValue(tuple_id, load.column_id),
+                              column[row]);
+        }
+        if (is_null) {
+          SetNullRow(column_nulls, row);
+        }
+      }
+    }
+
+    ExecuteBatch(registers.data(), nulls.data(), count);
+
+    // Store the results, in place if the column has the type of the result
+    const Register *result =
+        registers.data() + result_register_ * COMPILED_EXPRESSION_BATCH_SIZE;
+    const uint64_t *result_nulls =
+        nulls.data() + result_register_ * batch_null_words;
+    for (size_t row = 0; row < count; row++) {
+      bool is_null = IsNullRow(result_nulls, row);
+      if (destination_type == result_type) {
+        WriteStorage(result_type, result[row], is_null,
+                     destination->GetTupleLocation(start + row) +
+                         destination_offset);
+      } else {
+        auto value = GetResult(result[row], is_null);
+        destination->SetValue(value.CastAs(destination_type), start + row,
+                              column_id);
+      }
+    }
+  }
+}
+
+}  // End expression namespace
+}  // End peloton namespace
@@ -87,10 +87,20 @@ void TransactionLevelGCManager::Running(const int &thread_id) {
 }
 
 
-void TransactionLevelGCManager::RecycleTransaction(std::shared_ptr<GCSet> gc_set, const cid_t &timestamp) {
+void TransactionLevelGCManager::RecycleTransaction(GCSet &gc_set, const cid_t &timestamp) {
+
+  // Reuse a reclaimed garbage context if there is one
+  GarbageContext *gc_context = nullptr;
+  if (free_contexts_.Dequeue(gc_context) == false) {
+    gc_context = new GarbageContext();
+  }
+
+  // The transaction keeps the cleared set of the reused context
+  PL_ASSERT(gc_context->gc_set_.empty());
+  gc_context->gc_set_.swap(gc_set);
+  gc_context->timestamp_ = timestamp;
 
   // Add the garbage context to the lock-free queue
-  std::shared_ptr<GarbageContext> gc_context(new GarbageContext(gc_set, timestamp));
   unlink_queues_[HashToThread(gc_context->timestamp_)]->Enqueue(gc_context);
 }
 
@@ -100,11 +110,11 @@ int TransactionLevelGCManager::Unlink(const int &thread_id, const cid_t &max_cid
 
   // check if any garbage can be unlinked from indexes.
   // every time we garbage collect at most MAX_ATTEMPT_COUNT tuples.
-  std::vector<std::shared_ptr<GarbageContext>> garbages;
+  std::vector<GarbageContext *> garbages;
 
   // First iterate the local unlink queue
   local_unlink_queues_[thread_id].remove_if(
-    [this, &garbages, &tuple_counter, max_cid](const std::shared_ptr<GarbageContext>& garbage_ctx) -> bool {
+    [this, &garbages, &tuple_counter, max_cid](GarbageContext *garbage_ctx) -> bool {
       bool res = garbage_ctx->timestamp_ < max_cid;
       if (res == true) {
         DeleteFromIndexes(garbage_ctx);
@@ -119,7 +129,7 @@ int TransactionLevelGCManager::Unlink(const int &thread_id, const cid_t &max_cid
 
   for (size_t i = 0; i < MAX_ATTEMPT_COUNT; ++i) {
 
-    std::shared_ptr<GarbageContext> garbage_ctx;
+    GarbageContext *garbage_ctx = nullptr;
     // if there's no more tuples in the queue, then break.
     if (unlink_queues_[thread_id]->Dequeue(garbage_ctx) == false) {
       break;
@@ -165,6 +175,10 @@ int TransactionLevelGCManager::Reclaim(const int &thread_id, const cid_t &max_ci
     if (garbage_ts < max_cid) {
       AddToRecycleMap(garbage_ctx);
 
+      // The context can be reused by another transaction
+      garbage_ctx->gc_set_.clear();
+      free_contexts_.Enqueue(garbage_ctx);
+
       // Remove from the original map
       garbage_ctx_entry = reclaim_maps_[thread_id].erase(garbage_ctx_entry);
       gc_counter++;
@@ -178,40 +192,34 @@ int TransactionLevelGCManager::Reclaim(const int &thread_id, const cid_t &max_ci
 }
 
 // Multiple GC thread share the same recycle map
-void TransactionLevelGCManager::AddToRecycleMap(std::shared_ptr<GarbageContext> garbage_ctx) {
+void TransactionLevelGCManager::AddToRecycleMap(GarbageContext *garbage_ctx) {
   
-  for (auto &entry : *(garbage_ctx->gc_set_.get())) {
+  for (auto &entry : garbage_ctx->gc_set_) {
 
     auto &manager = catalog::Manager::GetInstance();
-    auto tile_group = manager.GetTileGroup(entry.first);
+    auto tile_group = manager.GetTileGroup(entry.block);
 
     // During the resetting, a table may deconstruct because of the DROP TABLE request
     if (tile_group == nullptr) {
-      return;
+      continue;
     }
 
-    PL_ASSERT(tile_group != nullptr);
-
     storage::DataTable *table =
       dynamic_cast<storage::DataTable *>(tile_group->GetAbstractTable());
     PL_ASSERT(table != nullptr);
 
     oid_t table_id = table->GetOid();
 
-    for (auto &element : entry.second) {
-
-      // as this transaction has been committed, we should reclaim older versions.
-      ItemPointer location(entry.first, element.first); 
-      
-      // If the tuple being reset no longer exists, just skip it
-      if (ResetTuple(location) == false) {
-        continue;
-      }
-      // if the entry for table_id exists.
-      if (recycle_queue_map_.find(table_id) != recycle_queue_map_.end()) {
-        recycle_queue_map_[table_id]->Enqueue(location);
-      }
+    // as this transaction has been committed, we should reclaim older versions.
+    ItemPointer location(entry.block, entry.offset);
 
+    // If the tuple being reset no longer exists, just skip it
+    if (ResetTuple(location) == false) {
+      continue;
+    }
+    // if the entry for table_id exists.
+    if (recycle_queue_map_.find(table_id) != recycle_queue_map_.end()) {
+      recycle_queue_map_[table_id]->Enqueue(location);
     }
   }
 
@@ -237,6 +245,14 @@ ItemPointer TransactionLevelGCManager::ReturnFreeSlot(const oid_t &table_id) {
   return INVALID_ITEMPOINTER;
 }
 
+void TransactionLevelGCManager::RecycleTupleSlot(const oid_t &table_id,
+                                                 const ItemPointer &location) {
+  auto recycle_queue = recycle_queue_map_.find(table_id);
+  if (recycle_queue != recycle_queue_map_.end()) {
+    recycle_queue->second->Enqueue(location);
+  }
+}
+
 void TransactionLevelGCManager::ClearGarbage(int thread_id) {
   while(!unlink_queues_[thread_id]->IsEmpty() || !local_unlink_queues_[thread_id].empty()) {
     Unlink(thread_id, MAX_CID);
@@ -249,22 +265,18 @@ void TransactionLevelGCManager::ClearGarbage(int thread_id) {
   return;
 }
 
-void TransactionLevelGCManager::DeleteFromIndexes(const std::shared_ptr<GarbageContext>& garbage_ctx) {
-
-  for (auto entry : *(garbage_ctx->gc_set_.get())) {
-    for (auto &element : entry.second) {
-      if (element.second == true) {
-        // only old versions are stored in the gc set.
-        // so we can safely get indirection from the indirection array.
-        auto tile_group = catalog::Manager::GetInstance().GetTileGroup(entry.first);
-        if (tile_group != nullptr){
-          auto tile_group_header = catalog::Manager::GetInstance()
-                                       .GetTileGroup(entry.first)
-                                       ->GetHeader();
-          ItemPointer *indirection = tile_group_header->GetIndirection(element.first);
-
-          DeleteTupleFromIndexes(indirection);
-        }
+void TransactionLevelGCManager::DeleteFromIndexes(const GarbageContext *garbage_ctx) {
+
+  for (auto &entry : garbage_ctx->gc_set_) {
+    if (entry.is_index_deletion == true) {
+      // only old versions are stored in the gc set.
+      // so we can safely get indirection from the indirection array.
+      auto tile_group = catalog::Manager::GetInstance().GetTileGroup(entry.block);
+      if (tile_group != nullptr){
+        auto tile_group_header = tile_group->GetHeader();
+        ItemPointer *indirection = tile_group_header->GetIndirection(entry.offset);
+
+        DeleteTupleFromIndexes(indirection);
       }
     }
   }
@@ -145,6 +145,9 @@ class configuration {
   // whether in holistic indexing mode or not.
   bool holistic_indexing;
 
+  // whether to measure the scan throughput of local and remote NUMA nodes.
+  bool numa_scan;
+
   oid_t multi_stage_idx = 0;
 };
 
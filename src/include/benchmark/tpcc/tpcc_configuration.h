@@ -191,10 +191,13 @@ class configuration {
   // number of gc threads
   bool gc_backend_count;
 
-  // throughput
+  // microseconds to wait for the owner of a tuple, 0 to abort at once
+  int lock_wait_timeout;
+
+  // throughput of committed transactions (goodput)
   double throughput = 0;
 
-  // abort rate
+  // aborts per committed transaction
   double abort_rate = 0;
 
   std::vector<double> profile_throughput;
@@ -225,6 +228,8 @@ void ValidateWarehouseCount(const configuration &state);
 
 void ValidateGCBackendCount(const configuration &state);
 
+void ValidateLockWaitTimeout(const configuration &state);
+
 void WriteOutput();
 
 }  // namespace tpcc
@@ -76,6 +76,9 @@ class configuration {
   // number of gc threads
   bool gc_backend_count;
 
+  // concurrency control protocol
+  ConcurrencyType protocol;
+
   // throughput
   double throughput = 0;
 
@@ -116,6 +119,8 @@ void ValidateZipfTheta(const configuration &state);
 
 void ValidateGCBackendCount(const configuration &state);
 
+void ValidateProtocol(const configuration &state);
+
 void WriteOutput();
 
 }  // namespace ycsb
@@ -31,6 +31,7 @@
 #define TABLE_METRIC_NAME "table_metric"
 #define INDEX_METRIC_NAME "index_metric"
 #define QUERY_METRIC_NAME "query_metric"
+#define LOG_METRIC_NAME "log_metric"
 
 #define QUERY_NUM_PARAM_COL_NAME "num_params"
 #define QUERY_PARAM_TYPE_COL_NAME "param_types"
@@ -161,6 +162,9 @@ class Catalog {
   // Initialize the schema of the query metrics table
   std::unique_ptr<catalog::Schema> InitializeQueryMetricsSchema();
 
+  // Initialize the schema of the log metrics table
+  std::unique_ptr<catalog::Schema> InitializeLogMetricsSchema();
+
   // Get table from a database with its name
   storage::DataTable *GetTableWithName(std::string database_name,
                                        std::string table_name);
@@ -76,5 +76,10 @@ std::unique_ptr<storage::Tuple> GetQueryMetricsCatalogTuple(
     stats::QueryMetric::QueryParamBuf val_buf, int64_t reads, int64_t updates,
     int64_t deletes, int64_t inserts, int64_t latency, int64_t cpu_time,
     int64_t time_stamp, type::AbstractPool *pool);
+
+std::unique_ptr<storage::Tuple> GetLogMetricsCatalogTuple(
+    const catalog::Schema *schema, std::string phase, int64_t count,
+    int64_t average, int64_t median, int64_t perc_99th, int64_t max,
+    int64_t time_stamp, type::AbstractPool *pool);
 }
 }
@@ -0,0 +1,80 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// partition_scheme.h
+//
+// Identification: src/include/catalog/partition_scheme.h
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "common/printable.h"
+#include "type/types.h"
+#include "type/value.h"
+
+namespace peloton {
+namespace catalog {
+
+//===--------------------------------------------------------------------===//
+// Partition Scheme
+//
+// How the tuples of a table are split into partitions by the value of one
+// column. A range scheme with n sorted bounds has n + 1 partitions:
+// partition i holds the values v with bound[i - 1] <= v < bound[i]. A hash
+// scheme spreads the values over a fixed number of partitions. NULLs go to
+// partition 0.
+//===--------------------------------------------------------------------===//
+
+class PartitionScheme : public Printable {
+ public:
+  static std::shared_ptr<const PartitionScheme> CreateRange(
+      oid_t column_id, type::Type::TypeId column_type,
+      const std::vector<type::Value> &bounds);
+
+  static std::shared_ptr<const PartitionScheme> CreateHash(
+      oid_t column_id, type::Type::TypeId column_type, oid_t partition_count);
+
+  inline PartitionType GetPartitionType() const { return partition_type_; }
+
+  inline oid_t GetColumnId() const { return column_id_; }
+
+  inline oid_t GetPartitionCount() const { return partition_count_; }
+
+  inline const std::vector<type::Value> &GetBounds() const { return bounds_; }
+
+  // The partition holding the value of the partition column
+  oid_t GetPartition(const type::Value &value) const;
+
+  // Flags the partitions that may hold tuples with (column <comparison>
+  // value). Comparisons that cannot be mapped to partitions flag all of them.
+  std::vector<bool> GetPartitions(ExpressionType comparison,
+                                  const type::Value &value) const;
+
+  // Get a string representation for debugging
+  const std::string GetInfo() const;
+
+ private:
+  PartitionScheme(PartitionType partition_type, oid_t column_id,
+                  type::Type::TypeId column_type, oid_t partition_count);
+
+  PartitionType partition_type_;
+
+  oid_t column_id_;
+
+  type::Type::TypeId column_type_;
+
+  oid_t partition_count_;
+
+  // sorted upper bounds of all but the last range partition
+  std::vector<type::Value> bounds_;
+};
+
+}  // End catalog namespace
+}  // End peloton namespace
@@ -14,6 +14,7 @@
 
 #include <memory>
 #include "catalog/column.h"
+#include "catalog/partition_scheme.h"
 #include "common/printable.h"
 #include "type/type.h"
 
@@ -186,6 +187,17 @@ class Schema : public Printable {
     }
   }
 
+  // Partitioning of the tuples of the table, nullptr if not partitioned
+  inline void SetPartitionScheme(
+      const std::shared_ptr<const PartitionScheme> &partition_scheme) {
+    partition_scheme_ = partition_scheme;
+  }
+
+  inline const std::shared_ptr<const PartitionScheme> &GetPartitionScheme()
+      const {
+    return partition_scheme_;
+  }
+
   // Get a string representation for debugging
   const std::string GetInfo() const;
 
@@ -209,6 +221,9 @@ class Schema : public Printable {
 
   // keeps track of indexed columns in original table
   std::vector<oid_t> indexed_columns_;
+
+  // partitioning of the table
+  std::shared_ptr<const PartitionScheme> partition_scheme_;
 };
 
 }  // End catalog namespace
@@ -262,6 +262,16 @@ class ContainerTuple<storage::TileGroup> : public AbstractTuple {
     container_->SetValue(val, tuple_id_, column_id);
   }
 
+  /** @brief Copy a column of another tile group tuple into this tuple
+   *  without building a value. */
+  void CopyValue(oid_t column_id, const ContainerTuple &source,
+                 oid_t source_column_id) {
+    container_->GetColumnAccessor(column_id).CopyField(
+        tuple_id_, source.container_->GetColumnAccessor(source_column_id),
+        source.tuple_id_);
+    container_->MarkZoneMapStale();
+  }
+
   inline char *GetData() const override {
     // NOTE: We can't.Get a table tuple from a tilegroup or logical tile
     // without materializing it. So, this must not be used.
@@ -0,0 +1,55 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// numa_util.h
+//
+// Identification: src/include/common/numa_util.h
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace peloton {
+
+// Memory that is not placed on a particular NUMA node
+static const int NUMA_NODE_ANY = -1;
+
+//===--------------------------------------------------------------------===//
+// NUMA Util
+//
+// The NUMA nodes of the host, read once from sysfs. Nodes are numbered
+// densely from 0, in the order of the kernel's node ids. Hosts without
+// NUMA information look like a single node, and then memory placement and
+// thread pinning do nothing.
+//===--------------------------------------------------------------------===//
+
+class NumaUtil {
+ public:
+  static int GetNodeCount();
+
+  // Node of the cpu the calling thread currently runs on
+  static int GetCurrentNode();
+
+  static int GetNodeOfCpu(int cpu);
+
+  static const std::vector<int> &GetNodeCpus(int node);
+
+  // Make the node the preferred node of the pages in the range that are not
+  // faulted in yet. Pages only partly covered by the range are left alone.
+  static void PlaceMemory(void *address, size_t size, int node);
+
+  // Restrict the calling thread to the cpus of the node
+  static bool PinCurrentThread(int node);
+
+  // Parse a sysfs cpu or node list such as "0-3,8,10-11"
+  static std::vector<int> ParseList(const std::string &list);
+};
+
+}  // End peloton namespace
@@ -77,6 +77,11 @@ class Statement : public Printable {
 
   inline void SetNeedsPlan(bool replan) { needs_replan_ = replan; }
 
+  // Whether the statement begins a read only transaction
+  inline bool GetReadOnly() const { return (read_only_); }
+
+  inline void SetReadOnly(bool read_only) { read_only_ = read_only; }
+
   // Get a string representation for debugging
   const std::string GetInfo() const;
 
@@ -105,6 +110,9 @@ class Statement : public Printable {
 
   // If this flag is true, then somebody wants us to replan this query
   bool needs_replan_ = false;
+
+  // BEGIN READ ONLY
+  bool read_only_ = false;
 };
 
 }  // namespace peloton
@@ -22,6 +22,8 @@
 #include <boost/function.hpp>
 
 #include "common/macros.h"
+#include "common/numa_util.h"
+#include "configuration/configuration.h"
 
 namespace peloton {
 // a wrapper for boost worker thread pool.
@@ -40,9 +42,12 @@ class ThreadPool {
     dedicated_thread_count_ = dedicated_thread_count;
 
     for (size_t i = 0; i < pool_size_; ++i) {
-      // add thread to thread pool.
-      thread_pool_.create_thread(
-          boost::bind(&boost::asio::io_service::run, &io_service_));
+      // add thread to thread pool, pinned to the nodes in turn.
+      int numa_node = static_cast<int>(i % NumaUtil::GetNodeCount());
+      thread_pool_.create_thread([this, numa_node]() {
+        if (FLAGS_numa_pin_threads) NumaUtil::PinCurrentThread(numa_node);
+        io_service_.run();
+      });
     }
 
     dedicated_threads_.resize(dedicated_thread_count_);
@@ -144,7 +144,11 @@ public:
   }
 
   cid_t GetReadOnlyTxnCid() {
-    IncreaseQueueTail();
+    // only try to move the queue tail when it can move, so that beginning a
+    // readonly transaction does not write to the shared epoch state
+    if (queue_tail_.load() + safety_interval_ < current_epoch_.load()) {
+      IncreaseQueueTail();
+    }
     return max_cid_ro_;
   }
 
@@ -0,0 +1,80 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// lock_table.h
+//
+// Identification: src/include/concurrency/lock_table.h
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <vector>
+
+#include "common/item_pointer.h"
+#include "type/types.h"
+
+// Number of wait queues, tuples are hashed onto them
+#define LOCK_TABLE_SIZE 1024
+
+// A waiter wakes up at least this often to recheck the owner of the tuple,
+// so a missed notification only delays it
+#define LOCK_WAIT_SLICE_US 100
+
+namespace peloton {
+
+namespace storage {
+class TileGroupHeader;
+}
+
+namespace concurrency {
+
+//===--------------------------------------------------------------------===//
+// Lock Table
+//
+// Wait queues for transactions that wait for the owner of a tuple to release
+// it. Ownership itself stays in the tuple header, the table only parks the
+// waiters: taking the ownership of a tuple nobody waits for does not touch
+// the table, and releasing it takes the latch of its queue.
+//===--------------------------------------------------------------------===//
+
+class LockTable {
+  LockTable(LockTable const &) = delete;
+
+ public:
+  typedef std::chrono::steady_clock::time_point Deadline;
+
+  LockTable();
+
+  static LockTable &GetInstance();
+
+  // Wait until the tuple is no longer owned by the owner or the deadline
+  // passes. Returns whether the owner has released the tuple.
+  bool WaitForRelease(const ItemPointer &location,
+                      const storage::TileGroupHeader *const tile_group_header,
+                      const txn_id_t owner, const Deadline &deadline);
+
+  // Wake up the transactions waiting for the tuple
+  void NotifyRelease(const ItemPointer &location);
+
+ private:
+  struct WaitQueue {
+    std::mutex latch;
+    std::condition_variable released;
+    // protected by the latch
+    int waiter_count = 0;
+  };
+
+  static size_t Hash(const ItemPointer &location);
+
+  std::vector<WaitQueue> queues_;
+};
+
+}  // End concurrency namespace
+}  // End peloton namespace
@@ -0,0 +1,62 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// optimistic_transaction_manager.h
+//
+// Identification: src/include/concurrency/optimistic_transaction_manager.h
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include "concurrency/timestamp_ordering_transaction_manager.h"
+
+namespace peloton {
+namespace concurrency {
+
+//===--------------------------------------------------------------------===//
+// optimistic concurrency control
+//
+// Reads only record the version in the read set, nothing is written to the
+// tuple header. Writes still take the ownership of the latest version, as
+// under timestamp ordering. At commit the transaction draws its commit id
+// and validates its read set: every version it read must still be the latest
+// one and must not be owned by another transaction. The reserved field of
+// the tuple header is left untouched by reads.
+//===--------------------------------------------------------------------===//
+
+class OptimisticTransactionManager
+    : public TimestampOrderingTransactionManager {
+ public:
+  OptimisticTransactionManager() {}
+
+  virtual ~OptimisticTransactionManager() {}
+
+  static OptimisticTransactionManager &GetInstance();
+
+  // Only the latest committed version can be owned.
+  virtual bool IsOwnable(
+      Transaction *const current_txn,
+      const storage::TileGroupHeader *const tile_group_header,
+      const oid_t &tuple_id);
+
+  virtual bool AcquireOwnership(
+      Transaction *const current_txn,
+      const storage::TileGroupHeader *const tile_group_header,
+      const oid_t &tuple_id);
+
+  virtual bool PerformRead(Transaction *const current_txn,
+                           const ItemPointer &location,
+                           bool acquire_ownership = false);
+
+  virtual ResultType CommitTransaction(Transaction *const current_txn);
+
+ private:
+  // Whether the versions read by the transaction are still the latest ones.
+  bool ValidateReadSet(Transaction *const current_txn);
+};
+}
+}
@@ -0,0 +1,97 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// read_write_set.h
+//
+// Identification: src/include/concurrency/read_write_set.h
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <vector>
+
+#include "common/item_pointer.h"
+#include "type/types.h"
+
+// Up to this many entries a lookup scans the entries, beyond it the entries
+// are indexed by an open-addressing hash table
+#define READ_WRITE_SET_SCAN_LIMIT 16
+
+// Buffers kept by every thread for the read/write sets of its transactions
+#define READ_WRITE_SET_POOL_SIZE 8
+
+// Larger buffers are released instead of being kept by the thread
+#define READ_WRITE_SET_MAX_POOLED_ENTRIES 4096
+
+namespace peloton {
+namespace concurrency {
+
+//===--------------------------------------------------------------------===//
+// Read Write Set
+//
+// The tuples a transaction has accessed, as a flat array of
+// (location, type) entries. The arrays are recycled through a per-thread
+// pool, so a transaction that touches a few tuples does not allocate.
+//===--------------------------------------------------------------------===//
+
+class ReadWriteSet {
+  ReadWriteSet(ReadWriteSet const &) = delete;
+  ReadWriteSet &operator=(ReadWriteSet const &) = delete;
+
+ public:
+  struct Entry {
+    ItemPointer location;
+    RWType type;
+  };
+
+  typedef std::vector<Entry>::const_iterator const_iterator;
+
+  ReadWriteSet();
+
+  ~ReadWriteSet();
+
+  // Returns the type recorded for the location, nullptr if there is none
+  RWType *Find(const ItemPointer &location);
+
+  // The location must not be recorded yet
+  void Insert(const ItemPointer &location, RWType type);
+
+  // Remove all entries, keeping the buffers
+  inline void Clear() {
+    entries_.clear();
+    index_.clear();
+  }
+
+  // Order the entries by tile group and slot, so the entries of a tile group
+  // are visited together
+  void SortByTileGroup();
+
+  inline size_t Size() const { return entries_.size(); }
+
+  inline bool IsEmpty() const { return entries_.empty(); }
+
+  inline const_iterator begin() const { return entries_.begin(); }
+
+  inline const_iterator end() const { return entries_.end(); }
+
+ private:
+  static size_t Hash(const ItemPointer &location);
+
+  // Rebuild the hash index over all entries, at most a quarter full
+  void BuildIndex();
+
+  void IndexEntry(uint32_t entry_offset);
+
+  std::vector<Entry> entries_;
+
+  // Entry offset + 1 of every slot, 0 marks an empty slot. Empty as long as
+  // the entries are scanned.
+  std::vector<uint32_t> index_;
+};
+
+}  // End concurrency namespace
+}  // End peloton namespace
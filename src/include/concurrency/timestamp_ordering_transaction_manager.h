@@ -13,10 +13,14 @@
 
 #pragma once
 
+#include "concurrency/lock_table.h"
 #include "concurrency/transaction_manager.h"
 #include "storage/tile_group.h"
 #include "statistics/stats_aggregator.h"
 
+// Ended transactions kept by every thread for reuse
+#define TRANSACTION_POOL_SIZE 16
+
 namespace peloton {
 namespace concurrency {
 
@@ -108,6 +112,12 @@ class TimestampOrderingTransactionManager : public TransactionManager {
 
   virtual void EndReadonlyTransaction(Transaction *current_txn);
 
+ protected:
+  // Install the writes of a transaction that is allowed to commit with the
+  // given commit id, then end it.
+  ResultType InstallTransaction(Transaction *const current_txn,
+                                const cid_t end_commit_id);
+
 private:
   static const int LOCK_OFFSET = 0;
   static const int LAST_READER_OFFSET = (LOCK_OFFSET + 8);
@@ -124,10 +134,22 @@ private:
       const storage::TileGroupHeader *const tile_group_header,
       const oid_t &tuple_id, const cid_t &current_cid);
 
+  // Wait for the transaction owning the tuple to release it, until the
+  // deadline. The deadline is set by the first wait of an operation.
+  bool WaitForOwner(Transaction *const current_txn,
+                    const storage::TileGroupHeader *const tile_group_header,
+                    const oid_t &tuple_id, LockTable::Deadline &deadline);
+
   // Initiate reserved area of a tuple
   void InitTupleReserved(
       const storage::TileGroupHeader *const tile_group_header,
       const oid_t tuple_id);
+
+  // Transactions are reused from a pool of the calling thread. Ended
+  // transactions go back to the pool of the thread that ends them.
+  static Transaction *AcquireTransaction();
+
+  static void ReleaseTransaction(Transaction *txn);
 };
 }
 }
@@ -21,6 +21,7 @@
 #include "common/exception.h"
 #include "common/item_pointer.h"
 #include "common/printable.h"
+#include "concurrency/read_write_set.h"
 #include "type/types.h"
 
 namespace peloton {
@@ -43,20 +44,27 @@ class Transaction : public Printable {
   }
 
   Transaction(const txn_id_t &txn_id, const cid_t &begin_cid, bool ro) {
-    Init(txn_id, begin_cid);
-    declared_readonly_ = ro;
+    Init(txn_id, begin_cid, ro);
   }
 
   ~Transaction() {}
 
-  void Init(const txn_id_t &txn_id, const cid_t &begin_cid) {
+  void Init(const txn_id_t &txn_id, const cid_t &begin_cid,
+            bool ro = false) {
     txn_id_ = txn_id;
     begin_cid_ = begin_cid;
     end_cid_ = MAX_CID;
     is_written_ = false;
-    declared_readonly_ = false;
+    declared_readonly_ = ro;
+    pipelined_commit_ = false;
     insert_count_ = 0;
-    gc_set_.reset(new GCSet());
+    result_ = ResultType::SUCCESS;
+
+    // a recycled transaction keeps the buffers of its sets
+    rw_set_.Clear();
+    gc_set_.clear();
+    updated_columns_.clear();
+    updated_columns_sorted_ = true;
   }
 
   //===--------------------------------------------------------------------===//
@@ -88,13 +96,21 @@ class Transaction : public Printable {
 
   RWType GetRWType(const ItemPointer &);
 
-  inline const ReadWriteSet &GetReadWriteSet() { return rw_set_; }
+  // Columns assigned by the updates of the tuple at the location, recorded
+  // by the update executor while the log writes only those columns
+  void RecordUpdatedColumns(const ItemPointer &location,
+                            const std::vector<oid_t> &columns);
 
-  inline std::shared_ptr<GCSet> GetGCSetPtr() {
-    return gc_set_;
-  }
+  // Fill in the sorted updated columns of the tuple, false if they are
+  // unknown
+  bool GetUpdatedColumns(const ItemPointer &location,
+                         std::vector<oid_t> &columns);
+
+  inline ReadWriteSet &GetReadWriteSet() { return rw_set_; }
+
+  inline GCSet &GetGCSet() { return gc_set_; }
 
-  inline bool IsGCSetEmpty() { return gc_set_->size() == 0; }
+  inline bool IsGCSetEmpty() { return gc_set_.empty(); }
 
   // Get a string representation for debugging
   const std::string GetInfo() const;
@@ -111,6 +127,14 @@ class Transaction : public Printable {
 
   inline bool IsDeclaredReadOnly() const { return declared_readonly_; }
 
+  // A pipelined commit does not wait for its log flush, the session waits
+  // for the flush before it acknowledges the commit
+  inline void SetPipelinedCommit(bool pipelined) {
+    pipelined_commit_ = pipelined;
+  }
+
+  inline bool IsPipelinedCommit() const { return pipelined_commit_; }
+
  private:
   //===--------------------------------------------------------------------===//
   // Data members
@@ -131,7 +155,13 @@ class Transaction : public Printable {
   ReadWriteSet rw_set_;
 
   // this set contains data location that needs to be gc'd in the transaction.
-  std::shared_ptr<GCSet> gc_set_;
+  GCSet gc_set_;
+
+  // (old version, column) of every recorded updated column. The buffer is
+  // kept by a recycled transaction, and sorted on the first lookup.
+  std::vector<std::pair<ItemPointer, oid_t>> updated_columns_;
+
+  bool updated_columns_sorted_;
 
   // result of the transaction
   ResultType result_ = peloton::ResultType::SUCCESS;
@@ -140,6 +170,8 @@ class Transaction : public Printable {
   size_t insert_count_;
 
   bool declared_readonly_;
+
+  bool pipelined_commit_;
 };
 
 }  // End concurrency namespace
@@ -35,10 +35,39 @@ DECLARE_string(socket_family);
 // RESOURCE USAGE
 //===----------------------------------------------------------------------===//
 
+// Memory in bytes the operators of a query that buffer rows may use. Sorts,
+// hash joins and hash aggregations spill to temporary files beyond it, merge
+// joins and set operations only count against it.
+DECLARE_uint64(query_memory);
+
+// Number of threads used by a sort or merge join
+DECLARE_uint64(sort_workers);
+
+DECLARE_bool(numa_placement);
+
+DECLARE_bool(numa_pin_threads);
+
+//===----------------------------------------------------------------------===//
+// CLIENT CONNECTION DEFAULTS
+//===----------------------------------------------------------------------===//
+
+// Run read only autocommit statements on the read only snapshot
+DECLARE_bool(autocommit_snapshot_read);
+
+//===----------------------------------------------------------------------===//
+// LOCK MANAGEMENT
+//===----------------------------------------------------------------------===//
+
+// Microseconds a transaction waits for the owner of a tuple
+DECLARE_uint64(lock_wait_timeout);
+
 //===----------------------------------------------------------------------===//
 // WRITE AHEAD LOG
 //===----------------------------------------------------------------------===//
 
+// Wait for the log flush of autocommit statements once per batch
+DECLARE_bool(pipelined_commit);
+
 //===----------------------------------------------------------------------===//
 // ERROR REPORTING AND LOGGING
 //===----------------------------------------------------------------------===//
@@ -57,6 +86,16 @@ DECLARE_bool(display_configuration);
 // Enable or disable statistics collection
 DECLARE_uint64(stats_mode);
 
+//===----------------------------------------------------------------------===//
+// COPY
+//===----------------------------------------------------------------------===//
+
+// Number of threads used by COPY
+DECLARE_uint64(copy_workers);
+
+// Make COPY TO write one file per worker
+DECLARE_bool(copy_file_per_worker);
+
 //===----------------------------------------------------------------------===//
 // AI
 //===----------------------------------------------------------------------===//
@@ -17,6 +17,7 @@
 
 #include "common/container_tuple.h"
 #include "executor/abstract_executor.h"
+#include "executor/spill_file.h"
 #include "planner/aggregate_plan.h"
 #include "type/value_factory.h"
 
@@ -262,12 +263,18 @@ class AbstractAggregator {
 /**
  * @brief Used when input is NOT sorted.
  * Will maintain an internal hash table.
+ *
+ * The groups are accounted for in the memory budget of the query. Once it
+ * is used up, the groups in memory keep aggregating, while the rows of new
+ * groups are hash partitioned to spill files. Finalize then aggregates the
+ * partitions one at a time, each with an aggregator on the next spill level.
  */
 class HashAggregator : public AbstractAggregator {
  public:
   HashAggregator(const planner::AggregatePlan *node,
                  storage::AbstractTable *output_table,
-                 executor::ExecutorContext *econtext, size_t num_input_columns);
+                 executor::ExecutorContext *econtext, size_t num_input_columns,
+                 size_t spill_level = 0);
 
   bool Advance(AbstractTuple *next_tuple) override;
 
@@ -276,8 +283,26 @@ class HashAggregator : public AbstractAggregator {
   ~HashAggregator();
 
  private:
+  // Reserve memory for a new group of the tuple, false if it should spill
+  bool ReserveGroup(const AbstractTuple *tuple);
+
+  // Free the groups in memory and return their memory to the query
+  void ClearGroups();
+
+  // Aggregate the partitions of the spilled rows one by one
+  bool FinalizeSpilledPartitions();
+
   const size_t num_input_columns;
 
+  /** @brief Partitioning level of the input, 0 unless it was spilled */
+  const size_t spill_level_;
+
+  /** @brief Rows of the groups that did not fit in memory */
+  std::unique_ptr<SpillPartitions> spilled_rows_;
+
+  /** @brief Memory reserved for the groups in memory */
+  size_t memory_reserved_ = 0;
+
   /** List of aggregates for a specific group. */
   struct AggregateList {
     // Keep a deep copy of the first tuple we met of this group
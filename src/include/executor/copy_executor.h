@@ -20,6 +20,15 @@
 #define COPY_BUFFER_SIZE 65536
 #define INVALID_COL_ID -1
 
+// Bytes of the import file handed to a parser thread at a time
+#define COPY_IMPORT_CHUNK_SIZE (1 << 22)
+
+// Chunks read ahead of the parser threads
+#define COPY_IMPORT_QUEUE_DEPTH 4
+
+// Formatted tile groups that may wait for the writer of an export
+#define COPY_EXPORT_WINDOW 16
+
 namespace peloton {
 namespace executor {
 
@@ -37,6 +46,8 @@ class CopyExecutor : public AbstractExecutor {
 
   inline size_t GetTotalBytesWritten() { return total_bytes_written; }
 
+  inline size_t GetTotalTuplesImported() { return total_tuples_imported; }
+
  protected:
   bool DInit();
 
@@ -51,6 +62,12 @@ class CopyExecutor : public AbstractExecutor {
   // Copy and escape the content of column to local buffer
   void Copy(const char *data, int len, bool end_of_line);
 
+  // Parse the file in parallel and append it to the target table
+  void ImportFile();
+
+  // Format the tile groups of the target table in parallel and write them
+  void ExportTable();
+
   //===--------------------------------------------------------------------===//
   // Executor State
   //===--------------------------------------------------------------------===//
@@ -58,6 +75,9 @@ class CopyExecutor : public AbstractExecutor {
   /** @brief Computed the result */
   bool done = false;
 
+  // Whether the export scans the tile groups of the target table itself
+  bool direct_export = false;
+
   // Internal copy buffer
   char buff[COPY_BUFFER_SIZE];
 
@@ -79,6 +99,9 @@ class CopyExecutor : public AbstractExecutor {
   // Total number of bytes written
   size_t total_bytes_written = 0;
 
+  // Total number of tuples imported
+  size_t total_tuples_imported = 0;
+
   // The special column ids in query_metric table
   unsigned int num_param_col_id = INVALID_COL_ID;
   unsigned int param_type_col_id = INVALID_COL_ID;
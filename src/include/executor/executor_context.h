@@ -13,6 +13,8 @@
 
 #pragma once
 
+#include <atomic>
+
 #include "type/ephemeral_pool.h"
 #include "type/value.h"
 
@@ -55,6 +57,25 @@ class ExecutorContext {
   // Get a pool
   type::EphemeralPool *GetPool();
 
+  // Account for memory held by an operator of the query, such as a hash
+  // table. Returns false, without reserving anything, if the query would
+  // exceed its budget; the operator should then spill to disk. Memory still
+  // reserved when the query ends goes away with the context.
+  bool ReserveMemory(size_t bytes);
+
+  // Account for memory held by an operator that can not spill, such as the
+  // buffers of a merge join, whether or not it fits. The operators that can
+  // spill then do so earlier.
+  void ChargeMemory(size_t bytes);
+
+  void ReleaseMemory(size_t bytes);
+
+  size_t GetMemoryUsage() const { return memory_used_; }
+
+  size_t GetMemoryBudget() const { return memory_budget_; }
+
+  void SetMemoryBudget(size_t bytes) { memory_budget_ = bytes; }
+
   // num of tuple processed
   uint32_t num_processed = 0;
 
@@ -72,6 +93,12 @@ class ExecutorContext {
   // pool
   std::unique_ptr<type::EphemeralPool> pool_;
 
+  // memory budget of the query, defaults to FLAGS_query_memory
+  size_t memory_budget_;
+
+  // memory reserved by the operators of the query
+  std::atomic<size_t> memory_used_;
+
 };
 
 }  // namespace executor
@@ -16,9 +16,14 @@
 #include <unordered_map>
 #include <unordered_set>
 
+#include <deque>
+#include <memory>
+
 #include "type/types.h"
+#include "catalog/schema.h"
 #include "executor/abstract_executor.h"
 #include "executor/logical_tile.h"
+#include "executor/spill_file.h"
 #include "common/container_tuple.h"
 
 #include <boost/functional/hash.hpp>
@@ -29,6 +34,11 @@ namespace executor {
 /**
  * @brief Hash executor.
  *
+ * The hash table is accounted for in the memory budget of the query. When it
+ * does not fit, all rows are hash partitioned to spill files instead. Under a
+ * hash join, the join takes the partitions over and partitions its other
+ * input the same way; otherwise the duplicates are removed one partition at
+ * a time, and a partition that still does not fit is partitioned again.
  */
 class HashExecutor : public AbstractExecutor {
  public:
@@ -54,12 +64,48 @@ class HashExecutor : public AbstractExecutor {
     return this->column_ids_;
   }
 
+  // Leave the spilled rows partitioned for the parent hash join
+  inline void SetPartitionedOutput() { partitioned_output_ = true; }
+
+  // Whether the hash table did not fit in memory
+  inline bool IsSpilled() const { return spilled_schema_ != nullptr; }
+
+  // Rows spilled with the partitioned output, nullptr if none were
+  inline std::unique_ptr<SpillPartitions> ReleaseSpilledRows() {
+    return std::move(spilled_rows_);
+  }
+
+  // Physical schema of the spilled rows
+  inline const catalog::Schema *GetSpilledSchema() const {
+    return spilled_schema_.get();
+  }
+
+  // Estimated memory of hashing one row
+  static size_t GetHashedRowSize(oid_t column_count);
+
  protected:
   bool DInit();
 
   bool DExecute();
 
  private:
+  // Add the rows of a child tile to the hash table
+  void HashTile(size_t child_tile_itr);
+
+  // Move the rows of the hash table to spill files, and spill from then on
+  void SpillHashTable(const LogicalTile *tile);
+
+  void SpillTile(LogicalTile *tile);
+
+  // Drop the hash table and its tiles, and return their memory to the query
+  void ClearHashTable();
+
+  // Hash the next spilled partition in memory, returns false when done
+  bool LoadSpilledPartition();
+
+  // Reserve memory for the hash table, true if there is no budget
+  bool ReserveMemory(size_t bytes);
+
   /** @brief Hash table */
   HashMapType hash_table_;
 
@@ -71,6 +117,20 @@ class HashExecutor : public AbstractExecutor {
   bool done_ = false;
 
   size_t result_itr = 0;
+
+  bool partitioned_output_ = false;
+
+  /** @brief Memory reserved for the hash table */
+  size_t memory_reserved_ = 0;
+
+  /** @brief Rows that did not fit in memory */
+  std::unique_ptr<SpillPartitions> spilled_rows_;
+
+  std::unique_ptr<catalog::Schema> spilled_schema_;
+
+  /** @brief Spilled partitions left to remove duplicates from */
+  std::deque<std::pair<std::unique_ptr<SpillFile>, size_t>>
+      spilled_partitions_;
 };
 
 } /* namespace executor */
@@ -19,10 +19,20 @@
 #include "executor/abstract_join_executor.h"
 #include "planner/hash_join_plan.h"
 #include "executor/hash_executor.h"
+#include "executor/spill_file.h"
 
 namespace peloton {
 namespace executor {
 
+/**
+ * @brief Hash join executor.
+ *
+ * When the hash table of the right input spills, the left input is hash
+ * partitioned the same way, and the join runs one pair of partitions at a
+ * time: the right rows are hashed in memory and probed with the left rows,
+ * and the rows of the partitions without a match are output for outer
+ * joins. A pair whose right rows still do not fit is partitioned again.
+ */
 class HashJoinExecutor : public AbstractJoinExecutor {
   HashJoinExecutor(const HashJoinExecutor &) = delete;
   HashJoinExecutor &operator=(const HashJoinExecutor &) = delete;
@@ -37,8 +47,55 @@ class HashJoinExecutor : public AbstractJoinExecutor {
   bool DExecute();
 
  private:
+  // Join the last left tile with the matching rows of the hash table, and
+  // buffer the output tiles
+  void ProbeLeftTile(const HashExecutor::HashMapType &hash_table,
+                     const std::vector<oid_t> &hashed_col_ids);
+
+  //===--------------------------------------------------------------------===//
+  // Grace hash join over the spilled partitions
+  //===--------------------------------------------------------------------===//
+
+  struct PartitionPair {
+    std::unique_ptr<SpillFile> left;
+    std::unique_ptr<SpillFile> right;
+    size_t level;
+  };
+
+  // Partition the left input like the spilled right input
+  void SpillLeftInput();
+
+  // Join the next tiles of the partitions, returns false when all are done
+  bool ExecuteSpilled();
+
+  // Hash the right rows of the pair, or partition the pair again
+  void LoadPartitionPair(PartitionPair &pair);
+
+  void RepartitionPair(PartitionPair &pair);
+
+  // Drop the state of the current pair of partitions
+  void UnloadPartitionPair();
+
   HashExecutor *hash_executor_ = nullptr;
 
+  bool spilled_ = false;
+
+  /** @brief Partition pairs left to join */
+  std::deque<PartitionPair> partition_pairs_;
+
+  /** @brief Hash table of the right rows of the current pair */
+  HashExecutor::HashMapType partition_hash_table_;
+
+  bool partition_loaded_ = false;
+
+  /** @brief Left rows of the current pair */
+  std::unique_ptr<SpillFile> left_partition_;
+
+  std::unique_ptr<catalog::Schema> left_schema_;
+
+  /** @brief Memory reserved for the current pair */
+  size_t partition_memory_ = 0;
+
   bool hashed_ = false;
 
   std::deque<LogicalTile *> buffered_output_tiles;
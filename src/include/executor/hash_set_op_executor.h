@@ -38,6 +38,9 @@ namespace executor {
  * we can simply massage the validation flags of the left child
  * and forward the (logical tiles) upwards.
  * This avoids materialization.
+ *
+ * The hash table and the left tiles are charged to the memory budget of the
+ * query. Set operations do not spill.
  */
 class HashSetOpExecutor : public AbstractExecutor {
  public:
@@ -49,6 +52,8 @@ class HashSetOpExecutor : public AbstractExecutor {
   explicit HashSetOpExecutor(const planner::AbstractPlan *node,
                              ExecutorContext *executor_context);
 
+  ~HashSetOpExecutor();
+
  protected:
   bool DInit();
   bool DExecute();
@@ -87,6 +92,9 @@ class HashSetOpExecutor : public AbstractExecutor {
 
   /** @brief Next tile Id in the vector to return */
   size_t next_tile_to_return_ = 0;
+
+  /** @brief Memory charged to the budget of the query */
+  size_t memory_charged_ = 0;
 };
 
 } /* namespace executor */
@@ -16,6 +16,7 @@
 #include "storage/data_table.h"
 #include "index/index.h"
 #include "executor/abstract_scan_executor.h"
+#include "executor/zone_map_filter.h"
 #include "planner/hybrid_scan_plan.h"
 
 #include <set>
@@ -54,6 +55,9 @@ class HybridScanExecutor : public AbstractScanExecutor {
   /** @brief Keeps track of the number of tile groups to scan. */
   oid_t table_tile_group_count_ = INVALID_OID;
 
+  /** @brief Predicate checks against the zone maps of the tile groups. */
+  ZoneMapFilter zone_map_filter_;
+
   inline bool SeqScanUtil();
   inline bool IndexScanUtil();
 
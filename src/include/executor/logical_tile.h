@@ -29,6 +29,7 @@ class Schema;
 }
 
 namespace storage {
+class ColumnAccessor;
 class Tile;
 class TileGroup;
 }
@@ -301,6 +302,12 @@ class LogicalTile : public Printable {
           &tile_to_cols,
       storage::Tile *dest_tile);
 
+  // Copy one field into the materialized tile
+  static void MaterializeField(const storage::ColumnAccessor &dest_column,
+                               oid_t new_tuple_id,
+                               const storage::ColumnAccessor &old_column,
+                               oid_t base_tuple_id);
+
   // Row-oriented materialization
   void MaterializeRowAtAtATime(
       const std::unordered_map<oid_t, oid_t> &old_to_new_cols,
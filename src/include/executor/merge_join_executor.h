@@ -13,6 +13,8 @@
 
 #pragma once
 
+#include <memory>
+#include <string>
 #include <vector>
 
 #include "executor/abstract_join_executor.h"
@@ -21,6 +23,20 @@
 namespace peloton {
 namespace executor {
 
+/**
+ * @warning This is a pipeline breaker.
+ *
+ * Both inputs are read completely and every row gets a normalized key built
+ * from its join clauses. Inputs that are not sorted on that key are sorted
+ * in parallel. The sorted left keys are then cut into ranges of equal size,
+ * each merged by a worker with the right keys between its first and last
+ * key, so that runs of equal keys are split too. The matched rows are
+ * returned in join key order. Rows with a NULL join key never match.
+ *
+ * The buffered tiles, keys and matched rows are charged to the memory budget
+ * of the query. A merge join does not spill, it only makes the operators
+ * that can spill do so earlier.
+ */
 class MergeJoinExecutor : public AbstractJoinExecutor {
   MergeJoinExecutor(const MergeJoinExecutor &) = delete;
   MergeJoinExecutor &operator=(const MergeJoinExecutor &) = delete;
@@ -29,23 +45,73 @@ class MergeJoinExecutor : public AbstractJoinExecutor {
   explicit MergeJoinExecutor(const planner::AbstractPlan *node,
                              ExecutorContext *executor_context);
 
+  ~MergeJoinExecutor();
+
  protected:
   bool DInit();
 
   bool DExecute();
 
  private:
-  size_t Advance(LogicalTile *tile, size_t start_row, bool is_left);
+  /** A row of one of the inputs and its normalized join key */
+  struct JoinKey {
+    std::string key;
+    oid_t tile_idx;
+    oid_t row_idx;
+
+    bool operator<(const JoinKey &rhs) const { return key < rhs.key; }
+  };
+
+  /** A left row and a right row that match */
+  struct MatchedRow {
+    oid_t left_tile_idx;
+    oid_t left_row_idx;
+    oid_t right_tile_idx;
+    oid_t right_row_idx;
+  };
+
+  typedef std::vector<MatchedRow> MatchedRows;
+
+  /** Account for buffered memory in the query's budget */
+  void ChargeMemory(size_t bytes);
+
+  void ReleaseMemory(size_t bytes);
+
+  /** Build the sorted join keys of the buffered tiles of one side */
+  void BuildJoinKeys(bool is_left, std::vector<JoinKey> &join_keys);
+
+  /** Join the sorted keys, one range of them per worker */
+  void Join();
+
+  std::unique_ptr<ExecutorContext> CreateWorkerContext() const;
+
+  /** Merge a range of the left keys with a range of the right keys. The
+   * workers evaluate the predicate in their own context, as the pool of the
+   * query's context is not thread safe. */
+  void JoinRange(size_t left_begin, size_t left_end, size_t right_begin,
+                 size_t right_end, ExecutorContext *context,
+                 MatchedRows &matched_rows) const;
 
   /** @brief a vector of join clauses
    * Get this from plan node during initialization */
   const std::vector<planner::MergeJoinPlan::JoinClause> *join_clauses_;
 
-  size_t left_start_row = 0;
-  size_t right_start_row = 0;
+  /** Type both sides of each join clause are compared in */
+  std::vector<type::Type::TypeId> key_types_;
+
+  std::vector<JoinKey> left_keys_;
+  std::vector<JoinKey> right_keys_;
+
+  bool join_done_ = false;
+
+  /** Matched rows in join key order */
+  MatchedRows matched_rows_;
+
+  /** Next matched row to return */
+  size_t next_matched_row_ = 0;
 
-  size_t left_end_row = 0;
-  size_t right_end_row = 0;
+  /** Memory charged to the budget of the query */
+  size_t memory_charged_ = 0;
 };
 
 }  // namespace executor
@@ -0,0 +1,40 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// normalized_key.h
+//
+// Identification: src/include/executor/normalized_key.h
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <string>
+
+#include "type/value.h"
+
+namespace peloton {
+namespace executor {
+
+//===----------------------------------------------------------------------===//
+// NormalizedKey
+//
+// Binary form of a sort key. Two keys built from values of the same types
+// compare like the values, one after the other, when they are compared
+// bytewise with memcmp and the shorter key wins a tie (std::string order).
+// NULLs sort after all other values, and the bytes of a descending value are
+// inverted, so NULLs come first there.
+//===----------------------------------------------------------------------===//
+
+class NormalizedKey {
+ public:
+  // Append the normalized form of the value to the key
+  static void Append(const type::Value &value, bool descending,
+                     std::string &key);
+};
+
+}  // End executor namespace
+}  // End peloton namespace
@@ -12,20 +12,32 @@
 
 #pragma once
 
+#include <string>
+
 #include "type/types.h"
 #include "executor/abstract_executor.h"
+#include "executor/spill_file.h"
 #include "storage/tuple.h"
 
+// Sorted tuples from one input tile that are passed on without copying
+#define ORDER_BY_MIN_PASS_THROUGH_RUN 64
+
+// Spilled runs merged at once
+#define ORDER_BY_MERGE_FAN_IN 64
+
 namespace peloton {
 namespace executor {
 
 /**
  * @warning This is a pipeline breaker and a materialization point.
  *
- * TODO Currently, we store all input tiles and sort result in memory
- * until this executor is destroyed, which is sometimes necessary.
- * But can we let it release the RAM earlier as long as the executor
- * is not needed any more (e.g., with a LIMIT sitting on top)?
+ * Sort keys are compared in their normalized binary form. With a LIMIT on
+ * top, only the first offset + limit tuples are kept in a heap and the input
+ * tiles of the others are released. Otherwise, once the sort buffer and the
+ * tuples it refers to no longer fit into the memory budget of the query
+ * (ExecutorContext::ReserveMemory), the buffer is sorted and spilled with
+ * its output columns to a temporary file, and the spilled runs are merged
+ * at the end.
  */
 class OrderByExecutor : public AbstractExecutor {
  public:
@@ -39,6 +51,9 @@ class OrderByExecutor : public AbstractExecutor {
 
   ~OrderByExecutor();
 
+  /** Number of runs spilled to temporary files by the last sort */
+  size_t GetSpilledRunCount() const { return spilled_run_count_; }
+
  protected:
   bool DInit();
 
@@ -47,45 +62,91 @@ class OrderByExecutor : public AbstractExecutor {
  private:
   bool DoSort();
 
+  /** Return the next tuples of the merged runs in a physical tile */
+  bool ExecuteMerge();
+
+  LogicalTile *BuildPassThroughTile(oid_t source_tile_id, size_t run_size);
+
+  /** Add the tuples of the last input tile to the sort buffer or the heap */
+  void AddInputTile();
+
+  /** Sort the sort buffer and write it to a new run */
+  void SpillSortBuffer();
+
+  /** Reserve memory_used_ from the query's budget */
+  bool ReserveMemory();
+
+  void ReleaseMemory();
+
   bool sort_done_ = false;
 
-  /**
-   * IMPORTANT This type must be move-constructible and move-assignable
-   * in order to be correctly sorted by STL sort
-   */
   struct sort_buffer_entry_t {
     ItemPointer item_pointer;
-    std::unique_ptr<storage::Tuple> tuple;
 
-    sort_buffer_entry_t(ItemPointer ipt, std::unique_ptr<storage::Tuple> &&tp)
-        : item_pointer(ipt), tuple(std::move(tp)) {}
+    /** Normalized sort key */
+    std::string key;
 
-    sort_buffer_entry_t(sort_buffer_entry_t &&rhs) {
-      item_pointer = rhs.item_pointer;
-      tuple = std::move(rhs.tuple);
+    bool operator<(const sort_buffer_entry_t &rhs) const {
+      return key < rhs.key;
     }
+  };
 
-    sort_buffer_entry_t &operator=(sort_buffer_entry_t &&rhs) {
-      item_pointer = rhs.item_pointer;
-      tuple = std::move(rhs.tuple);
-      return *this;
-    }
+  /** A sorted run in a temporary file and its current record */
+  struct SortedRun {
+    std::unique_ptr<SpillFile> file;
+    std::string key;
+    std::string row;
 
-    sort_buffer_entry_t(const sort_buffer_entry_t &) = delete;
-    sort_buffer_entry_t &operator=(const sort_buffer_entry_t &) = delete;
+    /** Position of the run in the merge, breaks ties between keys */
+    size_t order = 0;
+
+    /** Read the next record, returns false at the end of the run */
+    bool Next();
+
+    void Write(const std::string &record_key, const char *record_row,
+               size_t row_length);
   };
 
+  /** Merge the runs into a heap on their current keys */
+  void StartMerge(size_t first_run, size_t run_count);
+
+  /** Move past the smallest record of the merge */
+  void AdvanceMerge();
+
+  /** Heap order of the merge, the smallest record comes first */
+  static bool LaterInMerge(const SortedRun *lhs, const SortedRun *rhs);
+
   /** All tiles returned by child. */
   std::vector<std::unique_ptr<LogicalTile>> input_tiles_;
 
+  /** Entries of the sort buffer referring to each input tile */
+  std::vector<size_t> tile_references_;
+
   /** Physical (not logical) schema of input tiles */
   std::unique_ptr<catalog::Schema> input_schema_;
 
   /** All valid tuples in sorted order */
   std::vector<sort_buffer_entry_t> sort_buffer_;
 
-  /** Tuples in sort_buffer only contains the sort keys */
-  std::unique_ptr<catalog::Schema> sort_key_tuple_schema_;
+  /** Keep the best limit_offset_ + limit_number_ tuples in a heap */
+  bool top_n_ = false;
+
+  /** Estimated memory held by the sort buffer and its tuples */
+  size_t memory_used_ = 0;
+
+  /** Memory reserved from the budget of the query */
+  size_t memory_reserved_ = 0;
+
+  /** Sorted runs spilled to temporary files */
+  std::vector<std::unique_ptr<SortedRun>> runs_;
+
+  /** Runs being merged, ordered as a heap on their current keys */
+  std::vector<SortedRun *> merge_heap_;
+
+  size_t spilled_run_count_ = 0;
+
+  /** Number of tuples to return */
+  size_t num_tuples_sorted_ = 0;
 
   std::vector<bool> descend_flags_;
 
@@ -0,0 +1,118 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// parallel_sort.h
+//
+// Identification: src/include/executor/parallel_sort.h
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <algorithm>
+#include <functional>
+#include <vector>
+
+// Entries below which a partition is not worth a thread of its own
+#define PARALLEL_SORT_MIN_PARTITION_SIZE (16 * 1024)
+
+// Sampled entries per partition when choosing the splitters
+#define PARALLEL_SORT_OVERSAMPLING 32
+
+namespace peloton {
+namespace executor {
+
+// Threads used by sorts and merge joins
+size_t GetSortWorkerCount();
+
+// Run the task for every partition on a shared pool of sort workers, the
+// calling thread taking part. The first exception thrown by a task is
+// rethrown once all of them are done.
+void RunPartitions(size_t partition_count,
+                   const std::function<void(size_t)> &task);
+
+/**
+ * @brief Sort the entries by their operator< with a sample sort. Splitters
+ * picked from a sorted sample cut the entries into one range per worker,
+ * the workers move their slices of the entries into the ranges, and then
+ * sort one range each. Small inputs are sorted by the calling thread.
+ */
+template <typename Entry>
+void ParallelSort(std::vector<Entry> &entries) {
+  size_t partition_count =
+      std::min(GetSortWorkerCount(),
+               entries.size() / PARALLEL_SORT_MIN_PARTITION_SIZE);
+  if (partition_count <= 1) {
+    std::sort(entries.begin(), entries.end());
+    return;
+  }
+
+  std::vector<Entry> sample;
+  size_t sample_size = partition_count * PARALLEL_SORT_OVERSAMPLING;
+  for (size_t sample_itr = 0; sample_itr < sample_size; sample_itr++) {
+    sample.push_back(entries[sample_itr * entries.size() / sample_size]);
+  }
+  std::sort(sample.begin(), sample.end());
+  std::vector<Entry> splitters;
+  for (size_t partition = 1; partition < partition_count; partition++) {
+    splitters.push_back(
+        std::move(sample[partition * PARALLEL_SORT_OVERSAMPLING]));
+  }
+
+  // Partition of every entry, and the entries of every slice in each
+  // partition
+  std::vector<uint32_t> partitions(entries.size());
+  std::vector<std::vector<size_t>> counts(
+      partition_count, std::vector<size_t>(partition_count, 0));
+  auto slice_begin = [&](size_t slice) {
+    return slice * entries.size() / partition_count;
+  };
+  RunPartitions(partition_count, [&](size_t slice) {
+    for (size_t entry_itr = slice_begin(slice);
+         entry_itr < slice_begin(slice + 1); entry_itr++) {
+      uint32_t partition =
+          std::upper_bound(splitters.begin(), splitters.end(),
+                           entries[entry_itr]) -
+          splitters.begin();
+      partitions[entry_itr] = partition;
+      counts[slice][partition]++;
+    }
+  });
+
+  // Where the entries of a slice in a partition go
+  std::vector<size_t> partition_begin(partition_count + 1, 0);
+  std::vector<std::vector<size_t>> offsets(partition_count,
+                                           std::vector<size_t>(partition_count));
+  size_t offset = 0;
+  for (size_t partition = 0; partition < partition_count; partition++) {
+    partition_begin[partition] = offset;
+    for (size_t slice = 0; slice < partition_count; slice++) {
+      offsets[slice][partition] = offset;
+      offset += counts[slice][partition];
+    }
+  }
+  partition_begin[partition_count] = offset;
+
+  std::vector<Entry> partitioned(entries.size());
+  RunPartitions(partition_count, [&](size_t slice) {
+    auto &slice_offsets = offsets[slice];
+    for (size_t entry_itr = slice_begin(slice);
+         entry_itr < slice_begin(slice + 1); entry_itr++) {
+      partitioned[slice_offsets[partitions[entry_itr]]++] =
+          std::move(entries[entry_itr]);
+    }
+  });
+
+  RunPartitions(partition_count, [&](size_t partition) {
+    std::sort(partitioned.begin() + partition_begin[partition],
+              partitioned.begin() + partition_begin[partition + 1]);
+  });
+
+  entries.swap(partitioned);
+}
+
+}  // End executor namespace
+}  // End peloton namespace
@@ -14,6 +14,7 @@
 #pragma once
 
 #include "executor/abstract_executor.h"
+#include "expression/compiled_expression.h"
 #include "planner/project_info.h"
 
 namespace peloton {
@@ -44,6 +45,10 @@ class ProjectionExecutor : public AbstractExecutor {
 
   /** @brief Schema of projected tuples. */
   const catalog::Schema *schema_ = nullptr;
+
+  /** @brief Compiled target list expressions, nullptr if not compiled. */
+  std::vector<std::unique_ptr<expression::CompiledExpression>>
+      compiled_targets_;
 };
 
 } /* namespace executor */
@@ -14,6 +14,8 @@
 
 #include "planner/seq_scan_plan.h"
 #include "executor/abstract_scan_executor.h"
+#include "executor/zone_map_filter.h"
+#include "expression/compiled_expression.h"
 
 namespace peloton {
 namespace executor {
@@ -46,12 +48,24 @@ class SeqScanExecutor : public AbstractScanExecutor {
   /** @brief Keeps track of the number of tile groups to scan. */
   oid_t table_tile_group_count_ = INVALID_OID;
 
+  /** @brief Whether only the tile groups of some partitions are scanned. */
+  bool prune_partitions_ = false;
+
+  /** @brief Ids of the tile groups of the scanned partitions. */
+  std::vector<oid_t> tile_group_ids_;
+
   //===--------------------------------------------------------------------===//
   // Plan Info
   //===--------------------------------------------------------------------===//
 
   /** @brief Pointer to table to scan from. */
   storage::DataTable *target_table_ = nullptr;
+
+  /** @brief Compiled form of the predicate, if it can be compiled. */
+  std::unique_ptr<expression::CompiledExpression> compiled_predicate_;
+
+  /** @brief Predicate checks against the zone maps of the tile groups. */
+  ZoneMapFilter zone_map_filter_;
 };
 
 }  // namespace executor
@@ -0,0 +1,132 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// spill_file.h
+//
+// Identification: src/include/executor/spill_file.h
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <cstdio>
+#include <memory>
+#include <vector>
+
+#include "type/types.h"
+#include "type/value.h"
+
+// Partitions the rows of a hash table that ran out of memory are spilled to
+#define SPILL_PARTITION_COUNT 16
+
+// Partitions are partitioned again at most this many times
+#define SPILL_MAX_LEVEL 3
+
+namespace peloton {
+
+class AbstractTuple;
+
+namespace catalog {
+class Schema;
+}
+
+namespace executor {
+
+class LogicalTile;
+
+//===----------------------------------------------------------------------===//
+// SpillFile
+//
+// Temporary file an executor writes intermediate data to once it runs out of
+// memory. The file is removed from the file system as soon as it is created,
+// so it goes away with the executor or the process.
+//===----------------------------------------------------------------------===//
+
+class SpillFile {
+ public:
+  SpillFile(const SpillFile &) = delete;
+  SpillFile &operator=(const SpillFile &) = delete;
+
+  SpillFile();
+
+  ~SpillFile();
+
+  void Write(const void *data, size_t length);
+
+  // Flush the writes and read from the beginning of the file
+  void Rewind();
+
+  // Returns false at the end of the file
+  bool Read(void *data, size_t length);
+
+  // Number of bytes written
+  size_t GetSize() const { return size_; }
+
+  // Write the first column_count values of the tuple as one row, along with
+  // their types
+  void WriteRow(const AbstractTuple *tuple, size_t column_count);
+
+  // Read the next row written by WriteRow, returns false at the end of the
+  // file. The values own their data.
+  bool ReadRow(std::vector<type::Value> &values);
+
+  // Read up to max_rows rows into a new physical tile of the given schema,
+  // wrapped in a logical tile. Returns nullptr at the end of the file.
+  LogicalTile *ReadTile(const catalog::Schema &schema, size_t max_rows);
+
+  // Number of rows written by WriteRow
+  size_t GetRowCount() const { return row_count_; }
+
+ private:
+  FILE *file_;
+
+  size_t size_ = 0;
+
+  size_t row_count_ = 0;
+};
+
+//===----------------------------------------------------------------------===//
+// SpillPartitions
+//
+// Rows of a hash join or hash aggregation input that did not fit in the
+// query's memory budget, hash partitioned on their key columns into spill
+// files. Every level of partitioning hashes differently, so the rows of a
+// partition that still does not fit spread out when it is partitioned again.
+//===----------------------------------------------------------------------===//
+
+class SpillPartitions {
+ public:
+  SpillPartitions(const SpillPartitions &) = delete;
+  SpillPartitions &operator=(const SpillPartitions &) = delete;
+
+  explicit SpillPartitions(size_t level);
+
+  size_t GetLevel() const { return level_; }
+
+  // Partition of the tuple on this level
+  size_t GetPartition(const AbstractTuple *tuple,
+                      const std::vector<oid_t> &key_column_ids) const;
+
+  // Write the first column_count columns of the tuple to its partition
+  void Add(const AbstractTuple *tuple, size_t column_count,
+           const std::vector<oid_t> &key_column_ids);
+
+  // Take over the file of the partition, nullptr if it has no rows
+  std::unique_ptr<SpillFile> ReleasePartition(size_t partition);
+
+  // Number of rows added
+  size_t GetRowCount() const { return row_count_; }
+
+ private:
+  size_t level_;
+
+  std::vector<std::unique_ptr<SpillFile>> partitions_;
+
+  size_t row_count_ = 0;
+};
+
+}  // End executor namespace
+}  // End peloton namespace
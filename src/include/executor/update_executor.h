@@ -40,8 +40,21 @@ class UpdateExecutor : public AbstractExecutor {
   bool DExecute();
 
  private:
+  // Get the partition of the new version of the old tuple. Returns false if
+  // the update would move the tuple out of the partition of its tile group.
+  bool GetNewVersionPartition(const AbstractTuple *old_tuple,
+                              const storage::TileGroup *tile_group,
+                              oid_t &partition);
+
   storage::DataTable *target_table_ = nullptr;
   const planner::ProjectInfo *project_info_ = nullptr;
+
+  // sorted ids of the columns written by the target list, empty unless the
+  // log writes only the updated columns
+  std::vector<oid_t> updated_column_ids_;
+
+  // expression of the partition column, nullptr if it is not updated
+  const expression::AbstractExpression *partition_target_ = nullptr;
 };
 
 }  // namespace executor
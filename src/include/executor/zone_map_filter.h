@@ -0,0 +1,81 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// zone_map_filter.h
+//
+// Identification: src/include/executor/zone_map_filter.h
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <vector>
+
+#include "type/types.h"
+#include "type/value.h"
+
+namespace peloton {
+
+namespace expression {
+class AbstractExpression;
+}
+
+namespace storage {
+class TileGroup;
+class ZoneMap;
+}
+
+namespace executor {
+
+class ExecutorContext;
+
+//===----------------------------------------------------------------------===//
+// ZoneMapFilter
+//
+// The parts of a scan predicate that can be checked against the zone map of
+// a tile group: AND/OR of comparisons of a table column with a constant or
+// a parameter, and IS NULL tests. The constants are evaluated once, when the
+// filter is built. Everything else is assumed to match.
+//===----------------------------------------------------------------------===//
+
+class ZoneMapFilter {
+ public:
+  // Build the filter of the predicate, parameters come from the context
+  void Init(const expression::AbstractExpression *predicate,
+            ExecutorContext *executor_context);
+
+  // Whether the filter can rule out any tile group
+  inline bool IsEmpty() const { return nodes_.empty(); }
+
+  // Whether some tuple of the tile group may satisfy the predicate. Tile
+  // groups that have no zone map yet always may.
+  bool MayMatch(storage::TileGroup *tile_group) const;
+
+ private:
+  enum class NodeType { ANY, COMPARE, IS_NULL, AND, OR };
+
+  struct Node {
+    NodeType type = NodeType::ANY;
+    oid_t column_id = INVALID_OID;
+    ExpressionType comparison = ExpressionType::INVALID;
+    type::Value constant;
+    // offsets of the children of AND/OR nodes
+    size_t left = 0;
+    size_t right = 0;
+  };
+
+  // Returns the offset of the node built for the expression
+  size_t AddNode(const expression::AbstractExpression *expr,
+                 ExecutorContext *executor_context);
+
+  bool MayMatch(const storage::ZoneMap &zone_map, size_t node_offset) const;
+
+  // nodes of the filter, the root is the last one
+  std::vector<Node> nodes_;
+};
+
+}  // End executor namespace
+}  // End peloton namespace
@@ -0,0 +1,217 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// compiled_expression.h
+//
+// Identification: src/include/expression/compiled_expression.h
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <deque>
+#include <memory>
+#include <vector>
+
+#include "type/types.h"
+#include "type/value.h"
+
+// Registers of a compiled expression, limited by the width of the null bitmap
+#define COMPILED_EXPRESSION_MAX_REGISTERS 64
+
+// Rows evaluated together by EvaluateBatch
+#define COMPILED_EXPRESSION_BATCH_SIZE 1024
+
+namespace peloton {
+
+class AbstractTuple;
+
+namespace executor {
+class LogicalTile;
+}
+
+namespace storage {
+class Tile;
+class TileGroup;
+}
+
+namespace expression {
+
+class AbstractExpression;
+
+//===----------------------------------------------------------------------===//
+// CompiledExpression
+//
+// A bound expression tree flattened into a small register machine. Columns
+// are loaded once into native int64/double/string registers, and every
+// operation is specialized for its operand types at compile time, so the
+// evaluation needs neither type::Value boxing nor type::Type dispatch. The
+// NULL state of all registers lives in one bitmap.
+//
+// Supported are tuple value and constant expressions, comparisons,
+// AND/OR/NOT and integer/decimal arithmetic. Compile returns nullptr for
+// any other tree, and the caller keeps using AbstractExpression::Evaluate.
+//
+// Unlike the expression tree, a compiled expression keeps scratch state, so
+// every executor compiles its own copy.
+//===----------------------------------------------------------------------===//
+
+class CompiledExpression {
+ public:
+  CompiledExpression(const CompiledExpression &) = delete;
+  CompiledExpression &operator=(const CompiledExpression &) = delete;
+
+  // Returns nullptr if the expression cannot be compiled
+  static std::unique_ptr<CompiledExpression> Compile(
+      const AbstractExpression *expression);
+
+  // Type of the result
+  type::Type::TypeId GetValueType() const {
+    return register_types_[result_register_];
+  }
+
+  // Same result as AbstractExpression::Evaluate
+  type::Value Evaluate(const AbstractTuple *tuple1,
+                       const AbstractTuple *tuple2) const;
+
+  // Keep the tuples of the tile group for which the expression is true.
+  // Columns are read straight from the tiles.
+  void Filter(storage::TileGroup *tile_group,
+              std::vector<oid_t> &tuple_ids) const;
+
+  // Evaluate the expression for the given tuples of a logical tile and write
+  // the results into a column of the destination tile, starting at row 0.
+  // Every instruction runs over a whole batch of rows before the next one.
+  void EvaluateBatch(executor::LogicalTile *source_tile,
+                     const std::vector<oid_t> &tuple_ids,
+                     storage::Tile *destination, oid_t column_id) const;
+
+ private:
+  CompiledExpression() {}
+
+  enum class OpCode : uint8_t {
+    // Conversions
+    INTEGER_TO_DECIMAL,
+
+    // Arithmetic
+    ADD_INTEGER,
+    SUBTRACT_INTEGER,
+    MULTIPLY_INTEGER,
+    DIVIDE_INTEGER,
+    MODULO_INTEGER,
+    ADD_DECIMAL,
+    SUBTRACT_DECIMAL,
+    MULTIPLY_DECIMAL,
+    DIVIDE_DECIMAL,
+
+    // Comparisons
+    EQUAL_INTEGER,
+    NOT_EQUAL_INTEGER,
+    LESS_THAN_INTEGER,
+    GREATER_THAN_INTEGER,
+    LESS_THAN_OR_EQUAL_INTEGER,
+    GREATER_THAN_OR_EQUAL_INTEGER,
+    EQUAL_DECIMAL,
+    NOT_EQUAL_DECIMAL,
+    LESS_THAN_DECIMAL,
+    GREATER_THAN_DECIMAL,
+    LESS_THAN_OR_EQUAL_DECIMAL,
+    GREATER_THAN_OR_EQUAL_DECIMAL,
+    EQUAL_VARCHAR,
+    NOT_EQUAL_VARCHAR,
+    LESS_THAN_VARCHAR,
+    GREATER_THAN_VARCHAR,
+    LESS_THAN_OR_EQUAL_VARCHAR,
+    GREATER_THAN_OR_EQUAL_VARCHAR,
+
+    // Logic
+    AND,
+    OR,
+    NOT
+  };
+
+  union Register {
+    int64_t integer;
+    double decimal;
+    struct {
+      const char *data;
+      uint32_t length;
+    } varchar;
+  };
+
+  struct Instruction {
+    OpCode op_code;
+    uint8_t destination;
+    uint8_t left;
+    uint8_t right;
+
+    // Integer arithmetic: the range of the result type
+    int64_t min;
+    int64_t max;
+  };
+
+  // Reads a column of one of the input tuples into a register
+  struct ColumnLoad {
+    uint8_t destination;
+    uint32_t tuple_index;
+    oid_t column_id;
+  };
+
+  // Compile the subtree and return the register of its result
+  int CompileNode(const AbstractExpression *expression);
+
+  int AllocateRegister(type::Type::TypeId type_id);
+
+  // Convert an integer register into a new decimal register
+  int ToDecimal(int source);
+
+  // Reads a value in tuple storage format, returns true if it is NULL
+  static bool ReadStorage(type::Type::TypeId type_id, const char *location,
+                          Register &value);
+
+  // Writes a value in tuple storage format
+  static void WriteStorage(type::Type::TypeId type_id, const Register &value,
+                           bool is_null, char *location);
+
+  // Reads a value of the type of the register, returns true if it is NULL
+  bool ReadValue(type::Type::TypeId type_id, type::Value value,
+                 Register &destination) const;
+
+  // Run the instructions after the loads
+  void Execute(Register *registers, uint64_t &nulls) const;
+
+  // Run the instructions for a batch of rows. The rows of a register are
+  // stored together, and so are the words of its null bitmap.
+  void ExecuteBatch(Register *registers, uint64_t *nulls, size_t count) const;
+
+  // Load the columns of the tuples into the registers
+  void LoadTuples(const AbstractTuple *tuple1, const AbstractTuple *tuple2,
+                  Register *registers, uint64_t &nulls) const;
+
+  type::Value GetResult(const Register &result, bool is_null) const;
+
+  // Loads come first, so they can be bound to the tiles once per tile group
+  std::vector<ColumnLoad> loads_;
+  std::vector<Instruction> instructions_;
+
+  // Type of the value held by every register
+  std::vector<type::Type::TypeId> register_types_;
+
+  // Registers of the constants are set once
+  std::vector<Register> initial_registers_;
+  uint64_t initial_nulls_ = 0;
+
+  // Owns the data of varchar constants
+  std::deque<type::Value> constants_;
+
+  int result_register_ = -1;
+
+  // Keeps varchar values loaded from tuples alive during an evaluation
+  mutable std::deque<type::Value> loaded_values_;
+};
+
+}  // End expression namespace
+}  // End peloton namespace
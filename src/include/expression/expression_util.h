@@ -13,6 +13,7 @@
 #pragma once
 
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "catalog/catalog.h"
@@ -279,6 +280,63 @@ class ExpressionUtil {
     }
   }
 
+  /**
+   * Normalize a comparison between a column of the first tuple and a
+   * constant, or a parameter if parameters are allowed, to
+   * <column> <comparison> <operand>. The comparison is flipped when the
+   * column is on the right. Returns false for any other expression.
+   */
+  static bool NormalizeColumnComparison(const AbstractExpression *expr,
+                                        bool allow_parameters,
+                                        const TupleValueExpression *&column,
+                                        const AbstractExpression *&operand,
+                                        ExpressionType &comparison) {
+    comparison = expr->GetExpressionType();
+    switch (comparison) {
+      case ExpressionType::COMPARE_EQUAL:
+      case ExpressionType::COMPARE_LESSTHAN:
+      case ExpressionType::COMPARE_LESSTHANOREQUALTO:
+      case ExpressionType::COMPARE_GREATERTHAN:
+      case ExpressionType::COMPARE_GREATERTHANOREQUALTO:
+        break;
+      default:
+        return false;
+    }
+
+    auto left = expr->GetChild(0);
+    auto right = expr->GetChild(1);
+    if (left == nullptr || right == nullptr) {
+      return false;
+    }
+    if (left->GetExpressionType() != ExpressionType::VALUE_TUPLE) {
+      std::swap(left, right);
+      if (comparison == ExpressionType::COMPARE_LESSTHAN) {
+        comparison = ExpressionType::COMPARE_GREATERTHAN;
+      } else if (comparison == ExpressionType::COMPARE_LESSTHANOREQUALTO) {
+        comparison = ExpressionType::COMPARE_GREATERTHANOREQUALTO;
+      } else if (comparison == ExpressionType::COMPARE_GREATERTHAN) {
+        comparison = ExpressionType::COMPARE_LESSTHAN;
+      } else if (comparison == ExpressionType::COMPARE_GREATERTHANOREQUALTO) {
+        comparison = ExpressionType::COMPARE_LESSTHANOREQUALTO;
+      }
+    }
+    if (left->GetExpressionType() != ExpressionType::VALUE_TUPLE) {
+      return false;
+    }
+    if (right->GetExpressionType() != ExpressionType::VALUE_CONSTANT &&
+        (right->GetExpressionType() != ExpressionType::VALUE_PARAMETER ||
+         allow_parameters == false)) {
+      return false;
+    }
+
+    column = static_cast<const TupleValueExpression *>(left);
+    if (column->GetTupleId() != 0 || column->GetColumnId() < 0) {
+      return false;
+    }
+    operand = right;
+    return true;
+  }
+
   /**
    * Generate a pretty-printed string representation of the entire
    * Expresssion tree for the given root node
@@ -60,14 +60,20 @@ class GCManager {
     return INVALID_ITEMPOINTER;
   }
 
+  // Hands back a free slot taken with ReturnFreeSlot that was not used
+  virtual void RecycleTupleSlot(const oid_t &table_id UNUSED_ATTRIBUTE,
+                                const ItemPointer &location UNUSED_ATTRIBUTE) {
+  }
+
   virtual void RegisterTable(const oid_t &table_id UNUSED_ATTRIBUTE) {}
 
   virtual void DeregisterTable(const oid_t &table_id UNUSED_ATTRIBUTE) {}
 
   virtual size_t GetTableCount() { return 0; }
 
-  virtual void RecycleTransaction(std::shared_ptr<GCSet> gc_set UNUSED_ATTRIBUTE, 
-                                   const cid_t &timestamp UNUSED_ATTRIBUTE) {}
+  // Takes over the contents of the GC set and leaves it empty
+  virtual void RecycleTransaction(GCSet &gc_set UNUSED_ATTRIBUTE,
+                                  const cid_t &timestamp UNUSED_ATTRIBUTE) {}
 
  protected:
   void CheckAndReclaimVarlenColumns(storage::TileGroup *tg, oid_t tuple_id);
@@ -31,15 +31,13 @@ namespace gc {
 #define MAX_ATTEMPT_COUNT 100000
 
 
+// Garbage contexts are recycled through a free queue once reclaimed. A
+// transaction swaps its GC set with the cleared set of a recycled context,
+// so neither side allocates in the steady state.
 struct GarbageContext {
   GarbageContext() : timestamp_(INVALID_CID) {}
-  GarbageContext(std::shared_ptr<GCSet> gc_set, 
-                 const cid_t &timestamp) {
-    gc_set_ = gc_set;
-    timestamp_ = timestamp;
-  }
 
-  std::shared_ptr<GCSet> gc_set_;
+  GCSet gc_set_;
   cid_t timestamp_;
 };
 
@@ -48,19 +46,44 @@ public:
   TransactionLevelGCManager(int thread_count) 
     : gc_thread_count_(thread_count),
       gc_threads_(thread_count),
-      reclaim_maps_(thread_count) {
+      reclaim_maps_(thread_count),
+      free_contexts_(MAX_QUEUE_LENGTH) {
 
     unlink_queues_.reserve(thread_count);
     for (int i = 0; i < gc_thread_count_; ++i) {
-      std::shared_ptr<LockFreeQueue<std::shared_ptr<GarbageContext>>> unlink_queue(
-        new LockFreeQueue<std::shared_ptr<GarbageContext>>(MAX_QUEUE_LENGTH)
+      std::shared_ptr<LockFreeQueue<GarbageContext *>> unlink_queue(
+        new LockFreeQueue<GarbageContext *>(MAX_QUEUE_LENGTH)
       );
       unlink_queues_.push_back(unlink_queue);
       local_unlink_queues_.emplace_back();
     }
   }
 
-  virtual ~TransactionLevelGCManager() { }
+  virtual ~TransactionLevelGCManager() {
+    // Contexts still waiting to be unlinked or reclaimed are owned here too
+    GarbageContext *garbage_ctx;
+    for (auto &unlink_queue : unlink_queues_) {
+      while (unlink_queue->Dequeue(garbage_ctx) == true) {
+        delete garbage_ctx;
+      }
+    }
+    for (auto &local_unlink_queue : local_unlink_queues_) {
+      for (auto pending_ctx : local_unlink_queue) {
+        delete pending_ctx;
+      }
+      local_unlink_queue.clear();
+    }
+    for (auto &reclaim_map : reclaim_maps_) {
+      for (auto &entry : reclaim_map) {
+        delete entry.second;
+      }
+      reclaim_map.clear();
+    }
+
+    while (free_contexts_.Dequeue(garbage_ctx) == true) {
+      delete garbage_ctx;
+    }
+  }
 
   static TransactionLevelGCManager& GetInstance(int thread_count = 1) {
     static TransactionLevelGCManager gc_manager(thread_count);
@@ -83,10 +106,13 @@ public:
     }
   }
 
-  virtual void RecycleTransaction(std::shared_ptr<GCSet> gc_set, const cid_t &timestamp) override;
+  virtual void RecycleTransaction(GCSet &gc_set, const cid_t &timestamp) override;
 
   virtual ItemPointer ReturnFreeSlot(const oid_t &table_id) override;
 
+  virtual void RecycleTupleSlot(const oid_t &table_id,
+                                const ItemPointer &location) override;
+
   virtual void RegisterTable(const oid_t &table_id) override {
     // Insert a new entry for the table
     if (recycle_queue_map_.find(table_id) == recycle_queue_map_.end()) {
@@ -123,11 +149,11 @@ private:
 
   int Reclaim(const int &thread_id, const cid_t &max_cid);
 
-  void AddToRecycleMap(std::shared_ptr<GarbageContext> gc_ctx);
+  void AddToRecycleMap(GarbageContext *gc_ctx);
 
   bool ResetTuple(const ItemPointer &);
 
-  void DeleteFromIndexes(const std::shared_ptr<GarbageContext>& garbage_ctx);
+  void DeleteFromIndexes(const GarbageContext *garbage_ctx);
 
   void DeleteTupleFromIndexes(ItemPointer *indirection);
 
@@ -142,17 +168,20 @@ private:
 
   // queues for to-be-unlinked tuples.
   // # unlink_queues == # gc_threads
-  std::vector<std::shared_ptr<peloton::LockFreeQueue<std::shared_ptr<GarbageContext>>>> unlink_queues_;
+  std::vector<std::shared_ptr<peloton::LockFreeQueue<GarbageContext *>>> unlink_queues_;
   
   // local queues for to-be-unlinked tuples.
   // # local_unlink_queues == # gc_threads
-  std::vector<std::list<std::shared_ptr<GarbageContext>>> local_unlink_queues_;
+  std::vector<std::list<GarbageContext *>> local_unlink_queues_;
 
   // multimaps for to-be-reclaimed tuples.
   // The key is the timestamp when the garbage is identified, value is the
   // metadata of the garbage.
   // # reclaim_maps == # gc_threads
-  std::vector<std::multimap<cid_t, std::shared_ptr<GarbageContext>>> reclaim_maps_;
+  std::vector<std::multimap<cid_t, GarbageContext *>> reclaim_maps_;
+
+  // reclaimed garbage contexts, ready to be reused
+  peloton::LockFreeQueue<GarbageContext *> free_contexts_;
 
   // queues for to-be-reused tuples.
   // # recycle_queue_maps == # tables
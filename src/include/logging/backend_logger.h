@@ -12,6 +12,7 @@
 
 #pragma once
 
+#include <atomic>
 #include <condition_variable>
 #include <mutex>
 #include <vector>
@@ -19,9 +20,11 @@
 #include "common/item_pointer.h"
 #include "common/platform.h"
 #include "logging/circular_buffer_pool.h"
+#include "logging/concurrent_log_buffer.h"
 #include "logging/log_buffer.h"
 #include "logging/log_record.h"
 #include "logging/logger.h"
+#include "statistics/latency_histogram.h"
 #include "type/types.h"
 
 namespace peloton {
@@ -94,7 +97,27 @@ class BackendLogger : public Logger {
   // gets the Varlenpool used for log serialization
   type::AbstractPool *GetVarlenPool() { return backend_pool.get(); }
 
+  // Log into the buffer shared with the other backend loggers of the
+  // frontend logger instead of the local log buffers
+  void SetConcurrentLogBuffer(ConcurrentLogBuffer *concurrent_log_buffer) {
+    concurrent_log_buffer_ = concurrent_log_buffer;
+  }
+
+  // Offset of the record being written into the shared log buffer
+  uint64_t GetReservationOffset() const { return reservation_offset_.load(); }
+
  protected:
+  void LogToConcurrentBuffer(LogRecord *record);
+
+  // Remember when the oldest commit not yet collected was logged
+  void MarkCommitQueued() {
+    if (FLAGS_stats_mode != STATS_TYPE_INVALID &&
+        oldest_queued_commit_time_ ==
+            stats::LatencyHistogram::Clock::time_point()) {
+      oldest_queued_commit_time_ = stats::LatencyHistogram::Clock::now();
+    }
+  }
+
   // the lock for the buffer being used currently
   Spinlock log_buffer_lock;
 
@@ -130,6 +153,18 @@ class BackendLogger : public Logger {
 
   // shutdown flag
   bool shutdown = false;
+
+  // log buffer shared with the other backend loggers (if any)
+  ConcurrentLogBuffer *concurrent_log_buffer_ = nullptr;
+
+  // reservation being written into the shared log buffer
+  std::atomic<uint64_t> reservation_offset_{IDLE_RESERVATION_OFFSET};
+
+  // records were written into the shared log buffer since the last collection
+  bool has_shared_records_ = false;
+
+  // when the oldest commit not yet collected by the frontend logger was logged
+  stats::LatencyHistogram::Clock::time_point oldest_queued_commit_time_;
 };
 
 }  // namespace logging
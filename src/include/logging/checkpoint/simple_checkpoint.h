@@ -19,6 +19,11 @@
 #include "logging/checkpoint.h"
 
 namespace peloton {
+
+namespace executor {
+class LogicalTile;
+}
+
 namespace logging {
 
 class LogRecord;
@@ -45,6 +50,8 @@ class SimpleCheckpoint : public Checkpoint {
   // Internal functions
   void InsertTuple(cid_t commit_id);
 
+  void RecoverTileGroup(cid_t commit_id);
+
   void Scan(storage::DataTable *target_table, oid_t database_oid);
 
   // Getters and Setters
@@ -61,6 +68,10 @@ class SimpleCheckpoint : public Checkpoint {
 
   void Persist();
 
+  void PersistTileGroupImage(storage::DataTable *target_table,
+                             oid_t database_oid, oid_t tile_group_id,
+                             executor::LogicalTile *logical_tile);
+
   void Cleanup();
 
   void InitVersionNumber();
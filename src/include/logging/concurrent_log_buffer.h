@@ -0,0 +1,109 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// concurrent_log_buffer.h
+//
+// Identification: src/include/logging/concurrent_log_buffer.h
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <utility>
+
+#include "type/types.h"
+
+#define DEFAULT_CONCURRENT_LOG_BUFFER_CAPACITY (1 << 24)  // 16 MB
+
+// Reservation offset of a producer that is not writing a record
+#define IDLE_RESERVATION_OFFSET UINT64_MAX
+
+namespace peloton {
+namespace logging {
+
+//===--------------------------------------------------------------------===//
+// Concurrent Log Buffer
+//===--------------------------------------------------------------------===//
+
+/**
+ * @brief Log buffer shared by all backend loggers of a frontend logger.
+ *
+ * Producers reserve space for a record with a single fetch_add on a logical
+ * offset that only grows, and write the record into the ring at that offset,
+ * serializing it in place unless it wraps around the end of the ring.
+ * Each producer publishes the offset of its in-flight reservation, so the
+ * flusher can tell how far the buffer is contiguously complete: everything
+ * below both the reserved offset and every in-flight reservation.
+ */
+class ConcurrentLogBuffer {
+ public:
+  ConcurrentLogBuffer(size_t capacity = DEFAULT_CONCURRENT_LOG_BUFFER_CAPACITY);
+
+  //===--------------------------------------------------------------------===//
+  // Producer
+  //===--------------------------------------------------------------------===//
+
+  // Copy a record into the buffer. Blocks while the buffer is full.
+  // reservation is the producer's published in-flight offset.
+  bool WriteRecord(const char *data, size_t length, cid_t log_id,
+                   std::atomic<uint64_t> &reservation);
+
+  // Reserve space for a record and publish its offset in reservation.
+  // Blocks while the buffer is full. The record must then be written at
+  // the offset and completed with CompleteRecord.
+  bool ReserveRecord(size_t length, std::atomic<uint64_t> &reservation,
+                     uint64_t &offset);
+
+  // Space of a reserved record, or nullptr when it wraps around the end of
+  // the ring and has to be copied in with CopyRecord instead
+  char *GetRecordRegion(uint64_t offset, size_t length);
+
+  void CopyRecord(uint64_t offset, const char *data, size_t length);
+
+  // The reserved record is written
+  void CompleteRecord(cid_t log_id, std::atomic<uint64_t> &reservation);
+
+  //===--------------------------------------------------------------------===//
+  // Flusher
+  //===--------------------------------------------------------------------===//
+
+  uint64_t GetReservedOffset() const { return reserved_offset_.load(); }
+
+  uint64_t GetReleasedOffset() const {
+    return released_offset_.load(std::memory_order_acquire);
+  }
+
+  // Get the data between begin and end that is contiguous in the ring,
+  // callers loop until they have consumed the whole range
+  std::pair<const char *, size_t> GetRegion(uint64_t begin,
+                                            uint64_t end) const;
+
+  // Hand the space below end back to the producers
+  void Release(uint64_t end);
+
+  cid_t GetMaxLogId() const { return max_log_id_.load(); }
+
+  size_t GetCapacity() const { return capacity_; }
+
+ private:
+  size_t capacity_;
+
+  std::unique_ptr<char[]> data_;
+
+  // End of the space handed out to producers
+  std::atomic<uint64_t> reserved_offset_;
+
+  // End of the space that has been written out by the flusher
+  std::atomic<uint64_t> released_offset_;
+
+  // Max log id of the records in the buffer
+  std::atomic<cid_t> max_log_id_;
+};
+
+}  // namespace logging
+}  // namespace peloton
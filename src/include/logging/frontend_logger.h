@@ -27,6 +27,7 @@
 #include "logging/log_buffer.h"
 #include "logging/buffer_pool.h"
 #include "logging/backend_logger.h"
+#include "logging/concurrent_log_buffer.h"
 #include "logging/checkpoint.h"
 
 namespace peloton {
@@ -112,6 +113,15 @@ class FrontendLogger : public Logger {
 
   void SetNoWrite(bool no_write) { no_write_ = no_write; }
 
+  // Let backend loggers added from now on share a single log buffer
+  void EnableConcurrentLogBuffer(size_t capacity) {
+    concurrent_log_buffer_.reset(new ConcurrentLogBuffer(capacity));
+  }
+
+  ConcurrentLogBuffer *GetConcurrentLogBuffer() {
+    return concurrent_log_buffer_.get();
+  }
+
  protected:
   // Associated backend loggers
   std::vector<BackendLogger *> backend_loggers;
@@ -141,6 +151,13 @@ class FrontendLogger : public Logger {
   bool test_mode_ = false;
 
   bool is_distinguished_logger = false;
+
+  // log buffer shared by the backend loggers (if enabled)
+  std::unique_ptr<ConcurrentLogBuffer> concurrent_log_buffer_;
+
+  // the shared log buffer is complete up to this offset as of the last
+  // collection
+  uint64_t concurrent_log_buffer_end_ = 0;
 };
 
 }  // namespace logging
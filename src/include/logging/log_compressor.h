@@ -0,0 +1,52 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// log_compressor.h
+//
+// Identification: src/include/logging/log_compressor.h
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <cstddef>
+
+namespace peloton {
+namespace logging {
+
+//===--------------------------------------------------------------------===//
+// Log Compressor
+//===--------------------------------------------------------------------===//
+
+/**
+ * @brief Fast LZ77 block compressor for log buffers.
+ *
+ * Blocks use the LZ4 block layout: a token byte holding the literal and
+ * match lengths, the literals, a two byte little endian match offset and
+ * extra length bytes when a length does not fit into its nibble. There is
+ * no entropy coding, so compression and decompression are cheap enough to
+ * run on the logging path.
+ */
+class LogCompressor {
+ public:
+  // Upper bound of the compressed size of source_size bytes
+  static size_t GetMaxCompressedSize(size_t source_size) {
+    return source_size + source_size / 255 + 16;
+  }
+
+  // Compress source into destination, which must have room for
+  // GetMaxCompressedSize(source_size) bytes. Returns the compressed size.
+  static size_t Compress(const char *source, size_t source_size,
+                         char *destination);
+
+  // Decompress a block. Returns false unless the block is well formed and
+  // expands to exactly destination_size bytes.
+  static bool Decompress(const char *source, size_t source_size,
+                         char *destination, size_t destination_size);
+};
+
+}  // namespace logging
+}  // namespace peloton
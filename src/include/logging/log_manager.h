@@ -12,6 +12,7 @@
 
 #pragma once
 
+#include <atomic>
 #include <map>
 #include <mutex>
 #include <vector>
@@ -21,9 +22,12 @@
 #include "frontend_logger.h"
 #include "loggers/wal_frontend_logger.h"
 #include "logging/logger.h"
+#include "statistics/latency_histogram.h"
 
 #define DEFAULT_NUM_FRONTEND_LOGGERS 1
 
+#define DEFAULT_NUM_RECOVERY_THREADS 4
+
 //===--------------------------------------------------------------------===//
 // GUC Variables
 //===--------------------------------------------------------------------===//
@@ -92,6 +96,10 @@ class LogManager {
     return is_in_logging_mode;
   }
 
+  // Whether updates are logged with only the columns they assigned, which
+  // the update executor then records in its transaction
+  bool IsLoggingUpdatedColumns();
+
   // Used to terminate current logging and wait for sleep mode
   void TerminateLoggingMode();
 
@@ -175,9 +183,10 @@ class LogManager {
   // log the beginning of a commited transaction
   void LogBeginTransaction(cid_t commit_id);
 
-  // log an update
+  // log an update, only the updated columns if they are given
   void LogUpdate(cid_t commit_id, const ItemPointer &old_version,
-                 const ItemPointer &new_version);
+                 const ItemPointer &new_version,
+                 const std::vector<oid_t> *updated_columns = nullptr);
 
   // log an insert
   void LogInsert(cid_t commit_id, const ItemPointer &new_location);
@@ -185,8 +194,17 @@ class LogManager {
   // log a delete
   void LogDelete(cid_t commit_id, const ItemPointer &delete_location);
 
-  // commit a transaction and wait until stable
-  void LogCommitTransaction(cid_t commit_id);
+  // commit a transaction and wait until stable. A commit that does not wait
+  // is made stable by the next WaitForPendingFlush of the thread.
+  void LogCommitTransaction(cid_t commit_id, bool wait_for_flush = true);
+
+  // wait until the commits a read only transaction reading at the commit id
+  // may have seen are stable. Without waiting, the next WaitForPendingFlush
+  // of the thread waits for them.
+  void WaitForReadCommits(cid_t read_cid, bool wait_for_flush = true);
+
+  // wait until the commits the thread logged without waiting are stable
+  void WaitForPendingFlush();
 
   // used by the checkpointer to truncate unneeded log files
   void TruncateLogs(txn_id_t commit_id);
@@ -236,6 +254,30 @@ class LogManager {
     log_buffer_capacity_ = log_buffer_capacity;
   }
 
+  // get the number of threads used to replay log records during recovery
+  inline unsigned int GetRecoveryThreadCount() const {
+    return num_recovery_threads_;
+  }
+
+  // set the number of threads used to replay log records during recovery
+  inline void SetRecoveryThreadCount(unsigned int num_recovery_threads) {
+    num_recovery_threads_ = num_recovery_threads;
+  }
+
+  // compress the log buffers of each flush before writing them out
+  inline bool GetLogCompression() const { return log_compression_; }
+
+  inline void SetLogCompression(bool log_compression) {
+    log_compression_ = log_compression;
+  }
+
+  // share one log buffer between the backend loggers of a frontend logger
+  inline bool GetConcurrentLogBuffer() const { return concurrent_log_buffer_; }
+
+  inline void SetConcurrentLogBuffer(bool concurrent_log_buffer) {
+    concurrent_log_buffer_ = concurrent_log_buffer;
+  }
+
   inline void SetNoWrite(bool no_write) { no_write_ = no_write; }
 
   inline bool GetNoWrite() const { return no_write_; }
@@ -257,6 +299,16 @@ class LogManager {
   // numbe of frontend loggers
   unsigned int num_frontend_loggers_ = DEFAULT_NUM_FRONTEND_LOGGERS;
 
+  // number of threads used by each frontend logger to replay its log
+  unsigned int num_recovery_threads_ = DEFAULT_NUM_RECOVERY_THREADS;
+
+  // whether frontend loggers compress what they flush
+  bool log_compression_ = false;
+
+  // whether backend loggers write into a log buffer shared through their
+  // frontend logger (write ahead logging only)
+  bool concurrent_log_buffer_ = false;
+
   // set the strategy for mapping frontend loggers to worker threads
   LoggerMappingStrategyType logger_mapping_strategy_ =
       LoggerMappingStrategyType::INVALID;
@@ -283,6 +335,9 @@ class LogManager {
   std::mutex flush_notify_mutex;
   std::condition_variable flush_notify_cv;
 
+  // when the last flush was signaled, protected by flush_notify_mutex
+  stats::LatencyHistogram::Clock::time_point flush_notify_time;
+
   // To update catalog and txn managers
   std::mutex update_managers_mutex;
 
@@ -307,6 +362,9 @@ class LogManager {
 
   cid_t global_max_flushed_commit_id = 0;
 
+  // largest commit id of a transaction that began logging its commit
+  std::atomic<cid_t> max_logging_cid_ = ATOMIC_VAR_INIT(INVALID_CID);
+
   // number the fronted loggers who have updated the manager of their max oid
   // and cid
   int update_managers_count = 0;
@@ -33,6 +33,18 @@
  *     -BODY
  *       - Body length           : int
  *       - Data                  : void*
+ *
+ *     Partial Update Record : same HEADER as the Tuple Record
+ *     -BODY
+ *       - Body length           : int
+ *       - Column count          : int
+ *       - Column id, Value      : int, Value (for each modified column)
+ *
+ *     Compressed Block :
+ *       - LogRecordType         : enum
+ *       - Frame length          : int
+ *       - Uncompressed length   : int
+ *       - Records               : LogCompressor block
 */
 
 #pragma once
@@ -63,6 +75,12 @@ class LogRecord {
 
   virtual bool Serialize(CopySerializeOutput &output) = 0;
 
+  // Write the record into the output without keeping a copy of it
+  virtual bool SerializeTo(SerializeOutput &output) = 0;
+
+  // Number of bytes SerializeTo writes
+  virtual size_t GetSerializedLength() const = 0;
+
   char *GetMessage(void) const { return message; }
 
   size_t GetMessageLength(void) const { return message_length; }
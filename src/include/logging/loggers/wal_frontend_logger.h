@@ -22,6 +22,7 @@
 #include <vector>
 #include <set>
 #include <chrono>
+#include <memory>
 
 extern int peloton_flush_frequency_micros;
 
@@ -72,6 +73,8 @@ class WriteAheadFrontendLogger : public FrontendLogger {
 
   void UpdateTuple(TupleRecord *recovery_txn);
 
+  void ReplayTupleRecords(const std::vector<TupleRecord *> &tuple_records);
+
   void AbortActiveTransactions();
 
   void InitLogFilesList();
@@ -108,10 +111,21 @@ class WriteAheadFrontendLogger : public FrontendLogger {
   std::string GetLogFileName(void);
 
   bool RecoverTableIndexHelper(storage::DataTable *target_table,
-                               cid_t start_cid);
+                               oid_t index_offset, cid_t start_cid);
 
   void InsertIndexEntry(storage::Tuple *tuple, storage::DataTable *table,
-                        ItemPointer target_location);
+                        oid_t index_offset, ItemPointer target_location);
+
+  void ReplayCommittedRecords();
+
+  void WriteCompressedBlock();
+
+  void OpenCompressedBlock();
+
+  void CloseCompressedBlock();
+
+  std::pair<cid_t, cid_t> ExtractMaxLogIdAndMaxDelimFromFileHandle(
+      FileHandle &file_handle);
 
   //===--------------------------------------------------------------------===//
   // Member Variables
@@ -123,6 +137,30 @@ class WriteAheadFrontendLogger : public FrontendLogger {
   // Txn table during recovery
   std::map<txn_id_t, std::vector<TupleRecord *>> recovery_txn_table;
 
+  // Records of committed txns waiting to be replayed, in commit order
+  std::vector<TupleRecord *> committed_records_;
+
+  // Number of buffered records that triggers a replay
+  static constexpr size_t replay_batch_size = 1 << 16;
+
+  // Size of the stdio buffer used while reading log files
+  static constexpr size_t recovery_read_buffer_size = 1 << 22;
+
+  // stdio buffer used while reading log files
+  std::unique_ptr<char[]> recovery_read_buffer_;
+
+  // Log file that is put aside while cur_file_handle reads the records of
+  // a compressed block
+  FileHandle log_file_handle_;
+
+  // Uncompressed records of the current block
+  std::vector<char> compressed_block_records_;
+
+  // Staging buffers used to compress the log buffers of a flush
+  std::vector<char> compression_input_;
+
+  std::vector<char> compression_output_;
+
   // Keep tracking max oid for setting next_oid in manager
   // For active processing after recovery
   oid_t max_oid = 0;
@@ -59,8 +59,15 @@ class LoggingUtil {
                                              type::AbstractPool *pool,
                                              FileHandle &file_handle);
 
+  static storage::Tuple *ReadPartialTupleRecordBody(
+      TupleRecord &tuple_record, const catalog::Schema *schema,
+      type::AbstractPool *pool, FileHandle &file_handle);
+
   static void SkipTupleRecordBody(FileHandle &file_handle);
 
+  static bool ReadCompressedLogBlock(FileHandle &file_handle,
+                                     std::vector<char> &block);
+
   static int GetFileSizeFromFileName(const char *);
 
   static bool CreateDirectory(const char *dir_name, int mode);
@@ -42,6 +42,10 @@ class TransactionRecord : public LogRecord, Printable {
 
   bool Serialize(CopySerializeOutput &output);
 
+  bool SerializeTo(SerializeOutput &output);
+
+  size_t GetSerializedLength() const;
+
   void Deserialize(CopySerializeInput &input);
 
   static size_t GetTransactionRecordSize(void);
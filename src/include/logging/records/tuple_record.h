@@ -12,6 +12,8 @@
 
 #pragma once
 
+#include <vector>
+
 #include "common/item_pointer.h"
 #include "common/printable.h"
 #include "logging/log_record.h"
@@ -62,7 +64,11 @@ class TupleRecord : public LogRecord, Printable {
 
   bool Serialize(CopySerializeOutput &output);
 
-  void SerializeHeader(CopySerializeOutput &output);
+  bool SerializeTo(SerializeOutput &output);
+
+  size_t GetSerializedLength() const;
+
+  void SerializeHeader(SerializeOutput &output);
 
   void DeserializeHeader(CopySerializeInput &input);
 
@@ -82,6 +88,15 @@ class TupleRecord : public LogRecord, Printable {
 
   storage::Tuple *GetTuple();
 
+  // Columns carried by a partial update record
+  void SetModifiedColumns(const std::vector<oid_t> &columns) {
+    modified_columns = columns;
+  }
+
+  const std::vector<oid_t> &GetModifiedColumns() const {
+    return modified_columns;
+  }
+
   static size_t GetTupleRecordSize(void);
 
   // Get a string representation for debugging
@@ -107,6 +122,9 @@ class TupleRecord : public LogRecord, Printable {
   // tuple (for deserialize
   storage::Tuple *tuple = nullptr;
 
+  // modified columns (only for partial updates)
+  std::vector<oid_t> modified_columns;
+
   // database id
   oid_t db_oid = DEFAULT_DB_ID;
 };
@@ -14,6 +14,7 @@
 
 #include "type/types.h"
 #include "optimizer/query_node_visitor.h"
+#include "expression/abstract_expression.h"
 #include "parser/sql_statement.h"
 
 namespace peloton {
@@ -172,8 +173,14 @@ struct CreateStatement : TableRefStatement {
       delete index_attrs;
     }
 
+    if (partition_bounds) {
+      for (auto bound : *partition_bounds) delete bound;
+      delete partition_bounds;
+    }
+
     free(index_name);
     free(database_name);
+    free(partition_column);
   }
 
   virtual void Accept(optimizer::QueryNodeVisitor* v) const override {
@@ -192,6 +199,12 @@ struct CreateStatement : TableRefStatement {
   char* database_name = nullptr;
 
   bool unique = false;
+
+  // PARTITION BY clause of a table
+  PartitionType partition_type = PartitionType::INVALID;
+  char* partition_column = nullptr;
+  std::vector<expression::AbstractExpression*>* partition_bounds = nullptr;
+  int partition_count = 0;
 };
 
 }  // End parser namespace
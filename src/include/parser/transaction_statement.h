@@ -20,7 +20,8 @@ namespace parser {
 
 /**
  * @struct TransactionStatement
- * @brief Represents "BEGIN or COMMIT or ROLLBACK [TRANSACTION]"
+ * @brief Represents "BEGIN or COMMIT or ROLLBACK [TRANSACTION]", a BEGIN
+ * may be followed by READ ONLY
  */
 struct TransactionStatement : SQLStatement {
   enum CommandType {
@@ -30,13 +31,16 @@ struct TransactionStatement : SQLStatement {
   };
 
   TransactionStatement(CommandType type)
-      : SQLStatement(StatementType::TRANSACTION), type(type) {}
+      : SQLStatement(StatementType::TRANSACTION),
+        type(type),
+        read_only(false) {}
 
   virtual void Accept(optimizer::QueryNodeVisitor* v) const override {
     v->Visit(this);
   }
 
   CommandType type;
+  bool read_only;
 };
 
 }  // End parser namespace
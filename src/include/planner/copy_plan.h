@@ -40,6 +40,22 @@ class CopyPlan : public AbstractPlan {
     LOG_DEBUG("Creating a Copy Plan");
   }
 
+  // Import the file into the target table
+  explicit CopyPlan(storage::DataTable *target_table, char *file_path,
+                    CopyType copy_type, char delimiter)
+      : file_path(file_path),
+        copy_type(copy_type),
+        delimiter(delimiter),
+        target_table(target_table) {
+    LOG_DEBUG("Creating an import Copy Plan");
+  }
+
+  inline bool IsImport() const {
+    return copy_type == CopyType::IMPORT_CSV ||
+           copy_type == CopyType::IMPORT_TSV ||
+           copy_type == CopyType::IMPORT_BINARY;
+  }
+
   inline PlanNodeType GetPlanNodeType() const { return PlanNodeType::COPY; }
 
   const std::string GetInfo() const { return "CopyPlan"; }
@@ -52,6 +68,15 @@ class CopyPlan : public AbstractPlan {
 
   // Whether the copying requires deserialization of parameters
   bool deserialize_parameters = false;
+
+  // The direction and the format of the copy
+  CopyType copy_type = CopyType::EXPORT_OTHER;
+
+  // Field delimiter of text imports
+  char delimiter = ',';
+
+  // The table to import into
+  storage::DataTable *target_table = nullptr;
 };
 
 }  // namespace planner
@@ -16,6 +16,7 @@
 
 namespace peloton {
 namespace catalog {
+class PartitionScheme;
 class Schema;
 }
 namespace storage {
@@ -67,6 +68,10 @@ class CreatePlan : public AbstractPlan {
   std::vector<std::string> GetIndexAttributes() const { return index_attrs; }
 
  private:
+  // Partitioning of the table given by the PARTITION BY clause
+  static std::shared_ptr<const catalog::PartitionScheme> GetPartitionScheme(
+      parser::CreateStatement *parse_tree, const catalog::Schema *schema);
+
   // Target Table
   storage::DataTable *target_table_ = nullptr;
 
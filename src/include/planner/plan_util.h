@@ -101,6 +101,48 @@ class PlanUtil {
       }
     }
   }
+
+ public:
+  /**
+   * @brief Check whether the plan only reads, i.e. it has no mutator, DDL or
+   * copy node and no scan that acquires ownership
+   * @param The plan tree
+   * @return true if the plan can run in a read only transaction
+   */
+  static bool IsReadOnly(const planner::AbstractPlan *plan) {
+    if (plan == nullptr) {
+      return false;
+    }
+    switch (plan->GetPlanNodeType()) {
+      case PlanNodeType::UPDATE:
+      case PlanNodeType::INSERT:
+      case PlanNodeType::DELETE:
+      case PlanNodeType::DROP:
+      case PlanNodeType::CREATE:
+      case PlanNodeType::COPY:
+        return false;
+      // hybrid scans report SEQSCAN as their type and are checked here too
+      case PlanNodeType::ABSTRACT_SCAN:
+      case PlanNodeType::SEQSCAN:
+      case PlanNodeType::INDEXSCAN: {
+        const planner::AbstractScan *scan_node =
+            reinterpret_cast<const planner::AbstractScan *>(plan);
+        if (scan_node->IsForUpdate()) {
+          return false;
+        }
+        break;
+      }
+      default: {
+        break;
+      }
+    }  // SWITCH
+    for (auto &child : plan->GetChildren()) {
+      if (child != nullptr && IsReadOnly(child.get()) == false) {
+        return false;
+      }
+    }
+    return true;
+  }
 };
 }
 }
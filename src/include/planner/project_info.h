@@ -19,6 +19,16 @@
 #include "storage/tuple.h"
 
 namespace peloton {
+
+namespace expression {
+template <class T>
+class ContainerTuple;
+}
+
+namespace storage {
+class TileGroup;
+}
+
 namespace planner {
 
 /**
@@ -65,6 +75,13 @@ class ProjectInfo {
                 const AbstractTuple *tuple2,
                 executor::ExecutorContext *econtext) const;
 
+  // Build a new version from an old version in the same table. Direct maps
+  // from the old version are copied field by field.
+  bool Evaluate(expression::ContainerTuple<storage::TileGroup> *dest,
+                const expression::ContainerTuple<storage::TileGroup> *tuple1,
+                const AbstractTuple *tuple2,
+                executor::ExecutorContext *econtext) const;
+
   std::string Debug() const;
 
   ~ProjectInfo();
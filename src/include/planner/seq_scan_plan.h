@@ -24,6 +24,12 @@
 
 namespace peloton {
 
+namespace catalog {
+class PartitionScheme;
+}
+namespace executor {
+class ExecutorContext;
+}
 namespace parser {
 struct SelectStatement;
 }
@@ -57,6 +63,12 @@ class SeqScanPlan : public AbstractScan {
 
   void SetParameterValues(std::vector<type::Value> *values);
 
+  // Flags the partitions of a partitioned table that may hold tuples
+  // satisfying the predicate. Constants and parameters of the predicate are
+  // evaluated with the executor context, once the parameters are bound.
+  std::vector<bool> GetScannedPartitions(
+      executor::ExecutorContext *executor_context) const;
+
   //===--------------------------------------------------------------------===//
   // Serialization/Deserialization
   //===--------------------------------------------------------------------===//
@@ -75,6 +87,10 @@ class SeqScanPlan : public AbstractScan {
   }
 
  private:
+  static std::vector<bool> GetScannedPartitions(
+      const catalog::PartitionScheme &partition_scheme,
+      const expression::AbstractExpression *expr,
+      executor::ExecutorContext *executor_context);
 };
 
 }  // namespace planner
@@ -21,6 +21,7 @@
 #include "statistics/table_metric.h"
 #include "statistics/index_metric.h"
 #include "statistics/latency_metric.h"
+#include "statistics/log_metric.h"
 #include "statistics/database_metric.h"
 #include "statistics/query_metric.h"
 #include "container/cuckoo_map.h"
@@ -80,6 +81,9 @@ class BackendStatsContext {
   // Returns the latency metric
   LatencyMetric& GetTxnLatencyMetric();
 
+  // Returns the latencies of the logging phases run by this thread
+  LogMetric& GetLogMetric();
+
   // Increment the read stat for given tile group
   void IncrementTableReads(oid_t tile_group_id);
 
@@ -174,6 +178,9 @@ class BackendStatsContext {
   // Latencies recorded by this worker
   LatencyMetric txn_latencies_;
 
+  // Logging phase latencies recorded by this worker
+  LogMetric log_metric_;
+
   // Whether this context is registered to the global aggregator
   bool is_registered_to_aggregator_;
 
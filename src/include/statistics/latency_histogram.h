@@ -0,0 +1,119 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// latency_histogram.h
+//
+// Identification: src/include/statistics/latency_histogram.h
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <string>
+
+#include "type/types.h"
+#include "statistics/abstract_metric.h"
+
+// Bucket i holds latencies in [2^(i-1), 2^i) us, the last one everything above
+#define LATENCY_HISTOGRAM_BUCKET_COUNT 32
+
+namespace peloton {
+namespace stats {
+
+/**
+ * Metric for the distribution of latencies in log2-sized microsecond buckets.
+ *
+ * Unlike LatencyMetric it keeps no samples, so recording a latency is a few
+ * relaxed stores and never blocks. Each histogram has a single writer, the
+ * thread that owns it; the aggregator only reads it.
+ */
+class LatencyHistogram : public AbstractMetric {
+ public:
+  typedef std::chrono::steady_clock Clock;
+
+  LatencyHistogram(MetricType type = HISTOGRAM_METRIC);
+
+  //===--------------------------------------------------------------------===//
+  // ACCESSORS
+  //===--------------------------------------------------------------------===//
+
+  // Records a latency in microseconds
+  inline void RecordLatency(uint64_t latency_us) {
+    Increment(buckets_[GetBucket(latency_us)], 1);
+    Increment(count_, 1);
+    Increment(sum_, latency_us);
+    if (latency_us > max_.load(std::memory_order_relaxed)) {
+      max_.store(latency_us, std::memory_order_relaxed);
+    }
+  }
+
+  // Records the time elapsed since start
+  inline void RecordLatency(Clock::time_point start) {
+    RecordLatency(std::chrono::duration_cast<std::chrono::microseconds>(
+                      Clock::now() - start).count());
+  }
+
+  inline uint64_t GetCount() const {
+    return count_.load(std::memory_order_relaxed);
+  }
+
+  inline uint64_t GetMax() const {
+    return max_.load(std::memory_order_relaxed);
+  }
+
+  // Returns the average latency in microseconds
+  double GetAverage() const;
+
+  // Returns an upper bound of the given percentile (0 - 100) in microseconds
+  uint64_t GetPercentile(double percentile) const;
+
+  //===--------------------------------------------------------------------===//
+  // HELPER METHODS
+  //===--------------------------------------------------------------------===//
+
+  void Reset();
+
+  // Adds the counts of the source histogram to this histogram
+  void Aggregate(AbstractMetric &source);
+
+  // Returns a string representation of this histogram
+  const std::string GetInfo() const;
+
+  static inline size_t GetBucket(uint64_t latency_us) {
+    if (latency_us == 0) return 0;
+    size_t bucket = 64 - __builtin_clzll(latency_us);
+    return std::min<size_t>(bucket, LATENCY_HISTOGRAM_BUCKET_COUNT - 1);
+  }
+
+ private:
+  // Only the owning thread writes, so no read-modify-write is needed
+  static inline void Increment(std::atomic<uint64_t> &counter,
+                               uint64_t value) {
+    counter.store(counter.load(std::memory_order_relaxed) + value,
+                  std::memory_order_relaxed);
+  }
+
+  //===--------------------------------------------------------------------===//
+  // MEMBERS
+  //===--------------------------------------------------------------------===//
+
+  std::atomic<uint64_t> buckets_[LATENCY_HISTOGRAM_BUCKET_COUNT];
+
+  // Number of latencies recorded
+  std::atomic<uint64_t> count_;
+
+  // Sum of the latencies recorded
+  std::atomic<uint64_t> sum_;
+
+  // Largest latency recorded
+  std::atomic<uint64_t> max_;
+};
+
+}  // namespace stats
+}  // namespace peloton
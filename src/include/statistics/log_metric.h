@@ -0,0 +1,79 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// log_metric.h
+//
+// Identification: src/include/statistics/log_metric.h
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <string>
+
+#include "type/types.h"
+#include "statistics/abstract_metric.h"
+#include "statistics/latency_histogram.h"
+
+namespace peloton {
+namespace stats {
+
+// The phases a commit goes through in the logging subsystem
+enum LogPhaseType {
+  // Serializing the commit record in the backend logger
+  LOG_PHASE_SERIALIZATION = 0,
+  // From logging the commit record until the frontend logger collects it
+  LOG_PHASE_QUEUEING = 1,
+  // Writing the collected records to the log file
+  LOG_PHASE_WRITE = 2,
+  // Flushing and syncing the log file
+  LOG_PHASE_FSYNC = 3,
+  // From the frontend logger signaling a flush until the committer wakes up
+  LOG_PHASE_FLUSH_WAIT = 4,
+
+  LOG_PHASE_COUNT = 5
+};
+
+/**
+ * Metric for the latencies of the phases of logging a commit
+ */
+class LogMetric : public AbstractMetric {
+ public:
+  LogMetric(MetricType type);
+
+  //===--------------------------------------------------------------------===//
+  // ACCESSORS
+  //===--------------------------------------------------------------------===//
+
+  inline LatencyHistogram &GetPhaseLatency(LogPhaseType phase) {
+    return phase_latencies_[phase];
+  }
+
+  static std::string GetPhaseName(LogPhaseType phase);
+
+  //===--------------------------------------------------------------------===//
+  // HELPER METHODS
+  //===--------------------------------------------------------------------===//
+
+  void Reset();
+
+  // Adds the source log metric to this log metric
+  void Aggregate(AbstractMetric &source);
+
+  // Returns a string representation of this log metric
+  const std::string GetInfo() const;
+
+ private:
+  //===--------------------------------------------------------------------===//
+  // MEMBERS
+  //===--------------------------------------------------------------------===//
+
+  // Latencies (us) of each phase
+  LatencyHistogram phase_latencies_[LOG_PHASE_COUNT];
+};
+
+}  // namespace stats
+}  // namespace peloton
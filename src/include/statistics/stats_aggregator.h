@@ -165,6 +165,9 @@ class StatsAggregator {
   // Write all query metrics to a metric table
   void UpdateQueryMetrics(int64_t time_stamp, concurrency::Transaction *txn);
 
+  // Write the logging phase latencies to a metric table
+  void UpdateLogMetrics(int64_t time_stamp, concurrency::Transaction *txn);
+
   // Aggregate stats periodically
   void RunAggregator();
 };
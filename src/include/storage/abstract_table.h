@@ -20,6 +20,7 @@
 #include <string>
 
 #include "common/item_pointer.h"
+#include "common/numa_util.h"
 #include "common/printable.h"
 #include "type/types.h"
 
@@ -132,7 +133,8 @@ class AbstractTable : public Printable {
 
   TileGroup *GetTileGroupWithLayout(oid_t database_id, oid_t tile_group_id,
                                     const column_map_type &partitioning,
-                                    const size_t num_tuples);
+                                    const size_t num_tuples,
+                                    int numa_node = NUMA_NODE_ANY);
 
   column_map_type GetTileGroupLayout(LayoutType layout_type) const;
 
@@ -0,0 +1,117 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// column_accessor.h
+//
+// Identification: src/include/storage/column_accessor.h
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include "common/macros.h"
+#include "type/types.h"
+#include "type/value.h"
+
+namespace peloton {
+
+namespace type {
+class AbstractPool;
+}
+
+namespace storage {
+
+class Tile;
+
+//===--------------------------------------------------------------------===//
+// Column Accessor
+//
+// The location of one column of a tile, resolved once from the tile schema:
+// the tuple slots, the fixed offset of the field within a slot, its type and
+// whether it is inlined. Inlined fields are read and written as native
+// values, so no type::Value is built on the fast path.
+//
+// A default constructed accessor is not bound to any column.
+//===--------------------------------------------------------------------===//
+
+class ColumnAccessor {
+ public:
+  ColumnAccessor() {}
+
+  ColumnAccessor(Tile *tile, oid_t tile_column_id);
+
+  inline bool IsValid() const { return tile_ != nullptr; }
+
+  inline Tile *GetTile() const { return tile_; }
+
+  inline type::Type::TypeId GetType() const { return type_id_; }
+
+  inline bool IsInlined() const { return is_inlined_; }
+
+  // Storage length of the field, the pointer size for uninlined fields
+  inline size_t GetFieldLength() const { return field_length_; }
+
+  inline char *GetFieldLocation(const oid_t tuple_id) const {
+    return data_ + tuple_id * tuple_length_ + column_offset_;
+  }
+
+  // Native value of an inlined field. NULLs come back as the NULL sentinel
+  // of the type, e.g. PELOTON_INT32_NULL.
+  template <typename T>
+  inline T Get(const oid_t tuple_id) const {
+    PL_ASSERT(is_inlined_ && sizeof(T) == field_length_);
+    return *reinterpret_cast<const T *>(GetFieldLocation(tuple_id));
+  }
+
+  template <typename T>
+  inline void Set(const oid_t tuple_id, const T value) const {
+    PL_ASSERT(is_inlined_ && sizeof(T) == field_length_);
+    *reinterpret_cast<T *>(GetFieldLocation(tuple_id)) = value;
+  }
+
+  // Length and data of an uninlined field, data is nullptr for NULL
+  inline const char *GetVarlen(const oid_t tuple_id, uint32_t &length) const {
+    PL_ASSERT(!is_inlined_);
+    const char *varlen =
+        *reinterpret_cast<const char *const *>(GetFieldLocation(tuple_id));
+    if (varlen == nullptr) {
+      length = 0;
+      return nullptr;
+    }
+    length = *reinterpret_cast<const uint32_t *>(varlen);
+    return varlen + sizeof(uint32_t);
+  }
+
+  type::Value GetValue(const oid_t tuple_id) const;
+
+  void SetValue(const oid_t tuple_id, const type::Value &value) const;
+
+  // Copy a field of the source column into this column. Fields of the same
+  // inlined type are copied bytewise and uninlined fields are copied into the
+  // pool of this tile, without going through type::Value.
+  void CopyField(const oid_t tuple_id, const ColumnAccessor &source,
+                 const oid_t source_tuple_id) const;
+
+ private:
+  Tile *tile_ = nullptr;
+
+  char *data_ = nullptr;
+
+  type::AbstractPool *pool_ = nullptr;
+
+  size_t tuple_length_ = 0;
+
+  size_t column_offset_ = 0;
+
+  size_t field_length_ = 0;
+
+  type::Type::TypeId type_id_ = type::Type::INVALID;
+
+  bool is_inlined_ = true;
+};
+
+}  // End storage namespace
+}  // End peloton namespace
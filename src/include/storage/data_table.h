@@ -21,6 +21,7 @@
 #include "common/item_pointer.h"
 #include "common/platform.h"
 #include "container/lock_free_array.h"
+#include "container/lock_free_queue.h"
 #include "index/index.h"
 #include "storage/abstract_table.h"
 #include "storage/indirection_array.h"
@@ -39,6 +40,7 @@ class Sample;
 
 namespace catalog {
 class ForeignKey;
+class PartitionScheme;
 }
 
 namespace index {
@@ -103,7 +105,8 @@ class DataTable : public AbstractTable {
   // copy the content into the version. after that, we need to check constraints
   // and then install the version
   // into all the corresponding indexes.
-  ItemPointer AcquireVersion();
+  // a partitioned table places the version in the given partition.
+  ItemPointer AcquireVersion(const oid_t partition = INVALID_OID);
 
   // install an version in table. designed for update operation.
   // as we implement logical-pointer indexing mechanism, targets_ptr is
@@ -140,8 +143,51 @@ class DataTable : public AbstractTable {
 
   size_t GetTileGroupCount() const;
 
-  // Get a tile group with given layout
-  TileGroup *GetTileGroupWithLayout(const column_map_type &partitioning);
+  //===--------------------------------------------------------------------===//
+  // PARTITIONS
+  //===--------------------------------------------------------------------===//
+
+  // nullptr if the table is not partitioned
+  inline const std::shared_ptr<const catalog::PartitionScheme> &
+  GetPartitionScheme() const {
+    return partition_scheme_;
+  }
+
+  // Get the ids of the tile groups of the flagged partitions and of the tile
+  // groups not bound to any partition, in ascending order
+  void GetTileGroupIds(const std::vector<bool> &partitions,
+                       std::vector<oid_t> &tile_group_ids);
+
+  // Get a tile group with given layout, placed on the NUMA node if one is
+  // given
+  TileGroup *GetTileGroupWithLayout(const column_map_type &partitioning,
+                                    int numa_node = NUMA_NODE_ANY);
+
+  //===--------------------------------------------------------------------===//
+  // BULK LOAD
+  //===--------------------------------------------------------------------===//
+
+  // Get a fresh tile group with the default layout that is not yet part of
+  // the table. The bulk loader fills its tuple slots directly.
+  std::shared_ptr<TileGroup> GetBulkLoadTileGroup();
+
+  // Add a filled bulk load tile group to the table and insert its tuples into
+  // all indexes, one index at a time. The tuples stay owned by the loading
+  // transaction, and so invisible to others, until CommitBulkLoad.
+  // Returns false if a tuple violates a primary/unique index.
+  bool AddBulkLoadTileGroup(const std::shared_ptr<TileGroup> &tile_group,
+                            concurrency::Transaction *transaction);
+
+  // Record all tuples of the added bulk load tile groups as inserts of the
+  // loading transaction. They are logged and become visible when it commits.
+  void CommitBulkLoad(
+      const std::vector<std::shared_ptr<TileGroup>> &tile_groups,
+      concurrency::Transaction *transaction);
+
+  // Remove the index entries of all tuples of the added bulk load tile groups
+  // and invalidate the tuples
+  void AbortBulkLoad(
+      const std::vector<std::shared_ptr<TileGroup>> &tile_groups);
 
   //===--------------------------------------------------------------------===//
   // INDEX
@@ -268,20 +314,36 @@ class DataTable : public AbstractTable {
 
   bool CheckConstraints(const storage::Tuple *tuple) const;
 
-  // Claim a tuple slot in a tile group
-  ItemPointer GetEmptyTupleSlot(const storage::Tuple *tuple);
+  // Claim a tuple slot in a tile group. The slot of a partitioned table is
+  // taken from the given partition, or else from the partition of the tuple.
+  // New slots come from an active tile group on the NUMA node of the caller.
+  ItemPointer GetEmptyTupleSlot(const storage::Tuple *tuple,
+                                oid_t partition = INVALID_OID);
 
   // add a tile group to the table
   oid_t AddDefaultTileGroup();
   // add a tile group to the table. replace the active_tile_group_id-th active
-  // tile group.
+  // tile group, on the NUMA node of that active tile group.
   oid_t AddDefaultTileGroup(const size_t &active_tile_group_id);
 
+  // NUMA node whose tile groups take the slots of the active tile group
+  inline int GetActiveTileGroupNode(const size_t &active_tile_group_id) const {
+    if (numa_node_count_ == 1) return NUMA_NODE_ANY;
+    return static_cast<int>(active_tile_group_id / active_tilegroup_count_);
+  }
+
   oid_t AddDefaultIndirectionArray(const size_t &active_indirection_array_id);
 
   // Drop all tile groups of the table. Used by recovery
   void DropTileGroups();
 
+  // Record the tile group in the list of the partition. Tile groups that are
+  // not bound to a partition go to the last list.
+  void AddPartitionTileGroup(const std::shared_ptr<TileGroup> &tile_group,
+                             const oid_t partition);
+
+  size_t GetPartitionListId(const oid_t partition) const;
+
   //===--------------------------------------------------------------------===//
   // INDEX HELPERS
   //===--------------------------------------------------------------------===//
@@ -304,9 +366,14 @@ class DataTable : public AbstractTable {
   // MEMBERS
   //===--------------------------------------------------------------------===//
 
+  // active tile groups per NUMA node
   size_t active_tilegroup_count_;
   size_t active_indirection_array_count_;
 
+  // NUMA nodes with their own active tile groups, 1 unless NUMA placement
+  // is on
+  size_t numa_node_count_;
+
   oid_t database_oid;
   std::string table_name;
 
@@ -316,10 +383,24 @@ class DataTable : public AbstractTable {
   // TILE GROUPS
   LockFreeArray<oid_t> tile_groups_;
 
+  // the active tile groups of NUMA node n are those from
+  // n * active_tilegroup_count_ on
   std::vector<std::shared_ptr<storage::TileGroup>> active_tile_groups_;
 
   std::atomic<size_t> tile_group_count_ = ATOMIC_VAR_INIT(0);
 
+  // PARTITIONS
+  // with a partition scheme the i-th active tile group of every NUMA node
+  // belongs to partition i
+  std::shared_ptr<const catalog::PartitionScheme> partition_scheme_;
+  // ids of the tile groups of every partition, and of the unbound ones
+  std::vector<std::vector<oid_t>> partition_tile_groups_;
+  std::mutex partition_mutex_;
+  // recycled slots that the garbage collector returned for an insert into
+  // another partition, kept for the partition of their tile group
+  std::vector<std::unique_ptr<LockFreeQueue<ItemPointer>>>
+      partition_free_slots_;
+
   // INDIRECTIONS
   std::vector<std::shared_ptr<storage::IndirectionArray>>
       active_indirection_arrays_;
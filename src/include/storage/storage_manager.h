@@ -14,6 +14,7 @@
 
 #include <mutex>
 
+#include "common/numa_util.h"
 #include "common/platform.h"
 #include "type/types.h"
 
@@ -44,7 +45,9 @@ class StorageManager {
   StorageManager();
   ~StorageManager();
 
-  void *Allocate(BackendType type, size_t size);
+  // Main memory is placed on the NUMA node, if one is given
+  void *Allocate(BackendType type, size_t size,
+                 int numa_node = NUMA_NODE_ANY);
 
   void Release(BackendType type, void *address);
 
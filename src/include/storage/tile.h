@@ -18,7 +18,9 @@
 #include "catalog/schema.h"
 #include "common/item_pointer.h"
 #include "common/printable.h"
+#include "storage/column_accessor.h"
 #include "type/abstract_pool.h"
+#include "type/slab_pool.h"
 #include "type/serializeio.h"
 #include "type/serializer.h"
 
@@ -47,6 +49,7 @@ class TupleIterator;
  * NOTE: MVCC is implemented on the shared TileGroupHeader.
  */
 class Tile : public Printable {
+  friend class ColumnAccessor;
   friend class TileFactory;
   friend class TupleIterator;
   friend class TileGroupHeader;
@@ -110,6 +113,12 @@ class Tile : public Printable {
                     const size_t column_offset, const bool is_inlined,
                     const size_t column_length);
 
+  // Resolve the location of a column once for repeated accesses
+  ColumnAccessor GetColumnAccessor(const oid_t column_id) {
+    PL_ASSERT(column_id < schema.GetColumnCount());
+    return ColumnAccessor(this, column_id);
+  }
+
   // Get tuple at location
   static Tuple *GetTuple(catalog::Manager *catalog,
                          const ItemPointer *tuple_location);
@@ -172,6 +181,9 @@ class Tile : public Printable {
 
   type::AbstractPool *GetPool() { return (pool); }
 
+  // Get the space usage of the pool for uninlined data
+  type::SlabPoolStats GetPoolStats() const { return pool->GetStats(); }
+
   char *GetTupleLocation(const oid_t tuple_offset) const;
 
   // Sync the contents
@@ -201,7 +213,7 @@ class Tile : public Printable {
   TileGroup *tile_group;
 
   // storage pool for uninlined data
-  type::AbstractPool *pool;
+  type::SlabPool *pool;
 
   // number of tuple slots allocated
   oid_t num_tuple_slots;
@@ -19,9 +19,12 @@
 #include <vector>
 
 #include "common/item_pointer.h"
+#include "common/numa_util.h"
 #include "common/printable.h"
 #include "planner/project_info.h"
+#include "storage/column_accessor.h"
 #include "type/abstract_pool.h"
+#include "type/slab_pool.h"
 #include "type/types.h"
 #include "type/value.h"
 
@@ -49,6 +52,7 @@ namespace storage {
 class Tuple;
 class Tile;
 class TileGroupHeader;
+class ZoneMap;
 class AbstractTable;
 class TileGroupIterator;
 class RollbackSegment;
@@ -76,7 +80,8 @@ class TileGroup : public Printable {
   // Tile group constructor
   TileGroup(BackendType backend_type, TileGroupHeader *tile_group_header,
             AbstractTable *table, const std::vector<catalog::Schema> &schemas,
-            const column_map_type &column_map, int tuple_count);
+            const column_map_type &column_map, int tuple_count,
+            int numa_node = NUMA_NODE_ANY);
 
   ~TileGroup();
 
@@ -107,6 +112,11 @@ class TileGroup : public Printable {
   oid_t InsertTupleFromCheckpoint(oid_t tuple_slot_id, const Tuple *tuple,
                                   cid_t commit_id);
 
+  // mark tuple slots whose data was bulk loaded as committed at commit_id
+  // used by checkpoint recovery
+  void InitializeTupleSlotsFromCheckpoint(
+      const std::vector<oid_t> &tuple_slot_ids, cid_t commit_id);
+
   //===--------------------------------------------------------------------===//
   // Utilities
   //===--------------------------------------------------------------------===//
@@ -143,6 +153,9 @@ class TileGroup : public Printable {
 
   peloton::type::AbstractPool *GetTilePool(const oid_t tile_id) const;
 
+  // Get the space usage of the uninlined data of all tiles
+  type::SlabPoolStats GetPoolStats() const;
+
   const std::map<oid_t, std::pair<oid_t, oid_t>> &GetColumnMap() const {
     return column_map;
   }
@@ -157,6 +170,15 @@ class TileGroup : public Printable {
 
   void SetTileGroupId(oid_t tile_group_id_) { tile_group_id = tile_group_id_; }
 
+  // Partition of the table whose tuples go to this tile group, INVALID_OID if
+  // the tile group is not bound to a partition
+  oid_t GetPartitionId() const { return partition_id; }
+
+  void SetPartitionId(oid_t partition_id_) { partition_id = partition_id_; }
+
+  // NUMA node the tiles were placed on, NUMA_NODE_ANY if they were not
+  int GetNumaNode() const { return numa_node; }
+
   std::vector<catalog::Schema> &GetTileSchemas() { return tile_schemas; }
 
   size_t GetTileCount() const { return tile_count; }
@@ -176,6 +198,12 @@ class TileGroup : public Printable {
 
   oid_t GetTileColumnId(oid_t column_id);
 
+  // Accessor of a tile group column, resolved when the tile group is built
+  inline const ColumnAccessor &GetColumnAccessor(oid_t column_id) const {
+    PL_ASSERT(column_id < column_accessors.size());
+    return column_accessors[column_id];
+  }
+
   type::Value GetValue(oid_t tuple_id, oid_t column_id);
 
   void SetValue(type::Value &value, oid_t tuple_id, oid_t column_id);
@@ -185,6 +213,20 @@ class TileGroup : public Printable {
   // Sync the contents
   void Sync();
 
+  //===--------------------------------------------------------------------===//
+  // Zone Map
+  //===--------------------------------------------------------------------===//
+
+  // Called after tuple slots were written, the zone map is rebuilt on its
+  // next use
+  inline void MarkZoneMapStale() {
+    zone_map_stale.store(true, std::memory_order_release);
+  }
+
+  // Get the zone map of a full tile group, rebuilt if slots were written
+  // since it was built. nullptr while the tile group has free slots.
+  std::shared_ptr<const ZoneMap> GetZoneMap();
+
  protected:
   //===--------------------------------------------------------------------===//
   // Data members
@@ -195,9 +237,15 @@ class TileGroup : public Printable {
   oid_t table_id;
   oid_t tile_group_id;
 
+  // partition of the table, set by the table when the tile group is added
+  oid_t partition_id = INVALID_OID;
+
   // Backend type
   BackendType backend_type;
 
+  // NUMA node of the header and the tiles
+  int numa_node;
+
   // mapping to tile schemas
   std::vector<catalog::Schema> tile_schemas;
 
@@ -221,6 +269,17 @@ class TileGroup : public Printable {
   // column to tile mapping :
   // <column offset> to <tile offset, tile column offset>
   column_map_type column_map;
+
+  // accessors of the tile group columns, indexed by column offset
+  std::vector<ColumnAccessor> column_accessors;
+
+  // synopses of the full tile group, guarded by the zone map mutex
+  std::shared_ptr<const ZoneMap> zone_map;
+
+  std::mutex zone_map_mutex;
+
+  // whether slots were written since the zone map was built
+  std::atomic<bool> zone_map_stale = ATOMIC_VAR_INIT(true);
 };
 
 }  // End storage namespace
@@ -33,7 +33,8 @@ class TileGroupFactory {
                                  oid_t tile_group_id, AbstractTable *table,
                                  const std::vector<catalog::Schema> &schemas,
                                  const column_map_type &column_map,
-                                 int tuple_count);
+                                 int tuple_count,
+                                 int numa_node = NUMA_NODE_ANY);
 };
 
 }  // End storage namespace
@@ -20,6 +20,7 @@
 
 #include "common/item_pointer.h"
 #include "common/macros.h"
+#include "common/numa_util.h"
 #include "common/platform.h"
 #include "common/printable.h"
 #include "type/types.h"
@@ -67,7 +68,8 @@ class TileGroupHeader : public Printable {
   TileGroupHeader() = delete;
 
  public:
-  TileGroupHeader(const BackendType &backend_type, const int &tuple_count);
+  TileGroupHeader(const BackendType &backend_type, const int &tuple_count,
+                  int numa_node = NUMA_NODE_ANY);
 
   TileGroupHeader &operator=(const peloton::storage::TileGroupHeader &other) {
     // check for self-assignment
@@ -0,0 +1,74 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// zone_map.h
+//
+// Identification: src/include/storage/zone_map.h
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <vector>
+
+#include "common/printable.h"
+#include "type/types.h"
+#include "type/value.h"
+
+namespace peloton {
+namespace storage {
+
+class TileGroup;
+
+//===--------------------------------------------------------------------===//
+// Zone Map
+//
+// Min/max and null count synopses of every column over the tuple slots of a
+// tile group. The synopses cover every slot, whatever its visibility, so a
+// scan may skip the tile group if no value in the range can satisfy its
+// predicate.
+//===--------------------------------------------------------------------===//
+
+class ZoneMap : public Printable {
+ public:
+  struct ColumnSynopsis {
+    // smallest and largest non-NULL value, invalid if all values are NULL
+    type::Value min;
+    type::Value max;
+
+    oid_t null_count = 0;
+
+    bool has_values = false;
+  };
+
+  // Build the synopses over the first tuple_count slots of the tile group
+  ZoneMap(TileGroup *tile_group, oid_t tuple_count);
+
+  inline const ColumnSynopsis &GetColumnSynopsis(oid_t column_id) const {
+    return columns_[column_id];
+  }
+
+  inline oid_t GetColumnCount() const { return columns_.size(); }
+
+  // Whether some slot may hold a value with (value <comparison> constant).
+  // Comparisons that are not checked are assumed to match.
+  bool MayMatch(oid_t column_id, ExpressionType comparison,
+                const type::Value &constant) const;
+
+  // Whether some slot may hold a NULL
+  inline bool MayBeNull(oid_t column_id) const {
+    return columns_[column_id].null_count > 0;
+  }
+
+  // Get a string representation for debugging
+  const std::string GetInfo() const;
+
+ private:
+  std::vector<ColumnSynopsis> columns_;
+};
+
+}  // End storage namespace
+}  // End peloton namespace
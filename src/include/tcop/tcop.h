@@ -84,6 +84,10 @@ class TrafficCop {
   int BindParameters(std::vector<std::pair<int, std::string>> &parameters,
                      Statement **stmt, std::string &error_message);
 
+  // Wait until the pipelined commits of the connection are durable. Must be
+  // called before their results are sent to the client.
+  void WaitForPipelinedCommits();
+
  private:
   // The optimizer used for this connection
   std::unique_ptr<optimizer::AbstractOptimizer> optimizer_;
@@ -93,16 +97,26 @@ class TrafficCop {
   typedef std::pair<concurrency::Transaction *, ResultType> TcopTxnState;
   std::stack<TcopTxnState> tcop_txn_state_;
 
+  // The commit id after the last read write transaction of this connection
+  // committed. Single-statement reads run as read only transactions once the
+  // read only snapshot includes it, so the connection reads its own writes.
+  cid_t last_commit_cid_;
+
  private:
   static TcopTxnState &GetDefaultTxnState();
 
   TcopTxnState &GetCurrentTxnState();
 
-  ResultType BeginQueryHelper();
+  ResultType BeginQueryHelper(bool read_only = false);
 
   ResultType CommitQueryHelper();
 
   ResultType AbortQueryHelper();
+
+  // Whether a single-statement transaction running the plan can be a read only
+  // transaction. Only with --autocommit_snapshot_read, since the snapshot may
+  // lag behind the commits of other connections.
+  bool UseSnapshotRead(const planner::AbstractPlan *plan);
 };
 
 }  // End tcop namespace
@@ -0,0 +1,140 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// slab_pool.h
+//
+// Identification: src/include/type/slab_pool.h
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <unordered_set>
+#include <vector>
+
+#include "common/platform.h"
+#include "type/abstract_pool.h"
+
+// Size classes are powers of two between the min and the max chunk size
+#define SLAB_POOL_MIN_CHUNK_SIZE 16
+#define SLAB_POOL_MAX_CHUNK_SIZE 8192
+#define SLAB_POOL_SIZE_CLASS_COUNT 10
+
+// The first slab of a size class holds this many bytes of chunks, and every
+// further slab twice as many as the one before, up to the max slab size
+#define SLAB_POOL_MIN_SLAB_SIZE (1 << 10)
+#define SLAB_POOL_MAX_SLAB_SIZE (1 << 16)
+
+namespace peloton {
+namespace type {
+
+// Space usage of a slab pool
+struct SlabPoolStats {
+  // Bytes taken from the system, including free chunks
+  size_t reserved_bytes = 0;
+
+  // Bytes of the chunks handed out, including their headers
+  size_t allocated_bytes = 0;
+
+  // Bytes requested by the clients of the handed out chunks
+  size_t requested_bytes = 0;
+
+  // Bytes of the chunks in the free lists, the rest of the reserved bytes that
+  // are not allocated is the unused tail of the newest slabs
+  size_t free_bytes = 0;
+
+  // Share of the reserved bytes that does not hold client data
+  double GetFragmentation() const {
+    if (reserved_bytes == 0) return 0.0;
+    return 1.0 - static_cast<double>(requested_bytes) / reserved_bytes;
+  }
+};
+
+// A memory pool that carves chunks of power of two size classes out of slabs.
+// Freed chunks go to a free list of their size class and are reused by later
+// allocations of that class, so the space of varlen values reclaimed by the
+// garbage collector does not have to wait for the pool to die. Slabs are only
+// allocated once a size class is used, and grow with the use of the class,
+// so the pools of tiles that hold a few short values stay small.
+// Allocations larger than the biggest size class go to the system directly.
+class SlabPool : public AbstractPool {
+ public:
+  SlabPool();
+
+  // Destroy this pool, and all memory it owns.
+  ~SlabPool();
+
+  // Allocate a contiguous block of memory of the given size. If the allocation
+  // is successful a non-null pointer is returned. If the allocation fails, a
+  // null pointer will be returned.
+  void *Allocate(size_t size);
+
+  // Returns the provided chunk of memory back into the pool
+  void Free(void *ptr);
+
+  // Get the current space usage of the pool
+  SlabPoolStats GetStats() const;
+
+ private:
+  // Every chunk starts with its size class and the requested size
+  struct ChunkHeader {
+    uint32_t size_class;
+    uint32_t requested_size;
+  };
+
+  struct SizeClass {
+    // Free chunks, linked through their first bytes after the header
+    char *free_list = nullptr;
+
+    // Unused part of the current slab
+    char *slab_next = nullptr;
+    char *slab_end = nullptr;
+
+    // Size of the next slab
+    size_t slab_size = SLAB_POOL_MIN_SLAB_SIZE;
+
+    // Protects the size class
+    Spinlock lock;
+  };
+
+  static inline uint32_t GetSizeClass(size_t chunk_size) {
+    uint32_t size_class = 0;
+    size_t class_size = SLAB_POOL_MIN_CHUNK_SIZE;
+    while (class_size < chunk_size) {
+      class_size <<= 1;
+      size_class++;
+    }
+    return size_class;
+  }
+
+  static constexpr size_t GetClassSize(uint32_t size_class) {
+    return static_cast<size_t>(SLAB_POOL_MIN_CHUNK_SIZE) << size_class;
+  }
+
+  // Marks chunks that were not carved out of a slab
+  static const uint32_t large_size_class = UINT32_MAX;
+
+  SizeClass size_classes_[SLAB_POOL_SIZE_CLASS_COUNT];
+
+  // Slabs owned by this pool
+  std::vector<char *> slabs_;
+
+  // Allocations larger than the biggest size class
+  std::unordered_set<char *> large_chunks_;
+
+  // Protects the slab list and the large chunks
+  Spinlock pool_lock_;
+
+  std::atomic<size_t> reserved_bytes_;
+  std::atomic<size_t> allocated_bytes_;
+  std::atomic<size_t> requested_bytes_;
+  std::atomic<size_t> free_bytes_;
+};
+
+}  // namespace type
+}  // namespace peloton
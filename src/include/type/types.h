@@ -381,7 +381,8 @@ enum SqlStateErrorCode {
 
 enum class ConcurrencyType {
   INVALID = INVALID_TYPE_ID,
-  TIMESTAMP_ORDERING = 1  // timestamp ordering
+  TIMESTAMP_ORDERING = 1,  // timestamp ordering
+  OPTIMISTIC = 2           // optimistic, validates the read set at commit
 };
 
 //===--------------------------------------------------------------------===//
@@ -421,6 +422,19 @@ std::string BackendTypeToString(BackendType type);
 BackendType StringToBackendType(const std::string &str);
 std::ostream &operator<<(std::ostream &os, const BackendType &type);
 
+//===--------------------------------------------------------------------===//
+// Partition Types
+//===--------------------------------------------------------------------===//
+
+enum class PartitionType {
+  INVALID = INVALID_TYPE_ID,  // invalid partition type
+  RANGE = 1,                  // ranges split at sorted bounds
+  HASH = 2                    // hash of the partition column
+};
+std::string PartitionTypeToString(PartitionType type);
+PartitionType StringToPartitionType(const std::string &str);
+std::ostream &operator<<(std::ostream &os, const PartitionType &type);
+
 //===--------------------------------------------------------------------===//
 // Index Types
 //===--------------------------------------------------------------------===//
@@ -676,9 +690,11 @@ std::ostream &operator<<(std::ostream &os, const InsertType &type);
 enum class CopyType {
   IMPORT_CSV,     // Import csv data to database
   IMPORT_TSV,     // Import tsv data to database
+  IMPORT_BINARY,  // Import binary data to database
   EXPORT_CSV,     // Export data to csv file
   EXPORT_STDOUT,  // Export data to std out
   EXPORT_OTHER,   // Export data to other file format
+  EXPORT_BINARY,  // Export data to binary file
 };
 
 //===--------------------------------------------------------------------===//
@@ -869,6 +885,8 @@ enum LogRecordType {
   LOGRECORD_TYPE_WAL_TUPLE_INSERT = 21,
   LOGRECORD_TYPE_WAL_TUPLE_DELETE = 22,
   LOGRECORD_TYPE_WAL_TUPLE_UPDATE = 23,
+  // Update that only carries the modified columns
+  LOGRECORD_TYPE_WAL_TUPLE_PARTIAL_UPDATE = 24,
 
   // DML records for Write behind logging
   LOGRECORD_TYPE_WBL_TUPLE_INSERT = 31,
@@ -878,6 +896,12 @@ enum LogRecordType {
   // Record for delimiting transactions
   // includes max persistent commit_id
   LOGRECORD_TYPE_ITERATION_DELIMITER = 41,
+
+  // Image of all visible tuples of a tile group in a checkpoint
+  LOGRECORD_TYPE_CHECKPOINT_TILE_GROUP = 51,
+
+  // Compressed block of log records written in one flush
+  LOGRECORD_TYPE_COMPRESSED_BLOCK = 61,
 };
 std::string LogRecordTypeToString(LogRecordType type);
 LogRecordType StringToLogRecordType(const std::string &str);
@@ -929,6 +953,10 @@ enum MetricType {
   QUERY_METRIC = 9,
   // Statistics for CPU
   PROCESSOR_METRIC = 10,
+  // Bucketed distribution of latencies
+  HISTOGRAM_METRIC = 11,
+  // Latencies of the phases of logging a commit
+  LOG_METRIC = 12,
 };
 
 static const int INVALID_FILE_DESCRIPTOR = -1;
@@ -1048,13 +1076,15 @@ std::ostream &operator<<(std::ostream &os, const RWType &type);
 
 enum class GCSetType { COMMITTED, ABORTED };
 
-// block -> offset -> type
-typedef std::unordered_map<oid_t, std::unordered_map<oid_t, RWType>>
-    ReadWriteSet;
+// A version to be recycled once no transaction can see it
+struct GCSetEntry {
+  oid_t block;
+  oid_t offset;
+  bool is_index_deletion;
+};
 
-// block -> offset -> is_index_deletion
-typedef std::unordered_map<oid_t, std::unordered_map<oid_t, bool>>
-    GCSet;
+// Every version appears at most once
+typedef std::vector<GCSetEntry> GCSet;
 
 //===--------------------------------------------------------------------===//
 // File Handle
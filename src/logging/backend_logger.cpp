@@ -17,6 +17,7 @@
 #include "logging/loggers/wal_backend_logger.h"
 #include "logging/loggers/wbl_backend_logger.h"
 #include "logging/logging_util.h"
+#include "statistics/backend_stats_context.h"
 
 namespace peloton {
 namespace logging {
@@ -66,6 +67,11 @@ BackendLogger *BackendLogger::GetBackendLogger(LoggingType logging_type) {
  * @param log record
  */
 void BackendLogger::Log(LogRecord *record) {
+  if (concurrent_log_buffer_ != nullptr) {
+    LogToConcurrentBuffer(record);
+    return;
+  }
+
   // Enqueue the serialized log record into the queue
   record->Serialize(output_buffer);
 
@@ -84,6 +90,7 @@ void BackendLogger::Log(LogRecord *record) {
     PL_ASSERT(new_log_commit_id > highest_logged_commit_message);
     highest_logged_commit_message = new_log_commit_id;
     logging_cid_lower_bound = INVALID_CID;
+    MarkCommitQueued();
   }
 
   // update the max logged id for the current buffer
@@ -120,6 +127,49 @@ void BackendLogger::Log(LogRecord *record) {
   this->log_buffer_lock.Unlock();
 }
 
+/**
+ * @brief serialize a log record straight into the shared log buffer
+ * @param log record
+ */
+void BackendLogger::LogToConcurrentBuffer(LogRecord *record) {
+  size_t length = record->GetSerializedLength();
+  uint64_t offset;
+  if (!concurrent_log_buffer_->ReserveRecord(length, reservation_offset_,
+                                             offset)) {
+    LOG_ERROR("Write record to concurrent log buffer failed");
+    return;
+  }
+
+  // Only records that wrap around the end of the ring take a copy
+  char *region = concurrent_log_buffer_->GetRecordRegion(offset, length);
+  if (region != nullptr) {
+    ReferenceSerializeOutput output(region, length);
+    record->SerializeTo(output);
+    PL_ASSERT(output.Position() == length);
+  } else {
+    output_buffer.Reset();
+    record->SerializeTo(output_buffer);
+    PL_ASSERT(output_buffer.Size() == length);
+    concurrent_log_buffer_->CopyRecord(offset, output_buffer.Data(), length);
+  }
+
+  // The record is complete before the commit id is exposed to the frontend
+  // logger, so a flush that covers the commit id also covers the record
+  concurrent_log_buffer_->CompleteRecord(record->GetTransactionId(),
+                                         reservation_offset_);
+
+  this->log_buffer_lock.Lock();
+  if (record->GetType() == LOGRECORD_TYPE_TRANSACTION_COMMIT) {
+    auto new_log_commit_id = record->GetTransactionId();
+    PL_ASSERT(new_log_commit_id > highest_logged_commit_message);
+    highest_logged_commit_message = new_log_commit_id;
+    logging_cid_lower_bound = INVALID_CID;
+    MarkCommitQueued();
+  }
+  has_shared_records_ = true;
+  this->log_buffer_lock.Unlock();
+}
+
 // used by the frontend logger to collect data on the current state of the
 // backend
 // returns a pair of commit ids, the first is the lower bound for values this
@@ -129,7 +179,7 @@ std::pair<cid_t, cid_t> BackendLogger::PrepareLogBuffers() {
   this->log_buffer_lock.Lock();
   std::pair<cid_t, cid_t> ret(INVALID_CID, INVALID_CID);
   // prepare the cid's seen so far
-  if (logging_cid_lower_bound != INVALID_CID ||
+  if (logging_cid_lower_bound != INVALID_CID || has_shared_records_ ||
       (log_buffer_ && log_buffer_->GetSize() > 0)) {
     ret.second = highest_logged_commit_message;
     if (logging_cid_lower_bound > highest_logged_commit_message) {
@@ -144,8 +194,21 @@ std::pair<cid_t, cid_t> BackendLogger::PrepareLogBuffers() {
         (int)highest_logged_commit_message, (int)logging_cid_lower_bound);
     persist_buffer_pool_->Put(std::move(log_buffer_));
   }
+  has_shared_records_ = false;
+
+  // The frontend logger now owns the queued commits
+  auto oldest_queued_commit_time = oldest_queued_commit_time_;
+  oldest_queued_commit_time_ = stats::LatencyHistogram::Clock::time_point();
   this->log_buffer_lock.Unlock();
 
+  if (oldest_queued_commit_time !=
+      stats::LatencyHistogram::Clock::time_point()) {
+    stats::BackendStatsContext::GetInstance()
+        ->GetLogMetric()
+        .GetPhaseLatency(stats::LOG_PHASE_QUEUEING)
+        .RecordLatency(oldest_queued_commit_time);
+  }
+
   auto num_log_buffer = persist_buffer_pool_->GetSize();
   while (num_log_buffer > 0) {
     local_queue.push_back(persist_buffer_pool_->Get());
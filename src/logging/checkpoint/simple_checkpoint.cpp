@@ -147,6 +147,11 @@ cid_t SimpleCheckpoint::DoRecovery() {
         InsertTuple(commit_id);
         break;
       }
+      case LOGRECORD_TYPE_CHECKPOINT_TILE_GROUP: {
+        LOG_TRACE("Read checkpoint tile group entry");
+        RecoverTileGroup(commit_id);
+        break;
+      }
       case LOGRECORD_TYPE_TRANSACTION_COMMIT: {
         should_stop = true;
         break;
@@ -217,6 +222,141 @@ void SimpleCheckpoint::InsertTuple(cid_t commit_id) {
             target_location.offset);
 }
 
+/**
+ * @brief Bulk load a tile group image written by PersistTileGroupImage.
+ * When the recovered tile group has the default row layout and the image
+ * covers a prefix of its slots, the tuple data is read straight into the
+ * tile. Otherwise the tuples are copied slot by slot.
+ */
+void SimpleCheckpoint::RecoverTileGroup(cid_t commit_id) {
+  // Read the header frame
+  auto header_size = LoggingUtil::GetNextFrameSize(file_handle_);
+  if (header_size == 0) {
+    LOG_ERROR("Could not read tile group image header.");
+    return;
+  }
+  std::unique_ptr<char[]> header(new char[header_size]);
+  if (fread(header.get(), 1, header_size, file_handle_.file) != header_size) {
+    LOG_ERROR("Error occured in fread");
+    return;
+  }
+
+  CopySerializeInput header_input(header.get(), header_size);
+  header_input.ReadInt();
+  oid_t database_oid = (oid_t)header_input.ReadLong();
+  oid_t table_oid = (oid_t)header_input.ReadLong();
+  oid_t tile_group_id = (oid_t)header_input.ReadLong();
+  size_t tuple_count = (size_t)header_input.ReadLong();
+  size_t tuple_length = (size_t)header_input.ReadLong();
+  std::vector<oid_t> tuple_slot_ids(tuple_count);
+  for (size_t tuple_itr = 0; tuple_itr < tuple_count; tuple_itr++) {
+    tuple_slot_ids[tuple_itr] = (oid_t)header_input.ReadInt();
+  }
+
+  storage::DataTable *table = nullptr;
+  auto database =
+      catalog::Catalog::GetInstance()->GetDatabaseWithOid(database_oid);
+  if (database != nullptr) {
+    table = database->GetTableWithOid(table_oid);
+  }
+
+  // the table was deleted or altered, skip the tuple data and varlen data
+  if (table == nullptr || table->GetSchema()->GetLength() != tuple_length) {
+    for (int frame_itr = 0; frame_itr < 2; frame_itr++) {
+      auto frame_size = LoggingUtil::GetNextFrameSize(file_handle_);
+      fseek(file_handle_.file, frame_size, SEEK_CUR);
+    }
+    return;
+  }
+  auto schema = table->GetSchema();
+
+  auto &manager = catalog::Manager::GetInstance();
+  auto tile_group = manager.GetTileGroup(tile_group_id);
+  if (tile_group == nullptr) {
+    table->AddTileGroupWithOidForRecovery(tile_group_id);
+    tile_group = manager.GetTileGroup(tile_group_id);
+  }
+
+  // Read the tuple data frame
+  auto body_size = LoggingUtil::GetNextFrameSize(file_handle_);
+  if (body_size != sizeof(int32_t) + tuple_count * tuple_length) {
+    LOG_ERROR("Torn checkpoint write.");
+    return;
+  }
+  fseek(file_handle_.file, sizeof(int32_t), SEEK_CUR);
+
+  auto tile = tile_group->GetTile(0);
+  bool is_bulk_loadable =
+      tile_group->GetTileCount() == 1 &&
+      tile->GetSchema()->GetLength() == tuple_length &&
+      tuple_count <= tile_group->GetAllocatedTupleCount();
+  for (size_t tuple_itr = 0; is_bulk_loadable && tuple_itr < tuple_count;
+       tuple_itr++) {
+    is_bulk_loadable = (tuple_slot_ids[tuple_itr] == tuple_itr);
+  }
+
+  // Either the tile itself or a staging buffer receives the tuple data
+  std::unique_ptr<char[]> staging_buffer;
+  char *tuple_data = nullptr;
+  if (is_bulk_loadable) {
+    tuple_data = tile->GetTupleLocation(0);
+  } else {
+    staging_buffer.reset(new char[tuple_count * tuple_length]);
+    tuple_data = staging_buffer.get();
+  }
+  if (fread(tuple_data, 1, tuple_count * tuple_length, file_handle_.file) !=
+      tuple_count * tuple_length) {
+    LOG_ERROR("Torn checkpoint write.");
+    return;
+  }
+
+  // Read the varlen data frame and patch the uninlined columns
+  auto varlen_size = LoggingUtil::GetNextFrameSize(file_handle_);
+  if (varlen_size == 0) {
+    LOG_ERROR("Torn checkpoint write.");
+    return;
+  }
+  std::unique_ptr<char[]> varlen_data(new char[varlen_size]);
+  if (fread(varlen_data.get(), 1, varlen_size, file_handle_.file) !=
+      varlen_size) {
+    LOG_ERROR("Error occured in fread");
+    return;
+  }
+  CopySerializeInput varlen_input(varlen_data.get(), varlen_size);
+  varlen_input.ReadInt();
+
+  auto uninlined_column_count = schema->GetUninlinedColumnCount();
+  type::AbstractPool *varlen_pool =
+      is_bulk_loadable ? tile->GetPool() : pool.get();
+  for (size_t tuple_itr = 0; tuple_itr < tuple_count; tuple_itr++) {
+    // NOTE:: Only a tuple wrapper
+    storage::Tuple tuple(schema, tuple_data + tuple_itr * tuple_length);
+    for (oid_t uninlined_itr = 0; uninlined_itr < uninlined_column_count;
+         uninlined_itr++) {
+      auto column_id = schema->GetUninlinedColumn(uninlined_itr);
+      type::Value val = type::Value::DeserializeFrom(
+          varlen_input, schema->GetType(column_id), nullptr);
+      tuple.SetValue(column_id, val, varlen_pool);
+    }
+
+    if (!is_bulk_loadable) {
+      tile_group->InsertTupleFromCheckpoint(tuple_slot_ids[tuple_itr], &tuple,
+                                            commit_id);
+    }
+  }
+
+  if (is_bulk_loadable) {
+    tile_group->InitializeTupleSlotsFromCheckpoint(tuple_slot_ids, commit_id);
+  }
+  table->IncreaseTupleCount(tuple_count);
+
+  if (max_oid_ < tile_group_id) {
+    max_oid_ = tile_group_id;
+  }
+  LOG_TRACE("Recovered %lu tuples of tile group %u from checkpoint",
+            tuple_count, tile_group_id);
+}
+
 void SimpleCheckpoint::Scan(storage::DataTable *target_table,
                             oid_t database_oid) {
   auto schema = target_table->GetSchema();
@@ -248,6 +388,15 @@ void SimpleCheckpoint::Scan(storage::DataTable *target_table,
                              .base_tile->GetTileGroup()
                              ->GetTileGroupId();
 
+    // Write the whole tile group as one image that can be bulk loaded.
+    // Tuple records are only kept when there is no file to write to.
+    if (!disable_file_access) {
+      PersistTileGroupImage(target_table, database_oid, tile_group_id,
+                            logical_tile.get());
+      current_tile_group_offset++;
+      continue;
+    }
+
     // Go over the logical tile
     for (oid_t tuple_id : *logical_tile) {
       expression::ContainerTuple<executor::LogicalTile> cur_tuple(
@@ -280,6 +429,75 @@ void SimpleCheckpoint::Scan(storage::DataTable *target_table,
   }
 }
 
+/**
+ * @brief Write the visible tuples of a tile group as one image. The image
+ * holds three frames: a header with the tuple slots, the fixed-length tuple
+ * data in the table's row layout, and the values of the uninlined columns.
+ */
+void SimpleCheckpoint::PersistTileGroupImage(
+    storage::DataTable *target_table, oid_t database_oid, oid_t tile_group_id,
+    executor::LogicalTile *logical_tile) {
+  PL_ASSERT(file_handle_.file);
+  auto schema = target_table->GetSchema();
+  size_t tuple_length = schema->GetLength();
+  size_t tuple_count = logical_tile->GetTupleCount();
+  auto column_count = schema->GetColumnCount();
+
+  CopySerializeOutput output_buffer;
+  output_buffer.WriteEnumInSingleByte(LOGRECORD_TYPE_CHECKPOINT_TILE_GROUP);
+
+  // Header frame
+  size_t start = output_buffer.Position();
+  output_buffer.WriteInt(0);
+  output_buffer.WriteLong(database_oid);
+  output_buffer.WriteLong(target_table->GetOid());
+  output_buffer.WriteLong(tile_group_id);
+  output_buffer.WriteLong(tuple_count);
+  output_buffer.WriteLong(tuple_length);
+  for (oid_t tuple_id : *logical_tile) {
+    output_buffer.WriteInt(tuple_id);
+  }
+  output_buffer.WriteIntAt(
+      start, static_cast<int32_t>(output_buffer.Position() - start -
+                                  sizeof(int32_t)));
+
+  // Tuple data frame
+  CopySerializeOutput varlen_buffer;
+  varlen_buffer.WriteInt(0);
+
+  start = output_buffer.Position();
+  output_buffer.WriteInt(0);
+  storage::Tuple tuple(schema, true);
+  for (oid_t tuple_id : *logical_tile) {
+    expression::ContainerTuple<executor::LogicalTile> cur_tuple(logical_tile,
+                                                                tuple_id);
+    for (oid_t column_id = 0; column_id < column_count; column_id++) {
+      type::Value val = cur_tuple.GetValue(column_id);
+      if (schema->IsInlined(column_id)) {
+        tuple.SetValue(column_id, val, nullptr);
+      } else {
+        val.SerializeTo(varlen_buffer);
+      }
+    }
+    output_buffer.WriteBytes(tuple.GetData(), tuple_length);
+  }
+  output_buffer.WriteIntAt(
+      start, static_cast<int32_t>(output_buffer.Position() - start -
+                                  sizeof(int32_t)));
+
+  // Varlen data frame
+  varlen_buffer.WriteIntAt(
+      0, static_cast<int32_t>(varlen_buffer.Position() - sizeof(int32_t)));
+
+  fwrite(output_buffer.Data(), sizeof(char), output_buffer.Size(),
+         file_handle_.file);
+  fwrite(varlen_buffer.Data(), sizeof(char), varlen_buffer.Size(),
+         file_handle_.file);
+
+  LOG_TRACE("Persisted %lu tuples of tile group %u", tuple_count,
+            tile_group_id);
+}
+
 void SimpleCheckpoint::SetLogger(BackendLogger *logger) {
   logger_.reset(logger);
 }
@@ -0,0 +1,108 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// concurrent_log_buffer.cpp
+//
+// Identification: src/logging/concurrent_log_buffer.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <algorithm>
+#include <thread>
+
+#include "logging/concurrent_log_buffer.h"
+#include "common/logger.h"
+#include "common/macros.h"
+
+namespace peloton {
+namespace logging {
+
+//===--------------------------------------------------------------------===//
+// Concurrent Log Buffer
+//===--------------------------------------------------------------------===//
+ConcurrentLogBuffer::ConcurrentLogBuffer(size_t capacity)
+    : capacity_(capacity),
+      data_(new char[capacity]),
+      reserved_offset_(ATOMIC_VAR_INIT(0)),
+      released_offset_(ATOMIC_VAR_INIT(0)),
+      max_log_id_(ATOMIC_VAR_INIT(0)) {}
+
+bool ConcurrentLogBuffer::WriteRecord(const char *data, size_t length,
+                                      cid_t log_id,
+                                      std::atomic<uint64_t> &reservation) {
+  uint64_t offset;
+  if (!ReserveRecord(length, reservation, offset)) return false;
+  CopyRecord(offset, data, length);
+  CompleteRecord(log_id, reservation);
+  return true;
+}
+
+bool ConcurrentLogBuffer::ReserveRecord(size_t length,
+                                        std::atomic<uint64_t> &reservation,
+                                        uint64_t &offset) {
+  if (length > capacity_) {
+    LOG_ERROR("Log record of %lu bytes does not fit into the log buffer",
+              length);
+    return false;
+  }
+
+  // Publish a lower bound of the reservation before taking it, so that the
+  // flusher never misses a reservation that is about to be made
+  reservation.store(reserved_offset_.load());
+  offset = reserved_offset_.fetch_add(length);
+  reservation.store(offset);
+
+  // Wait until the flusher has written out the space, which takes a flush
+  while (offset + length - released_offset_.load(std::memory_order_acquire) >
+         capacity_) {
+    std::this_thread::yield();
+  }
+  return true;
+}
+
+char *ConcurrentLogBuffer::GetRecordRegion(uint64_t offset, size_t length) {
+  size_t position = offset % capacity_;
+  if (length > capacity_ - position) return nullptr;
+  return data_.get() + position;
+}
+
+void ConcurrentLogBuffer::CopyRecord(uint64_t offset, const char *data,
+                                     size_t length) {
+  // Copy the record, wrapping around the end of the ring
+  size_t position = offset % capacity_;
+  size_t first_length = std::min(length, capacity_ - position);
+  PL_MEMCPY(data_.get() + position, data, first_length);
+  if (first_length < length) {
+    PL_MEMCPY(data_.get(), data + first_length, length - first_length);
+  }
+}
+
+void ConcurrentLogBuffer::CompleteRecord(cid_t log_id,
+                                         std::atomic<uint64_t> &reservation) {
+  cid_t max_log_id = max_log_id_.load();
+  while (log_id > max_log_id &&
+         !max_log_id_.compare_exchange_weak(max_log_id, log_id)) {
+  }
+
+  // The record is complete
+  reservation.store(IDLE_RESERVATION_OFFSET);
+}
+
+std::pair<const char *, size_t> ConcurrentLogBuffer::GetRegion(
+    uint64_t begin, uint64_t end) const {
+  PL_ASSERT(begin <= end && end - begin <= capacity_);
+  size_t position = begin % capacity_;
+  size_t length = std::min<uint64_t>(end - begin, capacity_ - position);
+  return std::make_pair(data_.get() + position, length);
+}
+
+void ConcurrentLogBuffer::Release(uint64_t end) {
+  PL_ASSERT(end >= released_offset_.load());
+  released_offset_.store(end, std::memory_order_release);
+}
+
+}  // namespace logging
+}  // namespace peloton
@@ -220,6 +220,18 @@ void FrontendLogger::CollectLogRecordsFromBackendLoggers() {
       log_buffers.clear();
       i++;
     }
+
+    // The shared log buffer is complete below both the reserved offset and
+    // the in-flight reservations, which are read after the commit ids above
+    if (concurrent_log_buffer_) {
+      uint64_t completed_offset = concurrent_log_buffer_->GetReservedOffset();
+      for (auto backend_logger : backend_loggers) {
+        completed_offset = std::min(completed_offset,
+                                    backend_logger->GetReservationOffset());
+      }
+      concurrent_log_buffer_end_ =
+          std::max(concurrent_log_buffer_end_, completed_offset);
+    }
     cid_t max_possible_commit_id;
     if (max_committed_cid == 0 && lower_bound == MAX_CID) {
       // nothing collected
@@ -278,6 +290,8 @@ void FrontendLogger::SetBackendLoggerLoggedCid(BackendLogger &bel) {
  * @param backend logger
  */
 void FrontendLogger::AddBackendLogger(BackendLogger *backend_logger) {
+  backend_logger->SetConcurrentLogBuffer(concurrent_log_buffer_.get());
+
   // Grant empty buffers
   for (int i = 0; i < BUFFER_POOL_SIZE; i++) {
     std::unique_ptr<LogBuffer> buffer(new LogBuffer(backend_logger));
@@ -0,0 +1,200 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// log_compressor.cpp
+//
+// Identification: src/logging/log_compressor.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "logging/log_compressor.h"
+
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+namespace peloton {
+namespace logging {
+
+// Matches are at least four bytes long
+static const size_t min_match_length = 4;
+
+// The last five bytes of a block are always literals
+static const size_t last_literals = 5;
+
+// A match can not start within the last twelve bytes of a block
+static const size_t match_start_limit = 12;
+
+static const size_t max_match_offset = 65535;
+
+static const int hash_log = 12;
+
+static inline uint32_t ReadWord(const uint8_t *ptr) {
+  uint32_t value;
+  memcpy(&value, ptr, sizeof(value));
+  return value;
+}
+
+static inline uint32_t HashWord(uint32_t value) {
+  return (value * 2654435761U) >> (32 - hash_log);
+}
+
+// Write a length that overflows its nibble as a run of 255 bytes
+static inline uint8_t *WriteLength(uint8_t *output, size_t length) {
+  while (length >= 255) {
+    *output++ = 255;
+    length -= 255;
+  }
+  *output++ = static_cast<uint8_t>(length);
+  return output;
+}
+
+static inline uint8_t *WriteLiterals(uint8_t *output, uint8_t *token,
+                                     const uint8_t *literals, size_t length) {
+  if (length >= 15) {
+    *token = 15 << 4;
+    output = WriteLength(output, length - 15);
+  } else {
+    *token = static_cast<uint8_t>(length << 4);
+  }
+  memcpy(output, literals, length);
+  return output + length;
+}
+
+size_t LogCompressor::Compress(const char *source, size_t source_size,
+                               char *destination) {
+  const uint8_t *base = reinterpret_cast<const uint8_t *>(source);
+  const uint8_t *end = base + source_size;
+  const uint8_t *input = base;
+  const uint8_t *anchor = base;
+  uint8_t *output = reinterpret_cast<uint8_t *>(destination);
+
+  // Position (plus one) of the last occurrence of each hashed word
+  std::vector<uint32_t> hash_table(1 << hash_log, 0);
+
+  if (source_size > match_start_limit) {
+    const uint8_t *match_limit = end - match_start_limit;
+    const uint8_t *match_end_limit = end - last_literals;
+
+    while (input < match_limit) {
+      uint32_t word = ReadWord(input);
+      uint32_t hash = HashWord(word);
+      uint32_t candidate = hash_table[hash];
+      hash_table[hash] = static_cast<uint32_t>(input - base) + 1;
+
+      if (candidate == 0) {
+        input++;
+        continue;
+      }
+
+      const uint8_t *reference = base + candidate - 1;
+      if (static_cast<size_t>(input - reference) > max_match_offset ||
+          ReadWord(reference) != word) {
+        input++;
+        continue;
+      }
+
+      // Extend the match as far as possible
+      size_t match_length = min_match_length;
+      while (input + match_length < match_end_limit &&
+             reference[match_length] == input[match_length]) {
+        match_length++;
+      }
+
+      // Emit the sequence
+      uint8_t *token = output++;
+      output = WriteLiterals(output, token, anchor, input - anchor);
+
+      size_t offset = input - reference;
+      *output++ = static_cast<uint8_t>(offset & 0xFF);
+      *output++ = static_cast<uint8_t>(offset >> 8);
+
+      size_t length = match_length - min_match_length;
+      if (length >= 15) {
+        *token |= 15;
+        output = WriteLength(output, length - 15);
+      } else {
+        *token |= static_cast<uint8_t>(length);
+      }
+
+      input += match_length;
+      anchor = input;
+    }
+  }
+
+  // The last sequence only has literals
+  uint8_t *token = output++;
+  output = WriteLiterals(output, token, anchor, end - anchor);
+
+  return output - reinterpret_cast<uint8_t *>(destination);
+}
+
+bool LogCompressor::Decompress(const char *source, size_t source_size,
+                               char *destination, size_t destination_size) {
+  const uint8_t *input = reinterpret_cast<const uint8_t *>(source);
+  const uint8_t *input_end = input + source_size;
+  uint8_t *base = reinterpret_cast<uint8_t *>(destination);
+  uint8_t *output = base;
+  uint8_t *output_end = base + destination_size;
+
+  while (input < input_end) {
+    uint8_t token = *input++;
+
+    // Copy literals
+    size_t literal_length = token >> 4;
+    if (literal_length == 15) {
+      uint8_t extra;
+      do {
+        if (input >= input_end) return false;
+        extra = *input++;
+        literal_length += extra;
+      } while (extra == 255);
+    }
+    if (literal_length > static_cast<size_t>(input_end - input) ||
+        literal_length > static_cast<size_t>(output_end - output)) {
+      return false;
+    }
+    memcpy(output, input, literal_length);
+    input += literal_length;
+    output += literal_length;
+
+    // The last sequence has no match
+    if (input == input_end) break;
+
+    // Copy match
+    if (input_end - input < 2) return false;
+    size_t offset = input[0] | (input[1] << 8);
+    input += 2;
+    if (offset == 0 || offset > static_cast<size_t>(output - base)) {
+      return false;
+    }
+
+    size_t match_length = token & 15;
+    if (match_length == 15) {
+      uint8_t extra;
+      do {
+        if (input >= input_end) return false;
+        extra = *input++;
+        match_length += extra;
+      } while (extra == 255);
+    }
+    match_length += min_match_length;
+    if (match_length > static_cast<size_t>(output_end - output)) {
+      return false;
+    }
+
+    // Byte by byte as the match may overlap the output
+    const uint8_t *reference = output - offset;
+    for (size_t itr = 0; itr < match_length; itr++) {
+      *output++ = *reference++;
+    }
+  }
+
+  return output == output_end;
+}
+
+}  // namespace logging
+}  // namespace peloton
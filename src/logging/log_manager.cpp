@@ -10,6 +10,7 @@
 //
 //===----------------------------------------------------------------------===//
 
+#include <algorithm>
 #include <condition_variable>
 #include <memory>
 
@@ -22,6 +23,8 @@
 #include "logging/log_manager.h"
 #include "logging/logging_util.h"
 #include "logging/records/transaction_record.h"
+#include "logging/records/tuple_record.h"
+#include "statistics/backend_stats_context.h"
 #include "storage/data_table.h"
 #include "storage/database.h"
 #include "storage/tile_group.h"
@@ -33,6 +36,9 @@ namespace logging {
 // Each thread gets a backend logger
 thread_local static BackendLogger *backend_logger = nullptr;
 
+// Largest commit id the thread logged without waiting for its flush
+thread_local static cid_t pending_flush_cid = INVALID_CID;
+
 LogManager::LogManager() {
   Configure(peloton_logging_mode, false, DEFAULT_NUM_FRONTEND_LOGGERS,
             LoggerMappingStrategyType::ROUND_ROBIN);
@@ -171,11 +177,19 @@ void LogManager::LogBeginTransaction(cid_t commit_id) {
     auto logger = this->GetBackendLogger();
     TransactionRecord record(LOGRECORD_TYPE_TRANSACTION_BEGIN, commit_id);
     logger->Log(&record);
+
+    // before the versions of the transaction become visible
+    cid_t max_cid = max_logging_cid_.load();
+    while (commit_id > max_cid &&
+           max_logging_cid_.compare_exchange_weak(max_cid, commit_id) ==
+               false) {
+    }
   }
 }
 
 void LogManager::LogUpdate(cid_t commit_id, const ItemPointer &old_version,
-                           const ItemPointer &new_version) {
+                           const ItemPointer &new_version,
+                           const std::vector<oid_t> *updated_columns) {
   if (this->IsInLoggingMode()) {
     auto &manager = catalog::Manager::GetInstance();
     auto catalog = catalog::Catalog::GetInstance();
@@ -194,16 +208,36 @@ void LogManager::LogUpdate(cid_t commit_id, const ItemPointer &old_version,
     if (LoggingUtil::IsBasedOnWriteAheadLogging(logging_type_) ||
         replicating_) {
       tuple.reset(new storage::Tuple(schema, true));
-      for (oid_t col = 0; col < schema->GetColumnCount(); col++) {
-        type::Value val =
-            (new_tuple_tile_group->GetValue(new_version.offset, col));
-        tuple->SetValue(col, val, logger->GetVarlenPool());
+
+      // Only log the updated columns when WAL replays the update
+      if (LoggingUtil::IsBasedOnWriteAheadLogging(logging_type_) &&
+          updated_columns != nullptr &&
+          updated_columns->size() < schema->GetColumnCount()) {
+        for (auto col : *updated_columns) {
+          tuple->SetValue(col,
+                          new_tuple_tile_group->GetValue(new_version.offset,
+                                                         col),
+                          logger->GetVarlenPool());
+        }
+        TupleRecord *tuple_record = new TupleRecord(
+            LOGRECORD_TYPE_WAL_TUPLE_PARTIAL_UPDATE, commit_id,
+            new_tuple_tile_group->GetTableId(), new_version, old_version,
+            tuple.get(), new_tuple_tile_group->GetDatabaseId());
+        tuple_record->SetModifiedColumns(*updated_columns);
+        record.reset(tuple_record);
+      } else {
+        for (oid_t col = 0; col < schema->GetColumnCount(); col++) {
+          tuple->SetValue(col,
+                          new_tuple_tile_group->GetValue(new_version.offset,
+                                                         col),
+                          logger->GetVarlenPool());
+        }
+        record.reset(
+            logger->GetTupleRecord(LOGRECORD_TYPE_TUPLE_UPDATE, commit_id,
+                                   new_tuple_tile_group->GetTableId(),
+                                   new_tuple_tile_group->GetDatabaseId(),
+                                   new_version, old_version, tuple.get()));
       }
-      record.reset(
-          logger->GetTupleRecord(LOGRECORD_TYPE_TUPLE_UPDATE, commit_id,
-                                 new_tuple_tile_group->GetTableId(),
-                                 new_tuple_tile_group->GetDatabaseId(),
-                                 new_version, old_version, tuple.get()));
     } else {
       // if wbl without replication, do not include tuple data
       record.reset(logger->GetTupleRecord(
@@ -270,18 +304,59 @@ void LogManager::LogDelete(cid_t commit_id,
   }
 }
 
-void LogManager::LogCommitTransaction(cid_t commit_id) {
+void LogManager::LogCommitTransaction(cid_t commit_id, bool wait_for_flush) {
   if (this->IsInLoggingMode()) {
     auto logger = this->GetBackendLogger();
     TransactionRecord record(LOGRECORD_TYPE_TRANSACTION_COMMIT, commit_id);
-    logger->Log(&record);
+    if (FLAGS_stats_mode != STATS_TYPE_INVALID) {
+      auto start = stats::LatencyHistogram::Clock::now();
+      logger->Log(&record);
+      stats::BackendStatsContext::GetInstance()
+          ->GetLogMetric()
+          .GetPhaseLatency(stats::LOG_PHASE_SERIALIZATION)
+          .RecordLatency(start);
+    } else {
+      logger->Log(&record);
+    }
     if (syncronization_commit) {
-      WaitForFlush(commit_id);
+      if (wait_for_flush) {
+        WaitForFlush(commit_id);
+      } else if (commit_id > pending_flush_cid) {
+        pending_flush_cid = commit_id;
+      }
     }
     // logger->GetVarlenPool()->Purge();
   }
 }
 
+void LogManager::WaitForReadCommits(cid_t read_cid, bool wait_for_flush) {
+  if (this->IsInLoggingMode() == false || syncronization_commit == false) {
+    return;
+  }
+  // The transaction may have read every commit up to its commit id. Commits
+  // that had not started logging when it began are not visible to it, and
+  // the read commit id itself may belong to no logged transaction.
+  cid_t cid = std::min(read_cid, max_logging_cid_.load());
+  if (cid == INVALID_CID) {
+    return;
+  }
+  if (wait_for_flush) {
+    WaitForFlush(cid);
+  } else if (cid > pending_flush_cid) {
+    pending_flush_cid = cid;
+  }
+}
+
+void LogManager::WaitForPendingFlush() {
+  if (pending_flush_cid == INVALID_CID) {
+    return;
+  }
+  // The flushed commit id covers all smaller commit ids, so one wait
+  // acknowledges every commit of the thread
+  WaitForFlush(pending_flush_cid);
+  pending_flush_cid = INVALID_CID;
+}
+
 /**
  * @brief Return the backend logger based on logging type
     and store it into the vector
@@ -325,6 +400,11 @@ void LogManager::InitFrontendLoggers() {
       std::unique_ptr<FrontendLogger> frontend_logger(
           FrontendLogger::GetFrontendLogger(logging_type_, test_mode_));
       frontend_logger->SetNoWrite(no_write_);
+      if (concurrent_log_buffer_ &&
+          LoggingUtil::IsBasedOnWriteAheadLogging(logging_type_)) {
+        frontend_logger->EnableConcurrentLogBuffer(
+            DEFAULT_CONCURRENT_LOG_BUFFER_CAPACITY);
+      }
 
       if (frontend_logger.get() != nullptr) {
         frontend_loggers.push_back(std::move(frontend_logger));
@@ -343,6 +423,11 @@ FrontendLogger *LogManager::GetFrontendLogger(unsigned int logger_idx) {
   return frontend_loggers[logger_idx].get();
 }
 
+bool LogManager::IsLoggingUpdatedColumns() {
+  return IsInLoggingMode() &&
+         LoggingUtil::IsBasedOnWriteAheadLogging(logging_type_);
+}
+
 bool LogManager::ContainsFrontendLogger(void) {
   return (frontend_loggers.size() != 0);
 }
@@ -476,6 +561,9 @@ cid_t LogManager::GetPersistentFlushedCommitId() {
 void LogManager::FrontendLoggerFlushed() {
   {
     std::unique_lock<std::mutex> wait_lock(flush_notify_mutex);
+    if (FLAGS_stats_mode != STATS_TYPE_INVALID) {
+      flush_notify_time = stats::LatencyHistogram::Clock::now();
+    }
     flush_notify_cv.notify_all();
   }
 }
@@ -485,11 +573,22 @@ void LogManager::WaitForFlush(cid_t cid) {
   {
     std::unique_lock<std::mutex> wait_lock(flush_notify_mutex);
 
+    bool waited = false;
     while (this->GetPersistentFlushedCommitId() < cid) {
       LOG_TRACE(
           "Logs up to %lu cid is flushed. %lu cid is not flushed yet. Wait...",
           this->GetPersistentFlushedCommitId(), cid);
       flush_notify_cv.wait(wait_lock);
+      waited = true;
+    }
+
+    // Time from the flush being signaled until this committer got to run
+    if (waited && FLAGS_stats_mode != STATS_TYPE_INVALID &&
+        flush_notify_time != stats::LatencyHistogram::Clock::time_point()) {
+      stats::BackendStatsContext::GetInstance()
+          ->GetLogMetric()
+          .GetPhaseLatency(stats::LOG_PHASE_FLUSH_WAIT)
+          .RecordLatency(flush_notify_time);
     }
     LOG_TRACE(
         "Flushes done! Can return! Got persistent flushed commit id as %d",
@@ -14,8 +14,10 @@
 #include <sys/types.h>
 #include <sys/mman.h>
 #include <algorithm>
+#include <atomic>
 #include <dirent.h>
 #include <numeric>
+#include <thread>
 
 #include "catalog/catalog.h"
 #include "catalog/manager.h"
@@ -25,6 +27,7 @@
 #include "concurrency/transaction_manager_factory.h"
 #include "concurrency/transaction_manager.h"
 
+#include "logging/log_compressor.h"
 #include "logging/log_manager.h"
 #include "logging/records/transaction_record.h"
 #include "logging/records/tuple_record.h"
@@ -33,6 +36,7 @@
 #include "logging/checkpoint_tile_scanner.h"
 #include "logging/logging_util.h"
 #include "logging/checkpoint_manager.h"
+#include "statistics/backend_stats_context.h"
 
 #include "storage/database.h"
 #include "storage/data_table.h"
@@ -116,11 +120,18 @@ WriteAheadFrontendLogger::~WriteAheadFrontendLogger() {
 void WriteAheadFrontendLogger::FlushLogRecords(void) {
   size_t global_queue_size = global_queue.size();
 
+  // range of the shared log buffer to write out
+  uint64_t shared_begin = 0, shared_end = 0;
+  if (concurrent_log_buffer_) {
+    shared_begin = concurrent_log_buffer_->GetReleasedOffset();
+    shared_end = concurrent_log_buffer_end_;
+  }
+
   bool will_write_to_file;
 
   // check if we will end up writing something to disk
-  will_write_to_file =
-      ((max_collected_commit_id != max_flushed_commit_id) || global_queue_size);
+  will_write_to_file = ((max_collected_commit_id != max_flushed_commit_id) ||
+                        global_queue_size || shared_end > shared_begin);
 
   if (will_write_to_file) {
     if (cur_file_handle.fd == -1) {
@@ -131,16 +142,34 @@ void WriteAheadFrontendLogger::FlushLogRecords(void) {
     }
   }
 
+  // Time the write and fsync phases if statistics are enabled
+  stats::LogMetric *log_metric = nullptr;
+  if (FLAGS_stats_mode != STATS_TYPE_INVALID && will_write_to_file &&
+      !test_mode_ && !no_write_) {
+    log_metric = &stats::BackendStatsContext::GetInstance()->GetLogMetric();
+  }
+  auto write_start = stats::LatencyHistogram::Clock::now();
+
   TransactionRecord delimiter_rec(LOGRECORD_TYPE_ITERATION_DELIMITER,
                                   this->max_collected_commit_id);
   delimiter_rec.Serialize(output_buffer);
 
+  // Collect the records into a single block if they are compressed
+  bool compress_records =
+      LogManager::GetInstance().GetLogCompression() &&
+      (global_queue_size > 0 || shared_end > shared_begin) && !test_mode_ &&
+      !no_write_;
+  if (compress_records) compression_input_.clear();
+
   // First, write all the record in the queue
   for (oid_t global_queue_itr = 0; global_queue_itr < global_queue_size;
        global_queue_itr++) {
     auto &log_buffer = global_queue[global_queue_itr];
 
-    if (!test_mode_ && !no_write_) {
+    if (compress_records) {
+      compression_input_.insert(compression_input_.end(), log_buffer->GetData(),
+                                log_buffer->GetData() + log_buffer->GetSize());
+    } else if (!test_mode_ && !no_write_) {
       fwrite(log_buffer->GetData(), sizeof(char), log_buffer->GetSize(),
              cur_file_handle.file);
     }
@@ -159,6 +188,30 @@ void WriteAheadFrontendLogger::FlushLogRecords(void) {
     backend_logger->GrantEmptyBuffer(std::move(log_buffer));
   }
 
+  // Then, write the completed part of the shared log buffer
+  if (shared_end > shared_begin) {
+    for (uint64_t offset = shared_begin; offset < shared_end;) {
+      auto region = concurrent_log_buffer_->GetRegion(offset, shared_end);
+      if (compress_records) {
+        compression_input_.insert(compression_input_.end(), region.first,
+                                  region.first + region.second);
+      } else if (!test_mode_ && !no_write_) {
+        fwrite(region.first, sizeof(char), region.second,
+               cur_file_handle.file);
+      }
+      offset += region.second;
+    }
+    concurrent_log_buffer_->Release(shared_end);
+
+    if (concurrent_log_buffer_->GetMaxLogId() > this->max_log_id_file) {
+      this->max_log_id_file = concurrent_log_buffer_->GetMaxLogId();
+    }
+  }
+
+  if (compress_records && compression_input_.empty() == false) {
+    WriteCompressedBlock();
+  }
+
   bool flushed = false;
 
   if (max_collected_commit_id != max_flushed_commit_id) {
@@ -171,12 +224,21 @@ void WriteAheadFrontendLogger::FlushLogRecords(void) {
         }
         LOG_TRACE("Wrote delimiter to log file with commit_id %ld",
                   this->max_collected_commit_id);
+        if (log_metric != nullptr) {
+          log_metric->GetPhaseLatency(stats::LOG_PHASE_WRITE)
+              .RecordLatency(write_start);
+        }
 
         // by moving the fflush and sync here, we ensure that this file will
         // have at least 1 delimiter
         if (Clock::now() > last_flush + flush_frequency) {
           if (!no_write_) {
+            auto fsync_start = stats::LatencyHistogram::Clock::now();
             LoggingUtil::FFlushFsync(cur_file_handle);
+            if (log_metric != nullptr) {
+              log_metric->GetPhaseLatency(stats::LOG_PHASE_FSYNC)
+                  .RecordLatency(fsync_start);
+            }
           }
           last_flush = Clock::now();
           if (this->max_collected_commit_id > max_flushed_commit_id) {
@@ -216,6 +278,33 @@ void WriteAheadFrontendLogger::FlushLogRecords(void) {
   }
 }
 
+/**
+ * @brief compress the collected records and write them out as one block
+ */
+void WriteAheadFrontendLogger::WriteCompressedBlock() {
+  compression_output_.resize(
+      LogCompressor::GetMaxCompressedSize(compression_input_.size()));
+  size_t compressed_size =
+      LogCompressor::Compress(compression_input_.data(),
+                              compression_input_.size(),
+                              compression_output_.data());
+
+  // Type, frame length and uncompressed length precede the compressed data
+  CopySerializeOutput header_output;
+  header_output.WriteEnumInSingleByte(LOGRECORD_TYPE_COMPRESSED_BLOCK);
+  header_output.WriteInt(
+      static_cast<int32_t>(sizeof(int32_t) + compressed_size));
+  header_output.WriteInt(static_cast<int32_t>(compression_input_.size()));
+
+  fwrite(header_output.Data(), sizeof(char), header_output.Size(),
+         cur_file_handle.file);
+  fwrite(compression_output_.data(), sizeof(char), compressed_size,
+         cur_file_handle.file);
+
+  LOG_TRACE("Compressed %lu bytes of log records into %lu bytes",
+            compression_input_.size(), compressed_size);
+}
+
 //===--------------------------------------------------------------------===//
 // Recovery
 //===--------------------------------------------------------------------===//
@@ -230,6 +319,7 @@ void WriteAheadFrontendLogger::DoRecovery() {
   int num_inserts = 0;
   cid_t global_max_flushed_id_for_recovery;
   log_file_cursor_ = 0;
+  log_file_handle_ = FileHandle();
 
   global_max_flushed_id_for_recovery =
       log_manager.GetGlobalMaxFlushedIdForRecovery();
@@ -258,6 +348,7 @@ void WriteAheadFrontendLogger::DoRecovery() {
         TransactionRecord txn_rec(record_type);
         if (LoggingUtil::ReadTransactionRecordHeader(
                 txn_rec, cur_file_handle) == false) {
+          ReplayCommittedRecords();
           cur_file_handle = INVALID_FILE_HANDLE;
           return;
         }
@@ -270,12 +361,14 @@ void WriteAheadFrontendLogger::DoRecovery() {
         break;
       }
       case LOGRECORD_TYPE_WAL_TUPLE_INSERT:
-      case LOGRECORD_TYPE_WAL_TUPLE_UPDATE: {
+      case LOGRECORD_TYPE_WAL_TUPLE_UPDATE:
+      case LOGRECORD_TYPE_WAL_TUPLE_PARTIAL_UPDATE: {
         tuple_record = new TupleRecord(record_type);
         // Check for torn log write
         if (LoggingUtil::ReadTupleRecordHeader(*tuple_record,
                                                cur_file_handle) == false) {
           LOG_ERROR("Could not read tuple record header.");
+          ReplayCommittedRecords();
           cur_file_handle = INVALID_FILE_HANDLE;
           return;
         }
@@ -294,13 +387,20 @@ void WriteAheadFrontendLogger::DoRecovery() {
         if (recovery_txn_table.find(log_id) == recovery_txn_table.end()) {
           LOG_ERROR("Insert txd id %d not found in recovery txn table",
                     (int)log_id);
+          ReplayCommittedRecords();
           cur_file_handle = INVALID_FILE_HANDLE;
           return;
         }
 
         // Read off the tuple record body from the log
-        tuple_record->SetTuple(LoggingUtil::ReadTupleRecordBody(
-            table->GetSchema(), recovery_pool, cur_file_handle));
+        if (record_type == LOGRECORD_TYPE_WAL_TUPLE_PARTIAL_UPDATE) {
+          tuple_record->SetTuple(LoggingUtil::ReadPartialTupleRecordBody(
+              *tuple_record, table->GetSchema(), recovery_pool,
+              cur_file_handle));
+        } else {
+          tuple_record->SetTuple(LoggingUtil::ReadTupleRecordBody(
+              table->GetSchema(), recovery_pool, cur_file_handle));
+        }
         num_inserts++;
         break;
       }
@@ -309,6 +409,7 @@ void WriteAheadFrontendLogger::DoRecovery() {
         // Check for torn log write
         if (LoggingUtil::ReadTupleRecordHeader(*tuple_record,
                                                cur_file_handle) == false) {
+          ReplayCommittedRecords();
           cur_file_handle = INVALID_FILE_HANDLE;
           return;
         }
@@ -322,6 +423,7 @@ void WriteAheadFrontendLogger::DoRecovery() {
         if (recovery_txn_table.find(log_id) == recovery_txn_table.end()) {
           LOG_TRACE("Delete txd id %d not found in recovery txn table",
                     (int)log_id);
+          ReplayCommittedRecords();
           cur_file_handle = INVALID_FILE_HANDLE;
           return;
         }
@@ -351,6 +453,7 @@ void WriteAheadFrontendLogger::DoRecovery() {
         case LOGRECORD_TYPE_WAL_TUPLE_INSERT:
         case LOGRECORD_TYPE_WAL_TUPLE_DELETE:
         case LOGRECORD_TYPE_WAL_TUPLE_UPDATE:
+        case LOGRECORD_TYPE_WAL_TUPLE_PARTIAL_UPDATE:
           recovery_txn_table[tuple_record->GetTransactionId()]
               .push_back(tuple_record);
           break;
@@ -369,6 +472,9 @@ void WriteAheadFrontendLogger::DoRecovery() {
     }
   }
 
+  // Replay the records of the last committed txns
+  ReplayCommittedRecords();
+
   // Finally, abort ACTIVE transactions in recovery_txn_table
   AbortActiveTransactions();
 
@@ -389,6 +495,9 @@ void WriteAheadFrontendLogger::RecoverIndex() {
   auto catalog = catalog::Catalog::GetInstance();
   auto database_count = catalog->GetDatabaseCount();
 
+  // Each index is rebuilt independently of the others
+  std::vector<std::pair<storage::DataTable *, oid_t>> index_tasks;
+
   // loop all databases
   for (oid_t database_idx = 1; database_idx < database_count; database_idx++) {
     auto database = catalog->GetDatabaseWithOffset(database_idx);
@@ -402,15 +511,41 @@ void WriteAheadFrontendLogger::RecoverIndex() {
       LOG_TRACE("SeqScan: database oid %u table oid %u: %s", database_idx,
                 table_idx, target_table->GetName().c_str());
 
-      if (!RecoverTableIndexHelper(target_table, cid)) {
-        break;
+      auto index_count = target_table->GetIndexCount();
+      for (oid_t index_itr = 0; index_itr < index_count; index_itr++) {
+        index_tasks.emplace_back(target_table, index_itr);
       }
     }
   }
+
+  // Hand out the indexes to the recovery threads
+  std::atomic<size_t> next_task(0);
+  auto rebuild_indexes = [&]() {
+    size_t task_itr;
+    while ((task_itr = next_task.fetch_add(1)) < index_tasks.size()) {
+      RecoverTableIndexHelper(index_tasks[task_itr].first,
+                              index_tasks[task_itr].second, cid);
+    }
+  };
+
+  size_t thread_count = std::min<size_t>(
+      LogManager::GetInstance().GetRecoveryThreadCount(), index_tasks.size());
+  if (thread_count <= 1) {
+    rebuild_indexes();
+    return;
+  }
+
+  std::vector<std::thread> recovery_threads;
+  for (size_t thread_itr = 0; thread_itr < thread_count; thread_itr++) {
+    recovery_threads.emplace_back(rebuild_indexes);
+  }
+  for (auto &recovery_thread : recovery_threads) {
+    recovery_thread.join();
+  }
 }
 
 bool WriteAheadFrontendLogger::RecoverTableIndexHelper(
-    storage::DataTable *target_table, cid_t start_cid) {
+    storage::DataTable *target_table, oid_t index_offset, cid_t start_cid) {
   auto schema = target_table->GetSchema();
   PL_ASSERT(schema);
   std::vector<oid_t> column_ids;
@@ -457,7 +592,7 @@ bool WriteAheadFrontendLogger::RecoverTableIndexHelper(
         }
 
         ItemPointer location(tile_group_id, tuple_id);
-        InsertIndexEntry(tuple.get(), target_table, location);
+        InsertIndexEntry(tuple.get(), target_table, index_offset, location);
       }
     }
     current_tile_group_offset++;
@@ -467,26 +602,24 @@ bool WriteAheadFrontendLogger::RecoverTableIndexHelper(
 
 void WriteAheadFrontendLogger::InsertIndexEntry(storage::Tuple *tuple,
                                                 storage::DataTable *table,
+                                                oid_t index_offset,
                                                 ItemPointer target_location UNUSED_ATTRIBUTE) {
   PL_ASSERT(tuple);
   PL_ASSERT(table);
-  auto index_count = table->GetIndexCount();
-  LOG_TRACE("Insert tuple (%u, %u) into %u indexes", target_location.block,
-            target_location.offset, index_count);
-
-  for (int index_itr = index_count - 1; index_itr >= 0; --index_itr) {
-    auto index = table->GetIndex(index_itr);
-    auto index_schema = index->GetKeySchema();
-    auto indexed_columns = index_schema->GetIndexedColumns();
-    std::unique_ptr<storage::Tuple> key(new storage::Tuple(index_schema, true));
-    key->SetFromTuple(tuple, indexed_columns, index->GetPool());
-
-    // TODO: workaround. this can cause memory leak.
-    // since currently logging does not work, we will handle this later.
-    // index->InsertEntry(key.get(), new ItemPointer(target_location));
-    // Increase the indexes' number of tuples by 1 as well
-    index->IncreaseNumberOfTuplesBy(1);
-  }
+  LOG_TRACE("Insert tuple (%u, %u) into index %u", target_location.block,
+            target_location.offset, index_offset);
+
+  auto index = table->GetIndex(index_offset);
+  auto index_schema = index->GetKeySchema();
+  auto indexed_columns = index_schema->GetIndexedColumns();
+  std::unique_ptr<storage::Tuple> key(new storage::Tuple(index_schema, true));
+  key->SetFromTuple(tuple, indexed_columns, index->GetPool());
+
+  // TODO: workaround. this can cause memory leak.
+  // since currently logging does not work, we will handle this later.
+  // index->InsertEntry(key.get(), new ItemPointer(target_location));
+  // Increase the indexes' number of tuples by 1 as well
+  index->IncreaseNumberOfTuplesBy(1);
 }
 
 /**
@@ -512,31 +645,32 @@ void WriteAheadFrontendLogger::StartTransactionRecovery(cid_t commit_id) {
 }
 
 /**
- * @brief move tuples from current txn to recovery txn so that we can commit
- * them later
+ * @brief move tuples from current txn to the list of committed records so
+ * that we can replay them later
  * @param recovery txn
  */
 void WriteAheadFrontendLogger::CommitTransactionRecovery(cid_t commit_id) {
   std::vector<TupleRecord *> &tuple_records = recovery_txn_table[commit_id];
-  for (auto it = tuple_records.begin(); it != tuple_records.end(); it++) {
-    TupleRecord *curr = *it;
-    switch (curr->GetType()) {
-      case LOGRECORD_TYPE_WAL_TUPLE_INSERT:
-        InsertTuple(curr);
-        break;
-      case LOGRECORD_TYPE_WAL_TUPLE_UPDATE:
-        UpdateTuple(curr);
-        break;
-      case LOGRECORD_TYPE_WAL_TUPLE_DELETE:
-        DeleteTuple(curr);
-        break;
-      default:
-        continue;
-    }
-    delete curr;
-  }
+  committed_records_.insert(committed_records_.end(), tuple_records.begin(),
+                            tuple_records.end());
   max_cid = commit_id + 1;
   recovery_txn_table.erase(commit_id);
+
+  // Bound the number of records that are kept in memory
+  if (committed_records_.size() >= replay_batch_size) {
+    ReplayCommittedRecords();
+  }
+}
+
+/**
+ * @brief replay and release the records of the committed txns
+ */
+void WriteAheadFrontendLogger::ReplayCommittedRecords() {
+  ReplayTupleRecords(committed_records_);
+  for (auto tuple_record : committed_records_) {
+    delete tuple_record;
+  }
+  committed_records_.clear();
 }
 
 void InsertTupleHelper(oid_t &max_tg, cid_t commit_id, oid_t db_id,
@@ -608,9 +742,9 @@ void DeleteTupleHelper(oid_t &max_tg, cid_t commit_id, oid_t db_id,
   tile_group->DeleteTupleFromRecovery(commit_id, delete_loc.offset);
 }
 
-void UpdateTupleHelper(oid_t &max_tg, cid_t commit_id, oid_t db_id,
-                       oid_t table_id, const ItemPointer &remove_loc,
-                       const ItemPointer &insert_loc, storage::Tuple *tuple) {
+void InvalidateOldVersionHelper(oid_t &max_tg, cid_t commit_id, oid_t db_id,
+                                oid_t table_id, const ItemPointer &remove_loc,
+                                const ItemPointer &insert_loc) {
   auto &manager = catalog::Manager::GetInstance();
   auto catalog = catalog::Catalog::GetInstance();
   storage::Database *db = catalog->GetDatabaseWithOid(db_id);
@@ -618,7 +752,6 @@ void UpdateTupleHelper(oid_t &max_tg, cid_t commit_id, oid_t db_id,
 
   auto table = db->GetTableWithOid(table_id);
   if (!table) {
-    delete tuple;
     return;
   }
   PL_ASSERT(table);
@@ -634,10 +767,108 @@ void UpdateTupleHelper(oid_t &max_tg, cid_t commit_id, oid_t db_id,
     }
   }
   // table->GetTileGroupLock().Unlock();
+
+  tile_group->UpdateTupleFromRecovery(commit_id, remove_loc.offset, insert_loc);
+}
+
+void UpdateTupleHelper(oid_t &max_tg, cid_t commit_id, oid_t db_id,
+                       oid_t table_id, const ItemPointer &remove_loc,
+                       const ItemPointer &insert_loc, storage::Tuple *tuple) {
   InsertTupleHelper(max_tg, commit_id, db_id, table_id, insert_loc, tuple,
                     false);
+  InvalidateOldVersionHelper(max_tg, commit_id, db_id, table_id, remove_loc,
+                             insert_loc);
+}
 
-  tile_group->UpdateTupleFromRecovery(commit_id, remove_loc.offset, insert_loc);
+// Fill in the columns that a partial update did not log from the old version
+void MergePartialUpdateHelper(TupleRecord *record, type::AbstractPool *pool) {
+  auto &manager = catalog::Manager::GetInstance();
+  auto delete_loc = record->GetDeleteLocation();
+  auto tile_group = manager.GetTileGroup(delete_loc.block);
+  storage::Tuple *tuple = record->GetTuple();
+  if (tile_group == nullptr || tuple == nullptr) {
+    LOG_ERROR("Could not find the old version of a partial update");
+    return;
+  }
+
+  auto column_count = tuple->GetSchema()->GetColumnCount();
+  std::vector<bool> is_modified(column_count, false);
+  for (auto column_id : record->GetModifiedColumns()) {
+    is_modified[column_id] = true;
+  }
+
+  for (oid_t column_id = 0; column_id < column_count; column_id++) {
+    if (is_modified[column_id]) continue;
+    tuple->SetValue(column_id,
+                    tile_group->GetValue(delete_loc.offset, column_id), pool);
+  }
+}
+
+// A replay step that touches a single tile group. An update record yields
+// two steps: the insert of the new version and the invalidation of the old
+// version, which may live in a different tile group. The new version of a
+// partial update is only complete once the old version step has merged it,
+// which is signalled through old_version_merged.
+struct ReplayStep {
+  TupleRecord *record;
+  bool is_old_version;
+  std::atomic<bool> *old_version_merged;
+};
+
+void ReplayStepsHelper(const std::vector<ReplayStep> &replay_steps,
+                       oid_t &max_tg, type::AbstractPool *pool) {
+  for (auto &replay_step : replay_steps) {
+    auto record = replay_step.record;
+    switch (record->GetType()) {
+      case LOGRECORD_TYPE_WAL_TUPLE_INSERT:
+        InsertTupleHelper(max_tg, record->GetTransactionId(),
+                          record->GetDatabaseOid(), record->GetTableId(),
+                          record->GetInsertLocation(), record->GetTuple());
+        break;
+      case LOGRECORD_TYPE_WAL_TUPLE_UPDATE:
+        if (replay_step.is_old_version) {
+          InvalidateOldVersionHelper(
+              max_tg, record->GetTransactionId(), record->GetDatabaseOid(),
+              record->GetTableId(), record->GetDeleteLocation(),
+              record->GetInsertLocation());
+        } else {
+          InsertTupleHelper(max_tg, record->GetTransactionId(),
+                            record->GetDatabaseOid(), record->GetTableId(),
+                            record->GetInsertLocation(), record->GetTuple(),
+                            false);
+        }
+        break;
+      case LOGRECORD_TYPE_WAL_TUPLE_PARTIAL_UPDATE:
+        if (replay_step.is_old_version) {
+          MergePartialUpdateHelper(record, pool);
+          InvalidateOldVersionHelper(
+              max_tg, record->GetTransactionId(), record->GetDatabaseOid(),
+              record->GetTableId(), record->GetDeleteLocation(),
+              record->GetInsertLocation());
+          replay_step.old_version_merged->store(true,
+                                                std::memory_order_release);
+        } else {
+          // Steps are in log order in every partition, so the thread that
+          // owns the old version never waits on this one
+          while (!replay_step.old_version_merged->load(
+              std::memory_order_acquire)) {
+            std::this_thread::yield();
+          }
+          InsertTupleHelper(max_tg, record->GetTransactionId(),
+                            record->GetDatabaseOid(), record->GetTableId(),
+                            record->GetInsertLocation(), record->GetTuple(),
+                            false);
+        }
+        break;
+      case LOGRECORD_TYPE_WAL_TUPLE_DELETE:
+        DeleteTupleHelper(max_tg, record->GetTransactionId(),
+                          record->GetDatabaseOid(), record->GetTableId(),
+                          record->GetDeleteLocation());
+        break;
+      default:
+        break;
+    }
+  }
 }
 
 /**
@@ -666,12 +897,89 @@ void WriteAheadFrontendLogger::DeleteTuple(TupleRecord *record) {
  */
 
 void WriteAheadFrontendLogger::UpdateTuple(TupleRecord *record) {
+  if (record->GetType() == LOGRECORD_TYPE_WAL_TUPLE_PARTIAL_UPDATE) {
+    MergePartialUpdateHelper(record, recovery_pool);
+  }
   UpdateTupleHelper(max_oid, record->GetTransactionId(),
                     record->GetDatabaseOid(), record->GetTableId(),
                     record->GetDeleteLocation(), record->GetInsertLocation(),
                     record->GetTuple());
 }
 
+/**
+ * @brief replay the records of committed txns, given in commit order, with
+ * the recovery threads. The records are partitioned by tile group, so that
+ * every tuple slot is replayed by a single thread in log order.
+ * @param tuple records
+ */
+void WriteAheadFrontendLogger::ReplayTupleRecords(
+    const std::vector<TupleRecord *> &tuple_records) {
+  size_t thread_count =
+      std::max(1u, LogManager::GetInstance().GetRecoveryThreadCount());
+  std::vector<std::vector<ReplayStep>> partitions(thread_count);
+  std::unique_ptr<std::atomic<bool>[]> old_versions_merged(
+      new std::atomic<bool>[tuple_records.size()]);
+
+  for (size_t record_itr = 0; record_itr < tuple_records.size();
+       record_itr++) {
+    auto record = tuple_records[record_itr];
+    switch (record->GetType()) {
+      case LOGRECORD_TYPE_WAL_TUPLE_INSERT:
+        partitions[record->GetInsertLocation().block % thread_count]
+            .push_back({record, false, nullptr});
+        break;
+      case LOGRECORD_TYPE_WAL_TUPLE_UPDATE:
+        partitions[record->GetInsertLocation().block % thread_count]
+            .push_back({record, false, nullptr});
+        partitions[record->GetDeleteLocation().block % thread_count]
+            .push_back({record, true, nullptr});
+        break;
+      case LOGRECORD_TYPE_WAL_TUPLE_PARTIAL_UPDATE: {
+        // The old version step goes first as the new version depends on it
+        auto old_version_merged = &old_versions_merged[record_itr];
+        old_version_merged->store(false, std::memory_order_relaxed);
+        partitions[record->GetDeleteLocation().block % thread_count]
+            .push_back({record, true, old_version_merged});
+        partitions[record->GetInsertLocation().block % thread_count]
+            .push_back({record, false, old_version_merged});
+        break;
+      }
+      case LOGRECORD_TYPE_WAL_TUPLE_DELETE:
+        partitions[record->GetDeleteLocation().block % thread_count]
+            .push_back({record, false, nullptr});
+        break;
+      default:
+        break;
+    }
+  }
+
+  // Every thread tracks the max tile group id it has created
+  std::vector<oid_t> max_tile_group_ids(thread_count, max_oid);
+
+  std::vector<std::thread> recovery_threads;
+  for (size_t partition_itr = 1; partition_itr < thread_count;
+       partition_itr++) {
+    if (partitions[partition_itr].empty()) continue;
+    recovery_threads.emplace_back(ReplayStepsHelper,
+                                  std::cref(partitions[partition_itr]),
+                                  std::ref(max_tile_group_ids[partition_itr]),
+                                  recovery_pool);
+  }
+
+  // The frontend logger replays the first partition itself
+  ReplayStepsHelper(partitions[0], max_tile_group_ids[0], recovery_pool);
+
+  for (auto &recovery_thread : recovery_threads) {
+    recovery_thread.join();
+  }
+
+  for (auto max_tile_group_id : max_tile_group_ids) {
+    if (max_oid < max_tile_group_id) {
+      max_oid = max_tile_group_id;
+    }
+  }
+}
+
 //===--------------------------------------------------------------------===//
 // Utility functions
 //===--------------------------------------------------------------------===//
@@ -686,6 +994,12 @@ LogRecordType WriteAheadFrontendLogger::GetNextLogRecordTypeForRecovery() {
 
   LOG_TRACE("Inside GetNextLogRecordForRecovery");
 
+  // Go back to the log file once the records of a compressed block are used up
+  if (log_file_handle_.file != nullptr &&
+      LoggingUtil::IsFileTruncated(cur_file_handle, 1)) {
+    CloseCompressedBlock();
+  }
+
   LOG_TRACE("File is at position %d", (int)ftell(cur_file_handle.file));
 
   // Check if the log record type is broken
@@ -727,9 +1041,50 @@ LogRecordType WriteAheadFrontendLogger::GetNextLogRecordTypeForRecovery() {
   CopySerializeInput input(&buffer, sizeof(char));
   LogRecordType log_record_type = (LogRecordType)(input.ReadByte());
 
+  // Read the records of a compressed block as if they were in the log file
+  if (log_record_type == LOGRECORD_TYPE_COMPRESSED_BLOCK &&
+      log_file_handle_.file == nullptr) {
+    OpenCompressedBlock();
+    if (log_file_handle_.file == nullptr) return LOGRECORD_TYPE_INVALID;
+    return GetNextLogRecordTypeForRecovery();
+  }
+
   return log_record_type;
 }
 
+/**
+ * @brief decompress the block at the current position of the log file and
+ * switch cur_file_handle over to its records
+ */
+void WriteAheadFrontendLogger::OpenCompressedBlock() {
+  if (LoggingUtil::ReadCompressedLogBlock(cur_file_handle,
+                                          compressed_block_records_) == false ||
+      compressed_block_records_.empty()) {
+    LOG_ERROR("Could not read compressed log block");
+    return;
+  }
+
+  FILE *block_file = fmemopen(compressed_block_records_.data(),
+                              compressed_block_records_.size(), "rb");
+  if (block_file == nullptr) {
+    LOG_ERROR("Could not open compressed log block");
+    return;
+  }
+
+  log_file_handle_ = cur_file_handle;
+  cur_file_handle = FileHandle(block_file, log_file_handle_.fd,
+                               compressed_block_records_.size());
+}
+
+/**
+ * @brief switch cur_file_handle back to the log file after a compressed block
+ */
+void WriteAheadFrontendLogger::CloseCompressedBlock() {
+  fclose(cur_file_handle.file);
+  cur_file_handle = log_file_handle_;
+  log_file_handle_ = FileHandle();
+}
+
 std::string WriteAheadFrontendLogger::GetLogFileName(void) {
   auto &log_manager = logging::LogManager::GetInstance();
   return log_manager.GetLogFileName();
@@ -1006,6 +1361,13 @@ void WriteAheadFrontendLogger::OpenNextLogFile() {
     LOG_TRACE("Opened new log file for recovery");
   }
 
+  // Read the log file in large sequential chunks
+  if (recovery_read_buffer_ == nullptr) {
+    recovery_read_buffer_.reset(new char[recovery_read_buffer_size]);
+  }
+  setvbuf(cur_file_handle.file, recovery_read_buffer_.get(), _IOFBF,
+          recovery_read_buffer_size);
+
   cur_file_handle.fd = fileno(cur_file_handle.file);
 
   LOG_TRACE("FD of opened file is %d", (int)cur_file_handle.fd);
@@ -1088,9 +1450,7 @@ std::string WriteAheadFrontendLogger::GetFileNameFromVersion(int version) {
 std::pair<cid_t, cid_t>
 WriteAheadFrontendLogger::ExtractMaxLogIdAndMaxDelimFromLogFileRecords(
     FILE *log_file) {
-  bool reached_end_of_file = false;
   struct stat log_stats;
-  cid_t max_log_id_so_far = 0, max_delim_so_far = 0;
   FileHandle file_handle;
 
   file_handle.file = log_file;
@@ -1099,6 +1459,15 @@ WriteAheadFrontendLogger::ExtractMaxLogIdAndMaxDelimFromLogFileRecords(
   fstat(file_handle.fd, &log_stats);
   file_handle.size = log_stats.st_size;
 
+  return ExtractMaxLogIdAndMaxDelimFromFileHandle(file_handle);
+}
+
+std::pair<cid_t, cid_t>
+WriteAheadFrontendLogger::ExtractMaxLogIdAndMaxDelimFromFileHandle(
+    FileHandle &file_handle) {
+  bool reached_end_of_file = false;
+  cid_t max_log_id_so_far = 0, max_delim_so_far = 0;
+
   while (reached_end_of_file == false) {
     // Read the first byte to identify log record type
     // If that is not possible, then wrap up recovery
@@ -1127,7 +1496,8 @@ WriteAheadFrontendLogger::ExtractMaxLogIdAndMaxDelimFromLogFileRecords(
         break;
       }
       case LOGRECORD_TYPE_WAL_TUPLE_INSERT:
-      case LOGRECORD_TYPE_WAL_TUPLE_UPDATE: {
+      case LOGRECORD_TYPE_WAL_TUPLE_UPDATE:
+      case LOGRECORD_TYPE_WAL_TUPLE_PARTIAL_UPDATE: {
         tuple_record = new TupleRecord(record_type);
 
         if (LoggingUtil::ReadTupleRecordHeader(*tuple_record, file_handle) ==
@@ -1149,8 +1519,14 @@ WriteAheadFrontendLogger::ExtractMaxLogIdAndMaxDelimFromLogFileRecords(
         }
 
         // Read off the tuple record body from the log
-        auto record_body = LoggingUtil::ReadTupleRecordBody(
-            table->GetSchema(), recovery_pool, file_handle);
+        storage::Tuple *record_body;
+        if (record_type == LOGRECORD_TYPE_WAL_TUPLE_PARTIAL_UPDATE) {
+          record_body = LoggingUtil::ReadPartialTupleRecordBody(
+              *tuple_record, table->GetSchema(), recovery_pool, file_handle);
+        } else {
+          record_body = LoggingUtil::ReadTupleRecordBody(
+              table->GetSchema(), recovery_pool, file_handle);
+        }
         delete tuple_record;
         delete record_body;
 
@@ -1171,6 +1547,28 @@ WriteAheadFrontendLogger::ExtractMaxLogIdAndMaxDelimFromLogFileRecords(
         delete tuple_record;
         break;
       }
+      case LOGRECORD_TYPE_COMPRESSED_BLOCK: {
+        // Scan the records inside the block
+        std::vector<char> block;
+        if (LoggingUtil::ReadCompressedLogBlock(file_handle, block) == false) {
+          return std::pair<cid_t, cid_t>(UINT64_MAX, UINT64_MAX);
+        }
+
+        FileHandle block_handle(fmemopen(block.data(), block.size(), "rb"),
+                                file_handle.fd, block.size());
+        if (block_handle.file == nullptr) {
+          return std::pair<cid_t, cid_t>(UINT64_MAX, UINT64_MAX);
+        }
+        auto block_ids = ExtractMaxLogIdAndMaxDelimFromFileHandle(block_handle);
+        fclose(block_handle.file);
+
+        if (block_ids.first == UINT64_MAX) return block_ids;
+        if (block_ids.first > max_log_id_so_far)
+          max_log_id_so_far = block_ids.first;
+        if (block_ids.second > max_delim_so_far)
+          max_delim_so_far = block_ids.second;
+        break;
+      }
       default:
         reached_end_of_file = true;
         break;
@@ -16,6 +16,7 @@
 #include <cstring>
 
 #include "catalog/catalog.h"
+#include "logging/log_compressor.h"
 #include "storage/database.h"
 #include "type/types.h"
 
@@ -287,6 +288,81 @@ storage::Tuple *LoggingUtil::ReadTupleRecordBody(const catalog::Schema *schema,
   return tuple;
 }
 
+/**
+ * @brief Read the body of a partial update record
+ * @return a tuple holding only the modified columns, which are recorded in
+ * the tuple record; the caller fills in the rest from the old version
+ */
+storage::Tuple *LoggingUtil::ReadPartialTupleRecordBody(
+    TupleRecord &tuple_record, const catalog::Schema *schema,
+    type::AbstractPool *pool, FileHandle &file_handle) {
+  // Check if the frame is broken
+  size_t body_size = GetNextFrameSize(file_handle);
+  if (body_size == 0) {
+    LOG_ERROR("Body size is zero ");
+    return nullptr;
+  }
+
+  // Read Body
+  std::unique_ptr<char[]> body(new char[body_size]);
+  size_t ret = fread(body.get(), 1, body_size, file_handle.file);
+  if (ret != body_size) {
+    LOG_ERROR("Error occured in fread ");
+    return nullptr;
+  }
+
+  CopySerializeInput tuple_body(body.get(), body_size);
+  tuple_body.ReadInt();
+
+  std::unique_ptr<storage::Tuple> tuple(new storage::Tuple(schema, true));
+  std::vector<oid_t> modified_columns;
+  oid_t column_count = static_cast<oid_t>(tuple_body.ReadInt());
+  for (oid_t column_itr = 0; column_itr < column_count; column_itr++) {
+    oid_t column_id = static_cast<oid_t>(tuple_body.ReadInt());
+    if (column_id >= schema->GetColumnCount()) {
+      LOG_ERROR("Invalid column id %u in partial update", column_id);
+      return nullptr;
+    }
+    type::Value value = type::Value::DeserializeFrom(
+        tuple_body, schema->GetType(column_id), nullptr);
+    tuple->SetValue(column_id, value, pool);
+    modified_columns.push_back(column_id);
+  }
+
+  tuple_record.SetModifiedColumns(modified_columns);
+  return tuple.release();
+}
+
+/**
+ * @brief Read and decompress a compressed block of log records
+ * @param block receives the uncompressed records
+ * @return false if the block is truncated or corrupted
+ */
+bool LoggingUtil::ReadCompressedLogBlock(FileHandle &file_handle,
+                                         std::vector<char> &block) {
+  // Check if the frame is broken
+  size_t frame_size = GetNextFrameSize(file_handle);
+  if (frame_size <= 2 * sizeof(int32_t)) {
+    return false;
+  }
+
+  std::unique_ptr<char[]> frame(new char[frame_size]);
+  size_t ret = fread(frame.get(), 1, frame_size, file_handle.file);
+  if (ret != frame_size) {
+    LOG_ERROR("Error occured in fread ");
+    return false;
+  }
+
+  CopySerializeInput frame_input(frame.get(), frame_size);
+  frame_input.ReadInt();
+  size_t uncompressed_size = static_cast<size_t>(frame_input.ReadInt());
+
+  block.resize(uncompressed_size);
+  return LogCompressor::Decompress(frame.get() + 2 * sizeof(int32_t),
+                                   frame_size - 2 * sizeof(int32_t),
+                                   block.data(), uncompressed_size);
+}
+
 void LoggingUtil::SkipTupleRecordBody(FileHandle &file_handle) {
   // Check if the frame is broken
   size_t body_size = GetNextFrameSize(file_handle);
@@ -24,9 +24,21 @@ namespace logging {
  * @return true if we serialize data otherwise false
  */
 bool TransactionRecord::Serialize(CopySerializeOutput &output) {
-  bool status = true;
   output.Reset();
+  bool status = SerializeTo(output);
 
+  message_length = output.Size();
+  message = new char[message_length];
+  PL_MEMCPY(message, output.Data(), message_length);
+
+  return status;
+}
+
+/**
+ * @brief Serialize the record at the current position of the output
+ * @return true if we serialize data otherwise false
+ */
+bool TransactionRecord::SerializeTo(SerializeOutput &output) {
   // First, write out the log record type
   output.WriteEnumInSingleByte(log_record_type);
 
@@ -40,11 +52,12 @@ bool TransactionRecord::Serialize(CopySerializeOutput &output) {
       static_cast<int32_t>(output.Position() - start - sizeof(int32_t));
   output.WriteIntAt(start, header_length);
 
-  message_length = output.Size();
-  message = new char[message_length];
-  PL_MEMCPY(message, output.Data(), message_length);
+  return true;
+}
 
-  return status;
+size_t TransactionRecord::GetSerializedLength() const {
+  // log_record_type + header_length + cid
+  return sizeof(char) + sizeof(int32_t) + sizeof(int64_t);
 }
 
 /**
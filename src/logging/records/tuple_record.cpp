@@ -24,8 +24,22 @@ namespace logging {
  * @return true if we serialize data otherwise false
  */
 bool TupleRecord::Serialize(CopySerializeOutput &output) {
-  bool status = true;
   output.Reset();
+  bool status = SerializeTo(output);
+
+  message_length = output.Size();
+  message = new char[message_length];
+  PL_MEMCPY(message, output.Data(), message_length);
+
+  return status;
+}
+
+/**
+ * @brief Serialize the record at the current position of the output
+ * @return true if we serialize data otherwise false
+ */
+bool TupleRecord::SerializeTo(SerializeOutput &output) {
+  bool status = true;
 
   // Serialize the common variables such as database oid, table oid, etc.
   SerializeHeader(output);
@@ -39,6 +53,20 @@ bool TupleRecord::Serialize(CopySerializeOutput &output) {
       break;
     }
 
+    case LOGRECORD_TYPE_WAL_TUPLE_PARTIAL_UPDATE: {
+      // Only write out the (column id, value) pairs that were modified
+      storage::Tuple *tuple = (storage::Tuple *)data;
+      size_t start = output.ReserveBytes(sizeof(int32_t));
+      output.WriteInt(static_cast<int32_t>(modified_columns.size()));
+      for (auto column_id : modified_columns) {
+        output.WriteInt(static_cast<int32_t>(column_id));
+        tuple->GetValue(column_id).SerializeTo(output);
+      }
+      output.WriteIntAt(start, static_cast<int32_t>(output.Position() - start -
+                                                    sizeof(int32_t)));
+      break;
+    }
+
     case LOGRECORD_TYPE_WAL_TUPLE_DELETE:
       // Nothing to do here !
       break;
@@ -56,18 +84,68 @@ bool TupleRecord::Serialize(CopySerializeOutput &output) {
     }
   }
 
-  message_length = output.Size();
-  message = new char[message_length];
-  PL_MEMCPY(message, output.Data(), message_length);
-
   return status;
 }
 
+/**
+ * @brief Serialized length of a value, as written by Value::SerializeTo
+ */
+static size_t GetSerializedValueLength(const type::Value &value) {
+  auto type_id = value.GetTypeId();
+  if (type_id != type::Type::VARCHAR && type_id != type::Type::VARBINARY) {
+    return type::Type::GetTypeSize(type_id);
+  }
+
+  uint32_t length = value.GetLength();
+  if (length == 0 || length >= type::PELOTON_VALUE_NULL) {
+    return sizeof(int32_t);
+  }
+  return sizeof(int32_t) + length;
+}
+
+/**
+ * @brief Number of bytes SerializeTo writes, so that the record can be
+ * written straight into a reserved region of a log buffer
+ */
+size_t TupleRecord::GetSerializedLength() const {
+  // log_record_type + header_length + db_oid + table_oid + cid +
+  // insert_location + delete_location
+  size_t length = sizeof(char) + sizeof(int32_t) + 7 * sizeof(int64_t);
+
+  switch (GetType()) {
+    case LOGRECORD_TYPE_WAL_TUPLE_INSERT:
+    case LOGRECORD_TYPE_WAL_TUPLE_UPDATE: {
+      storage::Tuple *tuple = (storage::Tuple *)data;
+      length += sizeof(int32_t);
+      oid_t column_count = tuple->GetColumnCount();
+      for (oid_t column_id = 0; column_id < column_count; column_id++) {
+        length += GetSerializedValueLength(tuple->GetValue(column_id));
+      }
+      break;
+    }
+
+    case LOGRECORD_TYPE_WAL_TUPLE_PARTIAL_UPDATE: {
+      storage::Tuple *tuple = (storage::Tuple *)data;
+      length += 2 * sizeof(int32_t);
+      for (auto column_id : modified_columns) {
+        length += sizeof(int32_t) +
+                  GetSerializedValueLength(tuple->GetValue(column_id));
+      }
+      break;
+    }
+
+    default:
+      break;
+  }
+
+  return length;
+}
+
 /**
  * @brief Serialize LogRecordHeader
  * @param output
  */
-void TupleRecord::SerializeHeader(CopySerializeOutput &output) {
+void TupleRecord::SerializeHeader(SerializeOutput &output) {
   // Record LogRecordType first
   output.WriteEnumInSingleByte(log_record_type);
 
@@ -32,6 +32,9 @@ void RunBenchmark() {
   if (state.multi_stage) {
     // Run holistic indexing comparison benchmark
     RunMultiStageBenchmark();
+  } else if (state.numa_scan) {
+    // Run local versus remote NUMA node scan benchmark
+    RunNumaScanBenchmark();
   } else {
     // Run a single sdbench test
     RunSDBenchTest();
@@ -49,7 +49,8 @@ void Usage() {
       "   -w --write_ratio                    :  Fraction of writes\n"
       "   -x --index_count_threshold          :  Index count threshold\n"
       "   -y --index_utility_threshold        :  Index utility threshold\n"
-      "   -z --write_ratio_threshold          :  Write ratio threshold\n");
+      "   -z --write_ratio_threshold          :  Write ratio threshold\n"
+      "   -N --numa_scan                      :  Run NUMA scan experiment\n");
 
   exit(EXIT_FAILURE);
 }
@@ -79,6 +80,7 @@ static struct option opts[] = {
     {"write_ratio_threshold", optional_argument, NULL, 'z'},
     {"multi_stage", optional_argument, NULL, 'n'},
     {"holistic_indexing", optional_argument, NULL, 'r'},
+    {"numa_scan", optional_argument, NULL, 'N'},
     {NULL, 0, NULL, 0}};
 
 void GenerateSequence(oid_t column_count) {
@@ -373,6 +375,10 @@ static void ValidateHolisticIndexing(const configuration &state) {
   LOG_INFO("holistic_indexing : %d", state.holistic_indexing);
 }
 
+static void ValidateNumaScan(const configuration &state) {
+  LOG_INFO("numa_scan : %d", state.numa_scan);
+}
+
 void ParseArguments(int argc, char *argv[], configuration &state) {
   state.verbose = false;
 
@@ -419,18 +425,19 @@ void ParseArguments(int argc, char *argv[], configuration &state) {
   state.multi_stage = false;
   state.holistic_indexing = false;
   state.multi_stage_idx = 0;
+  state.numa_scan = false;
 
   // Parse args
   while (1) {
     int idx = 0;
     int c = getopt_long(argc, argv,
-                        "a:b:c:d:e:f:g:hi:j:k:l:m:n:o:p:q:r:s:t:u:v:w:x:y:z:",
+                        "a:b:c:d:e:f:g:hi:j:k:l:m:n:o:p:q:r:s:t:u:v:w:x:y:z:N:",
                         opts, &idx);
 
     if (c == -1) break;
 
     switch (c) {
-      // AVAILABLE FLAGS: rABCDEFGHIJKLMNOPQRSTUVWXYZ
+      // AVAILABLE FLAGS: ABCDEFGHIJKLMOPQRSTUVWXYZ
       case 'a':
         state.attribute_count = atoi(optarg);
         break;
@@ -509,6 +516,9 @@ void ParseArguments(int argc, char *argv[], configuration &state) {
       case 'z':
         state.write_ratio_threshold = atof(optarg);
         break;
+      case 'N':
+        state.numa_scan = atoi(optarg);
+        break;
 
       default:
         LOG_ERROR("Unknown option: -%c-", c);
@@ -558,6 +568,7 @@ void ParseArguments(int argc, char *argv[], configuration &state) {
   ValidateVariabilityThreshold(state);
   ValidateMultiStage(state);
   ValidateHolisticIndexing(state);
+  ValidateNumaScan(state);
 }
 
 }  // namespace sdbench
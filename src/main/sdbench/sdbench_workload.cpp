@@ -31,9 +31,11 @@
 #include "catalog/schema.h"
 #include "common/logger.h"
 #include "common/macros.h"
+#include "common/numa_util.h"
 #include "common/timer.h"
 #include "concurrency/transaction.h"
 #include "concurrency/transaction_manager_factory.h"
+#include "configuration/configuration.h"
 #include "type/types.h"
 #include "type/value.h"
 #include "type/value_factory.h"
@@ -1537,6 +1539,98 @@ void RunSDBenchTest() {
   BenchmarkCleanUp();
 }
 
+struct NumaScanResult {
+  size_t local_tuple_count = 0;
+  double local_duration = 0;
+
+  size_t remote_tuple_count = 0;
+  double remote_duration = 0;
+
+  // keeps the scanned values live
+  int64_t checksum = 0;
+};
+
+/**
+ * @brief Scan all columns of the table from a thread on the given NUMA node,
+ * timing the tile groups placed on that node apart from the others.
+ */
+static void NumaScanHelper(int numa_node, NumaScanResult *result) {
+  NumaUtil::PinCurrentThread(numa_node);
+
+  bool single_node = (NumaUtil::GetNodeCount() == 1);
+  oid_t column_count = sdbench_table->GetSchema()->GetColumnCount();
+  size_t tile_group_count = sdbench_table->GetTileGroupCount();
+  Timer<> local_timer, remote_timer;
+
+  for (size_t tile_group_itr = 0; tile_group_itr < tile_group_count;
+       tile_group_itr++) {
+    auto tile_group = sdbench_table->GetTileGroup(tile_group_itr);
+    oid_t tuple_count = tile_group->GetNextTupleSlot();
+    bool is_local = single_node || tile_group->GetNumaNode() == numa_node;
+    auto &timer = is_local ? local_timer : remote_timer;
+
+    timer.Start();
+    for (oid_t column_itr = 0; column_itr < column_count; column_itr++) {
+      auto &accessor = tile_group->GetColumnAccessor(column_itr);
+      for (oid_t tuple_itr = 0; tuple_itr < tuple_count; tuple_itr++) {
+        result->checksum += accessor.Get<int32_t>(tuple_itr);
+      }
+    }
+    timer.Stop();
+
+    if (is_local) {
+      result->local_tuple_count += tuple_count;
+    } else {
+      result->remote_tuple_count += tuple_count;
+    }
+  }
+
+  result->local_duration = local_timer.GetDuration();
+  result->remote_duration = remote_timer.GetDuration();
+}
+
+/**
+ * @brief Scan the table from every NUMA node in turn, and report the scan
+ * throughput of the tile groups local to the node and of the remote ones.
+ */
+void RunNumaScanBenchmark() {
+  // The table is loaded into tile groups placed on the nodes
+  FLAGS_numa_placement = true;
+  BenchmarkPrepare();
+
+  int node_count = NumaUtil::GetNodeCount();
+  for (int numa_node = 0; numa_node < node_count; numa_node++) {
+    // One node at a time, so that the scans do not share memory bandwidth
+    NumaScanResult result;
+    std::thread scanner(NumaScanHelper, numa_node, &result);
+    scanner.join();
+
+    double local_throughput = 0, remote_throughput = 0;
+    if (result.local_duration > 0) {
+      local_throughput = result.local_tuple_count / result.local_duration;
+    }
+    if (result.remote_duration > 0) {
+      remote_throughput = result.remote_tuple_count / result.remote_duration;
+    }
+
+    LOG_INFO("Node %d :: local %lu tuples %.0lf tuples/s :: "
+             "remote %lu tuples %.0lf tuples/s",
+             numa_node, result.local_tuple_count, local_throughput,
+             result.remote_tuple_count, remote_throughput);
+    LOG_TRACE("Checksum : %ld", result.checksum);
+
+    out << numa_node << " ";
+    out << result.local_tuple_count << " ";
+    out << std::fixed << std::setprecision(2) << local_throughput << " ";
+    out << result.remote_tuple_count << " ";
+    out << std::fixed << std::setprecision(2) << remote_throughput << "\n";
+  }
+
+  out.flush();
+
+  BenchmarkCleanUp();
+}
+
 }  // namespace sdbench
 }  // namespace benchmark
 }  // namespace peloton
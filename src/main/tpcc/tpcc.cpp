@@ -21,6 +21,7 @@
 #include "benchmark/tpcc/tpcc_workload.h"
 
 #include "gc/gc_manager_factory.h"
+#include "configuration/configuration.h"
 
 namespace peloton {
 namespace benchmark {
@@ -31,6 +32,8 @@ configuration state;
 // Main Entry Point
 void RunBenchmark() {
 
+  FLAGS_lock_wait_timeout = state.lock_wait_timeout;
+
   if (state.gc_mode == true) {
     gc::GCManagerFactory::Configure(state.gc_backend_count);
   }
@@ -36,6 +36,7 @@ void Usage(FILE *out) {
           "   -a --affinity          :  enable client affinity \n"
           "   -g --gc_mode           :  enable garbage collection \n"
           "   -n --gc_backend_count  :  # of gc backends \n"
+          "   -l --lock_wait_timeout :  lock wait timeout in us, 0 to abort \n"
   );
 }
 
@@ -50,6 +51,7 @@ static struct option opts[] = {
     { "affinity", no_argument, NULL, 'a' },
     { "gc_mode", no_argument, NULL, 'g' },
     { "gc_backend_count", optional_argument, NULL, 'n' },
+    { "lock_wait_timeout", optional_argument, NULL, 'l' },
     { NULL, 0, NULL, 0 }
 };
 
@@ -114,6 +116,15 @@ void ValidateGCBackendCount(const configuration &state) {
   LOG_TRACE("%s : %d", "gc_backend_count", state.gc_backend_count);
 }
 
+void ValidateLockWaitTimeout(const configuration &state) {
+  if (state.lock_wait_timeout < 0) {
+    LOG_ERROR("Invalid lock_wait_timeout :: %d", state.lock_wait_timeout);
+    exit(EXIT_FAILURE);
+  }
+
+  LOG_TRACE("%s : %d", "lock_wait_timeout", state.lock_wait_timeout);
+}
+
 
 void ParseArguments(int argc, char *argv[], configuration &state) {
   // Default Values
@@ -127,11 +138,12 @@ void ParseArguments(int argc, char *argv[], configuration &state) {
   state.affinity = false;
   state.gc_mode = false;
   state.gc_backend_count = 1;
+  state.lock_wait_timeout = 1000;
 
   // Parse args
   while (1) {
     int idx = 0;
-    int c = getopt_long(argc, argv, "heagi:k:d:p:b:w:n:", opts, &idx);
+    int c = getopt_long(argc, argv, "heagi:k:d:p:b:w:n:l:", opts, &idx);
 
     if (c == -1) break;
 
@@ -173,6 +185,9 @@ void ParseArguments(int argc, char *argv[], configuration &state) {
       case 'n':
         state.gc_backend_count = atof(optarg);
         break;
+      case 'l':
+        state.lock_wait_timeout = atoi(optarg);
+        break;
 
       case 'h':
         Usage(stderr);
@@ -200,6 +215,7 @@ void ParseArguments(int argc, char *argv[], configuration &state) {
   ValidateBackendCount(state);
   ValidateWarehouseCount(state);
   ValidateGCBackendCount(state);
+  ValidateLockWaitTimeout(state);
 
   LOG_TRACE("%s : %d", "Run client affinity", state.affinity);
   LOG_TRACE("%s : %d", "Run exponential backoff", state.exp_backoff);
@@ -216,6 +232,7 @@ void WriteOutput() {
     total_profile_memory += entry;
   }
 
+  // The throughput only counts committed transactions, i.e. it is the goodput
   LOG_INFO("----------------------------------------------------------");
   LOG_INFO("%lf %d %d :: %lf %lf %d",
            state.scale_factor,
@@ -19,6 +19,7 @@
 #include "benchmark/ycsb/ycsb_loader.h"
 #include "benchmark/ycsb/ycsb_workload.h"
 
+#include "concurrency/transaction_manager_factory.h"
 #include "gc/gc_manager_factory.h"
 
 namespace peloton {
@@ -29,6 +30,8 @@ configuration state;
 // Main Entry Point
 void RunBenchmark() {
 
+  concurrency::TransactionManagerFactory::Configure(state.protocol);
+
   if (state.gc_mode == true) {
     gc::GCManagerFactory::Configure(state.gc_backend_count);
   }
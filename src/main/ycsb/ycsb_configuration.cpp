@@ -40,6 +40,7 @@ void Usage(FILE *out) {
           "   -m --string_mode       :  store strings \n"
           "   -g --gc_mode           :  enable garbage collection \n"
           "   -n --gc_backend_count  :  # of gc backends \n"
+          "   -y --protocol          :  concurrency control: to (default) or occ\n"
   );
 }
 
@@ -57,6 +58,7 @@ static struct option opts[] = {
     { "string_mode", no_argument, NULL, 'm' },
     { "gc_mode", no_argument, NULL, 'g' },
     { "gc_backend_count", optional_argument, NULL, 'n' },
+    { "protocol", optional_argument, NULL, 'y' },
     { NULL, 0, NULL, 0 }
 };
 
@@ -148,6 +150,16 @@ void ValidateGCBackendCount(const configuration &state) {
   LOG_TRACE("%s : %d", "gc_backend_count", state.gc_backend_count);
 }
 
+void ValidateProtocol(const configuration &state) {
+  if (state.protocol != ConcurrencyType::TIMESTAMP_ORDERING &&
+      state.protocol != ConcurrencyType::OPTIMISTIC) {
+    LOG_ERROR("Invalid protocol");
+    exit(EXIT_FAILURE);
+  }
+
+  LOG_TRACE("%s : %d", "protocol", static_cast<int>(state.protocol));
+}
+
 void ParseArguments(int argc, char *argv[], configuration &state) {
   // Default Values
   state.index = IndexType::BWTREE;
@@ -163,11 +175,12 @@ void ParseArguments(int argc, char *argv[], configuration &state) {
   state.string_mode = false;
   state.gc_mode = false;
   state.gc_backend_count = 1;
+  state.protocol = ConcurrencyType::TIMESTAMP_ORDERING;
 
   // Parse args
   while (1) {
     int idx = 0;
-    int c = getopt_long(argc, argv, "hemgi:k:d:p:b:c:o:u:z:n:", opts, &idx);
+    int c = getopt_long(argc, argv, "hemgi:k:d:p:b:c:o:u:z:n:y:", opts, &idx);
 
     if (c == -1) break;
 
@@ -218,6 +231,18 @@ void ParseArguments(int argc, char *argv[], configuration &state) {
       case 'n':
         state.gc_backend_count = atof(optarg);
         break;
+      case 'y': {
+        char *protocol = optarg;
+        if (strcmp(protocol, "to") == 0) {
+          state.protocol = ConcurrencyType::TIMESTAMP_ORDERING;
+        } else if (strcmp(protocol, "occ") == 0) {
+          state.protocol = ConcurrencyType::OPTIMISTIC;
+        } else {
+          LOG_ERROR("Unknown protocol: %s", protocol);
+          exit(EXIT_FAILURE);
+        }
+        break;
+      }
         
       case 'h':
         Usage(stderr);
@@ -243,6 +268,7 @@ void ParseArguments(int argc, char *argv[], configuration &state) {
   ValidateUpdateRatio(state);
   ValidateZipfTheta(state);
   ValidateGCBackendCount(state);
+  ValidateProtocol(state);
 
   LOG_TRACE("%s : %d", "Run exponential backoff", state.exp_backoff);
   LOG_TRACE("%s : %d", "Run string mode", state.string_mode);
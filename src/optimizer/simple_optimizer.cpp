@@ -337,11 +337,14 @@ std::shared_ptr<planner::AbstractPlan> SimpleOptimizer::BuildPelotonPlanTree(
                 "Underlying plan has the same ordering output with"
                 "order_by plan with limit");
             order_by_plan->SetUnderlyingOrder(true);
-            order_by_plan->SetLimit(true);
-            order_by_plan->SetLimitNumber(select_stmt->limit->limit);
-            order_by_plan->SetLimitOffset(offset);
           }
 
+          // The order_by plan only needs to produce the tuples the limit
+          // returns
+          order_by_plan->SetLimit(true);
+          order_by_plan->SetLimitNumber(select_stmt->limit->limit);
+          order_by_plan->SetLimitOffset(offset);
+
           order_by_plan->AddChild(std::move(child_SelectPlan));
 
           // Create limit_plan
@@ -773,6 +776,20 @@ std::shared_ptr<planner::AbstractPlan> SimpleOptimizer::BuildPelotonPlanTree(
 std::unique_ptr<planner::AbstractPlan> SimpleOptimizer::CreateCopyPlan(
     parser::CopyStatement* copy_stmt) {
   std::string table_name(copy_stmt->cpy_table->GetTableName());
+
+  // Imports append to the target table directly and need no child plan
+  if (copy_stmt->type == CopyType::IMPORT_CSV ||
+      copy_stmt->type == CopyType::IMPORT_TSV ||
+      copy_stmt->type == CopyType::IMPORT_BINARY) {
+    auto target_table = catalog::Catalog::GetInstance()->GetTableWithName(
+        copy_stmt->cpy_table->GetDatabaseName(), table_name);
+    std::unique_ptr<planner::AbstractPlan> copy_plan(new planner::CopyPlan(
+        target_table, copy_stmt->file_path, copy_stmt->type,
+        copy_stmt->delimiter));
+    LOG_DEBUG("Import copy plan created");
+    return copy_plan;
+  }
+
   bool deserialize_parameters = false;
 
   // If we're copying the query metric table, then we need to handle the
@@ -782,8 +799,10 @@ std::unique_ptr<planner::AbstractPlan> SimpleOptimizer::CreateCopyPlan(
     deserialize_parameters = true;
   }
 
-  std::unique_ptr<planner::AbstractPlan> copy_plan(
+  std::unique_ptr<planner::CopyPlan> copy_plan(
       new planner::CopyPlan(copy_stmt->file_path, deserialize_parameters));
+  copy_plan->copy_type = copy_stmt->type;
+  copy_plan->delimiter = copy_stmt->delimiter;
 
   // Next, generate a dummy select * plan for target table
   // Hard code star expression
@@ -804,6 +823,9 @@ std::unique_ptr<planner::AbstractPlan> SimpleOptimizer::CreateCopyPlan(
   auto target_table = catalog::Catalog::GetInstance()->GetTableWithName(
       select_stmt->from_table->GetDatabaseName(), table_name);
 
+  // Parallel and binary exports scan the tile groups of the table directly
+  copy_plan->target_table = target_table;
+
   std::vector<oid_t> column_ids;
   bool needs_projection = false;
   expression::ExpressionUtil::TransformExpression(
@@ -1050,6 +1072,8 @@ void SimpleOptimizer::GetPredicateColumns(
 }
 
 static std::unique_ptr<const planner::ProjectInfo> CreateHackProjection();
+static void MergeJoinTupleIndexes(expression::AbstractExpression* expr,
+                                  oid_t left_column_count);
 static std::shared_ptr<const peloton::catalog::Schema> CreateHackJoinSchema();
 
 std::unique_ptr<planner::AbstractPlan>
@@ -1232,6 +1256,24 @@ SimpleOptimizer::CreateHackingNestedLoopJoinPlan(
   return std::move(agg_plan);
 }
 
+// Rewrite the columns of the right join input (tuple 1) as columns of the
+// join output (tuple 0), where they follow the left columns.
+void MergeJoinTupleIndexes(expression::AbstractExpression* expr,
+                           oid_t left_column_count) {
+  if (expr == nullptr) return;
+  if (expr->GetExpressionType() == ExpressionType::VALUE_TUPLE) {
+    auto tup_expr = (expression::TupleValueExpression*)expr;
+    if (tup_expr->GetTupleId() == 1) {
+      tup_expr->SetTupleValueExpressionParams(
+          tup_expr->GetValueType(),
+          tup_expr->GetColumnId() + left_column_count, 0);
+    }
+  }
+  for (size_t i = 0; i < expr->GetChildrenSize(); i++) {
+    MergeJoinTupleIndexes(expr->GetModifiableChild(i), left_column_count);
+  }
+}
+
 std::unique_ptr<const planner::ProjectInfo> CreateHackProjection() {
   // Create the plan node
   TargetList target_list;
@@ -1375,26 +1417,69 @@ std::unique_ptr<planner::AbstractPlan> SimpleOptimizer::CreateJoinPlan(
     }
   }
 
-  std::shared_ptr<const peloton::catalog::Schema> schema(
-      new catalog::Schema(output_table_columns));
-  std::unique_ptr<planner::ProjectInfo> proj_info(
-      new planner::ProjectInfo(std::move(tl), std::move(dml)));
-  LOG_DEBUG("Index scan column size: %ld\n", output_table_columns.size());
-  LOG_DEBUG("Schema info: %s", schema->GetInfo().c_str());
   // // Create hash join plan node.
   std::unique_ptr<const peloton::expression::AbstractExpression> predicates =
       nullptr;
   if (select_stmt->where_clause != nullptr)
     predicates = std::unique_ptr<const peloton::expression::AbstractExpression>(
         select_stmt->where_clause->Copy());
-  std::unique_ptr<planner::HashJoinPlan> hash_join_plan_node(
-      new planner::HashJoinPlan(join_type, std::move(predicates),
-                                std::move(proj_info), schema));
-  // index only works on comparison with a constant
 
+  // With only column references, the join output is built from the position
+  // lists of its inputs and nothing is materialized.
+  if (tl.size() == 0) {
+    std::shared_ptr<const peloton::catalog::Schema> schema(
+        new catalog::Schema(output_table_columns));
+    std::unique_ptr<planner::ProjectInfo> proj_info(
+        new planner::ProjectInfo(std::move(tl), std::move(dml)));
+    LOG_DEBUG("Index scan column size: %ld\n", output_table_columns.size());
+    LOG_DEBUG("Schema info: %s", schema->GetInfo().c_str());
+    std::unique_ptr<planner::HashJoinPlan> hash_join_plan_node(
+        new planner::HashJoinPlan(join_type, std::move(predicates),
+                                  std::move(proj_info), schema));
+    // index only works on comparison with a constant
+
+    hash_join_plan_node->AddChild(std::move(left_SelectPlan));
+    hash_join_plan_node->AddChild(std::move(hash_plan_node));
+    return hash_join_plan_node;
+  }
+
+  // Otherwise the join passes on all columns of both inputs, still as
+  // position lists, and a projection above it is the only operator reading
+  // column data. Its input is a single tuple, so the right columns follow
+  // the left ones.
+  oid_t left_column_count = left_schema->GetColumnCount();
+  std::vector<catalog::Column> join_columns = left_schema->GetColumns();
+  join_columns.insert(join_columns.end(), right_schema->GetColumns().begin(),
+                      right_schema->GetColumns().end());
+  std::shared_ptr<const peloton::catalog::Schema> join_schema(
+      new catalog::Schema(join_columns));
+  std::unique_ptr<planner::HashJoinPlan> hash_join_plan_node(
+      new planner::HashJoinPlan(join_type, std::move(predicates), nullptr,
+                                join_schema));
   hash_join_plan_node->AddChild(std::move(left_SelectPlan));
   hash_join_plan_node->AddChild(std::move(hash_plan_node));
-  return std::move(hash_join_plan_node);
+
+  for (auto& direct_map : dml) {
+    if (direct_map.second.first == 1) {
+      direct_map.second.second += left_column_count;
+    }
+    direct_map.second.first = 0;
+  }
+  for (auto& target : tl) {
+    MergeJoinTupleIndexes(
+        const_cast<expression::AbstractExpression*>(target.second),
+        left_column_count);
+  }
+
+  std::shared_ptr<const peloton::catalog::Schema> schema(
+      new catalog::Schema(output_table_columns));
+  LOG_DEBUG("Schema info: %s", schema->GetInfo().c_str());
+  std::unique_ptr<planner::ProjectInfo> proj_info(
+      new planner::ProjectInfo(std::move(tl), std::move(dml)));
+  std::unique_ptr<planner::AbstractPlan> projection_plan_node(
+      new planner::ProjectionPlan(std::move(proj_info), schema));
+  projection_plan_node->AddChild(std::move(hash_join_plan_node));
+  return projection_plan_node;
 }
 
 void SimpleOptimizer::SetIndexScanFlag(planner::AbstractPlan* select_plan,
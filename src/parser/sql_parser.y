@@ -190,13 +190,13 @@ struct PARSER_CUST_LTYPE {
 %token <uval> NOTEQUALS LESSEQ GREATEREQ
 
 /* SQL Keywords */
-%token TRANSACTION
+%token TRANSACTION READ ONLY
 %token REFERENCES DEALLOCATE PARAMETERS INTERSECT TEMPORARY TIMESTAMP
 %token VARBINARY ROLLBACK DISTINCT NVARCHAR RESTRICT TRUNCATE ANALYZE BETWEEN BOOLEAN ADDRESS
 %token DATABASE SMALLINT VARCHAR FOREIGN TINYINT CASCADE COLUMNS CONTROL DEFAULT EXECUTE EXPLAIN EXTRACT
 %token INTEGER NATURAL PREPARE PRIMARY SCHEMAS DECIMAL
 %token SPATIAL VIRTUAL BEFORE COLUMN CREATE DELETE DIRECT 
-%token BIGINT DOUBLE ESCAPE EXCEPT EXISTS GLOBAL HAVING
+%token BIGINT BINARY DOUBLE ESCAPE EXCEPT EXISTS GLOBAL HAVING
 %token INSERT ISNULL OFFSET RENAME SCHEMA SELECT SORTED
 %token COMMIT TABLES UNIQUE UNLOAD UPDATE VALUES AFTER ALTER CROSS STATS
 %token FLOAT BEGIN DELTA GROUP INDEX INNER LIMIT LOCAL MERGE MINUS ORDER COUNT
@@ -206,6 +206,7 @@ struct PARSER_CUST_LTYPE {
 %token AND ASC CSV FOR INT KEY NOT OFF SET TOP SUM MIN MAX AVG AS BY IF
 %token IN IS OF ON OR TO
 %token COPY DELIMITER
+%token PARTITION PARTITIONS RANGE
 
 /*********************************
  ** Non-Terminal types (http://www.gnu.org/software/bison/manual/html_node/Type-Decl.html)
@@ -223,7 +224,7 @@ struct PARSER_CUST_LTYPE {
 %type <txn_stmt>    transaction_statement
 %type <copy_stmt>   copy_statement
 %type <sval> 		opt_alias alias
-%type <bval> 		opt_not_exists opt_exists opt_distinct opt_notnull opt_primary opt_unique opt_update
+%type <bval> 		opt_not_exists opt_exists opt_distinct opt_notnull opt_primary opt_unique opt_update opt_read_only
 %type <uval>		opt_join_type column_type opt_column_width opt_index_type
 %type <table> 		from_clause table_ref table_ref_atomic table_ref_name
 %type <table>		join_clause join_table table_ref_name_no_alias
@@ -343,6 +344,8 @@ execute_statement:
 /******************************
  * Create Statement
  * CREATE TABLE students (name TEXT, student_number INTEGER, city TEXT, grade DOUBLE)
+ * CREATE TABLE events (ts INTEGER, id INTEGER) PARTITION BY RANGE (ts) VALUES (100, 200)
+ * CREATE TABLE events (ts INTEGER, id INTEGER) PARTITION BY HASH (id) PARTITIONS 4
  * CREATE INDEX i_security ON security (s_co_id, s_issue)
  * CREATE DATABASE my_db
  ******************************/
@@ -353,6 +356,25 @@ create_statement:
 			$$->table_info_ = $4;
 			$$->columns = $6;
 		}
+		|	CREATE TABLE opt_not_exists table_name '(' column_def_commalist ')' PARTITION BY RANGE '(' IDENTIFIER ')' VALUES '(' literal_list ')' {
+			$$ = new CreateStatement(CreateStatement::kTable);
+			$$->if_not_exists = $3;
+			$$->table_info_ = $4;
+			$$->columns = $6;
+			$$->partition_type = peloton::PartitionType::RANGE;
+			$$->partition_column = $12;
+			$$->partition_bounds = $16;
+		}
+		|	CREATE TABLE opt_not_exists table_name '(' column_def_commalist ')' PARTITION BY HASH '(' IDENTIFIER ')' PARTITIONS int_literal {
+			$$ = new CreateStatement(CreateStatement::kTable);
+			$$->if_not_exists = $3;
+			$$->table_info_ = $4;
+			$$->columns = $6;
+			$$->partition_type = peloton::PartitionType::HASH;
+			$$->partition_column = $12;
+			$$->partition_count = $15->ival_;
+			delete $15;
+		}
 		|	CREATE DATABASE opt_not_exists IDENTIFIER {
 			$$ = new CreateStatement(CreateStatement::kDatabase);
 			$$->if_not_exists = $3;
@@ -496,14 +518,15 @@ opt_exists:
 
 /******************************
  * Transaction Statement
- * BEGIN [ TRANSACTION ]
+ * BEGIN [ TRANSACTION ] [ READ ONLY ]
  * COMMIT [ TRANSACTION ]
  * ROLLBACK [ TRANSACTION ]
  ******************************/
 
 transaction_statement:
-	BEGIN opt_transaction { 
+	BEGIN opt_transaction opt_read_only { 
 		$$ = new TransactionStatement(TransactionStatement::kBegin);
+		$$->read_only = $3;
 	}
 	| COMMIT opt_transaction {
 		$$ = new TransactionStatement(TransactionStatement::kCommit);
@@ -517,6 +540,11 @@ opt_transaction:
 	| TRANSACTION
 	;
 
+opt_read_only:
+		READ ONLY { $$ = true; }
+	|	/* empty */ { $$ = false; }
+	;
+
 /******************************
  * Delete Statement / Truncate statement
  * DELETE FROM students WHERE grade > 3.0
@@ -948,6 +976,9 @@ join_condition:
 /******************************
  * Copy Statement
  * COPY catalog_db.query_metric TO '/home/user/query_metric.csv' DELIMITER ','
+ * COPY foo FROM '/home/user/foo.csv' DELIMITER ','
+ * COPY foo FROM '/home/user/foo.dat' WITH BINARY
+ * COPY foo TO '/home/user/foo.dat' WITH BINARY
  * TODO: Nested query like below is not supported yet
  * COPY (SELECT id FROM A WHERE val = 1) TO '/path/file.csv' DELIMITER ';'
  ******************************/
@@ -962,6 +993,26 @@ copy_statement:
 			$$->delimiter = *($6);
 			delete $6;
 		}
+	|	COPY table_ref_name TO STRING WITH BINARY {
+			$$ = new CopyStatement(peloton::CopyType::EXPORT_BINARY);
+			$$->cpy_table = $2;
+			$$->file_path = $4;
+		}
+	|	COPY table_ref_name FROM STRING DELIMITER STRING {
+			// A tab delimiter can be given as the escape sequence
+			char delimiter = (strcmp($6, "\\t") == 0) ? '\t' : *($6);
+			$$ = new CopyStatement(delimiter == '\t' ?
+				peloton::CopyType::IMPORT_TSV : peloton::CopyType::IMPORT_CSV);
+			$$->cpy_table = $2;
+			$$->file_path = $4;
+			$$->delimiter = delimiter;
+			delete $6;
+		}
+	|	COPY table_ref_name FROM STRING WITH BINARY {
+			$$ = new CopyStatement(peloton::CopyType::IMPORT_BINARY);
+			$$->cpy_table = $2;
+			$$->file_path = $4;
+		}
 	;
 
 
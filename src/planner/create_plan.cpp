@@ -16,6 +16,8 @@
 #include "storage/data_table.h"
 #include "catalog/schema.h"
 #include "catalog/column.h"
+#include "catalog/partition_scheme.h"
+#include "common/exception.h"
 
 namespace peloton {
 namespace planner {
@@ -67,8 +69,11 @@ CreatePlan::CreatePlan(parser::CreateStatement *parse_tree) {
       column_contraints.clear();
       columns.push_back(column);
     }
-    catalog::Schema *schema = new catalog::Schema(columns);
-    table_schema = schema;
+    std::unique_ptr<catalog::Schema> schema(new catalog::Schema(columns));
+    if (parse_tree->partition_type != PartitionType::INVALID) {
+      schema->SetPartitionScheme(GetPartitionScheme(parse_tree, schema.get()));
+    }
+    table_schema = schema.release();
   }
   if (parse_tree->type == parse_tree->CreateType::kIndex) {
     create_type = CreateType::INDEX;
@@ -95,5 +100,30 @@ CreatePlan::CreatePlan(parser::CreateStatement *parse_tree) {
   // TODO check type CreateType::kDatabase
 }
 
+std::shared_ptr<const catalog::PartitionScheme> CreatePlan::GetPartitionScheme(
+    parser::CreateStatement *parse_tree, const catalog::Schema *schema) {
+  std::string column_name(parse_tree->partition_column);
+  oid_t column_id = schema->GetColumnID(column_name);
+  if (column_id == INVALID_OID) {
+    throw PlannerException("Partition column \"" + column_name +
+                           "\" does not exist");
+  }
+  auto column_type = schema->GetType(column_id);
+
+  if (parse_tree->partition_type == PartitionType::HASH) {
+    if (parse_tree->partition_count <= 0) {
+      throw PlannerException("Hash partitioning needs at least one partition");
+    }
+    return catalog::PartitionScheme::CreateHash(
+        column_id, column_type, parse_tree->partition_count);
+  }
+
+  std::vector<type::Value> bounds;
+  for (auto bound : *parse_tree->partition_bounds) {
+    bounds.push_back(bound->Evaluate(nullptr, nullptr, nullptr));
+  }
+  return catalog::PartitionScheme::CreateRange(column_id, column_type, bounds);
+}
+
 }  // namespace planner
 }  // namespace peloton
@@ -11,6 +11,7 @@
 //===----------------------------------------------------------------------===//
 
 #include "planner/project_info.h"
+#include "common/container_tuple.h"
 
 #include "executor/executor_context.h"
 #include "expression/constant_value_expression.h"
@@ -111,6 +112,39 @@ bool ProjectInfo::Evaluate(AbstractTuple *dest, const AbstractTuple *tuple1,
   return true;
 }
 
+bool ProjectInfo::Evaluate(
+    expression::ContainerTuple<storage::TileGroup> *dest,
+    const expression::ContainerTuple<storage::TileGroup> *tuple1,
+    const AbstractTuple *tuple2, executor::ExecutorContext *econtext) const {
+  // (A) Execute target list
+  for (auto target : target_list_) {
+    auto col_id = target.first;
+    auto expr = target.second;
+    auto value = expr->Evaluate(tuple1, tuple2, econtext);
+    dest->SetValue(col_id, value);
+  }
+
+  // (B) Execute direct map
+  bool in_place = dest->GetContainer() == tuple1->GetContainer() &&
+                  dest->GetTupleId() == tuple1->GetTupleId();
+  for (auto dm : direct_map_list_) {
+    auto dest_col_id = dm.first;
+    // whether left tuple or right tuple ?
+    auto tuple_index = dm.second.first;
+    auto src_col_id = dm.second.second;
+
+    if (tuple_index == 0) {
+      // An in-place update leaves the unchanged columns alone
+      if (in_place && dest_col_id == src_col_id) continue;
+      dest->CopyValue(dest_col_id, *tuple1, src_col_id);
+    } else {
+      type::Value val2 = (tuple2->GetValue(src_col_id));
+      dest->SetValue(dest_col_id, val2);
+    }
+  }
+
+  return true;
+}
 
 std::string ProjectInfo::Debug() const {
   std::ostringstream buffer;
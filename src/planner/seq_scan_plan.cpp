@@ -15,10 +15,12 @@
 #include "../include/parser/select_statement.h"
 #include "catalog/catalog.h"
 #include "catalog/manager.h"
+#include "catalog/partition_scheme.h"
 #include "catalog/schema.h"
 #include "common/logger.h"
 #include "common/macros.h"
 #include "expression/expression_util.h"
+#include "expression/tuple_value_expression.h"
 #include "storage/data_table.h"
 #include "type/types.h"
 
@@ -259,5 +261,59 @@ void SeqScanPlan::SetParameterValues(std::vector<type::Value> *values) {
   }
 }
 
+//===--------------------------------------------------------------------===//
+// Partition Pruning
+//===--------------------------------------------------------------------===//
+
+std::vector<bool> SeqScanPlan::GetScannedPartitions(
+    executor::ExecutorContext *executor_context) const {
+  auto &partition_scheme = GetTable()->GetPartitionScheme();
+  PL_ASSERT(partition_scheme != nullptr);
+  return GetScannedPartitions(*partition_scheme, GetPredicate(),
+                              executor_context);
+}
+
+std::vector<bool> SeqScanPlan::GetScannedPartitions(
+    const catalog::PartitionScheme &partition_scheme,
+    const expression::AbstractExpression *expr,
+    executor::ExecutorContext *executor_context) {
+  std::vector<bool> partitions(partition_scheme.GetPartitionCount(), true);
+  if (expr == nullptr) {
+    return partitions;
+  }
+
+  auto expr_type = expr->GetExpressionType();
+  if (expr_type == ExpressionType::CONJUNCTION_AND ||
+      expr_type == ExpressionType::CONJUNCTION_OR) {
+    auto left = GetScannedPartitions(partition_scheme, expr->GetChild(0),
+                                     executor_context);
+    auto right = GetScannedPartitions(partition_scheme, expr->GetChild(1),
+                                      executor_context);
+    for (size_t partition_itr = 0; partition_itr < partitions.size();
+         partition_itr++) {
+      partitions[partition_itr] =
+          (expr_type == ExpressionType::CONJUNCTION_AND)
+              ? (left[partition_itr] && right[partition_itr])
+              : (left[partition_itr] || right[partition_itr]);
+    }
+    return partitions;
+  }
+
+  // Comparisons of the partition column with a constant or a parameter
+  const expression::TupleValueExpression *column = nullptr;
+  const expression::AbstractExpression *operand = nullptr;
+  ExpressionType comparison;
+  if (expression::ExpressionUtil::NormalizeColumnComparison(
+          expr, executor_context != nullptr, column, operand, comparison) ==
+          false ||
+      column->GetColumnId() !=
+          static_cast<int>(partition_scheme.GetColumnId())) {
+    return partitions;
+  }
+
+  auto value = operand->Evaluate(nullptr, nullptr, executor_context);
+  return partition_scheme.GetPartitions(comparison, value);
+}
+
 }  // namespace planner
 }  // namespace peloton
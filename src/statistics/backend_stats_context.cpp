@@ -47,7 +47,8 @@ BackendStatsContext* BackendStatsContext::GetInstance() {
 
 BackendStatsContext::BackendStatsContext(size_t max_latency_history,
                                          bool regiser_to_aggregator)
-    : txn_latencies_(LATENCY_METRIC, max_latency_history) {
+    : txn_latencies_(LATENCY_METRIC, max_latency_history),
+      log_metric_(LOG_METRIC) {
   std::thread::id this_id = std::this_thread::get_id();
   thread_id_ = this_id;
 
@@ -107,6 +108,8 @@ LatencyMetric& BackendStatsContext::GetTxnLatencyMetric() {
   return txn_latencies_;
 }
 
+LogMetric& BackendStatsContext::GetLogMetric() { return log_metric_; }
+
 void BackendStatsContext::IncrementTableReads(oid_t tile_group_id) {
   oid_t table_id =
       catalog::Manager::GetInstance().GetTileGroup(tile_group_id)->GetTableId();
@@ -233,6 +236,7 @@ void BackendStatsContext::Aggregate(BackendStatsContext& source) {
   // Aggregate all global metrics
   txn_latencies_.Aggregate(source.txn_latencies_);
   txn_latencies_.ComputeLatencies();
+  log_metric_.Aggregate(source.log_metric_);
 
   // Aggregate all per-database metrics
   for (auto& database_item : source.database_metrics_) {
@@ -267,6 +271,7 @@ void BackendStatsContext::Aggregate(BackendStatsContext& source) {
 
 void BackendStatsContext::Reset() {
   txn_latencies_.Reset();
+  log_metric_.Reset();
 
   for (auto& database_item : database_metrics_) {
     database_item.second->Reset();
@@ -322,6 +327,7 @@ std::string BackendStatsContext::ToString() const {
   std::stringstream ss;
 
   ss << txn_latencies_.GetInfo() << std::endl;
+  ss << log_metric_.GetInfo() << std::endl;
 
   for (auto& database_item : database_metrics_) {
     oid_t database_id = database_item.second->GetDatabaseId();
@@ -0,0 +1,87 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// latency_histogram.cpp
+//
+// Identification: src/statistics/latency_histogram.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <sstream>
+
+#include "statistics/latency_histogram.h"
+#include "common/macros.h"
+
+namespace peloton {
+namespace stats {
+
+LatencyHistogram::LatencyHistogram(MetricType type) : AbstractMetric(type) {
+  Reset();
+}
+
+double LatencyHistogram::GetAverage() const {
+  uint64_t count = GetCount();
+  if (count == 0) {
+    return 0.0;
+  }
+  return static_cast<double>(sum_.load(std::memory_order_relaxed)) / count;
+}
+
+uint64_t LatencyHistogram::GetPercentile(double percentile) const {
+  uint64_t count = GetCount();
+  if (count == 0) {
+    return 0;
+  }
+
+  // Find the bucket holding the target rank and report its upper bound
+  uint64_t rank = static_cast<uint64_t>(count * percentile / 100.0);
+  rank = std::max<uint64_t>(rank, 1);
+  uint64_t seen = 0;
+  for (size_t bucket = 0; bucket < LATENCY_HISTOGRAM_BUCKET_COUNT; bucket++) {
+    seen += buckets_[bucket].load(std::memory_order_relaxed);
+    if (seen >= rank) {
+      uint64_t upper_bound = bucket == 0 ? 0 : (1ULL << bucket) - 1;
+      return std::min(upper_bound, GetMax());
+    }
+  }
+  return GetMax();
+}
+
+void LatencyHistogram::Reset() {
+  for (auto &bucket : buckets_) {
+    bucket.store(0, std::memory_order_relaxed);
+  }
+  count_.store(0, std::memory_order_relaxed);
+  sum_.store(0, std::memory_order_relaxed);
+  max_.store(0, std::memory_order_relaxed);
+}
+
+void LatencyHistogram::Aggregate(AbstractMetric &source) {
+  PL_ASSERT(source.GetType() == HISTOGRAM_METRIC);
+
+  auto &histogram = static_cast<LatencyHistogram &>(source);
+  for (size_t bucket = 0; bucket < LATENCY_HISTOGRAM_BUCKET_COUNT; bucket++) {
+    Increment(buckets_[bucket],
+              histogram.buckets_[bucket].load(std::memory_order_relaxed));
+  }
+  Increment(count_, histogram.GetCount());
+  Increment(sum_, histogram.sum_.load(std::memory_order_relaxed));
+  max_.store(std::max(GetMax(), histogram.GetMax()),
+             std::memory_order_relaxed);
+}
+
+const std::string LatencyHistogram::GetInfo() const {
+  std::stringstream ss;
+  ss << "count=" << GetCount();
+  ss << ", average=" << GetAverage();
+  ss << ", median=" << GetPercentile(50);
+  ss << ", 99th-%-tile=" << GetPercentile(99);
+  ss << ", max=" << GetMax();
+  return ss.str();
+}
+
+}  // namespace stats
+}  // namespace peloton
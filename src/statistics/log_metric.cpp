@@ -0,0 +1,66 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// log_metric.cpp
+//
+// Identification: src/statistics/log_metric.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <sstream>
+
+#include "statistics/log_metric.h"
+#include "common/macros.h"
+
+namespace peloton {
+namespace stats {
+
+LogMetric::LogMetric(MetricType type) : AbstractMetric(type) {}
+
+std::string LogMetric::GetPhaseName(LogPhaseType phase) {
+  switch (phase) {
+    case LOG_PHASE_SERIALIZATION:
+      return "serialization";
+    case LOG_PHASE_QUEUEING:
+      return "queueing";
+    case LOG_PHASE_WRITE:
+      return "write";
+    case LOG_PHASE_FSYNC:
+      return "fsync";
+    case LOG_PHASE_FLUSH_WAIT:
+      return "flush_wait";
+    default:
+      return "invalid";
+  }
+}
+
+void LogMetric::Reset() {
+  for (auto &phase_latency : phase_latencies_) {
+    phase_latency.Reset();
+  }
+}
+
+void LogMetric::Aggregate(AbstractMetric &source) {
+  PL_ASSERT(source.GetType() == LOG_METRIC);
+
+  auto &log_metric = static_cast<LogMetric &>(source);
+  for (int phase = 0; phase < LOG_PHASE_COUNT; phase++) {
+    phase_latencies_[phase].Aggregate(log_metric.phase_latencies_[phase]);
+  }
+}
+
+const std::string LogMetric::GetInfo() const {
+  std::stringstream ss;
+  ss << "LOG LATENCY (us):" << std::endl;
+  for (int phase = 0; phase < LOG_PHASE_COUNT; phase++) {
+    ss << "  " << GetPhaseName(static_cast<LogPhaseType>(phase)) << ": [ "
+       << phase_latencies_[phase].GetInfo() << " ]" << std::endl;
+  }
+  return ss.str();
+}
+
+}  // namespace stats
+}  // namespace peloton
@@ -165,6 +165,30 @@ void StatsAggregator::UpdateQueryMetrics(int64_t time_stamp, concurrency::Transa
   }
 }
 
+void StatsAggregator::UpdateLogMetrics(int64_t time_stamp, concurrency::Transaction *txn) {
+  // Get the target log metrics table
+  auto log_metrics_table = GetMetricTable(LOG_METRIC_NAME);
+
+  auto &log_metric = aggregated_stats_.GetLogMetric();
+  for (int phase = 0; phase < LOG_PHASE_COUNT; phase++) {
+    auto phase_type = static_cast<LogPhaseType>(phase);
+    auto &phase_latency = log_metric.GetPhaseLatency(phase_type);
+
+    // Skip the phases the current logging mode does not go through
+    if (phase_latency.GetCount() == 0) {
+      continue;
+    }
+
+    auto log_tuple = catalog::GetLogMetricsCatalogTuple(
+        log_metrics_table->GetSchema(), LogMetric::GetPhaseName(phase_type),
+        phase_latency.GetCount(), (int64_t)phase_latency.GetAverage(),
+        phase_latency.GetPercentile(50), phase_latency.GetPercentile(99),
+        phase_latency.GetMax(), time_stamp, pool_.get());
+    catalog::InsertTuple(log_metrics_table, std::move(log_tuple), txn);
+    LOG_TRACE("Log Metric Tuple inserted");
+  }
+}
+
 void StatsAggregator::UpdateMetrics() {
   // All tuples are inserted in a single txn
   auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
@@ -201,6 +225,9 @@ void StatsAggregator::UpdateMetrics() {
   // Update all query metrics
   UpdateQueryMetrics(time_stamp, txn);
 
+  // Update the logging phase latencies
+  UpdateLogMetrics(time_stamp, txn);
+
   txn_manager.CommitTransaction(txn);
 }
 
@@ -0,0 +1,79 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// column_accessor.cpp
+//
+// Identification: src/storage/column_accessor.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <cstring>
+
+#include "catalog/schema.h"
+#include "storage/column_accessor.h"
+#include "storage/tile.h"
+#include "type/abstract_pool.h"
+
+namespace peloton {
+namespace storage {
+
+ColumnAccessor::ColumnAccessor(Tile *tile, oid_t tile_column_id)
+    : tile_(tile),
+      data_(tile->data),
+      pool_(tile->pool),
+      tuple_length_(tile->tuple_length),
+      column_offset_(tile->schema.GetOffset(tile_column_id)),
+      field_length_(tile->schema.GetLength(tile_column_id)),
+      type_id_(tile->schema.GetType(tile_column_id)),
+      is_inlined_(tile->schema.IsInlined(tile_column_id)) {}
+
+type::Value ColumnAccessor::GetValue(const oid_t tuple_id) const {
+  PL_ASSERT(IsValid());
+  return type::Value::DeserializeFrom(GetFieldLocation(tuple_id), type_id_,
+                                      is_inlined_);
+}
+
+void ColumnAccessor::SetValue(const oid_t tuple_id,
+                              const type::Value &value) const {
+  PL_ASSERT(IsValid());
+  PL_ASSERT(pool_ != nullptr);
+  value.SerializeTo(GetFieldLocation(tuple_id), is_inlined_, pool_);
+}
+
+void ColumnAccessor::CopyField(const oid_t tuple_id,
+                               const ColumnAccessor &source,
+                               const oid_t source_tuple_id) const {
+  PL_ASSERT(IsValid() && source.IsValid());
+
+  if (type_id_ != source.type_id_ || is_inlined_ != source.is_inlined_) {
+    SetValue(tuple_id, source.GetValue(source_tuple_id));
+    return;
+  }
+
+  char *location = GetFieldLocation(tuple_id);
+  const char *source_location = source.GetFieldLocation(source_tuple_id);
+
+  if (is_inlined_) {
+    PL_ASSERT(field_length_ == source.field_length_);
+    PL_MEMCPY(location, source_location, field_length_);
+    return;
+  }
+
+  // Same layout as VarlenType::SerializeTo: <uint32 length><data>
+  const char *varlen = *reinterpret_cast<const char *const *>(source_location);
+  char *copy = nullptr;
+  if (varlen != nullptr) {
+    size_t size =
+        *reinterpret_cast<const uint32_t *>(varlen) + sizeof(uint32_t);
+    PL_ASSERT(pool_ != nullptr);
+    copy = static_cast<char *>(pool_->Allocate(size));
+    PL_MEMCPY(copy, varlen, size);
+  }
+  *reinterpret_cast<char **>(location) = copy;
+}
+
+}  // End storage namespace
+}  // End peloton namespace
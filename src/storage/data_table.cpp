@@ -10,6 +10,7 @@
 //
 //===----------------------------------------------------------------------===//
 
+#include <algorithm>
 #include <mutex>
 #include <utility>
 
@@ -17,11 +18,14 @@
 #include "brain/sample.h"
 #include "catalog/catalog.h"
 #include "catalog/foreign_key.h"
+#include "catalog/partition_scheme.h"
+#include "common/container_tuple.h"
 #include "common/exception.h"
 #include "common/exception.h"
 #include "common/logger.h"
 #include "common/platform.h"
 #include "concurrency/transaction.h"
+#include "configuration/configuration.h"
 #include "concurrency/transaction_manager_factory.h"
 #include "gc/gc_manager_factory.h"
 #include "index/index.h"
@@ -45,6 +49,9 @@ double peloton_projectivity;
 
 int peloton_num_groups;
 
+// Initial capacity of the recycled slot queue of every partition
+#define PARTITION_FREE_SLOT_QUEUE_SIZE 1024
+
 namespace peloton {
 namespace storage {
 
@@ -71,16 +78,33 @@ DataTable::DataTable(catalog::Schema *schema, const std::string &table_name,
   if (is_catalog == true) {
     active_tilegroup_count_ = 1;
     active_indirection_array_count_ = 1;
+    numa_node_count_ = 1;
   } else {
-    active_tilegroup_count_ = default_active_tilegroup_count_;
+    // With NUMA placement the active tile groups are spread over the nodes
+    numa_node_count_ = 1;
+    if (FLAGS_numa_placement) numa_node_count_ = NumaUtil::GetNodeCount();
+    active_tilegroup_count_ = std::max<size_t>(
+        default_active_tilegroup_count_ / numa_node_count_, 1);
     active_indirection_array_count_ = default_active_indirection_array_count_;
+
+    // Every partition inserts into its own active tile group
+    partition_scheme_ = schema->GetPartitionScheme();
+    if (partition_scheme_ != nullptr) {
+      active_tilegroup_count_ = partition_scheme_->GetPartitionCount();
+      partition_tile_groups_.resize(active_tilegroup_count_ + 1);
+      for (size_t list_id = 0; list_id <= active_tilegroup_count_;
+           list_id++) {
+        partition_free_slots_.emplace_back(
+            new LockFreeQueue<ItemPointer>(PARTITION_FREE_SLOT_QUEUE_SIZE));
+      }
+    }
   }
 
-  active_tile_groups_.resize(active_tilegroup_count_);
+  active_tile_groups_.resize(active_tilegroup_count_ * numa_node_count_);
 
   active_indirection_arrays_.resize(active_indirection_array_count_);
   // Create tile groups.
-  for (size_t i = 0; i < active_tilegroup_count_; ++i) {
+  for (size_t i = 0; i < active_tile_groups_.size(); ++i) {
     AddDefaultTileGroup(i);
   }
 
@@ -167,23 +191,56 @@ bool DataTable::CheckConstraints(const storage::Tuple *tuple) const {
 // in-place update at executor level.
 // however, when performing insert, we have to copy data immediately,
 // and the argument cannot be set to nullptr.
-ItemPointer DataTable::GetEmptyTupleSlot(const storage::Tuple *tuple) {
+ItemPointer DataTable::GetEmptyTupleSlot(const storage::Tuple *tuple,
+                                         oid_t partition) {
+  if (partition_scheme_ == nullptr) {
+    partition = INVALID_OID;
+  } else if (partition == INVALID_OID && tuple != nullptr) {
+    partition = partition_scheme_->GetPartition(
+        tuple->GetValue(partition_scheme_->GetColumnId()));
+  }
+
   //=============== garbage collection==================
-  // check if there are recycled tuple slots
-  auto &gc_manager = gc::GCManagerFactory::GetInstance();
-  auto free_item_pointer = gc_manager.ReturnFreeSlot(this->table_oid);
+  // check if there are recycled tuple slots, first those kept for the
+  // partition
+  ItemPointer free_item_pointer = INVALID_ITEMPOINTER;
+  if (partition_scheme_ != nullptr) {
+    partition_free_slots_[GetPartitionListId(partition)]->Dequeue(
+        free_item_pointer);
+  }
+  if (free_item_pointer.IsNull() == true) {
+    auto &gc_manager = gc::GCManagerFactory::GetInstance();
+    free_item_pointer = gc_manager.ReturnFreeSlot(this->table_oid);
+  }
   if (free_item_pointer.IsNull() == false) {
-    // when inserting a tuple
-    if (tuple != nullptr) {
-      auto tile_group =
+    std::shared_ptr<storage::TileGroup> tile_group;
+    if (tuple != nullptr || partition != INVALID_OID) {
+      tile_group =
           catalog::Manager::GetInstance().GetTileGroup(free_item_pointer.block);
-      tile_group->CopyTuple(tuple, free_item_pointer.offset);
     }
-    return free_item_pointer;
+
+    // a slot of another partition is kept for that partition
+    if (partition != INVALID_OID && tile_group->GetPartitionId() != partition) {
+      partition_free_slots_[GetPartitionListId(tile_group->GetPartitionId())]
+          ->Enqueue(free_item_pointer);
+    } else {
+      // when inserting a tuple
+      if (tuple != nullptr) {
+        tile_group->CopyTuple(tuple, free_item_pointer.offset);
+      }
+      return free_item_pointer;
+    }
   }
   //====================================================
 
-  size_t active_tile_group_id = number_of_tuples_ % active_tilegroup_count_;
+  size_t active_tile_group_id = partition;
+  if (partition == INVALID_OID) {
+    active_tile_group_id = number_of_tuples_ % active_tilegroup_count_;
+  }
+  if (numa_node_count_ > 1) {
+    active_tile_group_id +=
+        NumaUtil::GetCurrentNode() * active_tilegroup_count_;
+  }
   std::shared_ptr<storage::TileGroup> tile_group;
   oid_t tuple_slot = INVALID_OID;
   oid_t tile_group_id = INVALID_OID;
@@ -235,9 +292,9 @@ ItemPointer DataTable::InsertEmptyVersion() {
   return location;
 }
 
-ItemPointer DataTable::AcquireVersion() {
+ItemPointer DataTable::AcquireVersion(const oid_t partition) {
   // First, claim a slot
-  ItemPointer location = GetEmptyTupleSlot(nullptr);
+  ItemPointer location = GetEmptyTupleSlot(nullptr, partition);
   if (location.block == INVALID_OID) {
     LOG_TRACE("Failed to get tuple slot.");
     return INVALID_ITEMPOINTER;
@@ -592,10 +649,12 @@ void DataTable::ResetDirty() { dirty_ = false; }
 //===--------------------------------------------------------------------===//
 
 TileGroup *DataTable::GetTileGroupWithLayout(
-    const column_map_type &partitioning) {
+    const column_map_type &partitioning, int numa_node) {
   oid_t tile_group_id = catalog::Manager::GetInstance().GetNextTileGroupId();
-  return (AbstractTable::GetTileGroupWithLayout(
-      database_oid, tile_group_id, partitioning, tuples_per_tilegroup_));
+  return (AbstractTable::GetTileGroupWithLayout(database_oid, tile_group_id,
+                                                partitioning,
+                                                tuples_per_tilegroup_,
+                                                numa_node));
 }
 
 oid_t DataTable::AddDefaultIndirectionArray(
@@ -627,11 +686,17 @@ oid_t DataTable::AddDefaultTileGroup(const size_t &active_tile_group_id) {
   column_map = GetTileGroupLayout((LayoutType)peloton_layout_mode);
 
   // Create a tile group with that partitioning
-  std::shared_ptr<TileGroup> tile_group(GetTileGroupWithLayout(column_map));
+  std::shared_ptr<TileGroup> tile_group(GetTileGroupWithLayout(
+      column_map, GetActiveTileGroupNode(active_tile_group_id)));
   PL_ASSERT(tile_group.get());
 
   tile_group_id = tile_group->GetTileGroupId();
 
+  if (partition_scheme_ != nullptr) {
+    AddPartitionTileGroup(tile_group,
+                          active_tile_group_id % active_tilegroup_count_);
+  }
+
   LOG_TRACE("Added a tile group ");
   tile_groups_.Append(tile_group_id);
 
@@ -673,6 +738,10 @@ void DataTable::AddTileGroupWithOidForRecovery(const oid_t &tile_group_id) {
   auto tile_groups_exists = tile_groups_.Contains(tile_group_id);
 
   if (tile_groups_exists == false) {
+    if (partition_scheme_ != nullptr) {
+      AddPartitionTileGroup(tile_group, INVALID_OID);
+    }
+
     tile_groups_.Append(tile_group_id);
 
     LOG_TRACE("Added a tile group ");
@@ -692,9 +761,15 @@ void DataTable::AddTileGroupWithOidForRecovery(const oid_t &tile_group_id) {
 
 // NOTE: This function is only used in test cases.
 void DataTable::AddTileGroup(const std::shared_ptr<TileGroup> &tile_group) {
-  size_t active_tile_group_id = number_of_tuples_ % active_tilegroup_count_;
-
-  active_tile_groups_[active_tile_group_id] = tile_group;
+  // The tuples of the tile group may belong to any partition, so it is
+  // registered as unbound and inserts keep going to the partitions' own
+  // active tile groups
+  if (partition_scheme_ != nullptr) {
+    AddPartitionTileGroup(tile_group, INVALID_OID);
+  } else {
+    size_t active_tile_group_id = number_of_tuples_ % active_tilegroup_count_;
+    active_tile_groups_[active_tile_group_id] = tile_group;
+  }
 
   oid_t tile_group_id = tile_group->GetTileGroupId();
 
@@ -712,6 +787,182 @@ void DataTable::AddTileGroup(const std::shared_ptr<TileGroup> &tile_group) {
   LOG_TRACE("Recording tile group : %u ", tile_group_id);
 }
 
+//===--------------------------------------------------------------------===//
+// BULK LOAD
+//===--------------------------------------------------------------------===//
+
+std::shared_ptr<TileGroup> DataTable::GetBulkLoadTileGroup() {
+  column_map_type column_map =
+      GetTileGroupLayout((LayoutType)peloton_layout_mode);
+
+  // Placed on the node of the loading thread, which fills it
+  int numa_node = NUMA_NODE_ANY;
+  if (numa_node_count_ > 1) numa_node = NumaUtil::GetCurrentNode();
+  return std::shared_ptr<TileGroup>(
+      GetTileGroupWithLayout(column_map, numa_node));
+}
+
+bool DataTable::AddBulkLoadTileGroup(
+    const std::shared_ptr<TileGroup> &tile_group,
+    concurrency::Transaction *transaction) {
+  auto tile_group_header = tile_group->GetHeader();
+  oid_t tile_group_id = tile_group->GetTileGroupId();
+  oid_t tuple_count = tile_group->GetNextTupleSlot();
+
+  // The tuples look like uncommitted inserts of the loading transaction
+  for (oid_t tuple_id = 0; tuple_id < tuple_count; tuple_id++) {
+    tile_group_header->SetTransactionId(tuple_id,
+                                        transaction->GetTransactionId());
+    tile_group_header->SetBeginCommitId(tuple_id, MAX_CID);
+    tile_group_header->SetEndCommitId(tuple_id, MAX_CID);
+    tile_group_header->SetNextItemPointer(tuple_id, INVALID_ITEMPOINTER);
+    tile_group_header->SetPrevItemPointer(tuple_id, INVALID_ITEMPOINTER);
+  }
+
+  // the loaded tuples are not routed, so the tile group is not pruned
+  if (partition_scheme_ != nullptr) {
+    AddPartitionTileGroup(tile_group, INVALID_OID);
+  }
+
+  tile_groups_.Append(tile_group_id);
+  catalog::Manager::GetInstance().AddTileGroup(tile_group_id, tile_group);
+
+  // we must guarantee that the compiler always add tile group before adding
+  // tile_group_count_.
+  COMPILER_MEMORY_FENCE;
+
+  tile_group_count_++;
+
+  LOG_TRACE("Recording bulk load tile group : %u ", tile_group_id);
+
+  // Allocate the indirections of all tuples up front
+  std::vector<ItemPointer *> index_entry_ptrs(tuple_count, nullptr);
+  size_t active_indirection_array_id =
+      tile_group_id % active_indirection_array_count_;
+  for (oid_t tuple_id = 0; tuple_id < tuple_count; tuple_id++) {
+    size_t indirection_offset = INVALID_INDIRECTION_OFFSET;
+    while (true) {
+      auto active_indirection_array =
+          active_indirection_arrays_[active_indirection_array_id];
+      indirection_offset = active_indirection_array->AllocateIndirection();
+
+      if (indirection_offset != INVALID_INDIRECTION_OFFSET) {
+        index_entry_ptrs[tuple_id] =
+            active_indirection_array->GetIndirectionByOffset(
+                indirection_offset);
+        break;
+      }
+    }
+
+    if (indirection_offset == INDIRECTION_ARRAY_MAX_SIZE - 1) {
+      AddDefaultIndirectionArray(active_indirection_array_id);
+    }
+
+    index_entry_ptrs[tuple_id]->block = tile_group_id;
+    index_entry_ptrs[tuple_id]->offset = tuple_id;
+    tile_group_header->SetIndirection(tuple_id, index_entry_ptrs[tuple_id]);
+  }
+
+  auto &transaction_manager =
+      concurrency::TransactionManagerFactory::GetInstance();
+
+  std::function<bool(const void *)> fn =
+      std::bind(&concurrency::TransactionManager::IsOccupied,
+                &transaction_manager, transaction, std::placeholders::_1);
+
+  // Walk one index at a time over all tuples of the tile group, so that the
+  // key schema and the index stay hot in the cache
+  int index_count = GetIndexCount();
+  for (int index_itr = index_count - 1; index_itr >= 0; --index_itr) {
+    auto index = GetIndex(index_itr);
+    auto index_schema = index->GetKeySchema();
+    auto indexed_columns = index_schema->GetIndexedColumns();
+    std::unique_ptr<storage::Tuple> key(new storage::Tuple(index_schema, true));
+    bool is_unique =
+        index->GetIndexType() == IndexConstraintType::PRIMARY_KEY ||
+        index->GetIndexType() == IndexConstraintType::UNIQUE;
+
+    for (oid_t tuple_id = 0; tuple_id < tuple_count; tuple_id++) {
+      expression::ContainerTuple<storage::TileGroup> tuple(tile_group.get(),
+                                                           tuple_id);
+      key->SetFromTuple(&tuple, indexed_columns, index->GetPool());
+
+      if (is_unique) {
+        if (index->CondInsertEntry(key.get(), index_entry_ptrs[tuple_id], fn) ==
+            false) {
+          LOG_TRACE("Bulk load violates index %s", index->GetName().c_str());
+          return false;
+        }
+      } else {
+        index->InsertEntry(key.get(), index_entry_ptrs[tuple_id]);
+      }
+    }
+  }
+
+  return true;
+}
+
+void DataTable::CommitBulkLoad(
+    const std::vector<std::shared_ptr<TileGroup>> &tile_groups,
+    concurrency::Transaction *transaction) {
+  // The transaction installs and logs the tuples like those of inserts, or
+  // invalidates them and removes their index entries if it aborts
+  size_t tuple_count = 0;
+  for (auto &tile_group : tile_groups) {
+    oid_t tile_group_id = tile_group->GetTileGroupId();
+    oid_t tile_group_tuple_count = tile_group->GetNextTupleSlot();
+    for (oid_t tuple_id = 0; tuple_id < tile_group_tuple_count; tuple_id++) {
+      transaction->RecordInsert(ItemPointer(tile_group_id, tuple_id));
+    }
+    tuple_count += tile_group_tuple_count;
+  }
+
+  IncreaseTupleCount(tuple_count);
+}
+
+void DataTable::AbortBulkLoad(
+    const std::vector<std::shared_ptr<TileGroup>> &tile_groups) {
+  // The index entries are removed before the tuples are invalidated, the
+  // entries of tuples that were not indexed yet are not found
+  int index_count = GetIndexCount();
+  for (int index_itr = index_count - 1; index_itr >= 0; --index_itr) {
+    auto index = GetIndex(index_itr);
+    auto index_schema = index->GetKeySchema();
+    auto indexed_columns = index_schema->GetIndexedColumns();
+    std::unique_ptr<storage::Tuple> key(new storage::Tuple(index_schema, true));
+
+    for (auto &tile_group : tile_groups) {
+      auto tile_group_header = tile_group->GetHeader();
+      oid_t tile_group_tuple_count = tile_group->GetNextTupleSlot();
+      for (oid_t tuple_id = 0; tuple_id < tile_group_tuple_count; tuple_id++) {
+        ItemPointer *index_entry_ptr =
+            tile_group_header->GetIndirection(tuple_id);
+        if (index_entry_ptr == nullptr) continue;
+
+        expression::ContainerTuple<storage::TileGroup> tuple(tile_group.get(),
+                                                             tuple_id);
+        key->SetFromTuple(&tuple, indexed_columns, index->GetPool());
+        index->DeleteEntry(key.get(), index_entry_ptr);
+      }
+    }
+  }
+
+  for (auto &tile_group : tile_groups) {
+    auto tile_group_header = tile_group->GetHeader();
+    oid_t tile_group_tuple_count = tile_group->GetNextTupleSlot();
+    for (oid_t tuple_id = 0; tuple_id < tile_group_tuple_count; tuple_id++) {
+      tile_group_header->SetBeginCommitId(tuple_id, MAX_CID);
+      tile_group_header->SetEndCommitId(tuple_id, MAX_CID);
+    }
+
+    COMPILER_MEMORY_FENCE;
+
+    for (oid_t tuple_id = 0; tuple_id < tile_group_tuple_count; tuple_id++) {
+      tile_group_header->SetTransactionId(tuple_id, INVALID_TXN_ID);
+    }
+  }
+}
+
 size_t DataTable::GetTileGroupCount() const { return tile_group_count_; }
 
 std::shared_ptr<storage::TileGroup> DataTable::GetTileGroup(
@@ -748,9 +999,66 @@ void DataTable::DropTileGroups() {
   // Clear array
   tile_groups_.Clear(invalid_tile_group_id);
 
+  {
+    std::lock_guard<std::mutex> lock(partition_mutex_);
+    for (auto &partition_tile_groups : partition_tile_groups_) {
+      partition_tile_groups.clear();
+    }
+  }
+  ItemPointer free_item_pointer;
+  for (auto &free_slots : partition_free_slots_) {
+    while (free_slots->Dequeue(free_item_pointer) == true) {
+    }
+  }
+
   tile_group_count_ = 0;
 }
 
+//===--------------------------------------------------------------------===//
+// PARTITIONS
+//===--------------------------------------------------------------------===//
+
+size_t DataTable::GetPartitionListId(const oid_t partition) const {
+  if (partition == INVALID_OID) return partition_scheme_->GetPartitionCount();
+  return partition;
+}
+
+void DataTable::AddPartitionTileGroup(
+    const std::shared_ptr<TileGroup> &tile_group, const oid_t partition) {
+  PL_ASSERT(partition_scheme_ != nullptr);
+  tile_group->SetPartitionId(partition);
+
+  size_t list_id = GetPartitionListId(partition);
+  PL_ASSERT(list_id < partition_tile_groups_.size());
+
+  std::lock_guard<std::mutex> lock(partition_mutex_);
+  partition_tile_groups_[list_id].push_back(tile_group->GetTileGroupId());
+}
+
+void DataTable::GetTileGroupIds(const std::vector<bool> &partitions,
+                                std::vector<oid_t> &tile_group_ids) {
+  PL_ASSERT(partition_scheme_ != nullptr);
+  PL_ASSERT(partitions.size() == partition_scheme_->GetPartitionCount());
+  tile_group_ids.clear();
+
+  {
+    std::lock_guard<std::mutex> lock(partition_mutex_);
+    for (oid_t list_id = 0; list_id < partition_tile_groups_.size();
+         list_id++) {
+      // the unbound tile groups are always scanned
+      if (list_id < partitions.size() && partitions[list_id] == false) {
+        continue;
+      }
+      auto &partition_tile_groups = partition_tile_groups_[list_id];
+      tile_group_ids.insert(tile_group_ids.end(),
+                            partition_tile_groups.begin(),
+                            partition_tile_groups.end());
+    }
+  }
+
+  std::sort(tile_group_ids.begin(), tile_group_ids.end());
+}
+
 //===--------------------------------------------------------------------===//
 // INDEX
 //===--------------------------------------------------------------------===//
@@ -1006,10 +1314,11 @@ storage::TileGroup *DataTable::TransformTileGroup(
           tile_group->GetDatabaseId(), tile_group->GetTableId(),
           tile_group->GetTileGroupId(), tile_group->GetAbstractTable(),
           new_schema, default_partition_,
-          tile_group->GetAllocatedTupleCount()));
+          tile_group->GetAllocatedTupleCount(), tile_group->GetNumaNode()));
 
   // Set the transformed tile group column-at-a-time
   SetTransformedTileGroup(tile_group.get(), new_tile_group.get());
+  new_tile_group->SetPartitionId(tile_group->GetPartitionId());
 
   // Set the location of the new tile group
   // and clean up the orig tile group
@@ -18,10 +18,11 @@
 #include "common/macros.h"
 #include "type/serializer.h"
 #include "type/types.h"
-#include "type/ephemeral_pool.h"
+#include "type/slab_pool.h"
 #include "concurrency/transaction_manager_factory.h"
 #include "storage/storage_manager.h"
 #include "storage/tile.h"
+#include "storage/tile_group.h"
 #include "storage/tile_group_header.h"
 #include "storage/tuple.h"
 #include "storage/tuple_iterator.h"
@@ -52,10 +53,13 @@ Tile::Tile(BackendType backend_type, TileGroupHeader *tile_header,
 
   tile_size = tuple_count * tuple_length;
 
-  // allocate tuple storage space for inlined data
+  // allocate tuple storage space for inlined data, on the node of the tile
+  // group
+  int numa_node =
+      (tile_group != nullptr) ? tile_group->GetNumaNode() : NUMA_NODE_ANY;
   auto &storage_manager = storage::StorageManager::GetInstance();
   data = reinterpret_cast<char *>(
-      storage_manager.Allocate(backend_type, tile_size));
+      storage_manager.Allocate(backend_type, tile_size, numa_node));
   PL_ASSERT(data != NULL);
 
   // zero out the data
@@ -63,7 +67,7 @@ Tile::Tile(BackendType backend_type, TileGroupHeader *tile_header,
 
   // allocate pool for blob storage if schema not inlined
   // if (schema.IsInlined() == false) {
-  pool = new type::EphemeralPool();
+  pool = new type::SlabPool();
   //}
 }
 
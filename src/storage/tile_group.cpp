@@ -23,6 +23,7 @@
 #include "storage/tile.h"
 #include "storage/tile_group_header.h"
 #include "storage/tuple.h"
+#include "storage/zone_map.h"
 
 namespace peloton {
 namespace storage {
@@ -30,11 +31,13 @@ namespace storage {
 TileGroup::TileGroup(BackendType backend_type,
                      TileGroupHeader *tile_group_header, AbstractTable *table,
                      const std::vector<catalog::Schema> &schemas,
-                     const column_map_type &column_map, int tuple_count)
+                     const column_map_type &column_map, int tuple_count,
+                     int numa_node)
     : database_id(INVALID_OID),
       table_id(INVALID_OID),
       tile_group_id(INVALID_OID),
       backend_type(backend_type),
+      numa_node(numa_node),
       tile_schemas(schemas),
       tile_group_header(tile_group_header),
       table(table),
@@ -53,6 +56,14 @@ TileGroup::TileGroup(BackendType backend_type,
     // Add a reference to the tile in the tile group
     tiles.push_back(tile);
   }
+
+  // Resolve every column once, so accesses skip the column map and schema
+  column_accessors.resize(column_map.size());
+  for (auto &entry : column_map) {
+    PL_ASSERT(entry.first < column_accessors.size());
+    auto &tile = tiles[entry.second.first];
+    column_accessors[entry.first] = tile->GetColumnAccessor(entry.second.second);
+  }
 }
 
 TileGroup::~TileGroup() {
@@ -77,6 +88,18 @@ type::AbstractPool *TileGroup::GetTilePool(const oid_t tile_id) const {
   return nullptr;
 }
 
+type::SlabPoolStats TileGroup::GetPoolStats() const {
+  type::SlabPoolStats stats;
+  for (auto &tile : tiles) {
+    auto tile_stats = tile->GetPoolStats();
+    stats.reserved_bytes += tile_stats.reserved_bytes;
+    stats.allocated_bytes += tile_stats.allocated_bytes;
+    stats.requested_bytes += tile_stats.requested_bytes;
+    stats.free_bytes += tile_stats.free_bytes;
+  }
+  return stats;
+}
+
 // TODO: check when this function is called. --Yingjun
 oid_t TileGroup::GetNextTupleSlot() const {
   return tile_group_header->GetCurrentNextTupleSlot();
@@ -121,6 +144,8 @@ void TileGroup::CopyTuple(const Tuple *tuple, const oid_t &tuple_slot_id) {
       column_itr++;
     }
   }
+
+  MarkZoneMapStale();
 }
 
 /**
@@ -205,6 +230,8 @@ oid_t TileGroup::InsertTupleFromRecovery(cid_t commit_id, oid_t tuple_slot_id,
     }
   }
 
+  MarkZoneMapStale();
+
   // Set MVCC info
   tile_group_header->SetTransactionId(tuple_slot_id, INITIAL_TXN_ID);
   tile_group_header->SetBeginCommitId(tuple_slot_id, commit_id);
@@ -305,6 +332,8 @@ oid_t TileGroup::InsertTupleFromCheckpoint(oid_t tuple_slot_id,
     }
   }
 
+  MarkZoneMapStale();
+
   // Set MVCC info
   tile_group_header->SetTransactionId(tuple_slot_id, INITIAL_TXN_ID);
   tile_group_header->SetBeginCommitId(tuple_slot_id, commit_id);
@@ -314,6 +343,27 @@ oid_t TileGroup::InsertTupleFromCheckpoint(oid_t tuple_slot_id,
   return tuple_slot_id;
 }
 
+/**
+ * Claim the given slots and set their MVCC info as if they were inserted by
+ * a txn that committed at commit_id. The tuple data must already be in place.
+ * Used by checkpoint recovery
+ */
+void TileGroup::InitializeTupleSlotsFromCheckpoint(
+    const std::vector<oid_t> &tuple_slot_ids, cid_t commit_id) {
+  for (auto tuple_slot_id : tuple_slot_ids) {
+    auto status = tile_group_header->GetEmptyTupleSlot(tuple_slot_id);
+    if (status == false) continue;
+
+    tile_group_header->SetTransactionId(tuple_slot_id, INITIAL_TXN_ID);
+    tile_group_header->SetBeginCommitId(tuple_slot_id, commit_id);
+    tile_group_header->SetEndCommitId(tuple_slot_id, MAX_CID);
+    tile_group_header->SetNextItemPointer(tuple_slot_id, INVALID_ITEMPOINTER);
+  }
+
+  // the tuple data was written directly to the tiles
+  MarkZoneMapStale();
+}
+
 oid_t TileGroup::GetTileIdFromColumnId(oid_t column_id) {
   oid_t tile_column_id, tile_offset;
   LocateTileAndColumn(column_id, tile_offset, tile_column_id);
@@ -328,17 +378,30 @@ oid_t TileGroup::GetTileColumnId(oid_t column_id) {
 
 type::Value TileGroup::GetValue(oid_t tuple_id, oid_t column_id) {
   PL_ASSERT(tuple_id < GetNextTupleSlot());
-  oid_t tile_column_id, tile_offset;
-  LocateTileAndColumn(column_id, tile_offset, tile_column_id);
-  return GetTile(tile_offset)->GetValue(tuple_id, tile_column_id);
+  return GetColumnAccessor(column_id).GetValue(tuple_id);
 }
 
 void TileGroup::SetValue(type::Value &value, oid_t tuple_id,
                          oid_t column_id) {
   PL_ASSERT(tuple_id < GetNextTupleSlot());
-  oid_t tile_column_id, tile_offset;
-  LocateTileAndColumn(column_id, tile_offset, tile_column_id);
-  GetTile(tile_offset)->SetValue(value, tuple_id, tile_column_id);
+  GetColumnAccessor(column_id).SetValue(tuple_id, value);
+  MarkZoneMapStale();
+}
+
+std::shared_ptr<const ZoneMap> TileGroup::GetZoneMap() {
+  if (GetNextTupleSlot() < num_tuple_slots) {
+    return nullptr;
+  }
+
+  std::lock_guard<std::mutex> lock(zone_map_mutex);
+  // Writes that end after the flag is cleared mark the new map stale again
+  if (zone_map_stale.exchange(false, std::memory_order_acq_rel) ||
+      zone_map == nullptr) {
+    zone_map.reset(new ZoneMap(this, num_tuple_slots));
+    LOG_TRACE("Built zone map of tile group %u : %s", tile_group_id,
+              zone_map->GetInfo().c_str());
+  }
+  return zone_map;
 }
 
 
@@ -29,7 +29,7 @@ namespace peloton {
 namespace storage {
 
 TileGroupHeader::TileGroupHeader(const BackendType &backend_type,
-                                 const int &tuple_count)
+                                 const int &tuple_count, int numa_node)
     : backend_type(backend_type),
       tile_group(nullptr),
       data(nullptr),
@@ -41,7 +41,7 @@ TileGroupHeader::TileGroupHeader(const BackendType &backend_type,
   // allocate storage space for header
   auto &storage_manager = storage::StorageManager::GetInstance();
   data = reinterpret_cast<char *>(
-      storage_manager.Allocate(backend_type, header_size));
+      storage_manager.Allocate(backend_type, header_size, numa_node));
   PL_ASSERT(data != nullptr);
 
   // zero out the data
@@ -0,0 +1,113 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// zone_map.cpp
+//
+// Identification: src/storage/zone_map.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "storage/zone_map.h"
+
+#include <sstream>
+
+#include "common/exception.h"
+#include "common/logger.h"
+#include "storage/tile_group.h"
+
+namespace peloton {
+namespace storage {
+
+ZoneMap::ZoneMap(TileGroup *tile_group, oid_t tuple_count) {
+  oid_t column_count = tile_group->GetColumnMap().size();
+  columns_.resize(column_count);
+
+  for (oid_t column_itr = 0; column_itr < column_count; column_itr++) {
+    auto &accessor = tile_group->GetColumnAccessor(column_itr);
+    auto &synopsis = columns_[column_itr];
+
+    for (oid_t tuple_itr = 0; tuple_itr < tuple_count; tuple_itr++) {
+      auto value = accessor.GetValue(tuple_itr);
+      if (value.IsNull()) {
+        synopsis.null_count++;
+        continue;
+      }
+
+      // the bounds are copied, the slots may be overwritten later on
+      if (synopsis.has_values == false) {
+        synopsis.min = value.Copy();
+        synopsis.max = value.Copy();
+        synopsis.has_values = true;
+      } else if (value.CompareLessThan(synopsis.min) == type::CMP_TRUE) {
+        synopsis.min = value.Copy();
+      } else if (value.CompareGreaterThan(synopsis.max) == type::CMP_TRUE) {
+        synopsis.max = value.Copy();
+      }
+    }
+  }
+}
+
+bool ZoneMap::MayMatch(oid_t column_id, ExpressionType comparison,
+                       const type::Value &constant) const {
+  PL_ASSERT(column_id < columns_.size());
+  auto &synopsis = columns_[column_id];
+
+  // Comparisons with NULL are never true
+  if (synopsis.has_values == false) {
+    return false;
+  }
+  if (constant.IsNull()) {
+    return true;
+  }
+
+  try {
+    switch (comparison) {
+      case ExpressionType::COMPARE_EQUAL:
+        return synopsis.min.CompareLessThanEquals(constant) !=
+                   type::CMP_FALSE &&
+               synopsis.max.CompareGreaterThanEquals(constant) !=
+                   type::CMP_FALSE;
+      case ExpressionType::COMPARE_LESSTHAN:
+        return synopsis.min.CompareLessThan(constant) != type::CMP_FALSE;
+      case ExpressionType::COMPARE_LESSTHANOREQUALTO:
+        return synopsis.min.CompareLessThanEquals(constant) != type::CMP_FALSE;
+      case ExpressionType::COMPARE_GREATERTHAN:
+        return synopsis.max.CompareGreaterThan(constant) != type::CMP_FALSE;
+      case ExpressionType::COMPARE_GREATERTHANOREQUALTO:
+        return synopsis.max.CompareGreaterThanEquals(constant) !=
+               type::CMP_FALSE;
+      default:
+        return true;
+    }
+  } catch (Exception &e) {
+    LOG_TRACE("Cannot compare column %u with %s: %s", column_id,
+              constant.GetInfo().c_str(), e.what());
+    return true;
+  }
+}
+
+const std::string ZoneMap::GetInfo() const {
+  std::ostringstream os;
+
+  os << "ZoneMap[";
+  for (oid_t column_itr = 0; column_itr < columns_.size(); column_itr++) {
+    auto &synopsis = columns_[column_itr];
+    if (column_itr > 0) os << ", ";
+    if (synopsis.has_values) {
+      os << "(" << synopsis.min.ToString() << ", " << synopsis.max.ToString()
+         << ")";
+    } else {
+      os << "(NULL)";
+    }
+    os << " nulls:" << synopsis.null_count;
+  }
+  os << "]";
+
+  return os.str();
+}
+
+}  // End storage namespace
+}  // End peloton namespace
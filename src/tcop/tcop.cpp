@@ -27,9 +27,12 @@
 #include "optimizer/simple_optimizer.h"
 #include "parser/parser.h"
 #include "parser/select_statement.h"
+#include "parser/transaction_statement.h"
 
 #include "catalog/catalog.h"
+#include "concurrency/epoch_manager_factory.h"
 #include "executor/plan_executor.h"
+#include "logging/log_manager.h"
 #include "optimizer/simple_optimizer.h"
 
 #include "planner/plan_util.h"
@@ -42,6 +45,8 @@ namespace tcop {
 TrafficCop::TrafficCop() {
   LOG_TRACE("Starting a new TrafficCop");
   optimizer_.reset(new optimizer::SimpleOptimizer());
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  last_commit_cid_ = txn_manager.GetCurrentCommitId();
 }
 
 void TrafficCop::Reset() {
@@ -80,9 +85,14 @@ TrafficCop::TcopTxnState &TrafficCop::GetCurrentTxnState() {
   return tcop_txn_state_.top();
 }
 
-ResultType TrafficCop::BeginQueryHelper() {
+ResultType TrafficCop::BeginQueryHelper(bool read_only) {
   auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
-  auto txn = txn_manager.BeginTransaction();
+  concurrency::Transaction *txn;
+  if (read_only == true) {
+    txn = txn_manager.BeginReadonlyTransaction();
+  } else {
+    txn = txn_manager.BeginTransaction();
+  }
 
   // this shouldn't happen
   if (txn == nullptr) {
@@ -104,7 +114,11 @@ ResultType TrafficCop::CommitQueryHelper() {
   if (curr_state.second != ResultType::ABORTED) {
     auto txn = curr_state.first;
     auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+    bool read_only = txn->IsDeclaredReadOnly();
     auto result = txn_manager.CommitTransaction(txn);
+    if (read_only == false) {
+      last_commit_cid_ = txn_manager.GetCurrentCommitId();
+    }
     return result;
   } else {
     // otherwise, the txn has already been aborted
@@ -129,6 +143,21 @@ ResultType TrafficCop::AbortQueryHelper() {
   }
 }
 
+bool TrafficCop::UseSnapshotRead(const planner::AbstractPlan *plan) {
+  if (FLAGS_autocommit_snapshot_read == false ||
+      planner::PlanUtil::IsReadOnly(plan) == false) {
+    return false;
+  }
+  // the snapshot must not miss a write of this connection
+  auto snapshot_cid =
+      concurrency::EpochManagerFactory::GetInstance().GetReadOnlyTxnCid();
+  return snapshot_cid >= last_commit_cid_;
+}
+
+void TrafficCop::WaitForPipelinedCommits() {
+  logging::LogManager::GetInstance().WaitForPendingFlush();
+}
+
 ResultType TrafficCop::ExecuteStatement(
     const std::string &query, std::vector<StatementResult> &result,
     std::vector<FieldInfo> &tuple_descriptor, int &rows_changed,
@@ -180,7 +209,7 @@ ResultType TrafficCop::ExecuteStatement(
 
   try {
     if (statement->GetQueryType() == "BEGIN")
-      return BeginQueryHelper();
+      return BeginQueryHelper(statement->GetReadOnly());
     else if (statement->GetQueryType() == "COMMIT")
       return CommitQueryHelper();
     else if (statement->GetQueryType() == "ROLLBACK")
@@ -212,7 +241,13 @@ bridge::peloton_status TrafficCop::ExecuteStatementPlan(
     auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
     // new txn, reset result status
     curr_state.second = ResultType::SUCCESS;
-    txn = txn_manager.BeginTransaction();
+    if (UseSnapshotRead(plan) == true) {
+      txn = txn_manager.BeginReadonlyTransaction();
+    } else {
+      txn = txn_manager.BeginTransaction();
+    }
+    // the result is only sent once the session waited for the log flush
+    txn->SetPipelinedCommit(FLAGS_pipelined_commit);
     single_statement_txn = true;
   } else {
     // get ptr to current active txn
@@ -222,6 +257,18 @@ bridge::peloton_status TrafficCop::ExecuteStatementPlan(
   // skip if already aborted
   if (curr_state.second != ResultType::ABORTED) {
     PL_ASSERT(txn);
+    if (txn->IsDeclaredReadOnly() == true &&
+        planner::PlanUtil::IsReadOnly(plan) == false) {
+      // a read only transaction can not write, it is aborted like a
+      // transaction whose plan failed
+      LOG_TRACE("Write in a read only transaction");
+      auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+      txn_manager.AbortTransaction(txn);
+      curr_state.second = ResultType::ABORTED;
+      p_status.m_result = ResultType::FAILURE;
+      return p_status;
+    }
+
     p_status = bridge::PlanExecutor::ExecutePlan(plan, txn, params, result,
                                                  result_format);
 
@@ -231,6 +278,7 @@ bridge::peloton_status TrafficCop::ExecuteStatementPlan(
     }
 
     auto txn_result = txn->GetResult();
+    bool read_only = txn->IsDeclaredReadOnly();
     if (single_statement_txn == true || init_failure == true ||
         txn_result == ResultType::FAILURE) {
       auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
@@ -244,6 +292,9 @@ bridge::peloton_status TrafficCop::ExecuteStatementPlan(
           // Commit
           LOG_TRACE("Commit Transaction");
           p_status.m_result = txn_manager.CommitTransaction(txn);
+          if (read_only == false) {
+            last_commit_cid_ = txn_manager.GetCurrentCommitId();
+          }
           break;
 
         case ResultType::FAILURE:
@@ -289,6 +340,9 @@ std::shared_ptr<Statement> TrafficCop::PrepareStatement(
       if (stmt->GetType() == StatementType::SELECT) {
         auto tuple_descriptor = GenerateTupleDescriptor(stmt);
         statement->SetTupleDescriptor(tuple_descriptor);
+      } else if (stmt->GetType() == StatementType::TRANSACTION) {
+        auto txn_stmt = static_cast<parser::TransactionStatement *>(stmt);
+        statement->SetReadOnly(txn_stmt->read_only);
       }
       break;
     }
@@ -0,0 +1,139 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// slab_pool.cpp
+//
+// Identification: src/type/slab_pool.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "type/slab_pool.h"
+
+#include <algorithm>
+
+#include "common/macros.h"
+
+namespace peloton {
+namespace type {
+
+SlabPool::SlabPool()
+    : reserved_bytes_(ATOMIC_VAR_INIT(0)),
+      allocated_bytes_(ATOMIC_VAR_INIT(0)),
+      requested_bytes_(ATOMIC_VAR_INIT(0)),
+      free_bytes_(ATOMIC_VAR_INIT(0)) {
+  static_assert(GetClassSize(SLAB_POOL_SIZE_CLASS_COUNT - 1) ==
+                    SLAB_POOL_MAX_CHUNK_SIZE,
+                "Size classes must end at the max chunk size");
+}
+
+SlabPool::~SlabPool() {
+  pool_lock_.Lock();
+  for (auto slab : slabs_) {
+    delete[] slab;
+  }
+  for (auto chunk : large_chunks_) {
+    delete[] chunk;
+  }
+  pool_lock_.Unlock();
+}
+
+void *SlabPool::Allocate(size_t size) {
+  size_t chunk_size = size + sizeof(ChunkHeader);
+  char *chunk = nullptr;
+  uint32_t size_class = large_size_class;
+
+  if (chunk_size > SLAB_POOL_MAX_CHUNK_SIZE) {
+    chunk = new char[chunk_size];
+    pool_lock_.Lock();
+    large_chunks_.insert(chunk);
+    pool_lock_.Unlock();
+    reserved_bytes_.fetch_add(chunk_size, std::memory_order_relaxed);
+  } else {
+    size_class = GetSizeClass(chunk_size);
+    chunk_size = GetClassSize(size_class);
+    auto &slab_class = size_classes_[size_class];
+
+    slab_class.lock.Lock();
+    if (slab_class.free_list != nullptr) {
+      // Reuse a freed chunk
+      chunk = slab_class.free_list;
+      slab_class.free_list =
+          *reinterpret_cast<char **>(chunk + sizeof(ChunkHeader));
+      free_bytes_.fetch_sub(chunk_size, std::memory_order_relaxed);
+    } else {
+      if (slab_class.slab_next == slab_class.slab_end) {
+        // Carve the chunks out of a new slab, larger than the last one
+        size_t slab_size = std::max(slab_class.slab_size, chunk_size);
+        slab_class.slab_size = std::min<size_t>(slab_class.slab_size * 2,
+                                                SLAB_POOL_MAX_SLAB_SIZE);
+        char *slab = new char[slab_size];
+        pool_lock_.Lock();
+        slabs_.push_back(slab);
+        pool_lock_.Unlock();
+        reserved_bytes_.fetch_add(slab_size, std::memory_order_relaxed);
+
+        slab_class.slab_next = slab;
+        slab_class.slab_end = slab + slab_size;
+      }
+      chunk = slab_class.slab_next;
+      slab_class.slab_next += chunk_size;
+    }
+    slab_class.lock.Unlock();
+  }
+
+  auto header = reinterpret_cast<ChunkHeader *>(chunk);
+  header->size_class = size_class;
+  header->requested_size = static_cast<uint32_t>(size);
+  allocated_bytes_.fetch_add(chunk_size, std::memory_order_relaxed);
+  requested_bytes_.fetch_add(size, std::memory_order_relaxed);
+
+  return chunk + sizeof(ChunkHeader);
+}
+
+void SlabPool::Free(void *ptr) {
+  if (ptr == nullptr) return;
+
+  char *chunk = reinterpret_cast<char *>(ptr) - sizeof(ChunkHeader);
+  auto header = reinterpret_cast<ChunkHeader *>(chunk);
+  requested_bytes_.fetch_sub(header->requested_size,
+                             std::memory_order_relaxed);
+
+  if (header->size_class == large_size_class) {
+    size_t chunk_size = header->requested_size + sizeof(ChunkHeader);
+    allocated_bytes_.fetch_sub(chunk_size, std::memory_order_relaxed);
+    reserved_bytes_.fetch_sub(chunk_size, std::memory_order_relaxed);
+
+    pool_lock_.Lock();
+    large_chunks_.erase(chunk);
+    pool_lock_.Unlock();
+    delete[] chunk;
+    return;
+  }
+
+  PL_ASSERT(header->size_class < SLAB_POOL_SIZE_CLASS_COUNT);
+  allocated_bytes_.fetch_sub(GetClassSize(header->size_class),
+                             std::memory_order_relaxed);
+
+  auto &slab_class = size_classes_[header->size_class];
+  slab_class.lock.Lock();
+  *reinterpret_cast<char **>(ptr) = slab_class.free_list;
+  slab_class.free_list = chunk;
+  slab_class.lock.Unlock();
+  free_bytes_.fetch_add(GetClassSize(header->size_class),
+                        std::memory_order_relaxed);
+}
+
+SlabPoolStats SlabPool::GetStats() const {
+  SlabPoolStats stats;
+  stats.reserved_bytes = reserved_bytes_.load(std::memory_order_relaxed);
+  stats.allocated_bytes = allocated_bytes_.load(std::memory_order_relaxed);
+  stats.requested_bytes = requested_bytes_.load(std::memory_order_relaxed);
+  stats.free_bytes = free_bytes_.load(std::memory_order_relaxed);
+  return stats;
+}
+
+}  // namespace type
+}  // namespace peloton
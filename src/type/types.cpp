@@ -787,6 +787,50 @@ std::ostream& operator<<(std::ostream& os, const ExpressionType& type) {
   return os;
 }
 
+//===--------------------------------------------------------------------===//
+// Partition Type - String Utilities
+//===--------------------------------------------------------------------===//
+
+std::string PartitionTypeToString(PartitionType type) {
+  switch (type) {
+    case PartitionType::INVALID: {
+      return "INVALID";
+    }
+    case PartitionType::RANGE: {
+      return "RANGE";
+    }
+    case PartitionType::HASH: {
+      return "HASH";
+    }
+    default: {
+      throw ConversionException(StringUtil::Format(
+          "No string conversion for PartitionType value '%d'",
+          static_cast<int>(type)));
+    }
+  }
+  return "INVALID";
+}
+
+PartitionType StringToPartitionType(const std::string& str) {
+  std::string upper_str = StringUtil::Upper(str);
+  if (upper_str == "INVALID") {
+    return PartitionType::INVALID;
+  } else if (upper_str == "RANGE") {
+    return PartitionType::RANGE;
+  } else if (upper_str == "HASH") {
+    return PartitionType::HASH;
+  } else {
+    throw ConversionException(StringUtil::Format(
+        "No PartitionType conversion from string '%s'", upper_str.c_str()));
+  }
+  return PartitionType::INVALID;
+}
+
+std::ostream& operator<<(std::ostream& os, const PartitionType& type) {
+  os << PartitionTypeToString(type);
+  return os;
+}
+
 //===--------------------------------------------------------------------===//
 // Index Method Type - String Utilities
 //===--------------------------------------------------------------------===//
@@ -2041,6 +2085,9 @@ std::string LogRecordTypeToString(LogRecordType type) {
     case LOGRECORD_TYPE_WAL_TUPLE_UPDATE: {
       return "WAL_TUPLE_UPDATE";
     }
+    case LOGRECORD_TYPE_WAL_TUPLE_PARTIAL_UPDATE: {
+      return "WAL_TUPLE_PARTIAL_UPDATE";
+    }
     case LOGRECORD_TYPE_WBL_TUPLE_INSERT: {
       return "WBL_TUPLE_INSERT";
     }
@@ -2053,6 +2100,12 @@ std::string LogRecordTypeToString(LogRecordType type) {
     case LOGRECORD_TYPE_ITERATION_DELIMITER: {
       return "ITERATION_DELIMITER";
     }
+    case LOGRECORD_TYPE_CHECKPOINT_TILE_GROUP: {
+      return "CHECKPOINT_TILE_GROUP";
+    }
+    case LOGRECORD_TYPE_COMPRESSED_BLOCK: {
+      return "COMPRESSED_BLOCK";
+    }
     default: {
       throw ConversionException(StringUtil::Format(
           "No string conversion for LogRecordType value '%d'",
@@ -2088,6 +2141,8 @@ LogRecordType StringToLogRecordType(const std::string& str) {
     return LOGRECORD_TYPE_WAL_TUPLE_DELETE;
   } else if (upper_str == "WAL_TUPLE_UPDATE") {
     return LOGRECORD_TYPE_WAL_TUPLE_UPDATE;
+  } else if (upper_str == "WAL_TUPLE_PARTIAL_UPDATE") {
+    return LOGRECORD_TYPE_WAL_TUPLE_PARTIAL_UPDATE;
   } else if (upper_str == "WBL_TUPLE_INSERT") {
     return LOGRECORD_TYPE_WBL_TUPLE_INSERT;
   } else if (upper_str == "WBL_TUPLE_DELETE") {
@@ -2096,6 +2151,10 @@ LogRecordType StringToLogRecordType(const std::string& str) {
     return LOGRECORD_TYPE_WBL_TUPLE_UPDATE;
   } else if (upper_str == "ITERATION_DELIMITER") {
     return LOGRECORD_TYPE_ITERATION_DELIMITER;
+  } else if (upper_str == "CHECKPOINT_TILE_GROUP") {
+    return LOGRECORD_TYPE_CHECKPOINT_TILE_GROUP;
+  } else if (upper_str == "COMPRESSED_BLOCK") {
+    return LOGRECORD_TYPE_COMPRESSED_BLOCK;
   } else {
     throw ConversionException(StringUtil::Format(
         "No LogRecordType conversion from string '%s'", upper_str.c_str()));
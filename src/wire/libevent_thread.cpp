@@ -15,6 +15,7 @@
 #include <vector>
 #include "boost/thread/future.hpp"
 #include "common/init.h"
+#include "common/numa_util.h"
 #include "common/thread_pool.h"
 #include "wire/libevent_server.h"
 
@@ -54,6 +55,11 @@ LibeventMasterThread::LibeventMasterThread(const int num_threads,
  * Start with worker event loop
  */
 void LibeventMasterThread::StartWorker(LibeventWorkerThread *worker_thread) {
+  // Workers are pinned to the NUMA nodes in turn
+  if (FLAGS_numa_pin_threads) {
+    NumaUtil::PinCurrentThread(worker_thread->GetThreadID() %
+                               NumaUtil::GetNodeCount());
+  }
   event_base_loop(worker_thread->GetEventBase(), 0);
 }
 
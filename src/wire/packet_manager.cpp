@@ -888,6 +888,7 @@ bool PacketManager::ProcessPacket(InputPacket *pkt) {
     case NetworkMessageType::SIMPLE_QUERY_COMMAND: {
       LOG_TRACE("SIMPLE_QUERY_COMMAND");
       ExecQueryMessage(pkt);
+      traffic_cop_->WaitForPipelinedCommits();
       force_flush = true;
     } break;
     case NetworkMessageType::PARSE_COMMAND: {
@@ -908,6 +909,8 @@ bool PacketManager::ProcessPacket(InputPacket *pkt) {
     } break;
     case NetworkMessageType::SYNC_COMMAND: {
       LOG_TRACE("SYNC_COMMAND");
+      // acknowledge the autocommit statements of the batch at once
+      traffic_cop_->WaitForPipelinedCommits();
       SendReadyForQuery(txn_state_);
       force_flush = true;
     } break;
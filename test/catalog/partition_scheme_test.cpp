@@ -0,0 +1,95 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// partition_scheme_test.cpp
+//
+// Identification: test/catalog/partition_scheme_test.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "common/harness.h"
+
+#include "catalog/partition_scheme.h"
+#include "common/exception.h"
+#include "type/value_factory.h"
+
+namespace peloton {
+namespace test {
+
+//===--------------------------------------------------------------------===//
+// Partition Scheme Tests
+//===--------------------------------------------------------------------===//
+
+class PartitionSchemeTests : public PelotonTest {};
+
+TEST_F(PartitionSchemeTests, RangePartitionTest) {
+  // The bounds are sorted by the scheme
+  auto scheme = catalog::PartitionScheme::CreateRange(
+      1, type::Type::INTEGER, {type::ValueFactory::GetIntegerValue(200),
+                               type::ValueFactory::GetIntegerValue(100)});
+  EXPECT_EQ(PartitionType::RANGE, scheme->GetPartitionType());
+  EXPECT_EQ(1, scheme->GetColumnId());
+  EXPECT_EQ(3, scheme->GetPartitionCount());
+
+  EXPECT_EQ(0, scheme->GetPartition(type::ValueFactory::GetIntegerValue(99)));
+  EXPECT_EQ(1, scheme->GetPartition(type::ValueFactory::GetIntegerValue(100)));
+  EXPECT_EQ(1, scheme->GetPartition(type::ValueFactory::GetIntegerValue(199)));
+  EXPECT_EQ(2, scheme->GetPartition(type::ValueFactory::GetIntegerValue(200)));
+  auto null_value =
+      type::ValueFactory::GetNullValueByType(type::Type::INTEGER);
+  EXPECT_EQ(0, scheme->GetPartition(null_value));
+
+  // Values of other types are cast to the column type
+  EXPECT_EQ(2, scheme->GetPartition(type::ValueFactory::GetBigIntValue(500)));
+
+  auto value = type::ValueFactory::GetIntegerValue(150);
+  EXPECT_EQ(std::vector<bool>({false, true, false}),
+            scheme->GetPartitions(ExpressionType::COMPARE_EQUAL, value));
+  EXPECT_EQ(std::vector<bool>({true, true, false}),
+            scheme->GetPartitions(ExpressionType::COMPARE_LESSTHAN, value));
+  EXPECT_EQ(std::vector<bool>({false, true, true}),
+            scheme->GetPartitions(
+                ExpressionType::COMPARE_GREATERTHANOREQUALTO, value));
+  EXPECT_EQ(std::vector<bool>({true, true, true}),
+            scheme->GetPartitions(ExpressionType::COMPARE_NOTEQUAL, value));
+
+  EXPECT_THROW(catalog::PartitionScheme::CreateRange(0, type::Type::INTEGER,
+                                                     {}),
+               CatalogException);
+  EXPECT_THROW(catalog::PartitionScheme::CreateRange(
+                   0, type::Type::INTEGER,
+                   {type::ValueFactory::GetIntegerValue(1),
+                    type::ValueFactory::GetIntegerValue(1)}),
+               CatalogException);
+}
+
+TEST_F(PartitionSchemeTests, HashPartitionTest) {
+  auto scheme =
+      catalog::PartitionScheme::CreateHash(0, type::Type::VARCHAR, 4);
+  EXPECT_EQ(PartitionType::HASH, scheme->GetPartitionType());
+  EXPECT_EQ(4, scheme->GetPartitionCount());
+
+  auto value = type::ValueFactory::GetVarcharValue("peloton");
+  oid_t partition = scheme->GetPartition(value);
+  EXPECT_LT(partition, 4);
+  EXPECT_EQ(partition, scheme->GetPartition(
+                           type::ValueFactory::GetVarcharValue("peloton")));
+
+  // Only equality picks a single hash partition
+  auto partitions =
+      scheme->GetPartitions(ExpressionType::COMPARE_EQUAL, value);
+  for (oid_t partition_itr = 0; partition_itr < 4; partition_itr++) {
+    EXPECT_EQ(partition_itr == partition, partitions[partition_itr]);
+  }
+  EXPECT_EQ(std::vector<bool>(4, true),
+            scheme->GetPartitions(ExpressionType::COMPARE_LESSTHAN, value));
+
+  EXPECT_THROW(catalog::PartitionScheme::CreateHash(0, type::Type::INTEGER, 0),
+               CatalogException);
+}
+
+}  // End test namespace
+}  // End peloton namespace
@@ -0,0 +1,88 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// numa_util_test.cpp
+//
+// Identification: test/common/numa_util_test.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "common/harness.h"
+
+#include "common/numa_util.h"
+#include "configuration/configuration.h"
+#include "executor/executor_tests_util.h"
+#include "storage/data_table.h"
+#include "storage/tile_group.h"
+
+namespace peloton {
+namespace test {
+
+//===--------------------------------------------------------------------===//
+// NUMA Util Tests
+//===--------------------------------------------------------------------===//
+
+class NumaUtilTests : public PelotonTest {};
+
+TEST_F(NumaUtilTests, ParseListTest) {
+  EXPECT_EQ(std::vector<int>({0}), NumaUtil::ParseList("0"));
+  EXPECT_EQ(std::vector<int>({0, 1, 2, 3, 8, 10, 11}),
+            NumaUtil::ParseList("0-3,8,10-11\n"));
+  EXPECT_TRUE(NumaUtil::ParseList("").empty());
+  EXPECT_TRUE(NumaUtil::ParseList("3-1").empty());
+}
+
+TEST_F(NumaUtilTests, TopologyTest) {
+  int node_count = NumaUtil::GetNodeCount();
+  EXPECT_GE(node_count, 1);
+
+  int current_node = NumaUtil::GetCurrentNode();
+  EXPECT_GE(current_node, 0);
+  EXPECT_LT(current_node, node_count);
+
+  // Every cpu belongs to the node it is listed under
+  for (int node = 0; node < node_count; node++) {
+    for (auto cpu : NumaUtil::GetNodeCpus(node)) {
+      EXPECT_EQ(node, NumaUtil::GetNodeOfCpu(cpu));
+    }
+  }
+
+  // Placing memory on a node leaves it usable
+  std::vector<char> buffer(1 << 16);
+  NumaUtil::PlaceMemory(buffer.data(), buffer.size(), current_node);
+  buffer.back() = 1;
+  EXPECT_EQ(1, buffer.back());
+}
+
+TEST_F(NumaUtilTests, TileGroupPlacementTest) {
+  // Tile groups are not placed unless asked for
+  std::unique_ptr<storage::DataTable> data_table(
+      ExecutorTestsUtil::CreateTable(TESTS_TUPLES_PER_TILEGROUP, false));
+  for (size_t tile_group_itr = 0;
+       tile_group_itr < data_table->GetTileGroupCount(); tile_group_itr++) {
+    auto tile_group = data_table->GetTileGroup(tile_group_itr);
+    EXPECT_EQ(NUMA_NODE_ANY, tile_group->GetNumaNode());
+  }
+
+  // Tile groups are only placed on hosts with several nodes
+  FLAGS_numa_placement = true;
+  std::unique_ptr<storage::DataTable> placed_table(
+      ExecutorTestsUtil::CreateTable(TESTS_TUPLES_PER_TILEGROUP, false));
+  FLAGS_numa_placement = false;
+  for (size_t tile_group_itr = 0;
+       tile_group_itr < placed_table->GetTileGroupCount(); tile_group_itr++) {
+    auto tile_group = placed_table->GetTileGroup(tile_group_itr);
+    if (NumaUtil::GetNodeCount() == 1) {
+      EXPECT_EQ(NUMA_NODE_ANY, tile_group->GetNumaNode());
+    } else {
+      EXPECT_GE(tile_group->GetNumaNode(), 0);
+      EXPECT_LT(tile_group->GetNumaNode(), NumaUtil::GetNodeCount());
+    }
+  }
+}
+
+}  // End test namespace
+}  // End peloton namespace
@@ -0,0 +1,58 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// lock_table_test.cpp
+//
+// Identification: test/concurrency/lock_table_test.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <thread>
+
+#include "common/harness.h"
+
+#include "concurrency/lock_table.h"
+#include "storage/tile_group_header.h"
+
+namespace peloton {
+namespace test {
+
+//===--------------------------------------------------------------------===//
+// Lock Table Tests
+//===--------------------------------------------------------------------===//
+
+class LockTableTests : public PelotonTest {};
+
+TEST_F(LockTableTests, WaitForReleaseTest) {
+  auto &lock_table = concurrency::LockTable::GetInstance();
+  storage::TileGroupHeader header(BackendType::MM, 4);
+  ItemPointer location(1, 2);
+  const txn_id_t owner = 10;
+
+  // Not owned by the owner any more
+  header.SetTransactionId(location.offset, INITIAL_TXN_ID);
+  auto deadline =
+      std::chrono::steady_clock::now() + std::chrono::milliseconds(100);
+  EXPECT_TRUE(lock_table.WaitForRelease(location, &header, owner, deadline));
+
+  // The owner keeps the tuple past the deadline
+  header.SetTransactionId(location.offset, owner);
+  deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(1);
+  EXPECT_FALSE(lock_table.WaitForRelease(location, &header, owner, deadline));
+
+  // The owner releases the tuple while the waiter is parked
+  std::thread releaser([&] {
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    header.SetTransactionId(location.offset, INITIAL_TXN_ID);
+    lock_table.NotifyRelease(location);
+  });
+  deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+  EXPECT_TRUE(lock_table.WaitForRelease(location, &header, owner, deadline));
+  releaser.join();
+}
+
+}  // End test namespace
+}  // End peloton namespace
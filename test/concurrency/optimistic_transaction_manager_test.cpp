@@ -0,0 +1,90 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// optimistic_transaction_manager_test.cpp
+//
+// Identification: test/concurrency/optimistic_transaction_manager_test.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+
+#include "common/harness.h"
+#include "concurrency/transaction_tests_util.h"
+
+namespace peloton {
+
+namespace test {
+
+//===--------------------------------------------------------------------===//
+// Optimistic Transaction Manager Tests
+//===--------------------------------------------------------------------===//
+
+class OptimisticTransactionManagerTests : public PelotonTest {};
+
+TEST_F(OptimisticTransactionManagerTests, ReadValidationTest) {
+  concurrency::TransactionManagerFactory::Configure(
+      ConcurrencyType::OPTIMISTIC);
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  std::unique_ptr<storage::DataTable> table(
+      TransactionTestsUtil::CreateTable());
+
+  // the version read by txn 0 is overwritten before it commits
+  {
+    TransactionScheduler scheduler(2, table.get(), &txn_manager);
+    scheduler.Txn(0).Read(0);
+    scheduler.Txn(1).Update(0, 1);
+    scheduler.Txn(1).Commit();
+    scheduler.Txn(0).Commit();
+
+    scheduler.Run();
+
+    EXPECT_EQ(ResultType::SUCCESS, scheduler.schedules[1].txn_result);
+    EXPECT_EQ(ResultType::ABORTED, scheduler.schedules[0].txn_result);
+    EXPECT_EQ(0, scheduler.schedules[0].results[0]);
+  }
+
+  // the version read by txn 0 is owned by a writer when it commits
+  {
+    TransactionScheduler scheduler(2, table.get(), &txn_manager);
+    scheduler.Txn(0).Read(1);
+    scheduler.Txn(1).Update(1, 2);
+    scheduler.Txn(0).Commit();
+    scheduler.Txn(1).Commit();
+
+    scheduler.Run();
+
+    EXPECT_EQ(ResultType::ABORTED, scheduler.schedules[0].txn_result);
+    EXPECT_EQ(ResultType::SUCCESS, scheduler.schedules[1].txn_result);
+  }
+
+  // readers of the same tuples do not conflict
+  {
+    TransactionScheduler scheduler(3, table.get(), &txn_manager);
+    scheduler.Txn(0).Read(0);
+    scheduler.Txn(1).Read(0);
+    scheduler.Txn(0).Update(2, 3);
+    scheduler.Txn(1).Read(3);
+    scheduler.Txn(1).Commit();
+    scheduler.Txn(0).Commit();
+    scheduler.Txn(2).Read(0);
+    scheduler.Txn(2).Read(2);
+    scheduler.Txn(2).Commit();
+
+    scheduler.Run();
+
+    EXPECT_EQ(ResultType::SUCCESS, scheduler.schedules[0].txn_result);
+    EXPECT_EQ(ResultType::SUCCESS, scheduler.schedules[1].txn_result);
+    EXPECT_EQ(ResultType::SUCCESS, scheduler.schedules[2].txn_result);
+    EXPECT_EQ(1, scheduler.schedules[2].results[0]);
+    EXPECT_EQ(3, scheduler.schedules[2].results[1]);
+  }
+
+  concurrency::TransactionManagerFactory::Configure(
+      ConcurrencyType::TIMESTAMP_ORDERING);
+}
+
+}  // End test namespace
+}  // End peloton namespace
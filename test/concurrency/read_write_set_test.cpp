@@ -0,0 +1,76 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// read_write_set_test.cpp
+//
+// Identification: test/concurrency/read_write_set_test.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "common/harness.h"
+
+#include "concurrency/read_write_set.h"
+#include "concurrency/transaction.h"
+
+namespace peloton {
+namespace test {
+
+//===--------------------------------------------------------------------===//
+// Read Write Set Tests
+//===--------------------------------------------------------------------===//
+
+class ReadWriteSetTests : public PelotonTest {};
+
+TEST_F(ReadWriteSetTests, LookupAndSortTest) {
+  // Enough entries to switch from scanning to the hash index
+  const oid_t tile_group_count = 7;
+  const oid_t slot_count = 11;
+
+  concurrency::ReadWriteSet rw_set;
+  for (oid_t slot = 0; slot < slot_count; slot++) {
+    for (oid_t block = tile_group_count; block > 0; block--) {
+      rw_set.Insert(ItemPointer(block, slot), RWType::READ);
+    }
+  }
+  EXPECT_EQ(tile_group_count * slot_count, rw_set.Size());
+
+  *rw_set.Find(ItemPointer(3, 4)) = RWType::UPDATE;
+  EXPECT_TRUE(rw_set.Find(ItemPointer(0, 4)) == nullptr);
+  EXPECT_TRUE(rw_set.Find(ItemPointer(3, slot_count)) == nullptr);
+
+  rw_set.SortByTileGroup();
+  ItemPointer previous(0, 0);
+  for (auto &entry : rw_set) {
+    EXPECT_TRUE(previous < entry.location);
+    previous = entry.location;
+  }
+
+  // Lookups still work after sorting
+  EXPECT_EQ(RWType::UPDATE, *rw_set.Find(ItemPointer(3, 4)));
+  EXPECT_EQ(RWType::READ, *rw_set.Find(ItemPointer(7, 10)));
+}
+
+TEST_F(ReadWriteSetTests, TransactionRecordTest) {
+  // Recycled buffers start out empty
+  for (int txn_itr = 0; txn_itr < 3; txn_itr++) {
+    concurrency::Transaction txn(txn_itr, 0);
+    EXPECT_TRUE(txn.GetReadWriteSet().IsEmpty());
+
+    txn.RecordRead(ItemPointer(1, 1));
+    txn.RecordReadOwn(ItemPointer(1, 1));
+    txn.RecordUpdate(ItemPointer(1, 1));
+    txn.RecordInsert(ItemPointer(2, 0));
+    EXPECT_TRUE(txn.RecordDelete(ItemPointer(2, 0)));
+
+    EXPECT_EQ(RWType::UPDATE, txn.GetRWType(ItemPointer(1, 1)));
+    EXPECT_EQ(RWType::INS_DEL, txn.GetRWType(ItemPointer(2, 0)));
+    EXPECT_EQ(RWType::INVALID, txn.GetRWType(ItemPointer(1, 2)));
+    EXPECT_EQ(2U, txn.GetReadWriteSet().Size());
+  }
+}
+
+}  // End test namespace
+}  // End peloton namespace
@@ -11,8 +11,12 @@
 //===----------------------------------------------------------------------===//
 
 
+#include <chrono>
+#include <thread>
+
 #include "common/harness.h"
 #include "concurrency/transaction_tests_util.h"
+#include "configuration/configuration.h"
 
 namespace peloton {
 
@@ -29,5 +33,84 @@ TEST_F(TimestampOrderingTransactionManagerTests, Test) {
   EXPECT_TRUE(true);
 }
 
+// Under wait-die an older transaction waits for the younger owner of a tuple,
+// and a younger transaction gives up on an older owner right away
+TEST_F(TimestampOrderingTransactionManagerTests, LockWaitTest) {
+  concurrency::TransactionManagerFactory::Configure(
+      ConcurrencyType::TIMESTAMP_ORDERING);
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  std::unique_ptr<storage::DataTable> table(
+      TransactionTestsUtil::CreateTable());
+  auto lock_wait_timeout = FLAGS_lock_wait_timeout;
+  FLAGS_lock_wait_timeout = 10 * 1000 * 1000;
+
+  // The younger owner aborts its update, the older waiter updates the tuple
+  {
+    auto older_txn = txn_manager.BeginTransaction();
+    auto younger_txn = txn_manager.BeginTransaction();
+    EXPECT_TRUE(
+        TransactionTestsUtil::ExecuteUpdate(younger_txn, table.get(), 0, 1));
+
+    bool updated = false;
+    std::thread waiter([&] {
+      updated =
+          TransactionTestsUtil::ExecuteUpdate(older_txn, table.get(), 0, 2);
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    txn_manager.AbortTransaction(younger_txn);
+    waiter.join();
+
+    EXPECT_TRUE(updated);
+    EXPECT_EQ(ResultType::SUCCESS, txn_manager.CommitTransaction(older_txn));
+
+    auto read_txn = txn_manager.BeginTransaction();
+    int result = -1;
+    EXPECT_TRUE(
+        TransactionTestsUtil::ExecuteRead(read_txn, table.get(), 0, result));
+    EXPECT_EQ(2, result);
+    txn_manager.CommitTransaction(read_txn);
+  }
+
+  // The younger owner commits its update, which the older waiter can not see
+  {
+    auto older_txn = txn_manager.BeginTransaction();
+    auto younger_txn = txn_manager.BeginTransaction();
+    EXPECT_TRUE(
+        TransactionTestsUtil::ExecuteUpdate(younger_txn, table.get(), 1, 1));
+
+    bool updated = true;
+    std::thread waiter([&] {
+      updated =
+          TransactionTestsUtil::ExecuteUpdate(older_txn, table.get(), 1, 2);
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    EXPECT_EQ(ResultType::SUCCESS, txn_manager.CommitTransaction(younger_txn));
+    waiter.join();
+
+    EXPECT_FALSE(updated);
+    EXPECT_EQ(ResultType::FAILURE, older_txn->GetResult());
+    txn_manager.AbortTransaction(older_txn);
+  }
+
+  // The younger transaction dies instead of waiting for the older owner
+  {
+    auto older_txn = txn_manager.BeginTransaction();
+    auto younger_txn = txn_manager.BeginTransaction();
+    EXPECT_TRUE(
+        TransactionTestsUtil::ExecuteUpdate(older_txn, table.get(), 2, 1));
+
+    auto start = std::chrono::steady_clock::now();
+    EXPECT_FALSE(
+        TransactionTestsUtil::ExecuteUpdate(younger_txn, table.get(), 2, 2));
+    EXPECT_LT(std::chrono::steady_clock::now() - start,
+              std::chrono::seconds(1));
+    EXPECT_EQ(ResultType::FAILURE, younger_txn->GetResult());
+    txn_manager.AbortTransaction(younger_txn);
+    EXPECT_EQ(ResultType::SUCCESS, txn_manager.CommitTransaction(older_txn));
+  }
+
+  FLAGS_lock_wait_timeout = lock_wait_timeout;
+}
+
 }  // End test namespace
 }  // End peloton namespace
@@ -230,5 +230,44 @@ TEST_F(TransactionTests, AbortTest) {
   }
 }
 
+TEST_F(TransactionTests, TransactionReuseTest) {
+  for (auto test_type : TEST_TYPES) {
+    concurrency::TransactionManagerFactory::Configure(test_type);
+    auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+    std::unique_ptr<storage::DataTable> table(
+        TransactionTestsUtil::CreateTable());
+    auto tile_group_id = table->GetTileGroup(0)->GetTileGroupId();
+
+    auto txn = txn_manager.BeginTransaction();
+    txn->RecordRead(ItemPointer(tile_group_id, 0));
+    txn->RecordRead(ItemPointer(tile_group_id, 1));
+    txn->RecordUpdatedColumns(ItemPointer(tile_group_id, 1), {0, 2});
+    txn->RecordUpdatedColumns(ItemPointer(tile_group_id, 2), {1});
+    txn->RecordUpdatedColumns(ItemPointer(tile_group_id, 1), {1, 2});
+    std::vector<oid_t> updated_columns;
+    EXPECT_TRUE(
+        txn->GetUpdatedColumns(ItemPointer(tile_group_id, 1), updated_columns));
+    EXPECT_EQ(std::vector<oid_t>({0, 1, 2}), updated_columns);
+    EXPECT_TRUE(
+        txn->GetUpdatedColumns(ItemPointer(tile_group_id, 2), updated_columns));
+    EXPECT_EQ(std::vector<oid_t>({1}), updated_columns);
+    EXPECT_FALSE(
+        txn->GetUpdatedColumns(ItemPointer(tile_group_id, 0), updated_columns));
+    txn->SetResult(ResultType::FAILURE);
+    txn_manager.AbortTransaction(txn);
+
+    // The ended transaction is reused by this thread, reset
+    auto reused_txn = txn_manager.BeginTransaction();
+    EXPECT_EQ(txn, reused_txn);
+    EXPECT_TRUE(reused_txn->GetReadWriteSet().IsEmpty());
+    EXPECT_TRUE(reused_txn->IsGCSetEmpty());
+    EXPECT_FALSE(reused_txn->GetUpdatedColumns(ItemPointer(tile_group_id, 1),
+                                               updated_columns));
+    EXPECT_TRUE(reused_txn->IsReadOnly());
+    EXPECT_EQ(ResultType::SUCCESS, reused_txn->GetResult());
+    txn_manager.CommitTransaction(reused_txn);
+  }
+}
+
 }  // End test namespace
 }  // End peloton namespace
@@ -643,6 +643,110 @@ TEST_F(AggregateTests, HashSumGroupByTest) {
   //  EXPECT_GE(3, result_tile->GetTupleCount());
 }
 
+TEST_F(AggregateTests, HashSpillGroupByTest) {
+  // SELECT b, d, COUNT(*) from table GROUP BY b, d;
+  // with a query memory budget too small for the groups
+  const int tuple_count = 100;
+  const int tile_group_count = 4;
+
+  // Create a table with unique b and d, and wrap it in logical tiles
+  auto& txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto txn = txn_manager.BeginTransaction();
+  std::unique_ptr<storage::DataTable> data_table(
+      ExecutorTestsUtil::CreateTable(tuple_count, false));
+  ExecutorTestsUtil::PopulateTable(data_table.get(),
+                                   tile_group_count * tuple_count, false,
+                                   false, false, txn);
+  txn_manager.CommitTransaction(txn);
+
+  // (1-5) Setup plan node
+
+  // 1) Set up group-by columns
+  std::vector<oid_t> group_by_columns = {1, 3};
+
+  // 2) Set up project info
+  DirectMapList direct_map_list = {{0, {0, 1}}, {1, {0, 3}}, {2, {1, 0}}};
+
+  std::unique_ptr<const planner::ProjectInfo> proj_info(
+      new planner::ProjectInfo(TargetList(), std::move(direct_map_list)));
+
+  // 3) Set up unique aggregates
+  std::vector<planner::AggregatePlan::AggTerm> agg_terms;
+  planner::AggregatePlan::AggTerm countStar(ExpressionType::AGGREGATE_COUNT_STAR,
+                                            nullptr);
+  agg_terms.push_back(countStar);
+
+  // 4) Set up predicate (empty)
+  std::unique_ptr<const expression::AbstractExpression> predicate(nullptr);
+
+  // 5) Create output table schema
+  auto data_table_schema = data_table.get()->GetSchema();
+  std::vector<catalog::Column> columns = {
+      data_table_schema->GetColumn(1), data_table_schema->GetColumn(3),
+      catalog::Column(type::Type::BIGINT,
+                      type::Type::GetTypeSize(type::Type::BIGINT), "COUNT",
+                      true)};
+  std::shared_ptr<const catalog::Schema> output_table_schema(
+      new catalog::Schema(columns));
+
+  // OK) Create the plan node
+  planner::AggregatePlan node(std::move(proj_info), std::move(predicate),
+                              std::move(agg_terms), std::move(group_by_columns),
+                              output_table_schema, AggregateType::HASH);
+
+  // Create and set up executor
+  txn = txn_manager.BeginTransaction();
+  std::unique_ptr<executor::ExecutorContext> context(
+      new executor::ExecutorContext(txn));
+  context->SetMemoryBudget(1024);
+
+  executor::AggregateExecutor executor(&node, context.get());
+  MockExecutor child_executor;
+  executor.AddChild(&child_executor);
+
+  EXPECT_CALL(child_executor, DInit()).WillOnce(Return(true));
+
+  std::vector<std::unique_ptr<executor::LogicalTile>> source_logical_tiles;
+  for (int tile_group_itr = 0; tile_group_itr < tile_group_count;
+       tile_group_itr++) {
+    source_logical_tiles.emplace_back(
+        executor::LogicalTileFactory::WrapTileGroup(
+            data_table->GetTileGroup(tile_group_itr)));
+  }
+
+  EXPECT_CALL(child_executor, DExecute())
+      .WillOnce(Return(true))
+      .WillOnce(Return(true))
+      .WillOnce(Return(true))
+      .WillOnce(Return(true))
+      .WillOnce(Return(false));
+
+  EXPECT_CALL(child_executor, GetOutput())
+      .WillOnce(Return(source_logical_tiles[0].release()))
+      .WillOnce(Return(source_logical_tiles[1].release()))
+      .WillOnce(Return(source_logical_tiles[2].release()))
+      .WillOnce(Return(source_logical_tiles[3].release()));
+
+  EXPECT_TRUE(executor.Init());
+
+  // Every group comes out once, with all of its columns
+  std::set<int32_t> groups;
+  while (executor.Execute()) {
+    std::unique_ptr<executor::LogicalTile> result_tile(executor.GetOutput());
+    for (oid_t tuple_id : *result_tile) {
+      auto b = result_tile->GetValue(tuple_id, 0).GetAs<int32_t>();
+      EXPECT_TRUE(groups.insert(b).second);
+      EXPECT_EQ(std::to_string(b + 2),
+                result_tile->GetValue(tuple_id, 1).ToString());
+      EXPECT_EQ(1, result_tile->GetValue(tuple_id, 2).GetAs<int64_t>());
+    }
+  }
+  EXPECT_EQ(static_cast<size_t>(tile_group_count * tuple_count),
+            groups.size());
+
+  txn_manager.CommitTransaction(txn);
+}
+
 TEST_F(AggregateTests, HashCountDistinctGroupByTest) {
   // SELECT a, COUNT(b), COUNT(DISTINCT b) from table group by a
   const int tuple_count = TESTS_TUPLES_PER_TILEGROUP;
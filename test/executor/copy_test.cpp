@@ -20,7 +20,10 @@
 #include "executor/seq_scan_executor.h"
 #include "optimizer/simple_optimizer.h"
 #include "parser/parser.h"
+#include "planner/copy_plan.h"
 #include "planner/seq_scan_plan.h"
+#include "storage/data_table.h"
+#include "storage/tile_group.h"
 #include "statistics/stats_tests_util.h"
 #include "tcop/tcop.h"
 
@@ -136,5 +139,196 @@ TEST_F(CopyTests, Copying) {
   txn_manager.CommitTransaction(txn);
 }
 
+// Plan and execute a COPY statement in its own transaction
+void ExecuteCopy(const std::string &copy_sql, size_t *tuples_imported,
+                 size_t *bytes_written = nullptr) {
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  optimizer::SimpleOptimizer optimizer;
+
+  auto &peloton_parser = parser::Parser::GetInstance();
+  auto copy_stmt = peloton_parser.BuildParseTree(copy_sql);
+  auto copy_plan = optimizer.BuildPelotonPlanTree(copy_stmt);
+
+  auto txn = txn_manager.BeginTransaction();
+  std::unique_ptr<executor::ExecutorContext> context(
+      new executor::ExecutorContext(txn));
+  executor::CopyExecutor copy_executor(copy_plan.get(), context.get());
+  std::unique_ptr<executor::AbstractExecutor> seq_scan_executor;
+  if (copy_plan->GetChildren().size() == 1) {
+    seq_scan_executor.reset(new executor::SeqScanExecutor(
+        copy_plan->GetChildren()[0].get(), context.get()));
+    copy_executor.AddChild(seq_scan_executor.get());
+  }
+  EXPECT_TRUE(copy_executor.Init());
+  try {
+    copy_executor.Execute();
+  } catch (Exception &e) {
+    txn_manager.AbortTransaction(txn);
+    throw;
+  }
+  *tuples_imported = copy_executor.GetTotalTuplesImported();
+  if (bytes_written != nullptr) {
+    *bytes_written = copy_executor.GetTotalBytesWritten();
+  }
+  txn_manager.CommitTransaction(txn);
+}
+
+// Write rows with quoted delimiters, quotes and empty fields for NULL
+void WriteImportFile(const std::string &file_path, int num_tuples) {
+  FILE *file = fopen(file_path.c_str(), "w");
+  ASSERT_NE(nullptr, file);
+  for (int i = 0; i < num_tuples; i++) {
+    if (i % 3 == 0) {
+      fprintf(file, "%d,\"dept, \"\"%d\"\"\"\n", i, i);
+    } else if (i % 3 == 1) {
+      fprintf(file, "%d,\n", i);
+    } else {
+      fprintf(file, "%d,dept_%d\n", i, i);
+    }
+  }
+  fclose(file);
+}
+
+// Every tuple is committed and holds the values of the import file
+void CheckImportedTable(storage::DataTable *table, int num_tuples) {
+  EXPECT_EQ(num_tuples, table->GetTupleCount());
+
+  int tuple_count = 0;
+  for (oid_t tile_group_itr = 0; tile_group_itr < table->GetTileGroupCount();
+       tile_group_itr++) {
+    auto tile_group = table->GetTileGroup(tile_group_itr);
+    auto tile_group_header = tile_group->GetHeader();
+    for (oid_t tuple_id = 0; tuple_id < tile_group->GetNextTupleSlot();
+         tuple_id++) {
+      if (tile_group_header->GetTransactionId(tuple_id) != INITIAL_TXN_ID) {
+        continue;
+      }
+      EXPECT_NE(MAX_CID, tile_group_header->GetBeginCommitId(tuple_id));
+      int id = tile_group->GetValue(tuple_id, 0).GetAs<int32_t>();
+      auto name = tile_group->GetValue(tuple_id, 1);
+      if (id % 3 == 0) {
+        EXPECT_EQ("dept, \"" + std::to_string(id) + "\"", name.ToString());
+      } else if (id % 3 == 1) {
+        EXPECT_TRUE(name.IsNull());
+      } else {
+        EXPECT_EQ("dept_" + std::to_string(id), name.ToString());
+      }
+      tuple_count++;
+    }
+  }
+  EXPECT_EQ(num_tuples, tuple_count);
+}
+
+TEST_F(CopyTests, Importing) {
+  auto catalog = catalog::Catalog::GetInstance();
+  catalog->CreateDatabase("emp_db", nullptr);
+  StatsTestsUtil::CreateTable(false);
+
+  int num_tuples = 5000;
+  std::string file_path = "./copy_input.csv";
+  WriteImportFile(file_path, num_tuples);
+
+  size_t tuples_imported = 0;
+  ExecuteCopy("COPY emp_db.department_table FROM '" + file_path +
+                  "' DELIMITER ',';",
+              &tuples_imported);
+  EXPECT_EQ(num_tuples, tuples_imported);
+  CheckImportedTable(catalog->GetTableWithName("emp_db", "department_table"),
+                     num_tuples);
+  remove(file_path.c_str());
+
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto txn = txn_manager.BeginTransaction();
+  catalog->DropDatabaseWithName("emp_db", txn);
+  txn_manager.CommitTransaction(txn);
+}
+
+TEST_F(CopyTests, BinaryRoundTrip) {
+  auto catalog = catalog::Catalog::GetInstance();
+  catalog->CreateDatabase("emp_db", nullptr);
+  StatsTestsUtil::CreateTable(false);
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+
+  int num_tuples = 5000;
+  std::string csv_file_path = "./copy_input.csv";
+  std::string binary_file_path = "./copy_output.dat";
+  WriteImportFile(csv_file_path, num_tuples);
+
+  size_t tuples_imported = 0;
+  size_t bytes_written = 0;
+  ExecuteCopy("COPY emp_db.department_table FROM '" + csv_file_path +
+                  "' DELIMITER ',';",
+              &tuples_imported);
+  ExecuteCopy("COPY emp_db.department_table TO '" + binary_file_path +
+                  "' WITH BINARY;",
+              &tuples_imported, &bytes_written);
+  EXPECT_LT(0, bytes_written);
+
+  // Load the export into a fresh table
+  auto txn = txn_manager.BeginTransaction();
+  catalog->DropTable("emp_db", "department_table", txn);
+  txn_manager.CommitTransaction(txn);
+  StatsTestsUtil::CreateTable(false);
+
+  ExecuteCopy("COPY emp_db.department_table FROM '" + binary_file_path +
+                  "' WITH BINARY;",
+              &tuples_imported);
+  EXPECT_EQ(num_tuples, tuples_imported);
+  CheckImportedTable(catalog->GetTableWithName("emp_db", "department_table"),
+                     num_tuples);
+  remove(csv_file_path.c_str());
+  remove(binary_file_path.c_str());
+
+  txn = txn_manager.BeginTransaction();
+  catalog->DropDatabaseWithName("emp_db", txn);
+  txn_manager.CommitTransaction(txn);
+}
+
+TEST_F(CopyTests, ImportingDuplicateKey) {
+  auto catalog = catalog::Catalog::GetInstance();
+  catalog->CreateDatabase("emp_db", nullptr);
+  StatsTestsUtil::CreateTable(true);
+
+  std::string file_path = "./copy_input.tsv";
+  FILE *file = fopen(file_path.c_str(), "w");
+  ASSERT_NE(nullptr, file);
+  fprintf(file, "1\tdept_1\n2\t\\N\n1\tdept_1_again\n");
+  fclose(file);
+
+  // The whole load fails and none of its tuples become visible
+  size_t tuples_imported = 0;
+  EXPECT_THROW(ExecuteCopy("COPY emp_db.department_table FROM '" +
+                               file_path + "' DELIMITER '\\t';",
+                           &tuples_imported),
+               ExecutorException);
+  EXPECT_EQ(0, tuples_imported);
+
+  auto table =
+      catalog->GetTableWithName("emp_db", "department_table");
+  EXPECT_EQ(0, table->GetTupleCount());
+  for (oid_t tile_group_itr = 0; tile_group_itr < table->GetTileGroupCount();
+       tile_group_itr++) {
+    auto tile_group = table->GetTileGroup(tile_group_itr);
+    for (oid_t tuple_id = 0; tuple_id < tile_group->GetNextTupleSlot();
+         tuple_id++) {
+      EXPECT_NE(INITIAL_TXN_ID,
+                tile_group->GetHeader()->GetTransactionId(tuple_id));
+    }
+  }
+
+  // and the indexes hold none of them
+  for (oid_t index_itr = 0; index_itr < table->GetIndexCount(); index_itr++) {
+    std::vector<ItemPointer *> index_entries;
+    table->GetIndex(index_itr)->ScanAllKeys(index_entries);
+    EXPECT_EQ(0, index_entries.size());
+  }
+  remove(file_path.c_str());
+
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto txn = txn_manager.BeginTransaction();
+  catalog->DropDatabaseWithName("emp_db", txn);
+  txn_manager.CommitTransaction(txn);
+}
+
 }  // End test namespace
 }  // End peloton namespace
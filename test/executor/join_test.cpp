@@ -10,6 +10,7 @@
 //
 //===----------------------------------------------------------------------===//
 
+#include <map>
 #include <memory>
 
 #include "common/harness.h"
@@ -18,6 +19,7 @@
 #include "executor/logical_tile_factory.h"
 #include "type/types.h"
 
+#include "executor/executor_context.h"
 #include "executor/hash_executor.h"
 #include "executor/hash_join_executor.h"
 #include "executor/index_scan_executor.h"
@@ -214,6 +216,186 @@ TEST_F(JoinTests, SpeedTest) {
   ExecuteNestedLoopJoinTest(JoinType::OUTER);
 }
 
+TEST_F(JoinTests, ParallelMergeJoinTest) {
+  MockExecutor left_table_scan_executor, right_table_scan_executor;
+
+  // Unsorted inputs, large enough to be sorted and joined by several workers
+  size_t tile_group_size = 1000;
+  size_t table_tile_group_count = 40;
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto txn = txn_manager.BeginTransaction();
+  std::unique_ptr<storage::DataTable> left_table(
+      ExecutorTestsUtil::CreateTable(tile_group_size));
+  ExecutorTestsUtil::PopulateTable(left_table.get(),
+                                   tile_group_size * table_tile_group_count,
+                                   false, true, false, txn);
+  std::unique_ptr<storage::DataTable> right_table(
+      ExecutorTestsUtil::CreateTable(tile_group_size));
+  ExecutorTestsUtil::PopulateTable(right_table.get(),
+                                   tile_group_size * table_tile_group_count,
+                                   false, true, false, txn);
+  txn_manager.CommitTransaction(txn);
+
+  // Expected matches on the join column
+  std::map<int32_t, size_t> left_counts, right_counts;
+  std::vector<std::unique_ptr<executor::LogicalTile>> left_tiles, right_tiles;
+  for (size_t tile_group_itr = 0; tile_group_itr < table_tile_group_count;
+       tile_group_itr++) {
+    left_tiles.emplace_back(executor::LogicalTileFactory::WrapTileGroup(
+        left_table->GetTileGroup(tile_group_itr)));
+    right_tiles.emplace_back(executor::LogicalTileFactory::WrapTileGroup(
+        right_table->GetTileGroup(tile_group_itr)));
+    for (oid_t tuple_id : *left_tiles.back()) {
+      left_counts[left_tiles.back()->GetValue(tuple_id, 1).GetAs<int32_t>()]++;
+    }
+    for (oid_t tuple_id : *right_tiles.back()) {
+      right_counts[right_tiles.back()->GetValue(tuple_id, 1)
+                       .GetAs<int32_t>()]++;
+    }
+  }
+  size_t expected_tuple_count = 0;
+  for (auto &left_count : left_counts) {
+    expected_tuple_count += left_count.second * right_counts[left_count.first];
+  }
+
+  ExpectNormalTileResults(table_tile_group_count, &left_table_scan_executor,
+                          left_tiles);
+  ExpectNormalTileResults(table_tile_group_count, &right_table_scan_executor,
+                          right_tiles);
+
+  auto join_clauses = CreateJoinClauses();
+  auto schema = CreateJoinSchema();
+  planner::MergeJoinPlan merge_join_node(JoinType::INNER, nullptr,
+                                         JoinTestsUtil::CreateProjection(),
+                                         schema, join_clauses);
+  executor::ExecutorContext context(nullptr);
+  executor::MergeJoinExecutor merge_join_executor(&merge_join_node, &context);
+  merge_join_executor.AddChild(&left_table_scan_executor);
+  merge_join_executor.AddChild(&right_table_scan_executor);
+
+  auto sort_workers = FLAGS_sort_workers;
+  FLAGS_sort_workers = 4;
+
+  size_t result_tuple_count = 0;
+  EXPECT_TRUE(merge_join_executor.Init());
+  while (merge_join_executor.Execute() == true) {
+    std::unique_ptr<executor::LogicalTile> result_logical_tile(
+        merge_join_executor.GetOutput());
+    for (oid_t tuple_id : *result_logical_tile) {
+      EXPECT_EQ(result_logical_tile->GetValue(tuple_id, 0)
+                    .CompareEquals(result_logical_tile->GetValue(tuple_id, 1)),
+                type::CMP_TRUE);
+      result_tuple_count++;
+    }
+  }
+
+  FLAGS_sort_workers = sort_workers;
+
+  EXPECT_EQ(expected_tuple_count, result_tuple_count);
+
+  // The buffered rows count against the budget of the query
+  EXPECT_LT(0, context.GetMemoryUsage());
+}
+
+TEST_F(JoinTests, SpilledHashJoinTest) {
+  // Duplicate join keys, and a query memory budget far too small for the
+  // hash table of the right table
+  size_t tile_group_size = 100;
+  size_t table_tile_group_count = 10;
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto txn = txn_manager.BeginTransaction();
+  std::unique_ptr<storage::DataTable> left_table(
+      ExecutorTestsUtil::CreateTable(tile_group_size));
+  ExecutorTestsUtil::PopulateTable(left_table.get(),
+                                   tile_group_size * table_tile_group_count,
+                                   false, true, false, txn);
+  std::unique_ptr<storage::DataTable> right_table(
+      ExecutorTestsUtil::CreateTable(tile_group_size));
+  ExecutorTestsUtil::PopulateTable(right_table.get(),
+                                   tile_group_size * table_tile_group_count,
+                                   false, true, false, txn);
+  txn_manager.CommitTransaction(txn);
+
+  for (auto join_type : {JoinType::INNER, JoinType::OUTER}) {
+    MockExecutor left_table_scan_executor, right_table_scan_executor;
+
+    // Expected matches on the join column
+    std::map<int32_t, size_t> left_counts, right_counts;
+    std::vector<std::unique_ptr<executor::LogicalTile>> left_tiles,
+        right_tiles;
+    for (size_t tile_group_itr = 0; tile_group_itr < table_tile_group_count;
+         tile_group_itr++) {
+      left_tiles.emplace_back(executor::LogicalTileFactory::WrapTileGroup(
+          left_table->GetTileGroup(tile_group_itr)));
+      right_tiles.emplace_back(executor::LogicalTileFactory::WrapTileGroup(
+          right_table->GetTileGroup(tile_group_itr)));
+      for (oid_t tuple_id : *left_tiles.back()) {
+        left_counts[left_tiles.back()->GetValue(tuple_id, 1)
+                        .GetAs<int32_t>()]++;
+      }
+      for (oid_t tuple_id : *right_tiles.back()) {
+        right_counts[right_tiles.back()->GetValue(tuple_id, 1)
+                         .GetAs<int32_t>()]++;
+      }
+    }
+    size_t expected_tuple_count = 0;
+    size_t expected_tuples_with_null = 0;
+    for (auto &left_count : left_counts) {
+      auto right_count = right_counts.find(left_count.first);
+      if (right_count != right_counts.end()) {
+        expected_tuple_count += left_count.second * right_count->second;
+      } else if (join_type == JoinType::OUTER) {
+        expected_tuples_with_null += left_count.second;
+      }
+    }
+    for (auto &right_count : right_counts) {
+      if (join_type == JoinType::OUTER &&
+          left_counts.find(right_count.first) == left_counts.end()) {
+        expected_tuples_with_null += right_count.second;
+      }
+    }
+    expected_tuple_count += expected_tuples_with_null;
+
+    ExpectNormalTileResults(table_tile_group_count, &left_table_scan_executor,
+                            left_tiles);
+    ExpectNormalTileResults(table_tile_group_count, &right_table_scan_executor,
+                            right_tiles);
+
+    std::vector<std::unique_ptr<const expression::AbstractExpression>>
+        hash_keys;
+    hash_keys.emplace_back(
+        new expression::TupleValueExpression(type::Type::INTEGER, 1, 1));
+    planner::HashPlan hash_plan_node(hash_keys);
+    auto schema = CreateJoinSchema();
+    planner::HashJoinPlan hash_join_plan_node(
+        join_type, nullptr, JoinTestsUtil::CreateProjection(), schema);
+
+    executor::ExecutorContext context(nullptr);
+    context.SetMemoryBudget(4 * 1024);
+    executor::HashExecutor hash_executor(&hash_plan_node, &context);
+    executor::HashJoinExecutor hash_join_executor(&hash_join_plan_node,
+                                                  &context);
+    hash_join_executor.AddChild(&left_table_scan_executor);
+    hash_join_executor.AddChild(&hash_executor);
+    hash_executor.AddChild(&right_table_scan_executor);
+
+    size_t result_tuple_count = 0;
+    size_t tuples_with_null = 0;
+    EXPECT_TRUE(hash_join_executor.Init());
+    while (hash_join_executor.Execute() == true) {
+      std::unique_ptr<executor::LogicalTile> result_logical_tile(
+          hash_join_executor.GetOutput());
+      result_tuple_count += result_logical_tile->GetTupleCount();
+      tuples_with_null += CountTuplesWithNullFields(result_logical_tile.get());
+      ValidateJoinLogicalTile(result_logical_tile.get());
+    }
+
+    EXPECT_TRUE(hash_executor.IsSpilled());
+    EXPECT_EQ(expected_tuple_count, result_tuple_count);
+    EXPECT_EQ(expected_tuples_with_null, tuples_with_null);
+  }
+}
+
 TEST_F(JoinTests, BasicNestedLoopTest) {
   LOG_TRACE("PlanNodeType::NESTLOOP");
   ExecuteNestedLoopJoinTest(JoinType::INNER);
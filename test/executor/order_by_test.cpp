@@ -21,9 +21,11 @@
 #include "planner/order_by_plan.h"
 #include "type/types.h"
 #include "type/value.h"
+#include "type/value_factory.h"
 #include "executor/executor_context.h"
 #include "executor/logical_tile.h"
 #include "executor/order_by_executor.h"
+#include "executor/normalized_key.h"
 #include "executor/logical_tile_factory.h"
 #include "storage/data_table.h"
 #include "concurrency/transaction_manager_factory.h"
@@ -302,5 +304,216 @@ TEST_F(OrderByTests, StringDescIntAscTest) {
 }
 }
 
+TEST_F(OrderByTests, PassThroughTest) {
+  // Create the plan node
+  std::vector<oid_t> sort_keys({1});
+  std::vector<bool> descend_flags({true});
+  std::vector<oid_t> output_columns({0, 1});
+  planner::OrderByPlan node(sort_keys, descend_flags, output_columns);
+
+  std::unique_ptr<executor::ExecutorContext> context(
+      new executor::ExecutorContext(nullptr));
+
+  // Create and set up executor
+  executor::OrderByExecutor executor(&node, context.get());
+  MockExecutor child_executor;
+  executor.AddChild(&child_executor);
+
+  EXPECT_CALL(child_executor, DInit()).WillOnce(Return(true));
+
+  EXPECT_CALL(child_executor, DExecute())
+      .WillOnce(Return(true))
+      .WillOnce(Return(false));
+
+  // Create a table and wrap it in logical tile
+  size_t tile_size = 20;
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto txn = txn_manager.BeginTransaction();
+  std::unique_ptr<storage::DataTable> data_table(
+      ExecutorTestsUtil::CreateTable(tile_size));
+  ExecutorTestsUtil::PopulateTable(data_table.get(), tile_size, false, false,
+                                   false, txn);
+  txn_manager.CommitTransaction(txn);
+
+  std::unique_ptr<executor::LogicalTile> source_logical_tile1(
+      executor::LogicalTileFactory::WrapTileGroup(data_table->GetTileGroup(0)));
+  auto source_base_tile = source_logical_tile1->GetBaseTile(1);
+
+  EXPECT_CALL(child_executor, GetOutput())
+      .WillOnce(Return(source_logical_tile1.release()));
+
+  EXPECT_TRUE(executor.Init());
+  EXPECT_TRUE(executor.Execute());
+  std::unique_ptr<executor::LogicalTile> result_tile(executor.GetOutput());
+  EXPECT_FALSE(executor.Execute());
+
+  // All tuples come from one input tile, so nothing is copied
+  EXPECT_EQ(source_base_tile, result_tile->GetBaseTile(1));
+
+  ASSERT_EQ(tile_size, result_tile->GetTupleCount());
+  oid_t row = 0;
+  for (oid_t tuple_id : *result_tile) {
+    EXPECT_EQ(ExecutorTestsUtil::PopulatedValue(tile_size - 1 - row, 1),
+              result_tile->GetValue(tuple_id, 1).GetAs<int32_t>());
+    row++;
+  }
+}
+
+TEST_F(OrderByTests, TopNTest) {
+  // Create the plan node, with a limit of 5 tuples after an offset of 2
+  std::vector<oid_t> sort_keys({1});
+  std::vector<bool> descend_flags({false});
+  std::vector<oid_t> output_columns({0, 1, 2, 3});
+  planner::OrderByPlan node(sort_keys, descend_flags, output_columns);
+  node.SetLimit(true);
+  node.SetLimitNumber(5);
+  node.SetLimitOffset(2);
+
+  std::unique_ptr<executor::ExecutorContext> context(
+      new executor::ExecutorContext(nullptr));
+
+  // Create and set up executor
+  executor::OrderByExecutor executor(&node, context.get());
+  MockExecutor child_executor;
+  executor.AddChild(&child_executor);
+
+  EXPECT_CALL(child_executor, DInit()).WillOnce(Return(true));
+
+  EXPECT_CALL(child_executor, DExecute())
+      .WillOnce(Return(true))
+      .WillOnce(Return(true))
+      .WillOnce(Return(false));
+
+  // Create a table and wrap it in logical tile
+  size_t tile_size = 20;
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto txn = txn_manager.BeginTransaction();
+  std::unique_ptr<storage::DataTable> data_table(
+      ExecutorTestsUtil::CreateTable(tile_size));
+  ExecutorTestsUtil::PopulateTable(data_table.get(), tile_size * 2, false,
+                                   false, false, txn);
+  txn_manager.CommitTransaction(txn);
+
+  // The smallest tuples come last
+  std::unique_ptr<executor::LogicalTile> source_logical_tile1(
+      executor::LogicalTileFactory::WrapTileGroup(data_table->GetTileGroup(1)));
+
+  std::unique_ptr<executor::LogicalTile> source_logical_tile2(
+      executor::LogicalTileFactory::WrapTileGroup(data_table->GetTileGroup(0)));
+
+  EXPECT_CALL(child_executor, GetOutput())
+      .WillOnce(Return(source_logical_tile1.release()))
+      .WillOnce(Return(source_logical_tile2.release()));
+
+  EXPECT_TRUE(executor.Init());
+  EXPECT_TRUE(executor.Execute());
+  std::unique_ptr<executor::LogicalTile> result_tile(executor.GetOutput());
+  EXPECT_FALSE(executor.Execute());
+
+  // Only offset + limit tuples are kept
+  ASSERT_EQ(7, result_tile->GetTupleCount());
+  oid_t row = 0;
+  for (oid_t tuple_id : *result_tile) {
+    EXPECT_EQ(ExecutorTestsUtil::PopulatedValue(row, 1),
+              result_tile->GetValue(tuple_id, 1).GetAs<int32_t>());
+    row++;
+  }
+}
+
+TEST_F(OrderByTests, SpillTest) {
+  // Create the plan node
+  std::vector<oid_t> sort_keys({1, 3});
+  std::vector<bool> descend_flags({true, false});
+  std::vector<oid_t> output_columns({0, 1, 2, 3});
+  planner::OrderByPlan node(sort_keys, descend_flags, output_columns);
+
+  std::unique_ptr<executor::ExecutorContext> context(
+      new executor::ExecutorContext(nullptr));
+
+  // Create and set up executor
+  executor::OrderByExecutor executor(&node, context.get());
+  MockExecutor child_executor;
+  executor.AddChild(&child_executor);
+
+  EXPECT_CALL(child_executor, DInit()).WillOnce(Return(true));
+
+  EXPECT_CALL(child_executor, DExecute())
+      .WillOnce(Return(true))
+      .WillOnce(Return(true))
+      .WillOnce(Return(true))
+      .WillOnce(Return(false));
+
+  // Create a table and wrap it in logical tile
+  size_t tile_size = 20;
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto txn = txn_manager.BeginTransaction();
+  std::unique_ptr<storage::DataTable> data_table(
+      ExecutorTestsUtil::CreateTable(tile_size));
+  ExecutorTestsUtil::PopulateTable(data_table.get(), tile_size * 3, false,
+                                   true, false, txn);
+  txn_manager.CommitTransaction(txn);
+
+  EXPECT_CALL(child_executor, GetOutput())
+      .WillOnce(Return(executor::LogicalTileFactory::WrapTileGroup(
+          data_table->GetTileGroup(0))))
+      .WillOnce(Return(executor::LogicalTileFactory::WrapTileGroup(
+          data_table->GetTileGroup(1))))
+      .WillOnce(Return(executor::LogicalTileFactory::WrapTileGroup(
+          data_table->GetTileGroup(2))));
+
+  // Every input tile exceeds the memory of the query
+  context->SetMemoryBudget(1);
+
+  EXPECT_TRUE(executor.Init());
+  std::vector<std::unique_ptr<executor::LogicalTile>> result_tiles;
+  while (executor.Execute()) {
+    result_tiles.emplace_back(executor.GetOutput());
+  }
+
+  EXPECT_EQ(3, executor.GetSpilledRunCount());
+  EXPECT_EQ(0, context->GetMemoryUsage());
+
+  std::vector<std::pair<int32_t, std::string>> values;
+  for (auto &tile : result_tiles) {
+    for (oid_t tuple_id : *tile) {
+      values.emplace_back(tile->GetValue(tuple_id, 1).GetAs<int32_t>(),
+                          tile->GetValue(tuple_id, 3).ToString());
+    }
+  }
+  ASSERT_EQ(tile_size * 3, values.size());
+  for (size_t i = 1; i < values.size(); i++) {
+    EXPECT_TRUE(values[i - 1].first > values[i].first ||
+                (values[i - 1].first == values[i].first &&
+                 values[i - 1].second <= values[i].second));
+  }
+}
+
+// NULLs sort last in ascending and first in descending order
+TEST_F(OrderByTests, NullOrderTest) {
+  std::vector<type::Value> values = {
+      type::ValueFactory::GetIntegerValue(-1),
+      type::ValueFactory::GetIntegerValue(2),
+      type::ValueFactory::GetNullValueByType(type::Type::INTEGER)};
+  std::vector<std::string> ascending_keys(values.size());
+  std::vector<std::string> descending_keys(values.size());
+  for (size_t i = 0; i < values.size(); i++) {
+    executor::NormalizedKey::Append(values[i], false, ascending_keys[i]);
+    executor::NormalizedKey::Append(values[i], true, descending_keys[i]);
+  }
+
+  EXPECT_LT(ascending_keys[0], ascending_keys[1]);
+  EXPECT_LT(ascending_keys[1], ascending_keys[2]);
+  EXPECT_LT(descending_keys[2], descending_keys[1]);
+  EXPECT_LT(descending_keys[1], descending_keys[0]);
+
+  std::string null_string_key, empty_string_key;
+  executor::NormalizedKey::Append(
+      type::ValueFactory::GetNullValueByType(type::Type::VARCHAR), false,
+      null_string_key);
+  executor::NormalizedKey::Append(type::ValueFactory::GetVarcharValue(""),
+                                  false, empty_string_key);
+  EXPECT_LT(empty_string_key, null_string_key);
+}
+
 }  // namespace test
 }  // namespace peloton
@@ -21,6 +21,8 @@
 #include "planner/projection_plan.h"
 #include "expression/expression_util.h"
 #include "expression/constant_value_expression.h"
+#include "expression/function_expression.h"
+#include "expression/string_functions.h"
 #include "executor/projection_executor.h"
 #include "executor/logical_tile_factory.h"
 #include "storage/data_table.h"
@@ -241,5 +243,202 @@ TEST_F(ProjectionTests, BasicTargetTest) {
   RunTest(executor, 1);
 }
 
+TEST_F(ProjectionTests, ComputedColumnTest) {
+  MockExecutor child_executor;
+  EXPECT_CALL(child_executor, DInit()).WillOnce(Return(true));
+
+  EXPECT_CALL(child_executor, DExecute())
+      .WillOnce(Return(true))
+      .WillOnce(Return(false));
+
+  size_t tile_size = 5;
+
+  // Create a table and wrap it in logical tile
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto txn = txn_manager.BeginTransaction();
+  std::unique_ptr<storage::DataTable> data_table(
+      ExecutorTestsUtil::CreateTable(tile_size));
+  ExecutorTestsUtil::PopulateTable(data_table.get(), tile_size, false, false,
+                                   false, txn);
+  txn_manager.CommitTransaction(txn);
+
+  std::unique_ptr<executor::LogicalTile> source_logical_tile1(
+      executor::LogicalTileFactory::WrapTileGroup(data_table->GetTileGroup(0)));
+  source_logical_tile1->RemoveVisibility(1);
+  auto source_base_tile = source_logical_tile1->GetBaseTile(0);
+
+  EXPECT_CALL(child_executor, GetOutput())
+      .WillOnce(Return(source_logical_tile1.release()));
+
+  // Create the plan node
+  TargetList target_list;
+  DirectMapList direct_map_list;
+
+  /////////////////////////////////////////////////////////
+  // PROJECTION 0, TARGET 0 * 2 + 2
+  /////////////////////////////////////////////////////////
+
+  // construct schema
+  std::vector<catalog::Column> columns;
+  auto orig_schema = data_table.get()->GetSchema();
+  columns.push_back(orig_schema->GetColumn(0));
+  columns.push_back(orig_schema->GetColumn(2));
+  std::shared_ptr<const catalog::Schema> schema(new catalog::Schema(columns));
+
+  // direct map
+  DirectMap direct_map = std::make_pair(0, std::make_pair(0, 0));
+  direct_map_list.push_back(direct_map);
+
+  // target list
+  auto times_two = expression::ExpressionUtil::OperatorFactory(
+      ExpressionType::OPERATOR_MULTIPLY, type::Type::INTEGER,
+      expression::ExpressionUtil::TupleValueFactory(type::Type::INTEGER, 0, 0),
+      new expression::ConstantValueExpression(
+          type::ValueFactory::GetIntegerValue(2)));
+  expression::AbstractExpression *expr =
+      expression::ExpressionUtil::OperatorFactory(
+          ExpressionType::OPERATOR_PLUS, type::Type::DECIMAL, times_two,
+          expression::ExpressionUtil::TupleValueFactory(type::Type::DECIMAL,
+                                                        0, 2));
+
+  Target target = std::make_pair(1, expr);
+  target_list.push_back(target);
+
+  std::unique_ptr<const planner::ProjectInfo> project_info(
+      new planner::ProjectInfo(std::move(target_list),
+                               std::move(direct_map_list)));
+
+  planner::ProjectionPlan node(std::move(project_info), schema);
+
+  // Create and set up executor
+  executor::ProjectionExecutor executor(&node, nullptr);
+  executor.AddChild(&child_executor);
+
+  EXPECT_TRUE(executor.Init());
+  EXPECT_TRUE(executor.Execute());
+  std::unique_ptr<executor::LogicalTile> result_tile(executor.GetOutput());
+  EXPECT_FALSE(executor.Execute());
+
+  // The direct mapped column is not copied
+  EXPECT_EQ(source_base_tile, result_tile->GetBaseTile(0));
+
+  ASSERT_EQ(tile_size - 1, result_tile->GetTupleCount());
+  oid_t row = 0;
+  for (oid_t tuple_id : *result_tile) {
+    oid_t source_row = (row == 0) ? 0 : row + 1;
+    EXPECT_EQ(ExecutorTestsUtil::PopulatedValue(source_row, 0),
+              result_tile->GetValue(tuple_id, 0).GetAs<int32_t>());
+    EXPECT_EQ(3 * ExecutorTestsUtil::PopulatedValue(source_row, 0) + 2,
+              result_tile->GetValue(tuple_id, 1).GetAs<double>());
+    row++;
+  }
+}
+
+// String functions are not compiled and are evaluated per value, in between
+// compiled targets that are evaluated column-at-a-time
+TEST_F(ProjectionTests, MixedComputedColumnTest) {
+  MockExecutor child_executor;
+  EXPECT_CALL(child_executor, DInit()).WillOnce(Return(true));
+
+  EXPECT_CALL(child_executor, DExecute())
+      .WillOnce(Return(true))
+      .WillOnce(Return(false));
+
+  size_t tile_size = 5;
+
+  // Create a table and wrap it in logical tile
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto txn = txn_manager.BeginTransaction();
+  std::unique_ptr<storage::DataTable> data_table(
+      ExecutorTestsUtil::CreateTable(tile_size));
+  ExecutorTestsUtil::PopulateTable(data_table.get(), tile_size, false, false,
+                                   false, txn);
+  txn_manager.CommitTransaction(txn);
+
+  std::unique_ptr<executor::LogicalTile> source_logical_tile1(
+      executor::LogicalTileFactory::WrapTileGroup(data_table->GetTileGroup(0)));
+  source_logical_tile1->RemoveVisibility(1);
+
+  EXPECT_CALL(child_executor, GetOutput())
+      .WillOnce(Return(source_logical_tile1.release()));
+
+  /////////////////////////////////////////////////////////
+  // PROJECTION 0 + 1, CONCAT(3, 'x'), 1 * 3, CHAR_LENGTH(3)
+  /////////////////////////////////////////////////////////
+
+  // construct schema
+  std::vector<catalog::Column> columns;
+  auto orig_schema = data_table.get()->GetSchema();
+  columns.push_back(orig_schema->GetColumn(0));
+  columns.push_back(orig_schema->GetColumn(3));
+  columns.push_back(orig_schema->GetColumn(1));
+  columns.push_back(orig_schema->GetColumn(1));
+  std::shared_ptr<const catalog::Schema> schema(new catalog::Schema(columns));
+
+  TargetList target_list;
+  DirectMapList direct_map_list;
+
+  auto plus_one = expression::ExpressionUtil::OperatorFactory(
+      ExpressionType::OPERATOR_PLUS, type::Type::INTEGER,
+      expression::ExpressionUtil::TupleValueFactory(type::Type::INTEGER, 0, 0),
+      new expression::ConstantValueExpression(
+          type::ValueFactory::GetIntegerValue(1)));
+  target_list.emplace_back(0, plus_one);
+
+  auto concat = new expression::FunctionExpression(
+      expression::StringFunctions::Concat, type::Type::VARCHAR,
+      {type::Type::VARCHAR, type::Type::VARCHAR},
+      {expression::ExpressionUtil::TupleValueFactory(type::Type::VARCHAR, 0, 3),
+       new expression::ConstantValueExpression(
+           type::ValueFactory::GetVarcharValue("x"))});
+  target_list.emplace_back(1, concat);
+
+  auto times_three = expression::ExpressionUtil::OperatorFactory(
+      ExpressionType::OPERATOR_MULTIPLY, type::Type::INTEGER,
+      expression::ExpressionUtil::TupleValueFactory(type::Type::INTEGER, 0, 1),
+      new expression::ConstantValueExpression(
+          type::ValueFactory::GetIntegerValue(3)));
+  target_list.emplace_back(2, times_three);
+
+  auto char_length = new expression::FunctionExpression(
+      expression::StringFunctions::CharLength, type::Type::INTEGER,
+      {type::Type::VARCHAR},
+      {expression::ExpressionUtil::TupleValueFactory(type::Type::VARCHAR, 0,
+                                                     3)});
+  target_list.emplace_back(3, char_length);
+
+  std::unique_ptr<const planner::ProjectInfo> project_info(
+      new planner::ProjectInfo(std::move(target_list),
+                               std::move(direct_map_list)));
+
+  planner::ProjectionPlan node(std::move(project_info), schema);
+
+  // Create and set up executor
+  executor::ProjectionExecutor executor(&node, nullptr);
+  executor.AddChild(&child_executor);
+
+  EXPECT_TRUE(executor.Init());
+  EXPECT_TRUE(executor.Execute());
+  std::unique_ptr<executor::LogicalTile> result_tile(executor.GetOutput());
+  EXPECT_FALSE(executor.Execute());
+
+  ASSERT_EQ(tile_size - 1, result_tile->GetTupleCount());
+  oid_t row = 0;
+  for (oid_t tuple_id : *result_tile) {
+    oid_t source_row = (row == 0) ? 0 : row + 1;
+    auto string_value =
+        std::to_string(ExecutorTestsUtil::PopulatedValue(source_row, 3));
+    EXPECT_EQ(ExecutorTestsUtil::PopulatedValue(source_row, 0) + 1,
+              result_tile->GetValue(tuple_id, 0).GetAs<int32_t>());
+    EXPECT_EQ(string_value + "x",
+              result_tile->GetValue(tuple_id, 1).ToString());
+    EXPECT_EQ(3 * ExecutorTestsUtil::PopulatedValue(source_row, 1),
+              result_tile->GetValue(tuple_id, 2).GetAs<int32_t>());
+    EXPECT_EQ(static_cast<int32_t>(string_value.length()),
+              result_tile->GetValue(tuple_id, 3).GetAs<int32_t>());
+    row++;
+  }
+}
+
 }  // namespace test
 }  // namespace peloton
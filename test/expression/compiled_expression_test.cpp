@@ -0,0 +1,182 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// compiled_expression_test.cpp
+//
+// Identification: test/expression/compiled_expression_test.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <memory>
+#include <vector>
+
+#include "common/harness.h"
+
+#include "common/container_tuple.h"
+#include "executor/executor_tests_util.h"
+#include "expression/compiled_expression.h"
+#include "expression/expression_util.h"
+#include "expression/parameter_value_expression.h"
+#include "storage/tile_group.h"
+#include "type/value.h"
+#include "type/value_factory.h"
+
+namespace peloton {
+namespace test {
+
+typedef std::unique_ptr<expression::AbstractExpression> ExpPtr;
+
+class CompiledExpressionTests : public PelotonTest {};
+
+namespace {
+
+expression::AbstractExpression *Column(type::Type::TypeId type_id,
+                                       int column_id) {
+  return expression::ExpressionUtil::TupleValueFactory(type_id, 0, column_id);
+}
+
+expression::AbstractExpression *Constant(const type::Value &value) {
+  return expression::ExpressionUtil::ConstantValueFactory(value);
+}
+
+expression::AbstractExpression *Compare(ExpressionType type,
+                                        expression::AbstractExpression *left,
+                                        expression::AbstractExpression *right) {
+  return expression::ExpressionUtil::ComparisonFactory(type, left, right);
+}
+
+expression::AbstractExpression *Operator(
+    ExpressionType type, type::Type::TypeId type_id,
+    expression::AbstractExpression *left,
+    expression::AbstractExpression *right) {
+  return expression::ExpressionUtil::OperatorFactory(type, type_id, left,
+                                                     right);
+}
+
+// Predicates and projections over the columns of the test tile group:
+// INTEGER, INTEGER, DECIMAL and VARCHAR
+std::vector<ExpPtr> BuildExpressions() {
+  std::vector<ExpPtr> expressions;
+
+  // COL_A > 50 AND COL_C <= 202.0
+  expressions.emplace_back(expression::ExpressionUtil::ConjunctionFactory(
+      ExpressionType::CONJUNCTION_AND,
+      Compare(ExpressionType::COMPARE_GREATERTHAN,
+              Column(type::Type::INTEGER, 0),
+              Constant(type::ValueFactory::GetIntegerValue(50))),
+      Compare(ExpressionType::COMPARE_LESSTHANOREQUALTO,
+              Column(type::Type::DECIMAL, 2),
+              Constant(type::ValueFactory::GetDecimalValue(202.0)))));
+
+  // COL_D = '33' OR COL_A * 2 + COL_B < 40
+  expressions.emplace_back(expression::ExpressionUtil::ConjunctionFactory(
+      ExpressionType::CONJUNCTION_OR,
+      Compare(ExpressionType::COMPARE_EQUAL, Column(type::Type::VARCHAR, 3),
+              Constant(type::ValueFactory::GetVarcharValue("33"))),
+      Compare(ExpressionType::COMPARE_LESSTHAN,
+              Operator(ExpressionType::OPERATOR_PLUS, type::Type::INTEGER,
+                       Operator(ExpressionType::OPERATOR_MULTIPLY,
+                                type::Type::INTEGER,
+                                Column(type::Type::INTEGER, 0),
+                                Constant(type::ValueFactory::GetIntegerValue(2))),
+                       Column(type::Type::INTEGER, 1)),
+              Constant(type::ValueFactory::GetIntegerValue(40)))));
+
+  // NOT (COL_B % 3 = 1) AND COL_A < NULL
+  expressions.emplace_back(expression::ExpressionUtil::ConjunctionFactory(
+      ExpressionType::CONJUNCTION_AND,
+      expression::ExpressionUtil::OperatorFactory(
+          ExpressionType::OPERATOR_NOT, type::Type::BOOLEAN,
+          Compare(ExpressionType::COMPARE_EQUAL,
+                  Operator(ExpressionType::OPERATOR_MOD, type::Type::INTEGER,
+                           Column(type::Type::INTEGER, 1),
+                           Constant(type::ValueFactory::GetIntegerValue(3))),
+                  Constant(type::ValueFactory::GetIntegerValue(1))),
+          nullptr),
+      Compare(ExpressionType::COMPARE_LESSTHAN, Column(type::Type::INTEGER, 0),
+              Constant(type::ValueFactory::GetNullValueByType(
+                  type::Type::INTEGER)))));
+
+  // COL_C / (COL_A + 1) - COL_B
+  expressions.emplace_back(Operator(
+      ExpressionType::OPERATOR_MINUS, type::Type::DECIMAL,
+      Operator(ExpressionType::OPERATOR_DIVIDE, type::Type::DECIMAL,
+               Column(type::Type::DECIMAL, 2),
+               Operator(ExpressionType::OPERATOR_PLUS, type::Type::INTEGER,
+                        Column(type::Type::INTEGER, 0),
+                        Constant(type::ValueFactory::GetIntegerValue(1)))),
+      Column(type::Type::INTEGER, 1)));
+
+  return expressions;
+}
+
+}  // namespace
+
+TEST_F(CompiledExpressionTests, MatchesInterpretedTest) {
+  const int tuple_count = 50;
+  std::shared_ptr<storage::TileGroup> tile_group(
+      ExecutorTestsUtil::CreateTileGroup(tuple_count));
+  ExecutorTestsUtil::PopulateTiles(tile_group, tuple_count);
+
+  auto expressions = BuildExpressions();
+  for (auto &expr : expressions) {
+    auto compiled = expression::CompiledExpression::Compile(expr.get());
+    ASSERT_TRUE(compiled != nullptr);
+    EXPECT_EQ(expr->GetValueType(), compiled->GetValueType());
+
+    std::vector<oid_t> expected;
+    std::vector<oid_t> tuple_ids;
+    for (oid_t tuple_id = 0; tuple_id < tuple_count; tuple_id++) {
+      expression::ContainerTuple<storage::TileGroup> tuple(tile_group.get(),
+                                                           tuple_id);
+      auto interpreted = expr->Evaluate(&tuple, nullptr, nullptr);
+      auto result = compiled->Evaluate(&tuple, nullptr);
+      EXPECT_EQ(interpreted.IsNull(), result.IsNull());
+      if (!interpreted.IsNull()) {
+        EXPECT_EQ(type::CMP_TRUE, interpreted.CompareEquals(result));
+      }
+
+      if (compiled->GetValueType() == type::Type::BOOLEAN &&
+          interpreted.IsTrue()) {
+        expected.push_back(tuple_id);
+      }
+      tuple_ids.push_back(tuple_id);
+    }
+
+    if (compiled->GetValueType() == type::Type::BOOLEAN) {
+      compiled->Filter(tile_group.get(), tuple_ids);
+      EXPECT_EQ(expected, tuple_ids);
+    }
+  }
+}
+
+TEST_F(CompiledExpressionTests, UnsupportedAndErrorsTest) {
+  // Parameters are not compiled
+  ExpPtr parameter(expression::ExpressionUtil::ComparisonFactory(
+      ExpressionType::COMPARE_EQUAL, Column(type::Type::INTEGER, 0),
+      new expression::ParameterValueExpression(0)));
+  EXPECT_TRUE(expression::CompiledExpression::Compile(parameter.get()) ==
+              nullptr);
+
+  // Overflow and division by zero raise the same errors as Value
+  ExpPtr overflow(Operator(
+      ExpressionType::OPERATOR_MULTIPLY, type::Type::SMALLINT,
+      Constant(type::ValueFactory::GetSmallIntValue(300)),
+      Constant(type::ValueFactory::GetTinyIntValue(120))));
+  auto compiled = expression::CompiledExpression::Compile(overflow.get());
+  ASSERT_TRUE(compiled != nullptr);
+  EXPECT_THROW(compiled->Evaluate(nullptr, nullptr), peloton::Exception);
+
+  ExpPtr divide(Operator(ExpressionType::OPERATOR_DIVIDE, type::Type::INTEGER,
+                         Constant(type::ValueFactory::GetIntegerValue(7)),
+                         Constant(type::ValueFactory::GetIntegerValue(0))));
+  compiled = expression::CompiledExpression::Compile(divide.get());
+  ASSERT_TRUE(compiled != nullptr);
+  EXPECT_THROW(compiled->Evaluate(nullptr, nullptr), peloton::Exception);
+}
+
+}  // End test namespace
+}  // End peloton namespace
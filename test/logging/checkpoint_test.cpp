@@ -111,6 +111,19 @@ TEST_F(CheckpointTests, CheckpointIntegrationTest) {
   EXPECT_EQ(db->GetTableCount(), 1);
   EXPECT_EQ(db->GetTable(0)->GetTupleCount(),
             tile_group_size * table_tile_group_count);
+
+  // tile group images keep both inlined and uninlined values
+  auto recovered_tile_group = db->GetTable(0)->GetTileGroup(0);
+  for (oid_t tuple_id = 0; tuple_id < tile_group_size; tuple_id++) {
+    type::Value expected_int = type::ValueFactory::GetIntegerValue(
+        ExecutorTestsUtil::PopulatedValue(tuple_id, 0));
+    type::Value expected_varchar = type::ValueFactory::GetVarcharValue(
+        std::to_string(ExecutorTestsUtil::PopulatedValue(tuple_id, 3)));
+    EXPECT_TRUE(recovered_tile_group->GetValue(tuple_id, 0)
+                    .CompareEquals(expected_int) == type::CMP_TRUE);
+    EXPECT_TRUE(recovered_tile_group->GetValue(tuple_id, 3)
+                    .CompareEquals(expected_varchar) == type::CMP_TRUE);
+  }
   catalog->DropDatabaseWithOid(db->GetOid());
   logging::LoggingUtil::RemoveDirectory("pl_checkpoint", false);
 }
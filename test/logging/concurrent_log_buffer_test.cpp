@@ -0,0 +1,200 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// concurrent_log_buffer_test.cpp
+//
+// Identification: test/logging/concurrent_log_buffer_test.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+#include "common/harness.h"
+
+#include "catalog/schema.h"
+#include "logging/concurrent_log_buffer.h"
+#include "logging/loggers/wal_backend_logger.h"
+#include "logging/records/transaction_record.h"
+#include "logging/records/tuple_record.h"
+#include "storage/tuple.h"
+#include "type/value_factory.h"
+
+namespace peloton {
+namespace test {
+
+//===--------------------------------------------------------------------===//
+// Concurrent Log Buffer Tests
+//===--------------------------------------------------------------------===//
+
+class ConcurrentLogBufferTests : public PelotonTest {};
+
+// Records are a producer id followed by a sequence number
+struct TestRecord {
+  uint32_t producer_id;
+  uint32_t sequence;
+};
+
+TEST_F(ConcurrentLogBufferTests, MultipleProducerTest) {
+  const size_t producer_count = 4;
+  const uint32_t records_per_producer = 2000;
+
+  // A small buffer makes the producers wrap around and wait for the flusher
+  logging::ConcurrentLogBuffer log_buffer(sizeof(TestRecord) * 256 + 4);
+  std::vector<std::atomic<uint64_t>> reservations(producer_count);
+  for (auto &reservation : reservations) {
+    reservation.store(IDLE_RESERVATION_OFFSET);
+  }
+
+  std::vector<std::thread> producers;
+  for (size_t producer_itr = 0; producer_itr < producer_count;
+       producer_itr++) {
+    producers.emplace_back([&, producer_itr] {
+      for (uint32_t sequence = 0; sequence < records_per_producer;
+           sequence++) {
+        TestRecord record{static_cast<uint32_t>(producer_itr), sequence};
+        EXPECT_TRUE(log_buffer.WriteRecord(
+            reinterpret_cast<const char *>(&record), sizeof(record),
+            sequence + 1, reservations[producer_itr]));
+      }
+    });
+  }
+
+  // Flush the contiguously completed part of the buffer
+  std::vector<char> flushed;
+  const size_t total_size =
+      producer_count * records_per_producer * sizeof(TestRecord);
+  while (flushed.size() < total_size) {
+    uint64_t end = log_buffer.GetReservedOffset();
+    for (auto &reservation : reservations) {
+      end = std::min<uint64_t>(end, reservation.load());
+    }
+
+    uint64_t offset = log_buffer.GetReleasedOffset();
+    while (offset < end) {
+      auto region = log_buffer.GetRegion(offset, end);
+      flushed.insert(flushed.end(), region.first,
+                     region.first + region.second);
+      offset += region.second;
+    }
+    log_buffer.Release(end);
+  }
+
+  for (auto &producer : producers) {
+    producer.join();
+  }
+
+  // Every record shows up intact and in order for its producer
+  EXPECT_EQ(total_size, flushed.size());
+  std::vector<uint32_t> next_sequence(producer_count, 0);
+  for (size_t offset = 0; offset < flushed.size();
+       offset += sizeof(TestRecord)) {
+    TestRecord record;
+    memcpy(&record, flushed.data() + offset, sizeof(record));
+    ASSERT_LT(record.producer_id, producer_count);
+    EXPECT_EQ(next_sequence[record.producer_id]++, record.sequence);
+  }
+  EXPECT_EQ(records_per_producer, log_buffer.GetMaxLogId());
+}
+
+TEST_F(ConcurrentLogBufferTests, RecordRoundTripTest) {
+  auto testing_pool = TestingHarness::GetInstance().GetTestingPool();
+  std::vector<catalog::Column> columns;
+  columns.emplace_back(type::Type::INTEGER,
+                       type::Type::GetTypeSize(type::Type::INTEGER), "A",
+                       true);
+  columns.emplace_back(type::Type::VARCHAR, 32, "B", false);
+  catalog::Schema schema(columns);
+  storage::Tuple tuple(&schema, true);
+  tuple.SetValue(0, type::ValueFactory::GetIntegerValue(7), testing_pool);
+  tuple.SetValue(1, type::ValueFactory::GetVarcharValue("round trip"),
+                 testing_pool);
+
+  logging::TupleRecord insert_record(LOGRECORD_TYPE_WAL_TUPLE_INSERT, 5, 1,
+                                     ItemPointer(2, 3), INVALID_ITEMPOINTER,
+                                     &tuple, DEFAULT_DB_ID);
+  logging::TupleRecord update_record(LOGRECORD_TYPE_WAL_TUPLE_PARTIAL_UPDATE,
+                                     5, 1, ItemPointer(2, 4),
+                                     ItemPointer(2, 3), &tuple, DEFAULT_DB_ID);
+  update_record.SetModifiedColumns({1});
+  logging::TransactionRecord commit_record(LOGRECORD_TYPE_TRANSACTION_COMMIT,
+                                           5);
+  std::vector<logging::LogRecord *> records = {&insert_record, &update_record,
+                                               &commit_record};
+
+  // The records as the local log buffers get them
+  std::vector<char> expected;
+  for (auto record : records) {
+    CopySerializeOutput output;
+    record->Serialize(output);
+    EXPECT_EQ(output.Size(), record->GetSerializedLength());
+    expected.insert(expected.end(), output.Data(),
+                    output.Data() + output.Size());
+  }
+
+  // Start the records past the beginning of the ring, so that the last one
+  // wraps around its end and the others are serialized in place
+  const size_t skipped_length = 8;
+  logging::ConcurrentLogBuffer log_buffer(expected.size());
+  std::atomic<uint64_t> reservation(IDLE_RESERVATION_OFFSET);
+  std::vector<char> filler(skipped_length, 'x');
+  EXPECT_TRUE(
+      log_buffer.WriteRecord(filler.data(), filler.size(), 1, reservation));
+  log_buffer.Release(skipped_length);
+
+  logging::WriteAheadBackendLogger backend_logger;
+  backend_logger.SetConcurrentLogBuffer(&log_buffer);
+  for (auto record : records) {
+    backend_logger.Log(record);
+  }
+  EXPECT_EQ(skipped_length + expected.size(), log_buffer.GetReservedOffset());
+  EXPECT_EQ(5, log_buffer.GetMaxLogId());
+
+  std::vector<char> logged;
+  uint64_t begin = skipped_length;
+  while (begin < log_buffer.GetReservedOffset()) {
+    auto region = log_buffer.GetRegion(begin, log_buffer.GetReservedOffset());
+    logged.insert(logged.end(), region.first, region.first + region.second);
+    begin += region.second;
+  }
+  EXPECT_EQ(expected, logged);
+
+  // Read the insert record back
+  CopySerializeInput input(logged.data(), logged.size());
+  EXPECT_EQ(LOGRECORD_TYPE_WAL_TUPLE_INSERT,
+            static_cast<LogRecordType>(input.ReadEnumInSingleByte()));
+  logging::TupleRecord read_record(LOGRECORD_TYPE_WAL_TUPLE_INSERT);
+  read_record.DeserializeHeader(input);
+  EXPECT_EQ(5, read_record.GetTransactionId());
+  EXPECT_EQ(1, read_record.GetTableId());
+  EXPECT_EQ(2, read_record.GetInsertLocation().block);
+  EXPECT_EQ(3, read_record.GetInsertLocation().offset);
+
+  input.ReadInt();
+  for (oid_t column_id = 0; column_id < schema.GetColumnCount();
+       column_id++) {
+    auto value = type::Value::DeserializeFrom(input,
+                                              schema.GetType(column_id));
+    EXPECT_EQ(type::CMP_TRUE, value.CompareEquals(tuple.GetValue(column_id)));
+  }
+}
+
+TEST_F(ConcurrentLogBufferTests, OversizedRecordTest) {
+  logging::ConcurrentLogBuffer log_buffer(16);
+  std::atomic<uint64_t> reservation(IDLE_RESERVATION_OFFSET);
+  std::vector<char> record(32, 'x');
+
+  EXPECT_FALSE(
+      log_buffer.WriteRecord(record.data(), record.size(), 1, reservation));
+  EXPECT_EQ(0, log_buffer.GetReservedOffset());
+  EXPECT_EQ(IDLE_RESERVATION_OFFSET, reservation.load());
+}
+
+}  // End test namespace
+}  // End peloton namespace
@@ -0,0 +1,89 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// log_compressor_test.cpp
+//
+// Identification: test/logging/log_compressor_test.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#include "common/harness.h"
+
+#include "logging/log_compressor.h"
+
+namespace peloton {
+namespace test {
+
+//===--------------------------------------------------------------------===//
+// Log Compressor Tests
+//===--------------------------------------------------------------------===//
+
+class LogCompressorTests : public PelotonTest {};
+
+// Compress and decompress the data, returning the compressed size
+static size_t RoundTrip(const std::string &data) {
+  std::vector<char> compressed(
+      logging::LogCompressor::GetMaxCompressedSize(data.size()));
+  size_t compressed_size = logging::LogCompressor::Compress(
+      data.data(), data.size(), compressed.data());
+  EXPECT_LE(compressed_size, compressed.size());
+
+  std::vector<char> decompressed(data.size());
+  EXPECT_TRUE(logging::LogCompressor::Decompress(
+      compressed.data(), compressed_size, decompressed.data(), data.size()));
+  EXPECT_EQ(data, std::string(decompressed.begin(), decompressed.end()));
+
+  return compressed_size;
+}
+
+TEST_F(LogCompressorTests, RoundTripTest) {
+  // Small inputs are stored as literals
+  RoundTrip("");
+  RoundTrip("a");
+  RoundTrip("peloton");
+
+  // Log records repeat most of their header bytes
+  std::string records;
+  for (int record_itr = 0; record_itr < 1000; record_itr++) {
+    records += "\x15record header " + std::to_string(record_itr % 7) +
+               std::string(32, '\0');
+  }
+  EXPECT_LT(RoundTrip(records), records.size() / 4);
+
+  // Random data does not compress but still has to survive
+  std::srand(0);
+  std::string random_data;
+  for (int byte_itr = 0; byte_itr < 100000; byte_itr++) {
+    random_data.push_back(static_cast<char>(std::rand()));
+  }
+  RoundTrip(random_data);
+}
+
+TEST_F(LogCompressorTests, CorruptedBlockTest) {
+  std::string data(4096, 'x');
+  std::vector<char> compressed(
+      logging::LogCompressor::GetMaxCompressedSize(data.size()));
+  size_t compressed_size = logging::LogCompressor::Compress(
+      data.data(), data.size(), compressed.data());
+
+  // A wrong uncompressed size is detected
+  std::vector<char> decompressed(data.size() + 1);
+  EXPECT_FALSE(logging::LogCompressor::Decompress(
+      compressed.data(), compressed_size, decompressed.data(),
+      data.size() + 1));
+
+  // So is a truncated block
+  EXPECT_FALSE(logging::LogCompressor::Decompress(
+      compressed.data(), compressed_size / 2, decompressed.data(),
+      data.size()));
+}
+
+}  // End test namespace
+}  // End peloton namespace
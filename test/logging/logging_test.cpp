@@ -10,6 +10,8 @@
 //
 //===----------------------------------------------------------------------===//
 
+#include <thread>
+
 #include "catalog/catalog.h"
 #include "common/harness.h"
 
@@ -368,6 +370,29 @@ TEST_F(LoggingTests, BasicLogManagerTest) {
 
   // since we are doing sync commit we should have reached 5 already
   EXPECT_EQ(commit_id, log_manager.GetPersistentFlushedCommitId());
+
+  // A pipelined commit is stable once the thread waited for its pending
+  // flushes, before the commit is acknowledged
+  commit_id = 6;
+  log_manager.PrepareLogging();
+  log_manager.LogBeginTransaction(commit_id);
+  log_manager.LogCommitTransaction(commit_id, false);
+  log_manager.WaitForPendingFlush();
+  EXPECT_LE(commit_id, log_manager.GetPersistentFlushedCommitId());
+
+  // A read only transaction waits for the pipelined commit of another thread
+  // that it may have read, and not for the larger commit id it read at,
+  // which no transaction logs
+  commit_id = 7;
+  std::thread committer([&log_manager, commit_id] {
+    log_manager.PrepareLogging();
+    log_manager.LogBeginTransaction(commit_id);
+    log_manager.LogCommitTransaction(commit_id, false);
+  });
+  committer.join();
+  log_manager.WaitForReadCommits(commit_id + 10);
+  EXPECT_LE(commit_id, log_manager.GetPersistentFlushedCommitId());
+
   log_manager.EndLogging();
 }
 
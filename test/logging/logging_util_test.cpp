@@ -14,6 +14,8 @@
 #include "common/harness.h"
 
 #include "logging/logging_util.h"
+#include "executor/executor_tests_util.h"
+#include "type/value_factory.h"
 
 namespace peloton {
 namespace test {
@@ -31,5 +33,52 @@ TEST_F(LoggingUtilTests, BasicLoggingUtilTest) {
   EXPECT_EQ(status, true);
 }
 
+TEST_F(LoggingUtilTests, PartialUpdateRecordTest) {
+  std::vector<catalog::Column> columns;
+  for (int column_itr = 0; column_itr < 4; column_itr++) {
+    columns.push_back(ExecutorTestsUtil::GetColumnInfo(column_itr));
+  }
+  catalog::Schema schema(columns);
+  auto pool = TestingHarness::GetInstance().GetTestingPool();
+
+  storage::Tuple tuple(&schema, true);
+  tuple.SetValue(0, type::ValueFactory::GetIntegerValue(1), pool);
+  tuple.SetValue(1, type::ValueFactory::GetIntegerValue(2), pool);
+  tuple.SetValue(2, type::ValueFactory::GetDecimalValue(3.5), pool);
+  tuple.SetValue(3, type::ValueFactory::GetVarcharValue("updated"), pool);
+
+  // Only the second and the last column are written out
+  logging::TupleRecord record(LOGRECORD_TYPE_WAL_TUPLE_PARTIAL_UPDATE, 10, 1,
+                              ItemPointer(2, 3), ItemPointer(4, 5), &tuple,
+                              DEFAULT_DB_ID);
+  record.SetModifiedColumns({1, 3});
+  CopySerializeOutput output;
+  EXPECT_TRUE(record.Serialize(output));
+
+  FILE *file = tmpfile();
+  fwrite(record.GetMessage(), sizeof(char), record.GetMessageLength(), file);
+  rewind(file);
+  FileHandle file_handle(file, fileno(file), record.GetMessageLength());
+
+  EXPECT_EQ(logging::LoggingUtil::GetNextLogRecordType(file_handle),
+            LOGRECORD_TYPE_WAL_TUPLE_PARTIAL_UPDATE);
+  logging::TupleRecord read_record(LOGRECORD_TYPE_WAL_TUPLE_PARTIAL_UPDATE);
+  EXPECT_TRUE(
+      logging::LoggingUtil::ReadTupleRecordHeader(read_record, file_handle));
+  EXPECT_EQ(read_record.GetInsertLocation().block, 2);
+  EXPECT_EQ(read_record.GetDeleteLocation().offset, 5);
+
+  std::unique_ptr<storage::Tuple> read_tuple(
+      logging::LoggingUtil::ReadPartialTupleRecordBody(read_record, &schema,
+                                                       pool, file_handle));
+  EXPECT_TRUE(read_tuple != nullptr);
+  EXPECT_EQ(read_record.GetModifiedColumns(), std::vector<oid_t>({1, 3}));
+  EXPECT_TRUE(read_tuple->GetValue(1).CompareEquals(tuple.GetValue(1)) ==
+              type::CMP_TRUE);
+  EXPECT_TRUE(read_tuple->GetValue(3).CompareEquals(tuple.GetValue(3)) ==
+              type::CMP_TRUE);
+  fclose(file);
+}
+
 }  // End test namespace
 }  // End peloton namespace
@@ -405,6 +405,147 @@ TEST_F(RecoveryTests, BasicDeleteTest) {
   EXPECT_EQ(recovery_table->GetTileGroupCount(), 2);
 }*/
 
+TEST_F(RecoveryTests, ParallelReplayTest) {
+  auto recovery_table = ExecutorTestsUtil::CreateTable(1024);
+  auto catalog = catalog::Catalog::GetInstance();
+  storage::Database *db = new storage::Database(DEFAULT_DB_ID);
+  catalog->AddDatabase(db);
+  db->AddTable(recovery_table);
+
+  const int tile_group_count = 4;
+  const int tuples_per_tile_group = 5;
+  auto tuples = BuildLoggingTuples(
+      recovery_table, tile_group_count * tuples_per_tile_group + 1, false,
+      false);
+  EXPECT_EQ(recovery_table->GetTupleCount(), 0);
+  EXPECT_EQ(recovery_table->GetTileGroupCount(), 1);
+
+  auto &log_manager = logging::LogManager::GetInstance();
+  auto recovery_thread_count = log_manager.GetRecoveryThreadCount();
+  log_manager.SetRecoveryThreadCount(tile_group_count);
+  logging::WriteAheadFrontendLogger fel(true);
+  cid_t test_commit_id = 10;
+
+  // Insert tuples into several tile groups
+  std::vector<logging::TupleRecord *> records;
+  int tuple_itr = 0;
+  for (int tile_group_itr = 0; tile_group_itr < tile_group_count;
+       tile_group_itr++) {
+    for (int slot_itr = 0; slot_itr < tuples_per_tile_group; slot_itr++) {
+      auto curr_rec = new logging::TupleRecord(
+          LOGRECORD_TYPE_WAL_TUPLE_INSERT, test_commit_id,
+          recovery_table->GetOid(), ItemPointer(100 + tile_group_itr, slot_itr),
+          INVALID_ITEMPOINTER, nullptr, DEFAULT_DB_ID);
+      curr_rec->SetTuple(tuples[tuple_itr++]);
+      records.push_back(curr_rec);
+    }
+  }
+
+  // Move a tuple across tile groups
+  auto update_rec = new logging::TupleRecord(
+      LOGRECORD_TYPE_WAL_TUPLE_UPDATE, test_commit_id + 1,
+      recovery_table->GetOid(), ItemPointer(101, tuples_per_tile_group),
+      ItemPointer(100, 0), nullptr, DEFAULT_DB_ID);
+  update_rec->SetTuple(tuples[tuple_itr++]);
+  records.push_back(update_rec);
+
+  // Delete a tuple that was inserted earlier in the log
+  records.push_back(new logging::TupleRecord(
+      LOGRECORD_TYPE_WAL_TUPLE_DELETE, test_commit_id + 2,
+      recovery_table->GetOid(), INVALID_ITEMPOINTER, ItemPointer(102, 1),
+      nullptr, DEFAULT_DB_ID));
+
+  fel.ReplayTupleRecords(records);
+  for (auto record : records) {
+    delete record;
+  }
+
+  EXPECT_EQ(recovery_table->GetTupleCount(),
+            tile_group_count * tuples_per_tile_group - 1);
+  EXPECT_EQ(recovery_table->GetTileGroupCount(), tile_group_count + 1);
+
+  auto old_header = recovery_table->GetTileGroupById(100)->GetHeader();
+  EXPECT_EQ(old_header->GetEndCommitId(0), test_commit_id + 1);
+  EXPECT_EQ(old_header->GetNextItemPointer(0).block, 101);
+  EXPECT_EQ(old_header->GetEndCommitId(1), MAX_CID);
+
+  auto new_header = recovery_table->GetTileGroupById(101)->GetHeader();
+  EXPECT_TRUE(new_header->GetBeginCommitId(tuples_per_tile_group) <=
+              test_commit_id + 1);
+  EXPECT_EQ(new_header->GetEndCommitId(tuples_per_tile_group), MAX_CID);
+
+  auto deleted_header = recovery_table->GetTileGroupById(102)->GetHeader();
+  EXPECT_EQ(deleted_header->GetEndCommitId(1), test_commit_id + 2);
+
+  log_manager.SetRecoveryThreadCount(recovery_thread_count);
+  catalog->DropDatabaseWithOid(DEFAULT_DB_ID);
+}
+
+TEST_F(RecoveryTests, PartialUpdateReplayTest) {
+  auto recovery_table = ExecutorTestsUtil::CreateTable(1024);
+  auto catalog = catalog::Catalog::GetInstance();
+  storage::Database *db = new storage::Database(DEFAULT_DB_ID);
+  catalog->AddDatabase(db);
+  db->AddTable(recovery_table);
+
+  auto tuples = BuildLoggingTuples(recovery_table, 1, false, false);
+
+  auto &log_manager = logging::LogManager::GetInstance();
+  auto recovery_thread_count = log_manager.GetRecoveryThreadCount();
+  log_manager.SetRecoveryThreadCount(4);
+  logging::WriteAheadFrontendLogger fel(true);
+  cid_t test_commit_id = 10;
+
+  std::vector<logging::TupleRecord *> records;
+  auto insert_rec = new logging::TupleRecord(
+      LOGRECORD_TYPE_WAL_TUPLE_INSERT, test_commit_id, recovery_table->GetOid(),
+      ItemPointer(100, 0), INVALID_ITEMPOINTER, nullptr, DEFAULT_DB_ID);
+  insert_rec->SetTuple(tuples[0]);
+  records.push_back(insert_rec);
+
+  // Only the second column is logged by the update, which moves the tuple
+  // into a tile group that is replayed by another thread
+  storage::Tuple *modified_tuple =
+      new storage::Tuple(recovery_table->GetSchema(), true);
+  modified_tuple->SetValue(1, type::ValueFactory::GetIntegerValue(12345),
+                           nullptr);
+  auto update_rec = new logging::TupleRecord(
+      LOGRECORD_TYPE_WAL_TUPLE_PARTIAL_UPDATE, test_commit_id + 1,
+      recovery_table->GetOid(), ItemPointer(101, 0), ItemPointer(100, 0),
+      nullptr, DEFAULT_DB_ID);
+  update_rec->SetTuple(modified_tuple);
+  update_rec->SetModifiedColumns({1});
+  records.push_back(update_rec);
+
+  fel.ReplayTupleRecords(records);
+  for (auto record : records) {
+    delete record;
+  }
+
+  EXPECT_EQ(recovery_table->GetTupleCount(), 1);
+
+  auto old_tile_group = recovery_table->GetTileGroupById(100);
+  EXPECT_EQ(old_tile_group->GetHeader()->GetEndCommitId(0),
+            test_commit_id + 1);
+
+  auto new_tile_group = recovery_table->GetTileGroupById(101);
+  EXPECT_EQ(new_tile_group->GetHeader()->GetEndCommitId(0), MAX_CID);
+  type::Value expected_int = type::ValueFactory::GetIntegerValue(
+      ExecutorTestsUtil::PopulatedValue(0, 0));
+  type::Value expected_update = type::ValueFactory::GetIntegerValue(12345);
+  type::Value expected_varchar = type::ValueFactory::GetVarcharValue(
+      std::to_string(ExecutorTestsUtil::PopulatedValue(0, 3)));
+  EXPECT_TRUE(new_tile_group->GetValue(0, 0).CompareEquals(expected_int) ==
+              type::CMP_TRUE);
+  EXPECT_TRUE(new_tile_group->GetValue(0, 1).CompareEquals(expected_update) ==
+              type::CMP_TRUE);
+  EXPECT_TRUE(new_tile_group->GetValue(0, 3).CompareEquals(expected_varchar) ==
+              type::CMP_TRUE);
+
+  log_manager.SetRecoveryThreadCount(recovery_thread_count);
+  catalog->DropDatabaseWithOid(DEFAULT_DB_ID);
+}
+
 TEST_F(RecoveryTests, OutOfOrderCommitTest) {
   auto recovery_table = ExecutorTestsUtil::CreateTable(1024);
   auto catalog = catalog::Catalog::GetInstance();
@@ -210,6 +210,7 @@ TEST_F(ParserTests, TransactionTest) {
   valid_queries.push_back("BEGIN;");
   valid_queries.push_back("COMMIT TRANSACTION;");
   valid_queries.push_back("ROLLBACK TRANSACTION;");
+  valid_queries.push_back("BEGIN READ ONLY;");
 
   for (auto query : valid_queries) {
     parser::SQLStatementList* result =
@@ -229,6 +230,7 @@ TEST_F(ParserTests, TransactionTest) {
       (parser::TransactionStatement*)list->GetStatement(0);
   EXPECT_EQ(list->GetStatement(0)->GetType(), StatementType::TRANSACTION);
   EXPECT_EQ(stmt->type, parser::TransactionStatement::kBegin);
+  EXPECT_FALSE(stmt->read_only);
   delete list;
 
   list = parser::Parser::ParseSQLString(valid_queries[1].c_str());
@@ -245,6 +247,12 @@ TEST_F(ParserTests, TransactionTest) {
   stmt = (parser::TransactionStatement*)list->GetStatement(0);
   EXPECT_EQ(stmt->type, parser::TransactionStatement::kRollback);
   delete list;
+
+  list = parser::Parser::ParseSQLString(valid_queries[4].c_str());
+  stmt = (parser::TransactionStatement*)list->GetStatement(0);
+  EXPECT_EQ(stmt->type, parser::TransactionStatement::kBegin);
+  EXPECT_TRUE(stmt->read_only);
+  delete list;
 }
 
 TEST_F(ParserTests, CreateTest) {
@@ -0,0 +1,95 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// column_accessor_performance_test.cpp
+//
+// Identification: test/performance/column_accessor_performance_test.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <memory>
+
+#include "common/harness.h"
+
+#include "common/timer.h"
+#include "concurrency/transaction_manager_factory.h"
+#include "executor/executor_tests_util.h"
+#include "storage/column_accessor.h"
+#include "storage/data_table.h"
+#include "storage/tile.h"
+#include "storage/tile_group.h"
+
+namespace peloton {
+namespace test {
+
+//===--------------------------------------------------------------------===//
+// Column Accessor Performance Tests
+//===--------------------------------------------------------------------===//
+
+class ColumnAccessorPerformanceTests : public PelotonTest {};
+
+TEST_F(ColumnAccessorPerformanceTests, ScanTest) {
+  const oid_t tuples_per_tilegroup = 1000;
+  const oid_t tile_group_count = 100;
+  const int scan_count = 10;
+
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto txn = txn_manager.BeginTransaction();
+  std::unique_ptr<storage::DataTable> data_table(
+      ExecutorTestsUtil::CreateTable(tuples_per_tilegroup, false));
+  ExecutorTestsUtil::PopulateTable(data_table.get(),
+                                   tuples_per_tilegroup * tile_group_count,
+                                   false, false, false, txn);
+  txn_manager.CommitTransaction(txn);
+
+  // Sum the first (integer) column of all full tile groups
+  Timer<> tile_timer, value_timer, native_timer;
+  int64_t tile_sum = 0, value_sum = 0, native_sum = 0;
+
+  for (int scan_itr = 0; scan_itr < scan_count; scan_itr++) {
+    for (oid_t tile_group_itr = 0; tile_group_itr < tile_group_count;
+         tile_group_itr++) {
+      auto tile_group = data_table->GetTileGroup(tile_group_itr);
+      oid_t tuple_count = tile_group->GetNextTupleSlot();
+
+      // Column map and tile schema lookups for every value
+      tile_timer.Start();
+      for (oid_t tuple_itr = 0; tuple_itr < tuple_count; tuple_itr++) {
+        oid_t tile_offset, tile_column_id;
+        tile_group->LocateTileAndColumn(0, tile_offset, tile_column_id);
+        tile_sum += tile_group->GetTile(tile_offset)
+                        ->GetValue(tuple_itr, tile_column_id)
+                        .GetAs<int32_t>();
+      }
+      tile_timer.Stop();
+
+      // Resolved accessor, building a value
+      auto &accessor = tile_group->GetColumnAccessor(0);
+      value_timer.Start();
+      for (oid_t tuple_itr = 0; tuple_itr < tuple_count; tuple_itr++) {
+        value_sum += accessor.GetValue(tuple_itr).GetAs<int32_t>();
+      }
+      value_timer.Stop();
+
+      // Resolved accessor, reading the native value
+      native_timer.Start();
+      for (oid_t tuple_itr = 0; tuple_itr < tuple_count; tuple_itr++) {
+        native_sum += accessor.Get<int32_t>(tuple_itr);
+      }
+      native_timer.Stop();
+    }
+  }
+
+  EXPECT_EQ(tile_sum, value_sum);
+  EXPECT_EQ(tile_sum, native_sum);
+
+  LOG_INFO("Tile lookup : %.4lf s", tile_timer.GetDuration());
+  LOG_INFO("Accessor value : %.4lf s", value_timer.GetDuration());
+  LOG_INFO("Accessor native : %.4lf s", native_timer.GetDuration());
+}
+
+}  // namespace test
+}  // namespace peloton
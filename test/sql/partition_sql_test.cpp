@@ -0,0 +1,90 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// partition_sql_test.cpp
+//
+// Identification: test/sql/partition_sql_test.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <memory>
+
+#include "catalog/catalog.h"
+#include "catalog/partition_scheme.h"
+#include "common/harness.h"
+#include "storage/data_table.h"
+#include "storage/tile_group.h"
+
+#include "sql/sql_tests_util.h"
+
+namespace peloton {
+namespace test {
+
+class PartitionSQLTests : public PelotonTest {};
+
+TEST_F(PartitionSQLTests, RangePartitionTest) {
+  catalog::Catalog::GetInstance()->CreateDatabase(DEFAULT_DB_NAME, nullptr);
+
+  EXPECT_EQ(ResultType::SUCCESS,
+            SQLTestsUtil::ExecuteSQLQuery(
+                "CREATE TABLE test(a INT, b INT) "
+                "PARTITION BY RANGE (a) VALUES (100, 200);"));
+  auto table = catalog::Catalog::GetInstance()->GetTableWithName(
+      DEFAULT_DB_NAME, "test");
+  ASSERT_TRUE(table->GetPartitionScheme() != nullptr);
+  EXPECT_EQ(3, table->GetPartitionScheme()->GetPartitionCount());
+
+  SQLTestsUtil::ExecuteSQLQuery("INSERT INTO test VALUES (5, 1);");
+  SQLTestsUtil::ExecuteSQLQuery("INSERT INTO test VALUES (50, 2);");
+  SQLTestsUtil::ExecuteSQLQuery("INSERT INTO test VALUES (150, 3);");
+  SQLTestsUtil::ExecuteSQLQuery("INSERT INTO test VALUES (250, 4);");
+
+  // Every partition fills its own tile groups
+  std::vector<oid_t> tile_group_ids;
+  table->GetTileGroupIds({false, true, false}, tile_group_ids);
+  ASSERT_EQ(1, tile_group_ids.size());
+  auto tile_group = table->GetTileGroupById(tile_group_ids[0]);
+  EXPECT_EQ(1, tile_group->GetPartitionId());
+  EXPECT_EQ(1, tile_group->GetActiveTupleCount());
+
+  std::vector<StatementResult> result;
+  std::vector<FieldInfo> tuple_descriptor;
+  std::string error_message;
+  int rows_affected;
+
+  SQLTestsUtil::ExecuteSQLQuery("SELECT b FROM test WHERE a < 100;", result,
+                                tuple_descriptor, rows_affected, error_message);
+  EXPECT_EQ(2, result.size());
+
+  SQLTestsUtil::ExecuteSQLQuery(
+      "SELECT b FROM test WHERE a >= 100 AND a < 200;", result,
+      tuple_descriptor, rows_affected, error_message);
+  ASSERT_EQ(1, result.size());
+  EXPECT_EQ('3', result[0].second[0]);
+
+  SQLTestsUtil::ExecuteSQLQuery("SELECT b FROM test WHERE a = 5 OR a = 250;",
+                                result, tuple_descriptor, rows_affected,
+                                error_message);
+  EXPECT_EQ(2, result.size());
+
+  // Updates stay within the partition of the tuple
+  EXPECT_EQ(ResultType::SUCCESS, SQLTestsUtil::ExecuteSQLQuery(
+                                     "UPDATE test SET a = 60 WHERE b = 2;"));
+  EXPECT_NE(ResultType::SUCCESS, SQLTestsUtil::ExecuteSQLQuery(
+                                     "UPDATE test SET a = 10 WHERE b = 3;"));
+  SQLTestsUtil::ExecuteSQLQuery("SELECT a FROM test WHERE a > 100;", result,
+                                tuple_descriptor, rows_affected, error_message);
+  EXPECT_EQ(2, result.size());
+
+  // free the database just created
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto txn = txn_manager.BeginTransaction();
+  catalog::Catalog::GetInstance()->DropDatabaseWithName(DEFAULT_DB_NAME, txn);
+  txn_manager.CommitTransaction(txn);
+}
+
+}  // namespace test
+}  // namespace peloton
@@ -0,0 +1,71 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// read_only_sql_test.cpp
+//
+// Identification: test/sql/read_only_sql_test.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <memory>
+
+#include "catalog/catalog.h"
+#include "common/harness.h"
+#include "configuration/configuration.h"
+
+#include "sql/sql_tests_util.h"
+
+namespace peloton {
+namespace test {
+
+class ReadOnlySQLTests : public PelotonTest {};
+
+TEST_F(ReadOnlySQLTests, ReadOnlyTransactionTest) {
+  catalog::Catalog::GetInstance()->CreateDatabase(DEFAULT_DB_NAME, nullptr);
+
+  SQLTestsUtil::ExecuteSQLQuery("CREATE TABLE test(a INT PRIMARY KEY, b INT);");
+  SQLTestsUtil::ExecuteSQLQuery("INSERT INTO test VALUES (1, 10);");
+
+  std::vector<StatementResult> result;
+  std::vector<FieldInfo> tuple_descriptor;
+  std::string error_message;
+  int rows_affected;
+
+  // A read only transaction can read but not write
+  EXPECT_EQ(ResultType::SUCCESS,
+            SQLTestsUtil::ExecuteSQLQuery("BEGIN READ ONLY;"));
+  EXPECT_EQ(ResultType::SUCCESS,
+            SQLTestsUtil::ExecuteSQLQuery("SELECT * FROM test;"));
+  EXPECT_EQ(ResultType::FAILURE,
+            SQLTestsUtil::ExecuteSQLQuery("UPDATE test SET b=20 WHERE a=1;"));
+  EXPECT_EQ(ResultType::ABORTED, SQLTestsUtil::ExecuteSQLQuery("COMMIT;"));
+
+  // A rolled back read only transaction
+  EXPECT_EQ(ResultType::SUCCESS,
+            SQLTestsUtil::ExecuteSQLQuery("BEGIN READ ONLY;"));
+  EXPECT_EQ(ResultType::SUCCESS,
+            SQLTestsUtil::ExecuteSQLQuery("SELECT * FROM test;"));
+  EXPECT_EQ(ResultType::ABORTED, SQLTestsUtil::ExecuteSQLQuery("ROLLBACK;"));
+
+  // The update was not applied, and the connection reads its own insert
+  // also from the read only snapshot
+  FLAGS_autocommit_snapshot_read = true;
+  SQLTestsUtil::ExecuteSQLQuery("SELECT b FROM test WHERE a=1", result,
+                                tuple_descriptor, rows_affected, error_message);
+  FLAGS_autocommit_snapshot_read = false;
+  EXPECT_EQ(1, result.size());
+  EXPECT_EQ('1', result[0].second[0]);
+  EXPECT_EQ('0', result[0].second[1]);
+
+  // free the database just created
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto txn = txn_manager.BeginTransaction();
+  catalog::Catalog::GetInstance()->DropDatabaseWithName(DEFAULT_DB_NAME, txn);
+  txn_manager.CommitTransaction(txn);
+}
+
+}  // namespace test
+}  // namespace peloton
@@ -0,0 +1,80 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// latency_histogram_test.cpp
+//
+// Identification: test/statistics/latency_histogram_test.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "common/harness.h"
+
+#include "statistics/latency_histogram.h"
+#include "statistics/log_metric.h"
+
+namespace peloton {
+namespace test {
+
+//===--------------------------------------------------------------------===//
+// Latency Histogram Tests
+//===--------------------------------------------------------------------===//
+
+class LatencyHistogramTests : public PelotonTest {};
+
+TEST_F(LatencyHistogramTests, BucketTest) {
+  EXPECT_EQ(0, stats::LatencyHistogram::GetBucket(0));
+  EXPECT_EQ(1, stats::LatencyHistogram::GetBucket(1));
+  EXPECT_EQ(2, stats::LatencyHistogram::GetBucket(2));
+  EXPECT_EQ(2, stats::LatencyHistogram::GetBucket(3));
+  EXPECT_EQ(11, stats::LatencyHistogram::GetBucket(1024));
+  EXPECT_EQ(LATENCY_HISTOGRAM_BUCKET_COUNT - 1,
+            stats::LatencyHistogram::GetBucket(UINT64_MAX));
+}
+
+TEST_F(LatencyHistogramTests, PercentileTest) {
+  stats::LatencyHistogram histogram;
+  EXPECT_EQ(0, histogram.GetPercentile(50));
+
+  // 98 fast latencies and 2 slow ones
+  for (int itr = 0; itr < 98; itr++) {
+    histogram.RecordLatency(10);
+  }
+  histogram.RecordLatency(5000);
+  histogram.RecordLatency(6000);
+
+  EXPECT_EQ(100, histogram.GetCount());
+  EXPECT_EQ(6000, histogram.GetMax());
+  EXPECT_DOUBLE_EQ((98 * 10 + 5000 + 6000) / 100.0, histogram.GetAverage());
+
+  // Percentiles are reported as the upper bound of their bucket
+  EXPECT_EQ(15, histogram.GetPercentile(50));
+  EXPECT_EQ(6000, histogram.GetPercentile(99));
+  EXPECT_EQ(6000, histogram.GetPercentile(100));
+
+  histogram.Reset();
+  EXPECT_EQ(0, histogram.GetCount());
+  EXPECT_EQ(0, histogram.GetMax());
+}
+
+TEST_F(LatencyHistogramTests, LogMetricAggregateTest) {
+  stats::LogMetric source(LOG_METRIC);
+  stats::LogMetric aggregated(LOG_METRIC);
+
+  source.GetPhaseLatency(stats::LOG_PHASE_FSYNC).RecordLatency(100);
+  source.GetPhaseLatency(stats::LOG_PHASE_FSYNC).RecordLatency(300);
+  aggregated.GetPhaseLatency(stats::LOG_PHASE_FSYNC).RecordLatency(200);
+  aggregated.Aggregate(source);
+
+  auto &fsync_latency = aggregated.GetPhaseLatency(stats::LOG_PHASE_FSYNC);
+  EXPECT_EQ(3, fsync_latency.GetCount());
+  EXPECT_EQ(300, fsync_latency.GetMax());
+  EXPECT_DOUBLE_EQ(200.0, fsync_latency.GetAverage());
+  EXPECT_EQ(0,
+            aggregated.GetPhaseLatency(stats::LOG_PHASE_WRITE).GetCount());
+}
+
+}  // End test namespace
+}  // End peloton namespace
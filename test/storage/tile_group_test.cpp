@@ -543,5 +543,82 @@ TEST_F(TileGroupTests, TileCopyTest) {
   delete schema;
 }
 
+TEST_F(TileGroupTests, ColumnAccessorTest) {
+  catalog::Column column1(type::Type::INTEGER,
+                          type::Type::GetTypeSize(type::Type::INTEGER), "A",
+                          true);
+  catalog::Column column2(type::Type::TINYINT,
+                          type::Type::GetTypeSize(type::Type::TINYINT), "B",
+                          true);
+  catalog::Column column3(type::Type::VARCHAR, 25, "C", false);
+  catalog::Schema schema({column1, column2, column3});
+
+  // Row layout: one tile with every column
+  storage::column_map_type row_map;
+  for (oid_t col_itr = 0; col_itr < 3; col_itr++) {
+    row_map[col_itr] = std::make_pair(0, col_itr);
+  }
+  std::shared_ptr<storage::TileGroup> row_group(
+      storage::TileGroupFactory::GetTileGroup(
+          INVALID_OID, INVALID_OID,
+          TestingHarness::GetInstance().GetNextTileGroupId(), nullptr,
+          {schema}, row_map, 4));
+
+  // Column layout: one tile per column
+  std::vector<catalog::Schema> column_schemas;
+  storage::column_map_type column_map;
+  for (oid_t col_itr = 0; col_itr < 3; col_itr++) {
+    column_schemas.push_back(catalog::Schema({schema.GetColumn(col_itr)}));
+    column_map[col_itr] = std::make_pair(col_itr, 0);
+  }
+  std::shared_ptr<storage::TileGroup> column_group(
+      storage::TileGroupFactory::GetTileGroup(
+          INVALID_OID, INVALID_OID,
+          TestingHarness::GetInstance().GetNextTileGroupId(), nullptr,
+          column_schemas, column_map, 4));
+
+  storage::Tuple tuple(&schema, true);
+  auto pool = row_group->GetTilePool(0);
+  tuple.SetValue(0, type::ValueFactory::GetIntegerValue(7), pool);
+  tuple.SetValue(1, type::ValueFactory::GetTinyIntValue(3), pool);
+  tuple.SetValue(2, type::ValueFactory::GetVarcharValue("accessor"), pool);
+  EXPECT_EQ(0, row_group->InsertTuple(&tuple));
+  tuple.SetValue(2, type::ValueFactory::GetNullValueByType(type::Type::VARCHAR),
+                 pool);
+  EXPECT_EQ(1, row_group->InsertTuple(&tuple));
+  EXPECT_EQ(0, column_group->InsertTuple(&tuple));
+  EXPECT_EQ(1, column_group->InsertTuple(&tuple));
+
+  // Native reads and writes at fixed offsets
+  auto &integer_column = row_group->GetColumnAccessor(0);
+  EXPECT_EQ(7, integer_column.Get<int32_t>(0));
+  integer_column.Set<int32_t>(1, 42);
+  EXPECT_EQ(42, row_group->GetValue(1, 0).GetAs<int32_t>());
+  EXPECT_EQ(3, column_group->GetColumnAccessor(1).Get<int8_t>(0));
+
+  uint32_t length;
+  const char *data = row_group->GetColumnAccessor(2).GetVarlen(0, length);
+  EXPECT_EQ("accessor", std::string(data, length - 1));
+  data = row_group->GetColumnAccessor(2).GetVarlen(1, length);
+  EXPECT_TRUE(data == nullptr);
+
+  // Copy a row across layouts, the varchar is copied into the target pool
+  for (oid_t col_itr = 0; col_itr < 3; col_itr++) {
+    column_group->GetColumnAccessor(col_itr).CopyField(
+        0, row_group->GetColumnAccessor(col_itr), 0);
+    column_group->GetColumnAccessor(col_itr).CopyField(
+        1, row_group->GetColumnAccessor(col_itr), 1);
+  }
+  row_group->GetColumnAccessor(2).SetValue(
+      0, type::ValueFactory::GetVarcharValue("changed"));
+
+  EXPECT_EQ(7, column_group->GetValue(0, 0).GetAs<int32_t>());
+  EXPECT_EQ(42, column_group->GetValue(1, 0).GetAs<int32_t>());
+  EXPECT_EQ(type::CMP_TRUE,
+            column_group->GetValue(0, 2).CompareEquals(
+                type::ValueFactory::GetVarcharValue("accessor")));
+  EXPECT_TRUE(column_group->GetValue(1, 2).IsNull());
+}
+
 }  // End test namespace
 }  // End peloton namespace
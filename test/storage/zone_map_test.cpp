@@ -0,0 +1,137 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// zone_map_test.cpp
+//
+// Identification: test/storage/zone_map_test.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "common/harness.h"
+
+#include "concurrency/transaction_manager_factory.h"
+#include "executor/executor_tests_util.h"
+#include "executor/zone_map_filter.h"
+#include "expression/expression_util.h"
+#include "storage/data_table.h"
+#include "storage/tile_group.h"
+#include "storage/zone_map.h"
+
+namespace peloton {
+namespace test {
+
+//===--------------------------------------------------------------------===//
+// Zone Map Tests
+//===--------------------------------------------------------------------===//
+
+class ZoneMapTests : public PelotonTest {};
+
+TEST_F(ZoneMapTests, SynopsisTest) {
+  const int tuple_count = TESTS_TUPLES_PER_TILEGROUP;
+
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto txn = txn_manager.BeginTransaction();
+  std::unique_ptr<storage::DataTable> data_table(
+      ExecutorTestsUtil::CreateTable(tuple_count, false));
+  ExecutorTestsUtil::PopulateTable(data_table.get(), tuple_count * 2, false,
+                                   false, false, txn);
+  txn_manager.CommitTransaction(txn);
+
+  // The first column holds 0, 10, 20, ... in insertion order
+  auto tile_group = data_table->GetTileGroup(1);
+  auto zone_map = tile_group->GetZoneMap();
+  ASSERT_TRUE(zone_map != nullptr);
+  auto &synopsis = zone_map->GetColumnSynopsis(0);
+  EXPECT_TRUE(synopsis.has_values);
+  EXPECT_EQ(10 * tuple_count, synopsis.min.GetAs<int32_t>());
+  EXPECT_EQ(10 * (2 * tuple_count - 1), synopsis.max.GetAs<int32_t>());
+  EXPECT_EQ(0, synopsis.null_count);
+  EXPECT_FALSE(zone_map->MayBeNull(0));
+
+  auto low = type::ValueFactory::GetIntegerValue(10 * tuple_count - 1);
+  auto high = type::ValueFactory::GetIntegerValue(10 * 2 * tuple_count);
+  EXPECT_FALSE(zone_map->MayMatch(0, ExpressionType::COMPARE_LESSTHAN, low));
+  EXPECT_TRUE(zone_map->MayMatch(0, ExpressionType::COMPARE_GREATERTHAN, low));
+  EXPECT_FALSE(zone_map->MayMatch(0, ExpressionType::COMPARE_EQUAL, high));
+  EXPECT_FALSE(zone_map->MayMatch(
+      0, ExpressionType::COMPARE_GREATERTHANOREQUALTO, high));
+
+  // The map is reused until a slot is written
+  EXPECT_EQ(zone_map, tile_group->GetZoneMap());
+  auto value = type::ValueFactory::GetNullValueByType(type::Type::INTEGER);
+  tile_group->SetValue(value, 0, 0);
+  auto new_zone_map = tile_group->GetZoneMap();
+  EXPECT_NE(zone_map, new_zone_map);
+  EXPECT_EQ(1, new_zone_map->GetColumnSynopsis(0).null_count);
+  EXPECT_TRUE(new_zone_map->MayBeNull(0));
+
+  // The tile group that takes the next inserts has no zone map yet
+  auto last_tile_group =
+      data_table->GetTileGroup(data_table->GetTileGroupCount() - 1);
+  EXPECT_TRUE(last_tile_group->GetZoneMap() == nullptr);
+}
+
+TEST_F(ZoneMapTests, FilterTest) {
+  const int tuple_count = TESTS_TUPLES_PER_TILEGROUP;
+
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto txn = txn_manager.BeginTransaction();
+  std::unique_ptr<storage::DataTable> data_table(
+      ExecutorTestsUtil::CreateTable(tuple_count, false));
+  ExecutorTestsUtil::PopulateTable(data_table.get(), tuple_count * 3, false,
+                                   false, false, txn);
+  txn_manager.CommitTransaction(txn);
+
+  // (a >= 10 * tuple_count AND 20 * tuple_count > a) OR b IS NULL
+  auto lower = expression::ExpressionUtil::ComparisonFactory(
+      ExpressionType::COMPARE_GREATERTHANOREQUALTO,
+      expression::ExpressionUtil::TupleValueFactory(type::Type::INTEGER, 0, 0),
+      expression::ExpressionUtil::ConstantValueFactory(
+          type::ValueFactory::GetIntegerValue(10 * tuple_count)));
+  auto upper = expression::ExpressionUtil::ComparisonFactory(
+      ExpressionType::COMPARE_GREATERTHAN,
+      expression::ExpressionUtil::ConstantValueFactory(
+          type::ValueFactory::GetIntegerValue(20 * tuple_count)),
+      expression::ExpressionUtil::TupleValueFactory(type::Type::INTEGER, 0, 0));
+  auto is_null = expression::ExpressionUtil::OperatorFactory(
+      ExpressionType::OPERATOR_IS_NULL, type::Type::BOOLEAN,
+      expression::ExpressionUtil::TupleValueFactory(type::Type::INTEGER, 0, 1),
+      nullptr);
+  std::unique_ptr<expression::AbstractExpression> predicate(
+      expression::ExpressionUtil::ConjunctionFactory(
+          ExpressionType::CONJUNCTION_OR,
+          expression::ExpressionUtil::ConjunctionFactory(
+              ExpressionType::CONJUNCTION_AND, lower, upper),
+          is_null));
+
+  executor::ZoneMapFilter filter;
+  filter.Init(predicate.get(), nullptr);
+  EXPECT_FALSE(filter.IsEmpty());
+
+  // Only the second tile group holds values in the range
+  EXPECT_FALSE(filter.MayMatch(data_table->GetTileGroup(0).get()));
+  EXPECT_TRUE(filter.MayMatch(data_table->GetTileGroup(1).get()));
+  EXPECT_FALSE(filter.MayMatch(data_table->GetTileGroup(2).get()));
+
+  // A NULL written later on brings the first tile group back
+  auto value = type::ValueFactory::GetNullValueByType(type::Type::INTEGER);
+  data_table->GetTileGroup(0)->SetValue(value, 0, 1);
+  EXPECT_TRUE(filter.MayMatch(data_table->GetTileGroup(0).get()));
+
+  // Predicates without checkable parts leave an empty filter
+  std::unique_ptr<expression::AbstractExpression> not_equal(
+      expression::ExpressionUtil::ComparisonFactory(
+          ExpressionType::COMPARE_NOTEQUAL,
+          expression::ExpressionUtil::TupleValueFactory(type::Type::INTEGER,
+                                                        0, 0),
+          expression::ExpressionUtil::ConstantValueFactory(
+              type::ValueFactory::GetIntegerValue(0))));
+  filter.Init(not_equal.get(), nullptr);
+  EXPECT_TRUE(filter.IsEmpty());
+}
+
+}  // End test namespace
+}  // End peloton namespace
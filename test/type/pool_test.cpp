@@ -12,8 +12,13 @@
 
 #include <limits.h>
 #include <pthread.h>
+#include <algorithm>
+#include <cstring>
+#include <thread>
+#include <vector>
 
 #include "type/ephemeral_pool.h"
+#include "type/slab_pool.h"
 #include "gtest/gtest.h"
 #include "common/harness.h"
 
@@ -57,5 +62,116 @@ TEST_F(PoolTests, AllocateOnceTest) {
   delete pool;
 }
 
+// Freed chunks are reused by allocations of the same size class
+TEST_F(PoolTests, SlabReuseTest) {
+  type::SlabPool pool;
+
+  char *first = (char *)pool.Allocate(40);
+  EXPECT_TRUE(first != nullptr);
+  memset(first, 'x', 40);
+  pool.Free(first);
+  EXPECT_EQ(0, pool.GetStats().allocated_bytes);
+  EXPECT_EQ(64, pool.GetStats().free_bytes);
+
+  char *second = (char *)pool.Allocate(50);
+  EXPECT_EQ(first, second);
+  EXPECT_EQ(0, pool.GetStats().free_bytes);
+
+  // A different size class takes a new chunk
+  char *third = (char *)pool.Allocate(200);
+  EXPECT_NE(second, third);
+
+  auto stats = pool.GetStats();
+  EXPECT_EQ(SLAB_POOL_MIN_SLAB_SIZE * 2, stats.reserved_bytes);
+  EXPECT_EQ(64 + 256, stats.allocated_bytes);
+  EXPECT_EQ(250, stats.requested_bytes);
+  EXPECT_GT(stats.GetFragmentation(), 0.8);
+
+  pool.Free(second);
+  pool.Free(third);
+}
+
+// The slabs of a size class start small and double up to the max slab size
+TEST_F(PoolTests, SlabGrowthTest) {
+  type::SlabPool pool;
+  const size_t chunk_size = 64;
+  const size_t value_size = chunk_size - 8;
+  std::vector<void *> chunks;
+
+  // The first slab holds the chunks of a small tile
+  chunks.push_back(pool.Allocate(value_size));
+  EXPECT_EQ(SLAB_POOL_MIN_SLAB_SIZE, pool.GetStats().reserved_bytes);
+
+  size_t reserved_bytes = 0;
+  size_t slab_size = SLAB_POOL_MIN_SLAB_SIZE;
+  while (slab_size <= SLAB_POOL_MAX_SLAB_SIZE * 2) {
+    reserved_bytes += std::min<size_t>(slab_size, SLAB_POOL_MAX_SLAB_SIZE);
+    while (chunks.size() * chunk_size < reserved_bytes) {
+      chunks.push_back(pool.Allocate(value_size));
+    }
+    EXPECT_EQ(reserved_bytes, pool.GetStats().reserved_bytes);
+    slab_size *= 2;
+  }
+
+  for (auto chunk : chunks) {
+    pool.Free(chunk);
+  }
+}
+
+// Allocations beyond the largest size class bypass the slabs
+TEST_F(PoolTests, SlabLargeAllocationTest) {
+  type::SlabPool pool;
+  size_t size = SLAB_POOL_MAX_CHUNK_SIZE * 4;
+
+  char *p = (char *)pool.Allocate(size);
+  EXPECT_TRUE(p != nullptr);
+  memset(p, 'x', size);
+  EXPECT_EQ(size, pool.GetStats().requested_bytes);
+
+  pool.Free(p);
+  auto stats = pool.GetStats();
+  EXPECT_EQ(0, stats.reserved_bytes);
+  EXPECT_EQ(0, stats.requested_bytes);
+}
+
+// Threads allocate and free strings of random sizes concurrently
+TEST_F(PoolTests, SlabConcurrentTest) {
+  type::SlabPool pool;
+  std::vector<std::thread> threads;
+
+  for (int thread_itr = 0; thread_itr < 4; thread_itr++) {
+    threads.emplace_back([&pool, thread_itr] {
+      std::vector<std::pair<char *, size_t>> chunks;
+      unsigned int seed = thread_itr;
+      for (int itr = 0; itr < M; itr++) {
+        size_t size = rand_r(&seed) % str_len + 1;
+        char *p = (char *)pool.Allocate(size);
+        memset(p, thread_itr, size);
+        chunks.emplace_back(p, size);
+
+        // Free every other chunk right away
+        if (itr % 2 == 1) {
+          auto chunk = chunks.back();
+          chunks.pop_back();
+          for (size_t byte_itr = 0; byte_itr < chunk.second; byte_itr++) {
+            EXPECT_EQ(thread_itr, chunk.first[byte_itr]);
+          }
+          pool.Free(chunk.first);
+        }
+      }
+      for (auto &chunk : chunks) {
+        pool.Free(chunk.first);
+      }
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+
+  auto stats = pool.GetStats();
+  EXPECT_EQ(0, stats.allocated_bytes);
+  EXPECT_EQ(0, stats.requested_bytes);
+}
+
 }
 }
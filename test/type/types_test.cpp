@@ -273,6 +273,31 @@ TEST_F(TypesTests, IndexTypeTest) {
                peloton::Exception);
 }
 
+TEST_F(TypesTests, PartitionTypeTest) {
+  std::vector<PartitionType> list = {PartitionType::INVALID,
+                                     PartitionType::RANGE, PartitionType::HASH};
+
+  // Make sure that ToString and FromString work
+  for (auto val : list) {
+    std::string str = peloton::PartitionTypeToString(val);
+    EXPECT_TRUE(str.size() > 0);
+
+    auto newVal = peloton::StringToPartitionType(str);
+    EXPECT_EQ(val, newVal);
+
+    std::ostringstream os;
+    os << val;
+    EXPECT_EQ(str, os.str());
+  }
+
+  // Then make sure that we can't cast garbage
+  std::string invalid("Mosaic");
+  EXPECT_THROW(peloton::StringToPartitionType(invalid), peloton::Exception);
+  EXPECT_THROW(
+      peloton::PartitionTypeToString(static_cast<PartitionType>(-99999)),
+      peloton::Exception);
+}
+
 TEST_F(TypesTests, IndexConstraintTypeTest) {
   std::vector<IndexConstraintType> list = {
       IndexConstraintType::INVALID, IndexConstraintType::DEFAULT,
@@ -548,10 +573,13 @@ TEST_F(TypesTests, LogRecordTypeTest) {
       LOGRECORD_TYPE_WAL_TUPLE_INSERT,
       LOGRECORD_TYPE_WAL_TUPLE_DELETE,
       LOGRECORD_TYPE_WAL_TUPLE_UPDATE,
+      LOGRECORD_TYPE_WAL_TUPLE_PARTIAL_UPDATE,
       LOGRECORD_TYPE_WBL_TUPLE_INSERT,
       LOGRECORD_TYPE_WBL_TUPLE_DELETE,
       LOGRECORD_TYPE_WBL_TUPLE_UPDATE,
       LOGRECORD_TYPE_ITERATION_DELIMITER,
+      LOGRECORD_TYPE_CHECKPOINT_TILE_GROUP,
+      LOGRECORD_TYPE_COMPRESSED_BLOCK,
   };
 
   // Make sure that ToString and FromString work